@@ -0,0 +1,57 @@
+/**
+ * @file core/cereal/template_class_version.hpp
+ *
+ * A version of CEREAL_CLASS_VERSION() for class templates.  Cereal's own macro
+ * only works for complete types, so it cannot set the version of every
+ * instantiation of a template at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CEREAL_TEMPLATE_CLASS_VERSION_HPP
+#define MLPACK_CORE_CEREAL_TEMPLATE_CLASS_VERSION_HPP
+
+#include <cereal/cereal.hpp>
+
+//! Remove the parentheses around a macro argument that contains commas.
+#define MLPACK_CEREAL_UNPAREN(...) __VA_ARGS__
+
+/**
+ * Set the cereal class version of every instantiation of a class template.
+ * The template signature and the class must be given in parentheses, since
+ * they may contain commas.  This must be used at global scope.  For example:
+ *
+ * @code
+ * CEREAL_TEMPLATE_CLASS_VERSION(
+ *     (template<typename SortPolicy, typename MatType>),
+ *     (mlpack::neighbor::LSHSearch<SortPolicy, MatType>), (1));
+ * @endcode
+ *
+ * When loading, the serialize() function of the class then receives the
+ * version the archive was saved with (0 for archives saved before the version
+ * was set).
+ */
+#define CEREAL_TEMPLATE_CLASS_VERSION(SIGNATURE, T, TVERSION) \
+namespace cereal { \
+namespace detail { \
+MLPACK_CEREAL_UNPAREN SIGNATURE \
+struct Version<MLPACK_CEREAL_UNPAREN T> \
+{ \
+  static std::uint32_t registerVersion() \
+  { \
+    ::cereal::detail::StaticObject<Versions>::getInstance().mapping.emplace( \
+        std::type_index(typeid(MLPACK_CEREAL_UNPAREN T)).hash_code(), \
+        MLPACK_CEREAL_UNPAREN TVERSION); \
+    return MLPACK_CEREAL_UNPAREN TVERSION; \
+  } \
+  static const std::uint32_t version; \
+}; \
+MLPACK_CEREAL_UNPAREN SIGNATURE \
+const std::uint32_t Version<MLPACK_CEREAL_UNPAREN T>::version = \
+    Version<MLPACK_CEREAL_UNPAREN T>::registerVersion(); \
+} /* namespace detail */ \
+} /* namespace cereal */
+
+#endif
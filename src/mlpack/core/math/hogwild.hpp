@@ -0,0 +1,96 @@
+/**
+ * @file core/math/hogwild.hpp
+ *
+ * Run one epoch of lock-free parallel stochastic gradient descent, as in
+ * Hogwild!.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_HOGWILD_HPP
+#define MLPACK_CORE_MATH_HOGWILD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "random.hpp"
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Visit every example in the given order once, calling update(i) for each
+ * example index i, in parallel and without any locking, as in the Hogwild!
+ * algorithm:
+ *
+ * @code
+ * @inproceedings{recht2011hogwild,
+ *   title={Hogwild!: A Lock-Free Approach to Parallelizing Stochastic Gradient
+ *       Descent},
+ *   author={Recht, Benjamin and Re, Christopher and Wright, Stephen and Niu,
+ *       Feng},
+ *   booktitle={Advances in Neural Information Processing Systems},
+ *   pages={693--701},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The order is split into one contiguous block per thread.  If shuffle is
+ * true, each thread shuffles its own block (with its own generator, seeded
+ * from RandGen()) before visiting it, so no serial shuffle of the whole order
+ * is needed.  The shuffled order is kept, so later epochs start from it.
+ *
+ * Updates from different threads may overlap, and their order is not fixed,
+ * so results are not reproducible from run to run; this is only reasonable when
+ * each update touches a small part of the parameters, as it does for matrix
+ * factorization of sparse ratings.
+ *
+ * @param visitationOrder Indices of the examples to visit.
+ * @param shuffle Whether or not to shuffle the order of each block.
+ * @param update Callable taking the index of an example.
+ */
+template<typename UpdateFunctionType>
+void HogwildEpoch(arma::uvec& visitationOrder,
+                  const bool shuffle,
+                  UpdateFunctionType& update)
+{
+  const size_t numPoints = visitationOrder.n_elem;
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = (size_t) omp_get_max_threads();
+  #endif
+  numThreads = std::max((size_t) 1, std::min(numThreads, numPoints));
+
+  // Draw the seeds serially, so that the shuffle of each block only depends on
+  // RandGen().  (The result of the epoch still depends on how the updates of
+  // the threads interleave, which differs from run to run.)
+  std::vector<std::mt19937::result_type> seeds(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+    seeds[t] = RandGen()();
+
+  #pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    const size_t begin = t * numPoints / numThreads;
+    const size_t end = (t + 1) * numPoints / numThreads;
+
+    if (shuffle)
+    {
+      std::mt19937 generator(seeds[t]);
+      std::shuffle(visitationOrder.begin() + begin,
+          visitationOrder.begin() + end, generator);
+    }
+
+    for (size_t j = begin; j < end; ++j)
+      update(visitationOrder[j]);
+  }
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
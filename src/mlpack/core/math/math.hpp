@@ -11,9 +11,11 @@
 #include "clamp.hpp"
 #include "columns_to_blocks.hpp"
 #include "digamma.hpp"
+#include "hogwild.hpp"
 #include "lin_alg.hpp"
 #include "log_add.hpp"
 #include "make_alias.hpp"
+#include "mixed_product.hpp"
 #include "multiply_slices.hpp"
 #include "quantile.hpp"
 #include "random_basis.hpp"
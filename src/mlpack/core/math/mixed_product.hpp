@@ -0,0 +1,106 @@
+/**
+ * @file core/math/mixed_product.hpp
+ *
+ * Products of double precision model parameters with data of any element type,
+ * dense or sparse, without converting the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_MIXED_PRODUCT_HPP
+#define MLPACK_CORE_MATH_MIXED_PRODUCT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Compute left * data, where left holds doubles (for instance the parameters
+ * of a linear model) and data is a dense or sparse matrix of doubles.
+ *
+ * @param left Dense matrix of doubles.
+ * @param data Dense or sparse data matrix.
+ * @return The product, in double precision.
+ */
+template<typename LeftType, typename MatType>
+arma::mat MixedProduct(
+    const LeftType& left,
+    const MatType& data,
+    const std::enable_if_t<std::is_same<typename MatType::elem_type,
+        double>::value>* = 0)
+{
+  return left * data;
+}
+
+/**
+ * Compute left * data, where left holds doubles and data is a dense or sparse
+ * matrix of another element type (for instance float).  Armadillo cannot
+ * multiply matrices of different element types, so left (which is usually
+ * much smaller than the data) is converted to the element type of the data.
+ *
+ * @param left Dense matrix of doubles.
+ * @param data Dense or sparse data matrix.
+ * @return The product, in double precision.
+ */
+template<typename LeftType, typename MatType>
+arma::mat MixedProduct(
+    const LeftType& left,
+    const MatType& data,
+    const std::enable_if_t<!std::is_same<typename MatType::elem_type,
+        double>::value>* = 0)
+{
+  typedef typename MatType::elem_type ElemType;
+  const arma::Mat<ElemType> convertedLeft =
+      arma::conv_to<arma::Mat<ElemType>>::from(left);
+  return arma::conv_to<arma::mat>::from(arma::Mat<ElemType>(convertedLeft *
+      data));
+}
+
+/**
+ * Compute left * data.t(), where left holds doubles (for instance residuals,
+ * when computing a gradient) and data is a dense or sparse matrix of doubles.
+ *
+ * @param left Dense matrix of doubles.
+ * @param data Dense or sparse data matrix.
+ * @return The product, in double precision.
+ */
+template<typename LeftType, typename MatType>
+arma::mat MixedProductTrans(
+    const LeftType& left,
+    const MatType& data,
+    const std::enable_if_t<std::is_same<typename MatType::elem_type,
+        double>::value>* = 0)
+{
+  return left * data.t();
+}
+
+/**
+ * Compute left * data.t(), where left holds doubles and data is a dense or
+ * sparse matrix of another element type; left is converted to the element
+ * type of the data.
+ *
+ * @param left Dense matrix of doubles.
+ * @param data Dense or sparse data matrix.
+ * @return The product, in double precision.
+ */
+template<typename LeftType, typename MatType>
+arma::mat MixedProductTrans(
+    const LeftType& left,
+    const MatType& data,
+    const std::enable_if_t<!std::is_same<typename MatType::elem_type,
+        double>::value>* = 0)
+{
+  typedef typename MatType::elem_type ElemType;
+  const arma::Mat<ElemType> convertedLeft =
+      arma::conv_to<arma::Mat<ElemType>>::from(left);
+  return arma::conv_to<arma::mat>::from(arma::Mat<ElemType>(convertedLeft *
+      data.t()));
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
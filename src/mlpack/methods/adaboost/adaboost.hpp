@@ -189,6 +189,27 @@ class AdaBoost
   std::vector<WeakLearnerType> wl;
   //! The weights corresponding to each weak learner.
   std::vector<double> alpha;
+
+  //! Get the columns [begin, end) of a dense matrix as an alias (no points are
+  //! copied).
+  template<typename eT>
+  static arma::Mat<eT> ColumnBlock(const arma::Mat<eT>& data,
+                                   const size_t begin,
+                                   const size_t end)
+  {
+    return arma::Mat<eT>(const_cast<eT*>(data.colptr(begin)), data.n_rows,
+        end - begin, false, true);
+  }
+
+  //! Get a copy of the columns [begin, end) of a sparse matrix (an alias is not
+  //! possible).
+  template<typename eT>
+  static arma::SpMat<eT> ColumnBlock(const arma::SpMat<eT>& data,
+                                     const size_t begin,
+                                     const size_t end)
+  {
+    return arma::SpMat<eT>(data.cols(begin, end - 1));
+  }
 }; // class AdaBoost
 
 } // namespace adaboost
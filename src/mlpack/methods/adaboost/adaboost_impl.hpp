@@ -87,13 +87,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // To be used for prediction by the weak learner.
   arma::Row<size_t> predictedLabels(labels.n_cols);
 
-  // Use tempData to modify input data for incorporating weights.
-  MatType tempData(data);
-
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
-      predictedLabels.n_cols);
-
   // Load the initial weights into a 2-D matrix.
   const double initWeight = 1.0 / double(data.n_cols * numClasses);
   arma::mat D(numClasses, data.n_cols);
@@ -102,9 +95,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Weights are stored in this row vector.
   arma::rowvec weights(predictedLabels.n_cols);
 
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
-
   // Now, start the boosting rounds.
   for (size_t i = 0; i < iterations; ++i)
   {
@@ -131,7 +121,7 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // This trains the new WeakLearnerType using the hyperparameters from the
     // given WeakLearnerType.
 
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    WeakLearnerType w(other, data, labels, numClasses, weights);
     // There is a bug with Adaboost!  It will not use the specified
     // hyperparameters for the decision tree because they are not properly
     // passed to the new weak learners!  (And: it's a hard bug, because the
@@ -139,18 +129,17 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // trained with!)
 
     // DecisionTree(DecisionTree&, MatType&, LabelsType&, size_t, WeightsType&, double = 0.0, double = 0.0, ...);
-    w.Classify(tempData, predictedLabels);
+    w.Classify(data, predictedLabels);
 
-    // Now from predictedLabels, build ht, the weak hypothesis
-    // buildClassificationMatrix(ht, predictedLabels);
-
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  The weight of each point is the sum
+    // of its column of D.
+    #pragma omp parallel for schedule(static) reduction(+:rt)
+    for (size_t j = 0; j < (size_t) D.n_cols; ++j)
     {
       if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
+        rt += weights(j);
       else
-        rt -= arma::accu(D.col(j));
+        rt -= weights(j);
     }
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
@@ -174,41 +163,19 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights: the weights of the points that were
+    // classified correctly are decreased, and the others are increased.  We
+    // also calculate zt, the normalization constant.
+    const double expo = exp(alphat);
+    #pragma omp parallel for schedule(static) reduction(+:zt)
+    for (size_t j = 0; j < (size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
       if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
+        D.col(j) /= expo;
       else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
+        D.col(j) *= expo;
+
+      zt += arma::accu(D.col(j));
     }
 
     // Normalize D.
@@ -228,7 +195,6 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
   arma::mat probabilities;
 
   Classify(test, predictedLabels, probabilities);
@@ -243,29 +209,43 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // Each thread classifies a contiguous block of points, evaluating each weak
+  // learner once on the whole block.
+  #pragma omp parallel
   {
-    wl[i].Classify(test, tempPredictedLabels);
+    size_t threadId = 0;
+    size_t numThreads = 1;
+    #ifdef MLPACK_USE_OPENMP
+      threadId = omp_get_thread_num();
+      numThreads = omp_get_num_threads();
+    #endif
+
+    const size_t blockSize = (test.n_cols + numThreads - 1) / numThreads;
+    const size_t begin = std::min(threadId * blockSize, (size_t) test.n_cols);
+    const size_t end = std::min(begin + blockSize, (size_t) test.n_cols);
+
+    if (begin < end)
+    {
+      // For dense data, the block is an alias of the columns of the test set,
+      // so no points are copied.
+      const MatType block = ColumnBlock(test, begin, end);
+      arma::Row<size_t> tempPredictedLabels;
+      for (size_t i = 0; i < wl.size(); ++i)
+      {
+        wl[i].Classify(block, tempPredictedLabels);
 
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
+        for (size_t j = 0; j < tempPredictedLabels.n_elem; ++j)
+          probabilities(tempPredictedLabels(j), begin + j) += alpha[i];
+      }
+    }
   }
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
-
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
-    pRow.max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  probabilities.each_row() /= arma::sum(probabilities, 0);
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(probabilities, 0));
 }
 
 /**
@@ -175,6 +175,19 @@ using SVDCompleteIncrementalFactorizer = amf::AMF<
     amf::SimpleResidueTermination,
     amf::RandomAcolInitialization<>,
     amf::SVDCompleteIncrementalLearning<MatType>>;
+
+/**
+ * SVDHogwildFactorizer factorizes given matrix V into two matrices W and H by
+ * complete incremental gradient descent, visiting the non-zero elements of V
+ * in parallel without locking (Hogwild!).
+ *
+ * @see SVDHogwildLearning
+ */
+using SVDHogwildFactorizer = amf::AMF<
+    amf::SimpleResidueTermination,
+    amf::RandomAcolInitialization<>,
+    amf::SVDHogwildLearning>;
+
 } // namespace amf
 } // namespace mlpack
 
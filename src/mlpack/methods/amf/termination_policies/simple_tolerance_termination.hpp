@@ -75,30 +75,10 @@ class SimpleToleranceTermination
    */
   bool IsConverged(arma::mat& W, arma::mat& H)
   {
-    arma::mat WH;
-
-    WH = W * H;
-
     // Compute residue.
     residueOld = residue;
-    size_t n = V->n_rows;
-    size_t m = V->n_cols;
-    double sum = 0;
     size_t count = 0;
-    for (size_t i = 0; i < n; ++i)
-    {
-        for (size_t j = 0; j < m; ++j)
-        {
-            double temp = 0;
-            if ((temp = (*V)(i, j)) != 0)
-            {
-                temp = (temp - WH(i, j));
-                temp = temp * temp;
-                sum += temp;
-                count++;
-            }
-        }
-    }
+    const double sum = SquaredError(*V, W, H, count);
 
     residue = sum;
     if (count > 0)
@@ -171,6 +151,64 @@ class SimpleToleranceTermination
   double& Tolerance() { return tolerance; }
 
  private:
+  /**
+   * Compute the sum of squared errors over the non-zero elements of a dense
+   * V, and count them.
+   */
+  template<typename eT>
+  static double SquaredError(const arma::Mat<eT>& V,
+                             const arma::mat& W,
+                             const arma::mat& H,
+                             size_t& count)
+  {
+    const arma::mat WH = W * H;
+    double sum = 0;
+    count = 0;
+    for (size_t i = 0; i < V.n_rows; ++i)
+    {
+        for (size_t j = 0; j < V.n_cols; ++j)
+        {
+            double temp = 0;
+            if ((temp = V(i, j)) != 0)
+            {
+                temp = (temp - WH(i, j));
+                temp = temp * temp;
+                sum += temp;
+                count++;
+            }
+        }
+    }
+
+    return sum;
+  }
+
+  /**
+   * Compute the sum of squared errors over the non-zero elements of a sparse
+   * V, and count them.  W * H is never formed, so the cost only depends on
+   * the number of non-zero elements.
+   */
+  static double SquaredError(const arma::sp_mat& V,
+                             const arma::mat& W,
+                             const arma::mat& H,
+                             size_t& count)
+  {
+    V.sync();
+    double sum = 0;
+    #pragma omp parallel for reduction(+:sum)
+    for (size_t j = 0; j < V.n_cols; ++j)
+    {
+      for (arma::sp_mat::const_col_iterator it = V.begin_col(j);
+           it != V.end_col(j); ++it)
+      {
+        const double temp = (*it) - arma::dot(W.row(it.row()), H.col(j));
+        sum += temp * temp;
+      }
+    }
+
+    count = V.n_nonzero;
+    return sum;
+  }
+
   //! Locally-stored tolerance.
   double tolerance;
   //! Locally-stored iteration threshold.
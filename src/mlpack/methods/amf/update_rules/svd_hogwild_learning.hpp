@@ -0,0 +1,156 @@
+/**
+ * @file methods/amf/update_rules/svd_hogwild_learning.hpp
+ *
+ * SVD factorizer used in AMF (Alternating Matrix Factorization), which runs
+ * stochastic gradient descent over the ratings in parallel without locking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_SVD_HOGWILD_LEARNING_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_SVD_HOGWILD_LEARNING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/hogwild.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class computes SVD with the same per-element updates as complete
+ * incremental learning ('Algorithm 3' in the paper below), but visits all of
+ * the non-zero elements of the input matrix (V) in parallel, without locking,
+ * as in Hogwild!.  Since each update only touches one row of W and one column
+ * of H, collisions between threads are rare for sparse ratings.
+ *
+ * @code
+ * @techreport{ma2008guide,
+ *   title={A Guide to Singular Value Decomposition for Collaborative
+ *       Filtering},
+ *   author={Ma, Chih-Chao},
+ *   year={2008},
+ *   institution={Department of Computer Science, National Taiwan University}
+ * }
+ * @endcode
+ *
+ * Each call to WUpdate() makes one full pass over the non-zero elements of V,
+ * updating both W and H; HUpdate() does nothing.  So, this update rule should
+ * be used with a termination policy that checks every iteration, such as
+ * SimpleResidueTermination or SimpleToleranceTermination.
+ *
+ * @see SVDCompleteIncrementalLearning
+ */
+class SVDHogwildLearning
+{
+ public:
+  /**
+   * Initialize the SVDHogwildLearning class with the given parameters.
+   *
+   * @param u Step value used in batch learning.
+   * @param kw Regularization constant for W matrix.
+   * @param kh Regularization constant for H matrix.
+   * @param shuffle Whether or not to visit the elements in a random order.
+   */
+  SVDHogwildLearning(const double u = 0.001,
+                     const double kw = 0,
+                     const double kh = 0,
+                     const bool shuffle = true) :
+      u(u), kw(kw), kh(kh), shuffle(shuffle)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize parameters before factorization.  This function must be called
+   * before a new factorization.  The locations and values of the non-zero
+   * elements of the dataset are stored, so that they can be visited in any
+   * order.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    const arma::sp_mat data(dataset);
+
+    locations.set_size(2, data.n_nonzero);
+    values.set_size(data.n_nonzero);
+    size_t i = 0;
+    for (arma::sp_mat::const_iterator it = data.begin(); it != data.end();
+         ++it, ++i)
+    {
+      locations(0, i) = it.row();
+      locations(1, i) = it.col();
+      values(i) = (*it);
+    }
+
+    visitationOrder = arma::linspace<arma::uvec>(0, data.n_nonzero - 1,
+        data.n_nonzero);
+  }
+
+  /**
+   * Make one pass over all the non-zero elements of V, updating the
+   * corresponding row of W and column of H for each of them.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      arma::mat& H)
+  {
+    auto update = [&](const size_t i)
+    {
+      const size_t item = locations(0, i);
+      const size_t user = locations(1, i);
+
+      const double error = values(i) - arma::dot(W.row(item), H.col(user));
+      W.row(item) += u * (error * H.col(user).t() - kw * W.row(item));
+      H.col(user) += u * (error * W.row(item).t() - kh * H.col(user));
+    };
+
+    math::HogwildEpoch(visitationOrder, shuffle, update);
+  }
+
+  /**
+   * H is already updated by WUpdate(), so this does nothing.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param * (W) Basis matrix.
+   * @param * (H) Encoding matrix.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& /* V */,
+                      const arma::mat& /* W */,
+                      arma::mat& /* H */)
+  {
+    // Nothing to do.
+  }
+
+ private:
+  //! Step size of the updates.
+  double u;
+  //! Regularization parameter for matrix W.
+  double kw;
+  //! Regularization parameter for matrix H.
+  double kh;
+  //! Whether or not to shuffle the order of the elements.
+  bool shuffle;
+
+  //! Locations (item, user) of the non-zero elements.
+  arma::umat locations;
+  //! Values of the non-zero elements.
+  arma::vec values;
+  //! Order in which the non-zero elements are visited.
+  arma::uvec visitationOrder;
+};
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -166,19 +166,19 @@ template<>
 inline void SVDIncompleteIncrementalLearning::WUpdate<arma::sp_mat>(
     const arma::sp_mat& V, arma::mat& W, const arma::mat& H)
 {
-  arma::mat deltaW(V.n_rows, W.n_cols);
-  deltaW.zeros();
+  // Each rated item only changes its own row of W, so the rows can be updated
+  // in place, without a dense delta of the size of W.
   for (arma::sp_mat::const_iterator it = V.begin_col(currentUserIndex);
       it != V.end_col(currentUserIndex); ++it)
   {
     double val = *it;
     size_t i = it.row();
-    deltaW.row(i) += (val - arma::dot(W.row(i), H.col(currentUserIndex))) *
-        arma::trans(H.col(currentUserIndex));
-    if (kw != 0) deltaW.row(i) -= kw * W.row(i);
-  }
+    arma::rowvec deltaW = (val - arma::dot(W.row(i),
+        H.col(currentUserIndex))) * arma::trans(H.col(currentUserIndex));
+    if (kw != 0) deltaW -= kw * W.row(i);
 
-  W += u*deltaW;
+    W.row(i) += u * deltaW;
+  }
 }
 
 template<>
@@ -13,5 +13,7 @@
 #include "svd_batch_learning.hpp"
 #include "svd_incomplete_incremental_learning.hpp"
 #include "svd_complete_incremental_learning.hpp"
+#include "svd_hogwild_learning.hpp"
+#include "weighted_als.hpp"
 
 #endif
@@ -0,0 +1,234 @@
+/**
+ * @file methods/amf/update_rules/weighted_als.hpp
+ *
+ * Weighted alternating least squares update rules for sparse explicit or
+ * implicit feedback.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements alternating least squares over the observed (non-zero)
+ * elements of a sparse matrix only, unlike NMFALSUpdate, which treats missing
+ * elements as zeros.  Each row of W and each column of H is found by solving
+ * its own rank x rank normal equations, and these solves are run in parallel.
+ *
+ * For explicit feedback (alpha == 0), the weighted-lambda regularization of
+ * the following paper is used, so each factor is regularized proportionally to
+ * its number of observed elements:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-Scale Parallel Collaborative Filtering for the Netflix
+ *       Prize},
+ *   author={Zhou, Yunhong and Wilkinson, Dennis and Schreiber, Robert and Pan,
+ *       Rong},
+ *   booktitle={Algorithmic Aspects in Information and Management},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * For implicit feedback (alpha > 0), every element is used with preference 1
+ * if it is observed and 0 otherwise, and confidence 1 + alpha * value, as in
+ * the paper below.  The unobserved elements are accounted for with a single
+ * Gram matrix per sweep, so the cost still only depends on the number of
+ * observed elements.  The values should then be non-negative (e.g. counts).
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative Filtering for Implicit Feedback Datasets},
+ *   author={Hu, Yifan and Koren, Yehuda and Volinsky, Chris},
+ *   booktitle={Eighth IEEE International Conference on Data Mining},
+ *   pages={263--272},
+ *   year={2008}
+ * }
+ * @endcode
+ */
+class WeightedALSUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given parameters.
+   *
+   * @param lambda Regularization parameter.
+   * @param alpha Confidence scaling for implicit feedback; 0 means explicit
+   *     feedback.
+   */
+  WeightedALSUpdate(const double lambda = 0.05, const double alpha = 0.0) :
+      lambda(lambda), alpha(alpha)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Initialize the update rule before factorization.  The transpose of the
+   * dataset is stored, so that the observed elements of each row can be
+   * accessed quickly.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    datasetTrans = arma::sp_mat(dataset).t();
+  }
+
+  /**
+   * The update rule for the basis matrix W.  Each row of W is solved for with
+   * H held fixed.
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& /* V */,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    arma::mat wTrans;
+    Solve(datasetTrans, H, wTrans);
+    W = wTrans.t();
+  }
+
+  /**
+   * The update rule for the encoding matrix H.  Each column of H is solved for
+   * with W held fixed.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    Solve(arma::sp_mat(V), W.t(), H);
+  }
+
+  /**
+   * The update rule for the encoding matrix H, without a copy of a sparse
+   * input matrix.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  inline void HUpdate(const arma::sp_mat& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    Solve(V, W.t(), H);
+  }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the implicit feedback confidence scaling.
+  double Alpha() const { return alpha; }
+  //! Modify the implicit feedback confidence scaling.
+  double& Alpha() { return alpha; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(alpha));
+  }
+
+ private:
+  /**
+   * Solve for the factors of every column of X, given the fixed factors of
+   * every row of X (one per column of fixed).
+   *
+   * @param X Matrix whose columns are solved for.
+   * @param fixed Fixed factors, one column per row of X.
+   * @param factors Resulting factors, one column per column of X.
+   */
+  void Solve(const arma::sp_mat& X,
+             const arma::mat& fixed,
+             arma::mat& factors) const
+  {
+    const size_t rank = fixed.n_rows;
+    factors.set_size(rank, X.n_cols);
+
+    // Make sure the column pointers are up to date before reading them.
+    X.sync();
+
+    // With implicit feedback, the unobserved elements contribute through the
+    // Gram matrix of the fixed factors.
+    arma::mat gram;
+    if (alpha > 0)
+      gram = fixed * fixed.t();
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t j = 0; j < X.n_cols; ++j)
+    {
+      const size_t count = X.col_ptrs[j + 1] - X.col_ptrs[j];
+      if (count == 0 && alpha == 0)
+      {
+        factors.col(j).zeros();
+        continue;
+      }
+
+      // Gather the fixed factors of the observed elements.
+      arma::uvec indices(count);
+      arma::vec values(count);
+      size_t k = 0;
+      for (arma::sp_mat::const_col_iterator it = X.begin_col(j);
+           it != X.end_col(j); ++it, ++k)
+      {
+        indices[k] = it.row();
+        values[k] = (*it);
+      }
+      const arma::mat observed = fixed.cols(indices);
+
+      arma::mat a;
+      arma::vec b;
+      if (alpha > 0)
+      {
+        const arma::vec confidence = alpha * values;
+        a = gram + (observed.each_row() % confidence.t()) * observed.t();
+        b = observed * (1.0 + confidence);
+        a.diag() += lambda;
+      }
+      else
+      {
+        a = observed * observed.t();
+        b = observed * values;
+        a.diag() += lambda * count;
+      }
+
+      factors.col(j) = arma::solve(a, b);
+    }
+  }
+
+  //! Regularization parameter.
+  double lambda;
+  //! Confidence scaling for implicit feedback (0 for explicit feedback).
+  double alpha;
+
+  //! Transpose of the dataset, for fast access to its rows.
+  arma::sp_mat datasetTrans;
+}; // class WeightedALSUpdate
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
@@ -62,10 +62,13 @@ class BiasSVD
    * @param iterations Number of optimization iterations.
    * @param alpha Learning rate for the SGD optimizer.
    * @param lambda Regularization parameter for the optimization.
+   * @param hogwild If true, optimize with lock-free parallel SGD updates
+   *     (Hogwild!) using ens::ParallelSGD instead of StandardSGD.
    */
   BiasSVD(const size_t iterations = 10,
           const double alpha = 0.02,
-          const double lambda = 0.05);
+          const double lambda = 0.05,
+          const bool hogwild = false);
 
   /**
    * Trains the model and obtains user/item matrices and user/item bias.
@@ -91,6 +94,8 @@ class BiasSVD
   double alpha;
   //! Regularization parameter for the optimization.
   double lambda;
+  //! Whether to optimize with parallel Hogwild! SGD.
+  bool hogwild;
 };
 
 } // namespace svd
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
+#include <mlpack/core/math/hogwild.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -100,6 +101,19 @@ class BiasSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take one stochastic gradient descent step for a single training example,
+   * changing only the parameter columns it touches.  No locking is done, so
+   * this may be called concurrently from several threads (Hogwild!).
+   *
+   * @param parameters Parameters(user/item matrices, user/item bias) of the decomposition.
+   * @param i Index of the training example.
+   * @param stepSize Step size of the update.
+   */
+  void Update(arma::mat& parameters,
+              const size_t i,
+              const double stepSize) const;
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
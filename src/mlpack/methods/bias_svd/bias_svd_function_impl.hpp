@@ -178,6 +178,37 @@ void BiasSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void BiasSVDFunction<MatType>::Update(arma::mat& parameters,
+                                      const size_t i,
+                                      const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+
+  // Prediction error for the example.
+  const double rating = data(2, i);
+  const double userBias = parameters(rank, user);
+  const double itemBias = parameters(rank, item);
+  const double ratingError = rating - userBias - itemBias -
+      arma::dot(parameters.col(user).subvec(0, rank - 1),
+                parameters.col(item).subvec(0, rank - 1));
+
+  // Gradient is non-zero only for the parameter columns corresponding to the
+  // example.
+  parameters.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(user).subvec(0, rank - 1) -
+      ratingError * parameters.col(item).subvec(0, rank - 1));
+  parameters.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(item).subvec(0, rank - 1) -
+      ratingError * parameters.col(user).subvec(0, rank - 1));
+  parameters(rank, user) -= stepSize * 2 * (
+      lambda * parameters(rank, user) - ratingError);
+  parameters(rank, item) -= stepSize * 2 * (
+      lambda * parameters(rank, item) - ratingError);
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -268,15 +299,23 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double lastObjective;
 
   // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
-  const size_t numUsers = function.NumUsers();
-  const double lambda = function.Lambda();
-
-  // Rank of decomposition.
-  const size_t rank = function.Rank();
+  const size_t numFunctions = function.NumFunctions();
+  arma::uvec visitationOrder = arma::linspace<arma::uvec>(0,
+      numFunctions - 1, numFunctions);
+
+  // Each thread visits at most threadShareSize examples per iteration.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numVisited = std::min(numFunctions,
+      numThreads * threadShareSize);
+
+  double stepSize = 0.0;
+  auto update = [&](const size_t i)
+  {
+    function.Update(iterate, i, stepSize);
+  };
 
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
@@ -288,7 +327,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     overallObjective = 0;
 
     #pragma omp parallel for reduction(+:overallObjective)
-    for (size_t j = 0; j < (size_t) function.NumFunctions(); ++j)
+    for (size_t j = 0; j < numFunctions; ++j)
     {
       overallObjective += function.Evaluate(iterate, j);
     }
@@ -313,66 +352,25 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     }
 
     // Get the stepsize for this iteration
-    double stepSize = decayPolicy.StepSize(i);
+    stepSize = decayPolicy.StepSize(i);
 
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::RandGen());
+    if (numVisited < numFunctions)
+    {
+      // Only some of the examples are visited; choose which ones.
+      if (shuffle)
+        std::shuffle(visitationOrder.begin(), visitationOrder.end(),
+            mlpack::math::RandGen());
 
-    #pragma omp parallel
+      arma::uvec partialOrder = visitationOrder.head(numVisited);
+      mlpack::math::HogwildEpoch(partialOrder, shuffle, update);
+    }
+    else
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef MLPACK_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
-      {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        double ratingError = rating - userBias - itemBias -
-            arma::dot(iterate.col(user).subvec(0, rank - 1),
-                      iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * iterate.col(user).subvec(0, rank - 1));
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-      }
+      mlpack::math::HogwildEpoch(visitationOrder, shuffle, update);
     }
   }
   mlpack::Log::Info << "\n Parallel SGD terminated with objective : "
-    << overallObjective << std::endl;
+      << overallObjective << std::endl;
 
   return overallObjective;
 }
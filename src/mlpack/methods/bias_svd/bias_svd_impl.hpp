@@ -20,10 +20,12 @@ namespace svd {
 template<typename OptimizerType>
 BiasSVD<OptimizerType>::BiasSVD(const size_t iterations,
                                 const double alpha,
-                                const double lambda) :
+                                const double lambda,
+                                const bool hogwild) :
     iterations(iterations),
     alpha(alpha),
-    lambda(lambda)
+    lambda(lambda),
+    hogwild(hogwild)
 {
   // Nothing to do.
 }
@@ -44,12 +46,30 @@ void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
 
   // Make the optimizer object using a BiasSVDFunction object.
   BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = biasSVDFunc.GetInitialPoint();
-  optimizer.Optimize(biasSVDFunc, parameters);
+  if (hogwild)
+  {
+    // Each ParallelSGD iteration is one pass over the data, split between the
+    // threads.  The first step size backoff lies after the last iteration, so
+    // the step size stays at alpha, as with StandardSGD.
+    size_t numThreads = 1;
+    #ifdef MLPACK_USE_OPENMP
+      numThreads = omp_get_max_threads();
+    #endif
+    const size_t threadShareSize = (size_t) std::ceil(
+        (double) biasSVDFunc.NumFunctions() / numThreads);
+    ens::ParallelSGD<ens::ExponentialBackoff> optimizer(iterations + 1,
+        threadShareSize, 1e-5, true,
+        ens::ExponentialBackoff(iterations + 1, alpha, 0.5));
+    optimizer.Optimize(biasSVDFunc, parameters);
+  }
+  else
+  {
+    ens::StandardSGD optimizer(alpha, batchSize, iterations * data.n_cols);
+    optimizer.Optimize(biasSVDFunc, parameters);
+  }
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
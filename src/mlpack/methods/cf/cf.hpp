@@ -19,6 +19,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
 #include <mlpack/methods/amf/amf.hpp>
 
 #include "normalization/normalization.hpp"
@@ -28,6 +29,31 @@
 
 namespace mlpack {
 namespace cf /** Collaborative filtering. **/ {
+
+/**
+ * This gives us HasGetItemFactorsCheck and HasGetUserFactorsCheck objects that
+ * we can use to tell whether a DecompositionPolicy exposes its factors.
+ */
+HAS_MEM_FUNC(GetItemFactors, HasGetItemFactorsCheck);
+HAS_MEM_FUNC(GetUserFactors, HasGetUserFactorsCheck);
+
+/**
+ * 'value' is true if the DecompositionPolicy class has the members
+ * GetItemFactors(arma::mat& itemFactors) const and
+ * GetUserFactors(const size_t user, arma::vec& userFactors) const.  In that
+ * case the ratings of many users are computed with one matrix multiplication;
+ * otherwise CFType falls back to GetRatingOfUser().
+ */
+template<typename DecompositionPolicy>
+struct HasFactors
+{
+  static const bool value =
+      HasGetItemFactorsCheck<DecompositionPolicy,
+          void(DecompositionPolicy::*)(arma::mat&) const>::value &&
+      HasGetUserFactorsCheck<DecompositionPolicy,
+          void(DecompositionPolicy::*)(const size_t, arma::vec&) const>::value;
+};
+
 /**
  * This class implements Collaborative Filtering (CF). This implementation
  * presently supports Alternating Least Squares (ALS) for collaborative
@@ -140,6 +166,33 @@ class CFType
              const double minResidue = 1e-5,
              const bool mit = false);
 
+  /**
+   * Update the trained model with new ratings, without retraining it from
+   * scratch.  The new ratings are merged into the stored ratings (overwriting
+   * any existing rating of the same user and item), and the factors of the
+   * users and items the new ratings touch are recomputed with a few
+   * alternating least squares steps against the rest of the model.  Users and
+   * items that were not seen during training are added to the model.
+   *
+   * The statistics of the normalization are updated incrementally with the
+   * new ratings (see the Update() method of each normalization class).  Only
+   * the stored ratings of users and items whose per-user or per-item
+   * statistics change are shifted to the new statistics; the other stored
+   * ratings are left as they are.
+   *
+   * The DecompositionPolicy must implement FoldIn(), and the
+   * NormalizationType must implement Update().
+   *
+   * @param data New ratings; dense matrix (coordinate lists).
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter for the least squares steps.  If
+   *     negative, the regularization parameter the decomposition was trained
+   *     with is used (0.01 for decompositions without one).
+   */
+  void FoldIn(const arma::mat& data,
+              const size_t iterations = 5,
+              const double lambda = -1.0);
+
   //! Sets number of users for calculating similarity.
   void NumUsersForSimilarity(const size_t num)
   {
@@ -213,6 +266,57 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Generates the given number of recommendations for all users, using
+   * max-kernel search (FastMKS with the linear kernel) over the item factors
+   * instead of computing the full rating vector of every user.  See the other
+   * overload for details.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations into.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch,
+           typename InterpolationPolicy = AverageInterpolation>
+  void GetFastMKSRecommendations(const size_t numRecs,
+                                 arma::Mat<size_t>& recommendations);
+
+  /**
+   * Generates the given number of recommendations for the specified users
+   * using max-inner-product search.  A cover tree is built once on the item
+   * factors returned by the decomposition's GetItemFactors(), and each user's
+   * interpolated factor vector is used as a query; this avoids computing the
+   * rating of every item for every user.  The query users are split across
+   * OpenMP threads, which all search the same item index.  Items that could
+   * not be recommended are marked with the number of items, as in
+   * GetRecommendations().  If the decomposition does not provide
+   * GetItemFactors() and GetUserFactors(), this is the same as
+   * GetRecommendations().
+   *
+   * The candidates are ranked by their normalized rating, so if the
+   * normalization adds an item-dependent offset (ItemMeanNormalization, or a
+   * CombinedNormalization containing it), the returned recommendations are an
+   * approximation of those returned by GetRecommendations().
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   * @tparam InterpolationPolicy The policy used to calculate interpolation
+   *     weights.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch,
+           typename InterpolationPolicy = AverageInterpolation>
+  void GetFastMKSRecommendations(const size_t numRecs,
+                                 arma::Mat<size_t>& recommendations,
+                                 const arma::Col<size_t>& users);
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -271,6 +375,121 @@ class CFType
   //! Data normalization object.
   NormalizationType normalization;
 
+  /**
+   * Compute the interpolation weights of the neighborhood of each query user,
+   * and combine the user factors of the neighborhood into a single query
+   * factor vector per user, so that the ratings of the user are (up to a
+   * per-user constant) the inner products of the item factors with its query
+   * factor vector.  This is done in parallel over the query users.
+   *
+   * @param users Query users.
+   * @param neighborhood Neighborhood of each query user.
+   * @param similarities Similarities between each query user and its
+   *     neighbors.
+   * @param interpolation Interpolation policy used to calculate weights.
+   * @param itemFactors Resulting item factors, one column per item.
+   * @param queries Resulting query factor vectors, one column per user.
+   */
+  template<typename InterpolationPolicy,
+           typename Policy = DecompositionPolicy>
+  typename std::enable_if<HasFactors<Policy>::value>::type
+  GetQueries(const arma::Col<size_t>& users,
+             const arma::Mat<size_t>& neighborhood,
+             const arma::mat& similarities,
+             InterpolationPolicy& interpolation,
+             arma::mat& itemFactors,
+             arma::mat& queries) const;
+
+  /**
+   * Compute the interpolation weights of the neighborhood of each query user,
+   * for decompositions that do not provide their factors.  The weights are
+   * stored in queries, and itemFactors is left empty.
+   *
+   * @param users Query users.
+   * @param neighborhood Neighborhood of each query user.
+   * @param similarities Similarities between each query user and its
+   *     neighbors.
+   * @param interpolation Interpolation policy used to calculate weights.
+   * @param itemFactors Unused.
+   * @param queries Resulting interpolation weights, one column per user.
+   */
+  template<typename InterpolationPolicy,
+           typename Policy = DecompositionPolicy>
+  typename std::enable_if<!HasFactors<Policy>::value>::type
+  GetQueries(const arma::Col<size_t>& users,
+             const arma::Mat<size_t>& neighborhood,
+             const arma::mat& similarities,
+             InterpolationPolicy& interpolation,
+             arma::mat& itemFactors,
+             arma::mat& queries) const;
+
+  /**
+   * Compute the ratings of every item by the query users in [begin, end),
+   * given the output of GetQueries(), as the product of the item factors and
+   * the query factor vectors.  The ratings are exact up to a per-user constant
+   * (e.g. the user bias), which does not change the ranking of the items.
+   *
+   * @param neighborhood Neighborhood of each query user.
+   * @param itemFactors Item factors returned by GetQueries().
+   * @param queries Query vectors returned by GetQueries().
+   * @param begin First query user of the block.
+   * @param end One past the last query user of the block.
+   * @param ratings Resulting ratings, one column per user of the block.
+   */
+  template<typename Policy = DecompositionPolicy>
+  typename std::enable_if<HasFactors<Policy>::value>::type
+  GetBlockRatings(const arma::Mat<size_t>& neighborhood,
+                  const arma::mat& itemFactors,
+                  const arma::mat& queries,
+                  const size_t begin,
+                  const size_t end,
+                  arma::mat& ratings) const;
+
+  /**
+   * Compute the ratings of every item by the query users in [begin, end),
+   * given the output of GetQueries(), as the weighted sum of the ratings of
+   * the neighborhood of each user.
+   *
+   * @param neighborhood Neighborhood of each query user.
+   * @param itemFactors Unused.
+   * @param queries Interpolation weights returned by GetQueries().
+   * @param begin First query user of the block.
+   * @param end One past the last query user of the block.
+   * @param ratings Resulting ratings, one column per user of the block.
+   */
+  template<typename Policy = DecompositionPolicy>
+  typename std::enable_if<!HasFactors<Policy>::value>::type
+  GetBlockRatings(const arma::Mat<size_t>& neighborhood,
+                  const arma::mat& itemFactors,
+                  const arma::mat& queries,
+                  const size_t begin,
+                  const size_t end,
+                  arma::mat& ratings) const;
+
+  /**
+   * Generate recommendations for the given users with FastMKS on the item
+   * factors.  This is the implementation of GetFastMKSRecommendations().
+   */
+  template<typename NeighborSearchPolicy,
+           typename InterpolationPolicy,
+           typename Policy = DecompositionPolicy>
+  typename std::enable_if<HasFactors<Policy>::value>::type
+  SearchRecommendations(const size_t numRecs,
+                        arma::Mat<size_t>& recommendations,
+                        const arma::Col<size_t>& users);
+
+  /**
+   * Decompositions that do not provide their factors cannot be searched with
+   * FastMKS; compute the recommendations with GetRecommendations() instead.
+   */
+  template<typename NeighborSearchPolicy,
+           typename InterpolationPolicy,
+           typename Policy = DecompositionPolicy>
+  typename std::enable_if<!HasFactors<Policy>::value>::type
+  SearchRecommendations(const size_t numRecs,
+                        arma::Mat<size_t>& recommendations,
+                        const arma::Col<size_t>& users);
+
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
 
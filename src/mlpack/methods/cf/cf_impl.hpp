@@ -150,6 +150,83 @@ Train(const arma::sp_mat& data,
       data, cleanedData, rank, maxIterations, minResidue, mit);
 }
 
+// Fold new ratings into the trained model.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+FoldIn(const arma::mat& data,
+       const size_t iterations,
+       const double lambda)
+{
+  if (data.n_rows != 3)
+  {
+    throw std::invalid_argument("CFType::FoldIn(): data must be a coordinate "
+        "list with 3 rows (user, item, rating)!");
+  }
+
+  if (data.n_cols == 0)
+    return;
+
+  arma::sp_mat newData;
+  CleanData(data, newData);
+
+  // Grow the stored ratings to cover new users and items.
+  const size_t numItems = std::max(cleanedData.n_rows, newData.n_rows);
+  const size_t numUsers = std::max(cleanedData.n_cols, newData.n_cols);
+  cleanedData.resize(numItems, numUsers);
+
+  // Collect the new ratings, and the stored ratings that they replace, as
+  // coordinate lists (user, item, rating).
+  arma::mat newRatings(3, newData.n_nonzero);
+  arma::mat oldRatings(3, newData.n_nonzero);
+  size_t numOld = 0;
+  size_t i = 0;
+  for (arma::sp_mat::const_iterator it = newData.begin();
+       it != newData.end(); ++it, ++i)
+  {
+    newRatings(0, i) = it.col();
+    newRatings(1, i) = it.row();
+    newRatings(2, i) = *it;
+
+    const double stored = cleanedData(it.row(), it.col());
+    if (stored != 0.0)
+    {
+      oldRatings(0, numOld) = it.col();
+      oldRatings(1, numOld) = it.row();
+      oldRatings(2, numOld) = stored;
+      ++numOld;
+    }
+  }
+  oldRatings.resize(3, numOld);
+
+  // Update the statistics of the normalization incrementally and normalize the
+  // new ratings.  Only the stored ratings of the users and items whose
+  // statistics change are adjusted.
+  normalization.Update(cleanedData, newRatings, oldRatings);
+
+  // Overwrite the replaced ratings and add the new ones.
+  arma::umat locations(2, newRatings.n_cols);
+  for (size_t j = 0; j < newRatings.n_cols; ++j)
+  {
+    locations(0, j) = (arma::uword) newRatings(1, j);
+    locations(1, j) = (arma::uword) newRatings(0, j);
+  }
+  const arma::sp_mat normalizedData(locations,
+      arma::vec(newRatings.row(2).t()), numItems, numUsers);
+  if (numOld > 0)
+    cleanedData -= cleanedData % arma::spones(normalizedData);
+  cleanedData += normalizedData;
+
+  // Only the factors of the users and items that received a rating change.
+  const arma::uvec users = arma::conv_to<arma::uvec>::from(
+      arma::unique(data.row(0)));
+  const arma::uvec items = arma::conv_to<arma::uvec>::from(
+      arma::unique(data.row(1)));
+
+  decomposition.FoldIn(cleanedData, users, items, iterations, lambda);
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 template<typename NeighborSearchPolicy,
@@ -194,79 +271,250 @@ GetRecommendations(const size_t numRecs,
   decomposition.template GetNeighborhood<NeighborSearchPolicy>(
       users, numUsersForSimilarity, neighborhood, similarities);
 
-  // Generate recommendations for each query user by finding the maximum numRecs
-  // elements in the ratings vector.
-  recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
-  recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
-
   // Initialization of an InterpolationPolicy object should be put ahead of the
   // following loop, because the initialization may takes a relatively long
   // time and we don't want to repeat the initialization process in each loop.
   InterpolationPolicy interpolation(cleanedData);
 
-  for (size_t i = 0; i < users.n_elem; ++i)
+  // Calculate the interpolation weights of all query users.  If the
+  // decomposition provides its factors, the user factors of each neighborhood
+  // are combined into a single query factor vector, and the ratings of a query
+  // user are then the product of the item factors and its query factor vector.
+  arma::mat itemFactors;
+  arma::mat queries;
+  GetQueries(users, neighborhood, similarities, interpolation, itemFactors,
+      queries);
+
+  // Generate recommendations for each query user by finding the maximum numRecs
+  // elements in the ratings vector.
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(cleanedData.n_rows);
+
+  // The ratings of a block of users are computed at once; limit the block so
+  // that each thread holds at most (approximately) 2^22 ratings at once.
+  const size_t numItems = cleanedData.n_rows;
+  const size_t blockSize = std::max((size_t) 1, std::min((size_t) 256,
+      (size_t(1) << 22) / std::max(numItems, (size_t) 1)));
+  const size_t numBlocks = (users.n_elem + blockSize - 1) / blockSize;
+  size_t numFailed = 0;
+
+  #pragma omp parallel for schedule(dynamic) reduction(+:numFailed)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) users.n_elem);
 
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
-        neighborhood.col(i), similarities.col(i), cleanedData);
+    // Ratings of each item (rows) by each user in the block (columns).
+    arma::mat ratings;
+    GetBlockRatings(neighborhood, itemFactors, queries, begin, end, ratings);
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    for (size_t i = begin; i < end; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
-
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+      // Let's build the list of candidate recomendations for the given user.
+      // Default candidate: the smallest possible value and invalid item number.
+      const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+      std::vector<Candidate> vect(numRecs, def);
+      typedef std::priority_queue<Candidate, std::vector<Candidate>,
+          CandidateCmp> CandidateList;
+      CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+      // Look through the ratings column corresponding to the current user.
+      for (size_t j = 0; j < ratings.n_rows; ++j)
+      {
+        // Ensure that the user hasn't already rated the item.
+        // The algorithm omits rating of zero. Thus, when normalizing original
+        // ratings in Normalize(), if normalized rating equals zero, it is set
+        // to the smallest positive double value.
+        if (cleanedData(j, users(i)) != 0.0)
+          continue; // The user already rated the item.
+
+        // Is the estimated value better than the worst candidate?
+        // Denormalize rating before comparison.
+        double realRating = normalization.Denormalize(users(i), j,
+            ratings(j, i - begin));
+        if (realRating > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(realRating, j);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
-    {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      for (size_t p = 1; p <= numRecs; p++)
       {
-        Candidate c = std::make_pair(realRating, j);
+        recommendations(numRecs - p, i) = pqueue.top().second;
         pqueue.pop();
-        pqueue.push(c);
       }
+
+      // Count the users we were not able to come up with enough
+      // recommendations for.
+      if (recommendations(numRecs - 1, i) == def.second)
+        ++numFailed;
     }
+  }
+
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  if (numFailed > 0)
+    Log::Warn << "Could not provide " << numRecs << " recommendations for "
+        << numFailed << " users (not enough un-rated items)!" << std::endl;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy,
+         typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetFastMKSRecommendations(const size_t numRecs,
+                          arma::Mat<size_t>& recommendations)
+{
+  // Generate list of users.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  // Call the main overload for recommendations.
+  GetFastMKSRecommendations<NeighborSearchPolicy,
+                            InterpolationPolicy>(numRecs, recommendations,
+                                                 users);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy,
+         typename InterpolationPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetFastMKSRecommendations(const size_t numRecs,
+                          arma::Mat<size_t>& recommendations,
+                          const arma::Col<size_t>& users)
+{
+  SearchRecommendations<NeighborSearchPolicy, InterpolationPolicy>(numRecs,
+      recommendations, users);
+}
 
-    for (size_t p = 1; p <= numRecs; p++)
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy,
+         typename InterpolationPolicy,
+         typename Policy>
+typename std::enable_if<HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+SearchRecommendations(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations,
+                      const arma::Col<size_t>& users)
+{
+  // Temporary storage for neighborhood of the queried users.
+  arma::Mat<size_t> neighborhood;
+  // Resulting similarities.
+  arma::mat similarities;
+
+  // Calculate the neighborhood of the queried users, exactly as in
+  // GetRecommendations().
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, neighborhood, similarities);
+
+  // The rating vector of a user is the weighted sum of the rating vectors of
+  // its neighborhood, so the query vector of a user is the same weighted sum
+  // of the user factors of its neighborhood.
+  InterpolationPolicy interpolation(cleanedData);
+  arma::mat itemFactors;
+  arma::mat queries;
+  GetQueries(users, neighborhood, similarities, interpolation, itemFactors,
+      queries);
+  const size_t numItems = itemFactors.n_cols;
+
+  arma::Col<size_t> numRated(users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+    numRated(i) = cleanedData.col(users(i)).n_nonzero;
+
+  // Build the item index only once.  It is shared by all threads: the
+  // dual-tree traversal only writes to the statistics of the query tree, and
+  // each thread builds its own query tree.
+  fastmks::FastMKS<kernel::LinearKernel> itemIndex(std::move(itemFactors));
+
+  // Items that could not be recommended are marked with the number of items,
+  // as in GetRecommendations().
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(cleanedData.n_rows);
+  size_t numFailed = 0;
+
+  #pragma omp parallel reduction(+:numFailed)
+  {
+    // Each thread searches the shared index for a contiguous block of users.
+    size_t threadId = 0;
+    size_t numThreads = 1;
+    #ifdef MLPACK_USE_OPENMP
+      threadId = omp_get_thread_num();
+      numThreads = omp_get_num_threads();
+    #endif
+
+    const size_t blockSize = (users.n_elem + numThreads - 1) / numThreads;
+    const size_t begin = std::min(threadId * blockSize, (size_t) users.n_elem);
+    const size_t end = std::min(begin + blockSize, (size_t) users.n_elem);
+
+    if (begin < end)
     {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
+      // Ask for enough candidates that numRecs un-rated items remain.
+      const size_t k = std::min(numItems,
+          numRecs + arma::max(numRated.subvec(begin, end - 1)));
+      arma::Mat<size_t> candidates;
+      arma::mat products;
+      itemIndex.Search(queries.cols(begin, end - 1), k, candidates,
+          products);
+
+      for (size_t i = begin; i < end; ++i)
+      {
+        // Rank the un-rated candidates by their denormalized rating.
+        std::vector<Candidate> list;
+        list.reserve(k);
+        for (size_t c = 0; c < k; ++c)
+        {
+          const size_t item = candidates(c, i - begin);
+          if (item >= numItems || cleanedData(item, users(i)) != 0.0)
+            continue;
+
+          // The inner product is the rating up to a per-user constant, which
+          // does not change the ranking.
+          list.push_back(std::make_pair(normalization.Denormalize(users(i),
+              item, products(c, i - begin)), item));
+        }
+
+        const size_t found = std::min(numRecs, list.size());
+        std::partial_sort(list.begin(), list.begin() + found, list.end(),
+            CandidateCmp());
+        for (size_t p = 0; p < found; ++p)
+          recommendations(p, i) = list[p].second;
+
+        if (found < numRecs)
+          ++numFailed;
+      }
     }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
-      Log::Warn << "Could not provide " << numRecs << " recommendations "
-          << "for user " << users(i) << " (not enough un-rated items)!"
-          << std::endl;
   }
+
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  if (numFailed > 0)
+    Log::Warn << "Could not provide " << numRecs << " recommendations for "
+        << numFailed << " users (not enough un-rated items)!" << std::endl;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy,
+         typename InterpolationPolicy,
+         typename Policy>
+typename std::enable_if<!HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+SearchRecommendations(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations,
+                      const arma::Col<size_t>& users)
+{
+  // Without the item factors there is nothing to build an index on.
+  GetRecommendations<NeighborSearchPolicy, InterpolationPolicy>(numRecs,
+      recommendations, users);
 }
 
 // Predict the rating for a single user/item combination.
@@ -323,14 +571,6 @@ void CFType<DecompositionPolicy,
 Predict(const arma::Mat<size_t>& combinations,
         arma::vec& predictions) const
 {
-  // Now, we must determine those query indices we need to find the nearest
-  // neighbors for.  This is easiest if we just sort the combinations matrix.
-  arma::Mat<size_t> sortedCombinations(combinations.n_rows,
-                                       combinations.n_cols);
-  arma::uvec ordering = arma::sort_index(combinations.row(0).t());
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    sortedCombinations.col(i) = combinations.col(ordering[i]);
-
   // Now, we have to get the list of unique users we will be searching for.
   arma::Col<size_t> users = arma::unique(combinations.row(0).t());
 
@@ -351,6 +591,7 @@ Predict(const arma::Mat<size_t>& combinations,
 
   // Calculate interpolation weights.
   InterpolationPolicy interpolation(cleanedData);
+  #pragma omp parallel for
   for (size_t i = 0; i < users.n_elem; ++i)
   {
     interpolation.GetWeights(weights.col(i), decomposition, users[i],
@@ -360,30 +601,129 @@ Predict(const arma::Mat<size_t>& combinations,
   // Now that we have the neighborhoods we need, calculate the predictions.
   predictions.set_size(combinations.n_cols);
 
-  size_t user = 0; // Cumulative user count, because we are doing it in order.
-  for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
+  #pragma omp parallel for
+  for (size_t i = 0; i < combinations.n_cols; ++i)
   {
-    // Could this be made faster by calculating dot products for multiple items
-    // at once?
-    double rating = 0.0;
-
-    // Map the combination's user to the user ID used for kNN.
-    while (users[user] < sortedCombinations(0, i))
-      ++user;
+    // Map the combination's user to the user ID used for kNN.  The list of
+    // users is sorted, since it was returned by arma::unique().
+    const size_t user = std::lower_bound(users.begin(), users.end(),
+        combinations(0, i)) - users.begin();
 
+    double rating = 0.0;
     for (size_t j = 0; j < neighborhood.n_rows; ++j)
     {
       rating += weights(j, user) * decomposition.GetRating(
-          neighborhood(j, user), sortedCombinations(1, i));
+          neighborhood(j, user), combinations(1, i));
     }
 
-    predictions(ordering[i]) = rating;
+    predictions(i) = rating;
   }
 
   // Denormalize ratings.
   normalization.Denormalize(combinations, predictions);
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename InterpolationPolicy,
+         typename Policy>
+typename std::enable_if<HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+GetQueries(const arma::Col<size_t>& users,
+           const arma::Mat<size_t>& neighborhood,
+           const arma::mat& similarities,
+           InterpolationPolicy& interpolation,
+           arma::mat& itemFactors,
+           arma::mat& queries) const
+{
+  decomposition.GetItemFactors(itemFactors);
+  queries.zeros(itemFactors.n_rows, users.n_elem);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    // Calculate interpolation weights.
+    arma::vec weights(neighborhood.n_rows);
+    interpolation.GetWeights(weights, decomposition, users(i),
+        neighborhood.col(i), similarities.col(i), cleanedData);
+
+    arma::vec userFactors;
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    {
+      decomposition.GetUserFactors(neighborhood(j, i), userFactors);
+      queries.col(i) += weights(j) * userFactors;
+    }
+  }
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename InterpolationPolicy,
+         typename Policy>
+typename std::enable_if<!HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+GetQueries(const arma::Col<size_t>& users,
+           const arma::Mat<size_t>& neighborhood,
+           const arma::mat& similarities,
+           InterpolationPolicy& interpolation,
+           arma::mat& itemFactors,
+           arma::mat& queries) const
+{
+  itemFactors.reset();
+  queries.set_size(neighborhood.n_rows, users.n_elem);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    interpolation.GetWeights(queries.col(i), decomposition, users(i),
+        neighborhood.col(i), similarities.col(i), cleanedData);
+  }
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename Policy>
+typename std::enable_if<HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+GetBlockRatings(const arma::Mat<size_t>& /* neighborhood */,
+                const arma::mat& itemFactors,
+                const arma::mat& queries,
+                const size_t begin,
+                const size_t end,
+                arma::mat& ratings) const
+{
+  ratings = itemFactors.t() * queries.cols(begin, end - 1);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename Policy>
+typename std::enable_if<!HasFactors<Policy>::value>::type
+CFType<DecompositionPolicy,
+       NormalizationType>::
+GetBlockRatings(const arma::Mat<size_t>& neighborhood,
+                const arma::mat& /* itemFactors */,
+                const arma::mat& queries,
+                const size_t begin,
+                const size_t end,
+                arma::mat& ratings) const
+{
+  ratings.zeros(cleanedData.n_rows, end - begin);
+
+  arma::vec neighborRatings;
+  for (size_t i = begin; i < end; ++i)
+  {
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    {
+      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
+      ratings.col(i - begin) += queries(j, i) * neighborRatings;
+    }
+  }
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 void CFType<DecompositionPolicy,
@@ -76,6 +76,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'ALS' -- Weighted alternating least squares over the observed "
+    "ratings, solved in parallel\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -100,6 +102,33 @@ BINDING_LONG_DESC(
     " - 'user_mean'  -- User Mean Normalization\n"
     " - 'z_score'  -- Z-Score Normalization\n"
     "\n"
+    "When generating recommendations, the " + PRINT_PARAM_STRING("fastmks") +
+    " flag may be specified to find the top items for each user with "
+    "max-inner-product search (FastMKS with the linear kernel) over the item "
+    "factors, instead of computing the rating of every item.  This is much "
+    "faster when there are many items; with 'item_mean' normalization the "
+    "results may differ slightly from the exact recommendations."
+    "\n\n"
+    "The 'ALS' algorithm is regularized by " + PRINT_PARAM_STRING("lambda") +
+    ".  If " + PRINT_PARAM_STRING("alpha") + " is positive, the ratings are "
+    "treated as implicit feedback (e.g. counts): every item is used with "
+    "preference 1 if it was rated and 0 otherwise, weighted by a confidence "
+    "of 1 + alpha * rating."
+    "\n\n"
+    "The 'RegSVD', 'BiasSVD' and 'SVDPP' algorithms are trained with "
+    "stochastic gradient descent; if " + PRINT_PARAM_STRING("hogwild") +
+    " is specified, the updates are applied in parallel and without locking "
+    "(Hogwild!) over all available threads.  This is faster for large "
+    "datasets, but the results are no longer deterministic."
+    "\n\n"
+    "New ratings may be folded into a trained model without retraining it "
+    "by passing them with the " + PRINT_PARAM_STRING("fold_in") + " "
+    "parameter (in the same format as the training set).  Only the factors of "
+    "the users and items that receive a new rating are recomputed, with " +
+    PRINT_PARAM_STRING("fold_in_iterations") + " alternating least squares "
+    "steps regularized by " + PRINT_PARAM_STRING("fold_in_lambda") + "; new "
+    "users and items are added to the model."
+    "\n\n"
     "A trained model may be saved to with the " +
     PRINT_PARAM_STRING("output_model") + " output parameter.");
 
@@ -157,10 +186,28 @@ PARAM_FLAG("iteration_only_termination", "Terminate only when the maximum "
 PARAM_DOUBLE_IN("min_residue", "Residue required to terminate the factorization"
     " (lower values generally mean better fits).", "r", 1e-5);
 
+// Weighted ALS settings.
+PARAM_DOUBLE_IN("lambda", "Regularization parameter for the 'ALS' algorithm.",
+    "", 0.05);
+PARAM_DOUBLE_IN("alpha", "Confidence scaling of implicit feedback for the "
+    "'ALS' algorithm (0 means explicit ratings).", "", 0.0);
+
+// SGD settings.
+PARAM_FLAG("hogwild", "Train the 'RegSVD', 'BiasSVD' and 'SVDPP' algorithms "
+    "with parallel lock-free (Hogwild!) SGD.", "");
+
 // Load/save a model.
 PARAM_MODEL_IN(CFModel, "input_model", "Trained CF model to load.", "m");
 PARAM_MODEL_OUT(CFModel, "output_model", "Output for trained CF model.", "M");
 
+// Fold-in settings.
+PARAM_MATRIX_IN("fold_in", "New ratings to fold into the trained model.", "F");
+PARAM_INT_IN("fold_in_iterations", "Number of alternating least squares steps "
+    "used to fold in new ratings.", "", 5);
+PARAM_DOUBLE_IN("fold_in_lambda", "Regularization used to fold in new "
+    "ratings; if negative, the regularization the model was trained with is "
+    "used.", "", -1.0);
+
 // Query settings.
 PARAM_UMATRIX_IN("query", "List of query users for which recommendations should"
     " be generated.", "q");
@@ -170,6 +217,8 @@ PARAM_UMATRIX_OUT("output", "Matrix that will store output recommendations.",
     "o");
 PARAM_INT_IN("recommendations", "Number of recommendations to generate for each"
     " query user.", "c", 5);
+PARAM_FLAG("fastmks", "Use max-inner-product search (FastMKS) over the item "
+    "factors to generate recommendations.", "f");
 
 PARAM_INT_IN("seed", "Set the random seed (0 uses std::time(NULL)).", "s", 0);
 
@@ -197,11 +246,14 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   RequireAtLeastOnePassed(params, { "output", "output_model" }, false,
       "no output will be saved");
   if (!params.Has("query") && !params.Has("all_user_recommendations"))
+  {
     ReportIgnoredParam(params, "output", "no recommendations requested");
+    ReportIgnoredParam(params, "fastmks", "no recommendations requested");
+  }
 
   RequireParamInSet<string>(params, "algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "ALS" }, true, "unknown algorithm");
 
   ReportIgnoredParam(params, {{ "iteration_only_termination", true }},
       "min_residue");
@@ -209,6 +261,18 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   RequireParamValue<int>(params, "recommendations",
       [](int x) { return x > 0; }, true, "recommendations must be positive");
 
+  if (params.Has("fold_in"))
+  {
+    RequireParamValue<int>(params, "fold_in_iterations",
+        [](int x) { return x > 0; }, true,
+        "fold_in_iterations must be positive");
+  }
+  else
+  {
+    ReportIgnoredParam(params, "fold_in_iterations", "no ratings to fold in");
+    ReportIgnoredParam(params, "fold_in_lambda", "no ratings to fold in");
+  }
+
   // Either load from a model, or train a model.
   CFModel* cf;
   if (params.Has("training"))
@@ -287,6 +351,28 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
           "when max_iterations is reached");
       cf->DecompositionType() = CFModel::SVD_PLUS_PLUS;
     }
+    else if (algo == "ALS")
+    {
+      RequireParamValue<double>(params, "lambda",
+          [](double x) { return x >= 0; }, true,
+          "lambda must be non-negative");
+      RequireParamValue<double>(params, "alpha",
+          [](double x) { return x >= 0; }, true,
+          "alpha must be non-negative");
+      cf->DecompositionType() = CFModel::ALS;
+    }
+
+    if (algo != "ALS")
+    {
+      ReportIgnoredParam(params, "lambda", "only the ALS algorithm uses it");
+      ReportIgnoredParam(params, "alpha", "only the ALS algorithm uses it");
+    }
+
+    if (algo != "RegSVD" && algo != "BiasSVD" && algo != "SVDPP")
+    {
+      ReportIgnoredParam(params, "hogwild", "only the SGD-based algorithms "
+          "use it");
+    }
 
     // Perform the factorization and do whatever the user wanted.
     const size_t neighborhood = (size_t) params.Get<int>("neighborhood");
@@ -314,19 +400,39 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
               rank,
               size_t(params.Get<int>("max_iterations")),
               params.Get<double>("min_residue"),
-              params.Has("iteration_only_termination"));
+              params.Has("iteration_only_termination"),
+              params.Get<double>("lambda"),
+              params.Get<double>("alpha"),
+              params.Has("hogwild"));
     timers.Stop("cf_factorization");
   }
   else
   {
     // Load from a model after validating parameters.
     RequireAtLeastOnePassed(params, { "query", "all_user_recommendations",
-        "test" }, true);
+        "test", "fold_in" }, true);
 
     // Load an input model.
     cf = std::move(params.Get<CFModel*>("input_model"));
   }
 
+  if (params.Has("fold_in"))
+  {
+    arma::mat foldInData = std::move(params.Get<arma::mat>("fold_in"));
+    if (foldInData.n_rows != 3)
+    {
+      Log::Fatal << "Ratings to fold in must have 3 rows (user, item, rating);"
+          << " given matrix has " << foldInData.n_rows << " rows!" << endl;
+    }
+
+    Log::Info << "Folding " << foldInData.n_cols << " ratings into the model."
+        << endl;
+    timers.Start("cf_fold_in");
+    cf->FoldIn(foldInData, (size_t) params.Get<int>("fold_in_iterations"),
+        params.Get<double>("fold_in_lambda"));
+    timers.Stop("cf_fold_in");
+  }
+
   // Get the types of the neighbor search method and the interpolation.  (These
   // may or may not be used.)
   NeighborSearchTypes nsType;
@@ -378,13 +484,13 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
           << " users." << endl;
 
       cf->GetRecommendations(nsType, interpolationType, numRecs,
-          recommendations, users.row(0).t());
+          recommendations, users.row(0).t(), params.Has("fastmks"));
     }
     else
     {
       Log::Info << "Generating recommendations for all users." << endl;
       cf->GetRecommendations(nsType, interpolationType, numRecs,
-          recommendations);
+          recommendations, params.Has("fastmks"));
     }
 
     // Save the output.
@@ -64,20 +64,29 @@ class CFWrapperBase
                        const arma::Mat<size_t>& combinations,
                        arma::vec& predictions) = 0;
 
-  //! Compute recommendations for all users.
+  //! Compute recommendations for all users.  If useFastMKS is true,
+  //! max-inner-product search over the item factors is used.
   virtual void GetRecommendations(
       const NeighborSearchTypes nsType,
       const InterpolationTypes interpolationType,
       const size_t numRecs,
-      arma::Mat<size_t>& recommendations) = 0;
+      arma::Mat<size_t>& recommendations,
+      const bool useFastMKS) = 0;
 
-  //! Compute recommendations.
+  //! Compute recommendations.  If useFastMKS is true, max-inner-product search
+  //! over the item factors is used.
   virtual void GetRecommendations(
       const NeighborSearchTypes nsType,
       const InterpolationTypes interpolationType,
       const size_t numRecs,
       arma::Mat<size_t>& recommendations,
-      const arma::Col<size_t>& users) = 0;
+      const arma::Col<size_t>& users,
+      const bool useFastMKS) = 0;
+
+  //! Fold new ratings into the trained model.
+  virtual void FoldIn(const arma::mat& data,
+                      const size_t iterations,
+                      const double lambda) = 0;
 };
 
 /**
@@ -134,7 +143,8 @@ class CFWrapper : public CFWrapperBase
       const NeighborSearchTypes nsType,
       const InterpolationTypes interpolationType,
       const size_t numRecs,
-      arma::Mat<size_t>& recommendations);
+      arma::Mat<size_t>& recommendations,
+      const bool useFastMKS);
 
   //! Compute recommendations.
   virtual void GetRecommendations(
@@ -142,7 +152,16 @@ class CFWrapper : public CFWrapperBase
       const InterpolationTypes interpolationType,
       const size_t numRecs,
       arma::Mat<size_t>& recommendations,
-      const arma::Col<size_t>& users);
+      const arma::Col<size_t>& users,
+      const bool useFastMKS);
+
+  //! Fold new ratings into the trained model.
+  virtual void FoldIn(const arma::mat& data,
+                      const size_t iterations,
+                      const double lambda)
+  {
+    cf.FoldIn(data, iterations, lambda);
+  }
 
   //! Serialize the model.
   template<typename Archive>
@@ -171,7 +190,8 @@ class CFModel
     SVD_COMPLETE,
     SVD_INCOMPLETE,
     BIAS_SVD,
-    SVD_PLUS_PLUS
+    SVD_PLUS_PLUS,
+    ALS
   };
 
   enum NormalizationTypes
@@ -240,13 +260,17 @@ class CFModel
     return normalizationType;
   }
 
-  //! Train the model.
+  //! Train the model.  lambda and alpha are only used by ALS; hogwild is only
+  //! used by the regularized SVD, bias SVD and SVD++ decompositions.
   void Train(const arma::mat& data,
              const size_t numUsersForSimilarity,
              const size_t rank,
              const size_t maxIterations,
              const double minResidue,
-             const bool mit);
+             const bool mit,
+             const double lambda = 0.05,
+             const double alpha = 0.0,
+             const bool hogwild = false);
 
   //! Make predictions.
   void Predict(const NeighborSearchTypes nsType,
@@ -254,18 +278,31 @@ class CFModel
                const arma::Mat<size_t>& combinations,
                arma::vec& predictions);
 
-  //! Compute recommendations for query users.
+  //! Compute recommendations for query users.  If useFastMKS is true,
+  //! max-inner-product search over the item factors is used instead of
+  //! computing the rating of every item.
   void GetRecommendations(const NeighborSearchTypes nsType,
                           const InterpolationTypes interpolationType,
                           const size_t numRecs,
                           arma::Mat<size_t>& recommendations,
-                          const arma::Col<size_t>& users);
+                          const arma::Col<size_t>& users,
+                          const bool useFastMKS = false);
 
-  //! Compute recommendations for all users.
+  //! Compute recommendations for all users.  If useFastMKS is true,
+  //! max-inner-product search over the item factors is used instead of
+  //! computing the rating of every item.
   void GetRecommendations(const NeighborSearchTypes nsType,
                           const InterpolationTypes interpolationType,
                           const size_t numRecs,
-                          arma::Mat<size_t>& recommendations);
+                          arma::Mat<size_t>& recommendations,
+                          const bool useFastMKS = false);
+
+  //! Fold new ratings into the trained model, recomputing the factors of the
+  //! users and items they touch with a few alternating least squares steps.
+  //! A negative lambda uses the regularization of the trained decomposition.
+  void FoldIn(const arma::mat& data,
+              const size_t iterations = 5,
+              const double lambda = -1.0);
 
   //! Serialize the model.
   template<typename Archive>
@@ -199,26 +199,54 @@ void GetRecommendationsHelper(
     const InterpolationTypes interpolationType,
     const size_t numRecs,
     arma::Mat<size_t>& recommendations,
-    const arma::Col<size_t>& users)
+    const arma::Col<size_t>& users,
+    const bool useFastMKS)
 {
   switch (interpolationType)
   {
     case AVERAGE_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     AverageInterpolation>(
-          numRecs, recommendations, users);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              AverageInterpolation>(
+            numRecs, recommendations, users);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       AverageInterpolation>(
+            numRecs, recommendations, users);
+      }
       break;
 
     case REGRESSION_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     RegressionInterpolation>(
-          numRecs, recommendations, users);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              RegressionInterpolation>(
+            numRecs, recommendations, users);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       RegressionInterpolation>(
+            numRecs, recommendations, users);
+      }
       break;
 
     case SIMILARITY_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     SimilarityInterpolation>(
-          numRecs, recommendations, users);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              SimilarityInterpolation>(
+            numRecs, recommendations, users);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       SimilarityInterpolation>(
+            numRecs, recommendations, users);
+      }
       break;
   }
 }
@@ -230,23 +258,24 @@ void CFWrapper<DecompositionPolicy, NormalizationPolicy>::GetRecommendations(
     const InterpolationTypes interpolationType,
     const size_t numRecs,
     arma::Mat<size_t>& recommendations,
-    const arma::Col<size_t>& users)
+    const arma::Col<size_t>& users,
+    const bool useFastMKS)
 {
   switch (nsType)
   {
     case COSINE_SEARCH:
       GetRecommendationsHelper<CosineSearch>(cf, interpolationType, numRecs,
-          recommendations, users);
+          recommendations, users, useFastMKS);
       break;
 
     case EUCLIDEAN_SEARCH:
       GetRecommendationsHelper<EuclideanSearch>(cf, interpolationType, numRecs,
-          recommendations, users);
+          recommendations, users, useFastMKS);
       break;
 
     case PEARSON_SEARCH:
       GetRecommendationsHelper<PearsonSearch>(cf, interpolationType, numRecs,
-          recommendations, users);
+          recommendations, users, useFastMKS);
       break;
   }
 }
@@ -256,26 +285,54 @@ void GetRecommendationsHelper(
     CFType& cf,
     const InterpolationTypes interpolationType,
     const size_t numRecs,
-    arma::Mat<size_t>& recommendations)
+    arma::Mat<size_t>& recommendations,
+    const bool useFastMKS)
 {
   switch (interpolationType)
   {
     case AVERAGE_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     AverageInterpolation>(
-          numRecs, recommendations);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              AverageInterpolation>(
+            numRecs, recommendations);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       AverageInterpolation>(
+            numRecs, recommendations);
+      }
       break;
 
     case REGRESSION_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     RegressionInterpolation>(
-          numRecs, recommendations);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              RegressionInterpolation>(
+            numRecs, recommendations);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       RegressionInterpolation>(
+            numRecs, recommendations);
+      }
       break;
 
     case SIMILARITY_INTERPOLATION:
-      cf.template GetRecommendations<NeighborSearchPolicy,
-                                     SimilarityInterpolation>(
-          numRecs, recommendations);
+      if (useFastMKS)
+      {
+        cf.template GetFastMKSRecommendations<NeighborSearchPolicy,
+                                              SimilarityInterpolation>(
+            numRecs, recommendations);
+      }
+      else
+      {
+        cf.template GetRecommendations<NeighborSearchPolicy,
+                                       SimilarityInterpolation>(
+            numRecs, recommendations);
+      }
       break;
   }
 }
@@ -286,23 +343,24 @@ void CFWrapper<DecompositionPolicy, NormalizationPolicy>::GetRecommendations(
     const NeighborSearchTypes nsType,
     const InterpolationTypes interpolationType,
     const size_t numRecs,
-    arma::Mat<size_t>& recommendations)
+    arma::Mat<size_t>& recommendations,
+    const bool useFastMKS)
 {
   switch (nsType)
   {
     case COSINE_SEARCH:
       GetRecommendationsHelper<CosineSearch>(cf, interpolationType, numRecs,
-          recommendations);
+          recommendations, useFastMKS);
       break;
 
     case EUCLIDEAN_SEARCH:
       GetRecommendationsHelper<EuclideanSearch>(cf, interpolationType, numRecs,
-          recommendations);
+          recommendations, useFastMKS);
       break;
 
     case PEARSON_SEARCH:
       GetRecommendationsHelper<PearsonSearch>(cf, interpolationType, numRecs,
-          recommendations);
+          recommendations, useFastMKS);
       break;
   }
 }
@@ -362,6 +420,9 @@ inline CFWrapperBase* InitializeModel(
 
     case CFModel::SVD_PLUS_PLUS:
       return InitializeModelHelper<SVDPlusPlusPolicy>(normalizationType);
+
+    case CFModel::ALS:
+      return InitializeModelHelper<ALSPolicy>(normalizationType);
   }
 
   // This shouldn't ever happen.
@@ -428,7 +489,10 @@ inline void CFModel::Train(
     const size_t rank,
     const size_t maxIterations,
     const double minResidue,
-    const bool mit)
+    const bool mit,
+    const double lambda,
+    const double alpha,
+    const bool hogwild)
 {
   // Delete the current CFType object, if there is one.
   delete cf;
@@ -451,7 +515,7 @@ inline void CFModel::Train(
       break;
 
     case REG_SVD:
-      cf = TrainHelper(RegSVDPolicy(), normalizationType, data,
+      cf = TrainHelper(RegSVDPolicy(10, hogwild), normalizationType, data,
           numUsersForSimilarity, rank, maxIterations, minResidue, mit);
       break;
 
@@ -466,12 +530,19 @@ inline void CFModel::Train(
       break;
 
     case BIAS_SVD:
-      cf = TrainHelper(BiasSVDPolicy(), normalizationType, data,
+      cf = TrainHelper(BiasSVDPolicy(10, 0.02, 0.05, hogwild),
+          normalizationType, data,
           numUsersForSimilarity, rank, maxIterations, minResidue, mit);
       break;
 
     case SVD_PLUS_PLUS:
-      cf = TrainHelper(SVDPlusPlusPolicy(), normalizationType, data,
+      cf = TrainHelper(SVDPlusPlusPolicy(10, 0.001, 0.1, hogwild),
+          normalizationType, data,
+          numUsersForSimilarity, rank, maxIterations, minResidue, mit);
+      break;
+
+    case ALS:
+      cf = TrainHelper(ALSPolicy(lambda, alpha), normalizationType, data,
           numUsersForSimilarity, rank, maxIterations, minResidue, mit);
       break;
   }
@@ -493,10 +564,11 @@ inline void CFModel::GetRecommendations(
     const InterpolationTypes interpolationType,
     const size_t numRecs,
     arma::Mat<size_t>& recommendations,
-    const arma::Col<size_t>& users)
+    const arma::Col<size_t>& users,
+    const bool useFastMKS)
 {
   cf->GetRecommendations(nsType, interpolationType, numRecs, recommendations,
-      users);
+      users, useFastMKS);
 }
 
 //! Compute recommendations for all users.
@@ -504,9 +576,19 @@ inline void CFModel::GetRecommendations(
     const NeighborSearchTypes nsType,
     const InterpolationTypes interpolationType,
     const size_t numRecs,
-    arma::Mat<size_t>& recommendations)
+    arma::Mat<size_t>& recommendations,
+    const bool useFastMKS)
 {
-  cf->GetRecommendations(nsType, interpolationType, numRecs, recommendations);
+  cf->GetRecommendations(nsType, interpolationType, numRecs, recommendations,
+      useFastMKS);
+}
+
+//! Fold new ratings into the trained model.
+inline void CFModel::FoldIn(const arma::mat& data,
+                            const size_t iterations,
+                            const double lambda)
+{
+  cf->FoldIn(data, iterations, lambda);
 }
 
 template<typename Archive>
@@ -556,6 +638,10 @@ void CFModel::serialize(Archive& ar, const uint32_t /* version */)
     case SVD_PLUS_PLUS:
       SerializeHelper<SVDPlusPlusPolicy>(ar, cf, normalizationType);
       break;
+
+    case ALS:
+      SerializeHelper<ALSPolicy>(ar, cf, normalizationType);
+      break;
   }
 }
 
@@ -0,0 +1,373 @@
+/**
+ * @file methods/cf/decomposition_policies/als_fold_in.hpp
+ *
+ * Alternating least squares steps used by the decomposition policies to fold
+ * new users, items and ratings into an already-trained factorization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_FOLD_IN_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_FOLD_IN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Grow a trained model to cover every item and user of cleanedData.  The
+ * factors of the new items and users are initialized with small random values
+ * and their biases (if used) with zeros.
+ *
+ * @param cleanedData Item-user table of (normalized) ratings.
+ * @param w Item factor matrix (one row per item).
+ * @param h User factor matrix (one column per user).
+ * @param p Item bias vector; ignored if useBias is false.
+ * @param q User bias vector; ignored if useBias is false.
+ * @param useBias Whether or not the model has item and user biases.
+ */
+inline void GrowFoldInModel(const arma::sp_mat& cleanedData,
+                            arma::mat& w,
+                            arma::mat& h,
+                            arma::vec& p,
+                            arma::vec& q,
+                            const bool useBias)
+{
+  const size_t rank = w.n_cols;
+  const size_t oldItems = w.n_rows;
+  const size_t oldUsers = h.n_cols;
+
+  if (cleanedData.n_rows > oldItems)
+  {
+    w.resize(cleanedData.n_rows, rank);
+    w.rows(oldItems, w.n_rows - 1).randu();
+    w.rows(oldItems, w.n_rows - 1) *= 0.01;
+    if (useBias)
+      p.resize(cleanedData.n_rows);
+  }
+  if (cleanedData.n_cols > oldUsers)
+  {
+    h.resize(rank, cleanedData.n_cols);
+    h.cols(oldUsers, h.n_cols - 1).randu();
+    h.cols(oldUsers, h.n_cols - 1) *= 0.01;
+    if (useBias)
+      q.resize(cleanedData.n_cols);
+  }
+}
+
+/**
+ * Collect the ratings of the given items as (user, rating) pairs, since the
+ * item-user table is stored by column (user).
+ *
+ * @param cleanedData Item-user table of (normalized) ratings.
+ * @param items Items whose ratings are collected.
+ * @param itemRatings Resulting ratings, one list per item.
+ */
+inline void CollectItemRatings(
+    const arma::sp_mat& cleanedData,
+    const arma::uvec& items,
+    std::vector<std::vector<std::pair<size_t, double>>>& itemRatings)
+{
+  std::vector<size_t> itemIndex(cleanedData.n_rows, items.n_elem);
+  for (size_t i = 0; i < items.n_elem; ++i)
+    itemIndex[items[i]] = i;
+  itemRatings.clear();
+  itemRatings.resize(items.n_elem);
+  for (arma::sp_mat::const_iterator it = cleanedData.begin();
+       it != cleanedData.end(); ++it)
+  {
+    if (itemIndex[it.row()] < items.n_elem)
+      itemRatings[itemIndex[it.row()]].push_back(
+          std::make_pair(it.col(), (double) *it));
+  }
+}
+
+/**
+ * Fold new ratings into a trained model of the form
+ *
+ *   X(i, u) ~ W.row(i) * (H.col(u) + O.col(u)) + p(i) + q(u),
+ *
+ * where O is an optional fixed user offset (used by SVD++ for the implicit
+ * feedback term) and p and q are optional item and user biases.  Only the
+ * factors (and biases) of the given users and items are changed: each
+ * iteration solves the regularized rank x rank normal equations of every
+ * affected user against the current item factors, and then of every affected
+ * item against the current user factors.  The solves are independent and are
+ * run in parallel.
+ *
+ * If cleanedData has more rows or columns than the current factors, W, H (and
+ * the biases) are grown and the factors of the new items and users are
+ * initialized with small random values.
+ *
+ * @param cleanedData Item-user table of (normalized) ratings.
+ * @param users Users whose factors should be recomputed.
+ * @param items Items whose factors should be recomputed.
+ * @param w Item factor matrix (one row per item).
+ * @param h User factor matrix (one column per user).
+ * @param p Item bias vector; ignored if useBias is false.
+ * @param q User bias vector; ignored if useBias is false.
+ * @param userOffset Fixed offset added to the user factors; may be empty.
+ * @param useBias Whether or not the model has item and user biases.
+ * @param iterations Number of alternating passes to run.
+ * @param lambda Regularization parameter; if negative, 0.01 is used.
+ * @param nonNegative If true, negative factors are set to zero after each
+ *     solve (as in NMF).
+ */
+inline void ALSFoldIn(const arma::sp_mat& cleanedData,
+                      const arma::uvec& users,
+                      const arma::uvec& items,
+                      arma::mat& w,
+                      arma::mat& h,
+                      arma::vec& p,
+                      arma::vec& q,
+                      const arma::mat& userOffset,
+                      const bool useBias,
+                      const size_t iterations,
+                      const double lambda,
+                      const bool nonNegative)
+{
+  const size_t rank = w.n_cols;
+
+  // Grow the model to cover any new item or user.
+  GrowFoldInModel(cleanedData, w, h, p, q, useBias);
+
+  // Each solved vector holds the factors, followed by the bias if used.
+  const size_t dim = rank + (useBias ? 1 : 0);
+  const arma::mat regularization = (lambda < 0 ? 0.01 : lambda) *
+      arma::eye(dim, dim);
+
+  std::vector<std::vector<std::pair<size_t, double>>> itemRatings;
+  CollectItemRatings(cleanedData, items, itemRatings);
+
+  for (size_t iter = 0; iter < iterations; ++iter)
+  {
+    // Solve for the affected users, holding the items fixed.
+    #pragma omp parallel for
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      const size_t user = users[i];
+      arma::mat a(regularization);
+      arma::vec b(dim, arma::fill::zeros);
+      arma::vec x(dim);
+
+      arma::sp_mat::const_col_iterator it = cleanedData.begin_col(user);
+      for (; it != cleanedData.end_col(user); ++it)
+      {
+        const size_t item = it.row();
+        x.head(rank) = w.row(item).t();
+        double target = (*it);
+        if (useBias)
+        {
+          x(rank) = 1.0;
+          target -= p(item);
+        }
+        if (!userOffset.is_empty())
+          target -= arma::dot(w.row(item), userOffset.col(user));
+
+        a += x * x.t();
+        b += target * x;
+      }
+
+      arma::vec solution = arma::solve(a, b);
+      if (nonNegative)
+        solution.elem(arma::find(solution < 0)).zeros();
+
+      h.col(user) = solution.head(rank);
+      if (useBias)
+        q(user) = solution(rank);
+    }
+
+    // Solve for the affected items, holding the users fixed.
+    #pragma omp parallel for
+    for (size_t i = 0; i < items.n_elem; ++i)
+    {
+      const size_t item = items[i];
+      arma::mat a(regularization);
+      arma::vec b(dim, arma::fill::zeros);
+      arma::vec x(dim);
+
+      for (size_t j = 0; j < itemRatings[i].size(); ++j)
+      {
+        const size_t user = itemRatings[i][j].first;
+        x.head(rank) = h.col(user);
+        if (!userOffset.is_empty())
+          x.head(rank) += userOffset.col(user);
+        double target = itemRatings[i][j].second;
+        if (useBias)
+        {
+          x(rank) = 1.0;
+          target -= q(user);
+        }
+
+        a += x * x.t();
+        b += target * x;
+      }
+
+      arma::vec solution = arma::solve(a, b);
+      if (nonNegative)
+        solution.elem(arma::find(solution < 0)).zeros();
+
+      w.row(item) = solution.head(rank).t();
+      if (useBias)
+        p(item) = solution(rank);
+    }
+  }
+}
+
+/**
+ * Fold new ratings into a trained model of the form X ~ W * H, without biases.
+ * See the other overload for details.
+ *
+ * @param cleanedData Item-user table of (normalized) ratings.
+ * @param users Users whose factors should be recomputed.
+ * @param items Items whose factors should be recomputed.
+ * @param w Item factor matrix (one row per item).
+ * @param h User factor matrix (one column per user).
+ * @param iterations Number of alternating passes to run.
+ * @param lambda Regularization parameter; if negative, 0.01 is used.
+ * @param nonNegative If true, negative factors are set to zero after each
+ *     solve (as in NMF).
+ */
+inline void ALSFoldIn(const arma::sp_mat& cleanedData,
+                      const arma::uvec& users,
+                      const arma::uvec& items,
+                      arma::mat& w,
+                      arma::mat& h,
+                      const size_t iterations,
+                      const double lambda,
+                      const bool nonNegative = false)
+{
+  arma::vec p, q;
+  ALSFoldIn(cleanedData, users, items, w, h, p, q, arma::mat(), false,
+      iterations, lambda, nonNegative);
+}
+
+/**
+ * Fold new ratings into a model trained with amf::WeightedALSUpdate.  The
+ * factors of the given users and items are recomputed by solving the same
+ * normal equations as a training sweep, so that folding in ratings gives the
+ * same factors as an ALS step over the full, updated data:
+ *
+ *  - for explicit feedback (alpha == 0), only the observed ratings are used and
+ *    each factor is regularized by lambda times its number of ratings;
+ *  - for implicit feedback (alpha > 0), every item (or user) is used with
+ *    preference 1 if it was rated and 0 otherwise, weighted by the confidence
+ *    1 + alpha * rating, and each factor is regularized by lambda.  The
+ *    unrated elements are accounted for with the Gram matrix of all the fixed
+ *    factors, which is computed once per pass.
+ *
+ * New users and items are added to the model as in ALSFoldIn().
+ *
+ * @param cleanedData Item-user table of ratings.
+ * @param users Users whose factors should be recomputed.
+ * @param items Items whose factors should be recomputed.
+ * @param w Item factor matrix (one row per item).
+ * @param h User factor matrix (one column per user).
+ * @param iterations Number of alternating passes to run.
+ * @param lambda Regularization parameter.
+ * @param alpha Confidence scaling for implicit feedback; 0 means explicit
+ *     feedback.
+ */
+inline void WeightedALSFoldIn(const arma::sp_mat& cleanedData,
+                              const arma::uvec& users,
+                              const arma::uvec& items,
+                              arma::mat& w,
+                              arma::mat& h,
+                              const size_t iterations,
+                              const double lambda,
+                              const double alpha)
+{
+  const size_t rank = w.n_cols;
+
+  // Grow the model to cover any new item or user.
+  arma::vec p, q;
+  GrowFoldInModel(cleanedData, w, h, p, q, false);
+
+  std::vector<std::vector<std::pair<size_t, double>>> itemRatings;
+  CollectItemRatings(cleanedData, items, itemRatings);
+
+  // Make sure the column pointers are up to date before reading them.
+  cleanedData.sync();
+
+  // Solve for one factor, given the fixed factors of its observed elements and
+  // their values, as in WeightedALSUpdate.
+  auto solve = [&](const arma::mat& observed,
+                   const arma::vec& values,
+                   const arma::mat& gram) -> arma::vec
+  {
+    if (values.n_elem == 0 && alpha == 0)
+      return arma::vec(rank, arma::fill::zeros);
+
+    arma::mat a;
+    arma::vec b;
+    if (alpha > 0)
+    {
+      const arma::vec confidence = alpha * values;
+      a = gram + (observed.each_row() % confidence.t()) * observed.t();
+      b = observed * (1.0 + confidence);
+      a.diag() += lambda;
+    }
+    else
+    {
+      a = observed * observed.t();
+      b = observed * values;
+      a.diag() += lambda * values.n_elem;
+    }
+
+    return arma::solve(a, b);
+  };
+
+  arma::mat gram;
+  for (size_t iter = 0; iter < iterations; ++iter)
+  {
+    // Solve for the affected users, holding the items fixed.
+    if (alpha > 0)
+      gram = w.t() * w;
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      const size_t user = users[i];
+      const size_t count = cleanedData.col_ptrs[user + 1] -
+          cleanedData.col_ptrs[user];
+      arma::uvec indices(count);
+      arma::vec values(count);
+      size_t k = 0;
+      arma::sp_mat::const_col_iterator it = cleanedData.begin_col(user);
+      for (; it != cleanedData.end_col(user); ++it, ++k)
+      {
+        indices[k] = it.row();
+        values[k] = (*it);
+      }
+
+      h.col(user) = solve(w.rows(indices).t(), values, gram);
+    }
+
+    // Solve for the affected items, holding the users fixed.
+    if (alpha > 0)
+      gram = h * h.t();
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < items.n_elem; ++i)
+    {
+      const size_t count = itemRatings[i].size();
+      arma::uvec indices(count);
+      arma::vec values(count);
+      for (size_t j = 0; j < count; ++j)
+      {
+        indices[j] = itemRatings[i][j].first;
+        values[j] = itemRatings[i][j].second;
+      }
+
+      w.row(items[i]) = solve(h.cols(indices), values, gram).t();
+    }
+  }
+}
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file methods/cf/decomposition_policies/als_method.hpp
+ *
+ * Implementation of weighted alternating least squares for use in
+ * Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/amf/amf.hpp>
+#include <mlpack/methods/amf/update_rules/weighted_als.hpp>
+#include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
+#include <mlpack/methods/amf/termination_policies/simple_tolerance_termination.hpp>
+
+#include "als_fold_in.hpp"
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of the weighted alternating least squares policy to act as a
+ * wrapper when accessing WeightedALSUpdate from within CFType.  Only the
+ * observed ratings are used, and the per-user and per-item least squares
+ * problems are solved in parallel, so this scales to very large, very sparse
+ * rating matrices.
+ *
+ * An example of how to use ALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ALSPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ALSPolicy
+{
+ public:
+  /**
+   * Use weighted alternating least squares to perform collaborative
+   * filtering.
+   *
+   * @param lambda Regularization parameter.
+   * @param alpha Confidence scaling for implicit feedback; 0 means the ratings
+   *     are explicit feedback.
+   */
+  ALSPolicy(const double lambda = 0.05, const double alpha = 0.0) :
+      lambda(lambda),
+      alpha(alpha)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided dataset using weighted
+   * alternating least squares.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix (cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Residue required to terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    amf::WeightedALSUpdate update(lambda, alpha);
+    if (mit)
+    {
+      amf::MaxIterationTermination iter(maxIterations);
+
+      amf::AMF<amf::MaxIterationTermination, amf::RandomInitialization,
+          amf::WeightedALSUpdate> als(iter, amf::RandomInitialization(),
+          update);
+      als.Apply(cleanedData, rank, w, h);
+    }
+    else
+    {
+      // The residue is only computed over the observed ratings.
+      amf::SimpleToleranceTermination<arma::sp_mat> stt(minResidue,
+          maxIterations);
+
+      amf::AMF<amf::SimpleToleranceTermination<arma::sp_mat>,
+          amf::RandomInitialization, amf::WeightedALSUpdate> als(stt,
+          amf::RandomInitialization(), update);
+      als.Apply(cleanedData, rank, w, h);
+    }
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is the inner product of its column with the
+   * vector returned by GetUserFactors().
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = w.t();
+  }
+
+  /**
+   * Get the latent factors of a user, such that the predicted rating of each
+   * item is the inner product of this vector with the corresponding column of
+   * the matrix returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors = h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  The steps solve the same (explicit or implicit
+   * feedback) weighted least squares problems as training.  New users and
+   * items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, the regularization
+   *     parameter of the policy is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    WeightedALSFoldIn(cleanedData, users, items, w, h, iterations,
+        (lambda < 0) ? this->lambda : lambda, alpha);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the implicit feedback confidence scaling.
+  double Alpha() const { return alpha; }
+  //! Modify the implicit feedback confidence scaling.
+  double& Alpha() { return alpha; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(alpha));
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  //! Regularization parameter.
+  double lambda;
+  //! Confidence scaling for implicit feedback.
+  double alpha;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
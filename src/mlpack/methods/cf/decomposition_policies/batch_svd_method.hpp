@@ -19,6 +19,8 @@
 #include <mlpack/methods/amf/termination_policies/simple_residue_termination.hpp>
 #include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
 
+#include "als_fold_in.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -107,6 +109,31 @@ class BatchSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is the inner product of its column with the
+   * vector returned by GetUserFactors().
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = w.t();
+  }
+
+  /**
+   * Get the latent factors of a user, such that the predicted rating of each
+   * item is the inner product of this vector with the corresponding column of
+   * the matrix returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors = h.col(user);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -146,6 +173,26 @@ class BatchSVDPolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  New users and items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, 0.01 is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    ALSFoldIn(cleanedData, users, items, w, h, iterations, lambda);
+  }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/bias_svd/bias_svd.hpp>
 
+#include "als_fold_in.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -47,13 +49,17 @@ class BiasSVDPolicy
    * @param maxIterations Number of iterations.
    * @param alpha Learning rate for optimization.
    * @param lambda Regularization parameter for optimization.
+   * @param hogwild If true, train with lock-free parallel SGD updates
+   *     (Hogwild!) instead of sequential SGD.
    */
   BiasSVDPolicy(const size_t maxIterations = 10,
                 const double alpha = 0.02,
-                const double lambda = 0.05) :
+                const double lambda = 0.05,
+                const bool hogwild = false) :
       maxIterations(maxIterations),
       alpha(alpha),
-      lambda(lambda)
+      lambda(lambda),
+      hogwild(hogwild)
   {
     /* Nothing to do here */
   }
@@ -78,7 +84,7 @@ class BiasSVDPolicy
              const bool /* mit */)
   {
     // Perform decomposition using the bias SVD algorithm.
-    svd::BiasSVD<> biassvd(maxIterations, alpha, lambda);
+    svd::BiasSVD<> biassvd(maxIterations, alpha, lambda, hogwild);
     biassvd.Apply(data, rank, w, h, p, q);
   }
 
@@ -106,6 +112,34 @@ class BiasSVDPolicy
     rating = w * h.col(user) + p + q(user);
   }
 
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is (up to the user bias, which does not
+   * depend on the item) the inner product of its column with the vector
+   * returned by GetUserFactors().  The item bias is stored in the last row.
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = arma::join_cols(w.t(), p.t());
+  }
+
+  /**
+   * Get the latent factors of a user, such that the predicted rating of each
+   * item is (up to the user bias) the inner product of this vector with the
+   * corresponding column of the matrix returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors.set_size(h.n_rows + 1);
+    userFactors.head(h.n_rows) = h.col(user);
+    userFactors(h.n_rows) = 1.0;
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -136,6 +170,28 @@ class BiasSVDPolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  New users and items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, the regularization
+   *     parameter of the policy is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    ALSFoldIn(cleanedData, users, items, w, h, p, q, arma::mat(), true,
+        iterations, (lambda < 0) ? this->lambda : lambda, false);
+  }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
@@ -160,6 +216,11 @@ class BiasSVDPolicy
   //! Modify regularization parameter.
   double& Lambda() { return lambda; }
 
+  //! Get whether to train with parallel Hogwild! SGD.
+  bool Hogwild() const { return hogwild; }
+  //! Modify whether to train with parallel Hogwild! SGD.
+  bool& Hogwild() { return hogwild; }
+
   /**
    * Serialization.
    */
@@ -182,6 +243,8 @@ class BiasSVDPolicy
   double alpha;
   //! Regularization parameter for optimization.
   double lambda;
+  //! Whether to train with parallel Hogwild! SGD.
+  bool hogwild;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
@@ -7,6 +7,7 @@
 #ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_DECOMPOSITION_POLICIES_HPP
 #define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_DECOMPOSITION_POLICIES_HPP
 
+#include "als_method.hpp"
 #include "batch_svd_method.hpp"
 #include "bias_svd_method.hpp"
 #include "nmf_method.hpp"
@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/randomized_svd/randomized_svd.hpp>
 
+#include "als_fold_in.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -113,6 +115,31 @@ class RandomizedSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is the inner product of its column with the
+   * vector returned by GetUserFactors().
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = w.t();
+  }
+
+  /**
+   * Get the latent factors of a user, such that the predicted rating of each
+   * item is the inner product of this vector with the corresponding column of
+   * the matrix returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors = h.col(user);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -152,6 +179,26 @@ class RandomizedSVDPolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  New users and items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, 0.01 is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    ALSFoldIn(cleanedData, users, items, w, h, iterations, lambda);
+  }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
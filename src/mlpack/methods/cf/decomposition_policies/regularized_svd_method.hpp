@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/regularized_svd/regularized_svd.hpp>
 
+#include "als_fold_in.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -46,9 +48,12 @@ class RegSVDPolicy
    *
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
+   * @param hogwild If true, train with lock-free parallel SGD updates
+   *     (Hogwild!) instead of sequential SGD.
    */
-  RegSVDPolicy(const size_t maxIterations = 10) :
-      maxIterations(maxIterations)
+  RegSVDPolicy(const size_t maxIterations = 10, const bool hogwild = false) :
+      maxIterations(maxIterations),
+      hogwild(hogwild)
   {
     /* Nothing to do here */
   }
@@ -73,7 +78,7 @@ class RegSVDPolicy
              const bool /* mit */)
   {
     // Do singular value decomposition using the regularized SVD algorithm.
-    svd::RegularizedSVD<> regsvd(maxIterations);
+    svd::RegularizedSVD<> regsvd(maxIterations, 0.01, 0.02, hogwild);
     regsvd.Apply(data, rank, w, h);
   }
 
@@ -100,6 +105,31 @@ class RegSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is the inner product of its column with the
+   * vector returned by GetUserFactors().
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = w.t();
+  }
+
+  /**
+   * Get the latent factors of a user, such that the predicted rating of each
+   * item is the inner product of this vector with the corresponding column of
+   * the matrix returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors = h.col(user);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -139,6 +169,29 @@ class RegSVDPolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  New users and items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, the regularization
+   *     parameter of the policy is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    // RegularizedSVD is trained with lambda = 0.02 in Apply().
+    ALSFoldIn(cleanedData, users, items, w, h, iterations,
+        (lambda < 0) ? 0.02 : lambda);
+  }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
@@ -149,6 +202,11 @@ class RegSVDPolicy
   //! Modify the number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get whether to train with parallel Hogwild! SGD.
+  bool Hogwild() const { return hogwild; }
+  //! Modify whether to train with parallel Hogwild! SGD.
+  bool& Hogwild() { return hogwild; }
+
   /**
    * Serialization.
    */
@@ -162,6 +220,8 @@ class RegSVDPolicy
  private:
   //! Locally stored number of iterations.
   size_t maxIterations;
+  //! Whether to train with parallel Hogwild! SGD.
+  bool hogwild;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/svdplusplus/svdplusplus.hpp>
 
+#include "als_fold_in.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -47,13 +49,17 @@ class SVDPlusPlusPolicy
    * @param maxIterations Number of iterations.
    * @param alpha Learning rate for optimization.
    * @param lambda Regularization parameter for optimization.
+   * @param hogwild If true, train with lock-free parallel SGD updates
+   *     (Hogwild!) instead of sequential SGD.
    */
   SVDPlusPlusPolicy(const size_t maxIterations = 10,
                     const double alpha = 0.001,
-                    const double lambda = 0.1) :
+                    const double lambda = 0.1,
+                    const bool hogwild = false) :
       maxIterations(maxIterations),
       alpha(alpha),
-      lambda(lambda)
+      lambda(lambda),
+      hogwild(hogwild)
   {
     /* Nothing to do here */
   }
@@ -77,7 +83,7 @@ class SVDPlusPlusPolicy
              const double /* minResidue */,
              const bool /* mit */)
   {
-    svd::SVDPlusPlus<> svdpp(maxIterations, alpha, lambda);
+    svd::SVDPlusPlus<> svdpp(maxIterations, alpha, lambda, hogwild);
 
     // Save implicit data in the form of sparse matrix.
     arma::mat implicitDenseData = data.submat(0, 0, 1, data.n_cols - 1);
@@ -141,6 +147,45 @@ class SVDPlusPlusPolicy
     rating = w * userVec + p + q(user);
   }
 
+  /**
+   * Get the latent factors of all items, one item per column, such that the
+   * predicted rating of an item is (up to the user bias, which does not
+   * depend on the item) the inner product of its column with the vector
+   * returned by GetUserFactors().  The item bias is stored in the last row.
+   *
+   * @param itemFactors Resulting item factor matrix.
+   */
+  void GetItemFactors(arma::mat& itemFactors) const
+  {
+    itemFactors = arma::join_cols(w.t(), p.t());
+  }
+
+  /**
+   * Get the latent factors of a user (including the implicit feedback term),
+   * such that the predicted rating of each item is (up to the user bias) the
+   * inner product of this vector with the corresponding column of the matrix
+   * returned by GetItemFactors().
+   *
+   * @param user User ID.
+   * @param userFactors Resulting user factor vector.
+   */
+  void GetUserFactors(const size_t user, arma::vec& userFactors) const
+  {
+    userFactors.zeros(h.n_rows + 1);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userFactors.head(h.n_rows) += y.col(it.row());
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userFactors /= std::sqrt(implicitCount);
+    userFactors.head(h.n_rows) += h.col(user);
+    userFactors(h.n_rows) = 1.0;
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -171,6 +216,67 @@ class SVDPlusPlusPolicy
         query, numUsersForSimilarity, neighborhood, similarities);
   }
 
+  /**
+   * Fold new ratings into the trained model by recomputing the factors of the
+   * given users and items with a few alternating least squares steps against
+   * the existing factors.  New users and items are added to the model.
+   *
+   * @param cleanedData Updated item user table in form of sparse matrix.
+   * @param users Users whose factors should be recomputed.
+   * @param items Items whose factors should be recomputed.
+   * @param iterations Number of alternating least squares steps.
+   * @param lambda Regularization parameter; if negative, the regularization
+   *     parameter of the policy is used.
+   */
+  void FoldIn(const arma::sp_mat& cleanedData,
+              const arma::uvec& users,
+              const arma::uvec& items,
+              const size_t iterations,
+              const double lambda)
+  {
+    // Every rated item counts as implicit feedback, as in Apply().
+    implicitData = arma::spones(cleanedData);
+    if (y.n_cols < cleanedData.n_rows)
+      y.resize(y.n_rows, cleanedData.n_rows);
+
+    // The implicit feedback term of each user is held fixed.  It is only used
+    // for the given users and for the users that rated one of the given items,
+    // so it is not computed for any other user.
+    std::vector<bool> isItem(cleanedData.n_rows, false);
+    for (size_t i = 0; i < items.n_elem; ++i)
+      isItem[items[i]] = true;
+    std::vector<bool> needsOffset(cleanedData.n_cols, false);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      needsOffset[users[i]] = true;
+    for (arma::sp_mat::const_iterator it = cleanedData.begin();
+         it != cleanedData.end(); ++it)
+    {
+      if (isItem[it.row()])
+        needsOffset[it.col()] = true;
+    }
+
+    arma::mat userOffset(h.n_rows, cleanedData.n_cols, arma::fill::zeros);
+    for (size_t user = 0; user < cleanedData.n_cols; ++user)
+    {
+      if (!needsOffset[user])
+        continue;
+
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        userOffset.col(user) += y.col(it.row());
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        userOffset.col(user) /= std::sqrt(implicitCount);
+    }
+
+    ALSFoldIn(cleanedData, users, items, w, h, p, q, userOffset, true,
+        iterations, (lambda < 0) ? this->lambda : lambda, false);
+  }
+
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
@@ -199,6 +305,11 @@ class SVDPlusPlusPolicy
   //! Modify regularization parameter.
   double& Lambda() { return lambda; }
 
+  //! Get whether to train with parallel Hogwild! SGD.
+  bool Hogwild() const { return hogwild; }
+  //! Modify whether to train with parallel Hogwild! SGD.
+  bool& Hogwild() { return hogwild; }
+
   /**
    * Serialization.
    */
@@ -223,6 +334,8 @@ class SVDPlusPlusPolicy
   double alpha;
   //! Regularization parameter for optimization.
   double lambda;
+  //! Whether to train with parallel Hogwild! SGD.
+  bool hogwild;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
@@ -68,9 +68,21 @@ class RegressionInterpolation
    */
   RegressionInterpolation(const arma::sp_mat& cleanedData)
   {
+    // GetWeights() may be called from several threads at once, so every
+    // thread gets its own caches.
+    size_t numThreads = 1;
+    #ifdef MLPACK_USE_OPENMP
+      numThreads = omp_get_max_threads();
+    #endif
+
     const size_t userNum = cleanedData.n_cols;
-    a.set_size(userNum, userNum);
-    b.set_size(userNum, userNum);
+    a.resize(numThreads);
+    b.resize(numThreads);
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      a[t].set_size(userNum, userNum);
+      b[t].set_size(userNum, userNum);
+    }
   }
 
   /**
@@ -106,6 +118,13 @@ class RegressionInterpolation
           << std::endl;
     }
 
+    size_t threadId = 0;
+    #ifdef MLPACK_USE_OPENMP
+      threadId = omp_get_thread_num();
+    #endif
+    arma::sp_mat& threadA = a[threadId];
+    arma::sp_mat& threadB = b[threadId];
+
     const arma::mat& w = decomposition.W();
     const arma::mat& h = decomposition.H();
     const size_t itemNum = cleanedData.n_rows;
@@ -132,10 +151,11 @@ class RegressionInterpolation
       arma::vec iPrediction;
       for (size_t j = i; j < neighborNum; ++j)
       {
-        if (a(neighbors(i), neighbors(j)) != 0)
+        const double cached = threadA(neighbors(i), neighbors(j));
+        if (cached != 0)
         {
           // The coefficient has already been cached.
-          coeff(i, j) = a(neighbors(i), neighbors(j));
+          coeff(i, j) = cached;
           coeff(j, i) = coeff(i, j);
         }
         else
@@ -150,15 +170,16 @@ class RegressionInterpolation
             coeff(i, j) = std::numeric_limits<double>::min();
           coeff(j, i) = coeff(i, j);
           // Cache calcualted coefficient.
-          a(neighbors(i), neighbors(j)) = coeff(i, j);
-          a(neighbors(j), neighbors(i)) = coeff(i, j);
+          threadA(neighbors(i), neighbors(j)) = coeff(i, j);
+          threadA(neighbors(j), neighbors(i)) = coeff(i, j);
         }
       }
 
       // Calculate constant terms.
-      if (b(neighbors(i), queryUser) != 0)
+      const double cached = threadB(neighbors(i), queryUser);
+      if (cached != 0)
         // The constant term has already been cached.
-        constant(i) = b(neighbors(i), queryUser);
+        constant(i) = cached;
       else
       {
         // Calcuate the constant term.
@@ -169,17 +190,19 @@ class RegressionInterpolation
         if (constant(i) == 0)
           constant(i) = std::numeric_limits<double>::min();
         // Cache calculated constant term.
-        b(neighbors(i), queryUser) = constant(i);
+        threadB(neighbors(i), queryUser) = constant(i);
       }
     }
     weights = arma::solve(coeff, constant);
   }
 
  private:
-  //! Cached coefficients used in linear equations to compute weights.
-  arma::sp_mat a;
-  //! Cached constant terms used in linear equations to compute weights.
-  arma::sp_mat b;
+  //! Cached coefficients used in linear equations to compute weights (one
+  //! cache per thread).
+  std::vector<arma::sp_mat> a;
+  //! Cached constant terms used in linear equations to compute weights (one
+  //! cache per thread).
+  std::vector<arma::sp_mat> b;
 };
 
 } // namespace cf
@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
+#include "parallel_search.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -50,13 +52,10 @@ class CosineSearch
    *
    * @param referenceSet Set of reference points.
    */
-  CosineSearch(const arma::mat& referenceSet)
-  {
-    // Normalize all vectors to unit length.
-    arma::mat normalizedSet = arma::normalise(referenceSet, 2, 0);
-
-    neighborSearch.Train(std::move(normalizedSet));
-  }
+  CosineSearch(const arma::mat& referenceSet) :
+      // Normalize all vectors to unit length.
+      neighborSearch(arma::normalise(referenceSet, 2, 0))
+  { }
 
   /**
    * Given a set of query points, find the nearest k neighbors, and return
@@ -85,8 +84,9 @@ class CosineSearch
   }
 
  private:
-  //! NeighborSearch object.
-  neighbor::KNN neighborSearch;
+  //! Neighbor search object.
+  ParallelSearch<neighbor::NearestNeighborSort, metric::EuclideanDistance>
+      neighborSearch;
 };
 
 } // namespace cf
@@ -16,6 +16,8 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 
+#include "parallel_search.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -42,8 +44,7 @@ template<int TPower>
 class LMetricSearch
 {
  public:
-  using NeighborSearchType = neighbor::NeighborSearch<
-      neighbor::NearestNeighborSort,
+  using NeighborSearchType = ParallelSearch<neighbor::NearestNeighborSort,
       metric::LMetric<TPower, true>>;
 
   /**
@@ -72,7 +73,7 @@ class LMetricSearch
   }
 
  private:
-  //! NeighborSearch object.
+  //! Neighbor search object.
   NeighborSearchType neighborSearch;
 };
 
@@ -0,0 +1,126 @@
+/**
+ * @file methods/cf/neighbor_search_policies/parallel_search.hpp
+ *
+ * Helper to split a neighbor search over the query set across OpenMP threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_PARALLEL_SEARCH_HPP
+#define MLPACK_METHODS_CF_PARALLEL_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Dual-tree neighbor search on a kd-tree that is built once on the reference
+ * set.  Search() splits the query set into one contiguous block per OpenMP
+ * thread.  All threads traverse the same reference tree; each thread builds a
+ * query tree on its own block, and the traversal only writes to the statistics
+ * of the query tree, so the reference tree is never copied.
+ *
+ * @tparam SortPolicy Sort policy (e.g. neighbor::NearestNeighborSort).
+ * @tparam MetricType Distance metric to use.
+ */
+template<typename SortPolicy, typename MetricType>
+class ParallelSearch
+{
+ public:
+  //! Type of the reference and query trees.
+  typedef tree::KDTree<MetricType, neighbor::NeighborSearchStat<SortPolicy>,
+      arma::mat> Tree;
+
+  /**
+   * Build the reference tree on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  ParallelSearch(arma::mat referenceSet) :
+      referenceTree(std::move(referenceSet), oldFromNewReferences)
+  { }
+
+  /**
+   * Find the k nearest neighbors of each point in the query set.
+   *
+   * @param query Set of query points.
+   * @param k Number of neighbors to search.
+   * @param neighbors Resulting nearest neighbors.
+   * @param distances Resulting distances between query points and neighbors.
+   */
+  void Search(const arma::mat& query,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances)
+  {
+    if (k > referenceTree.Dataset().n_cols)
+    {
+      std::stringstream ss;
+      ss << "Requested value of k (" << k << ") is greater than the number of "
+          << "points in the reference set (" << referenceTree.Dataset().n_cols
+          << ")";
+      throw std::invalid_argument(ss.str());
+    }
+
+    typedef neighbor::NeighborSearchRules<SortPolicy, MetricType, Tree>
+        RuleType;
+
+    neighbors.set_size(k, query.n_cols);
+    distances.set_size(k, query.n_cols);
+
+    size_t numThreads = 1;
+    #ifdef MLPACK_USE_OPENMP
+      numThreads = omp_get_max_threads();
+    #endif
+    const size_t blockSize = (query.n_cols + numThreads - 1) / numThreads;
+
+    #pragma omp parallel for schedule(static, 1)
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      const size_t begin = std::min(t * blockSize, (size_t) query.n_cols);
+      const size_t end = std::min(begin + blockSize, (size_t) query.n_cols);
+      if (begin == end)
+        continue;
+
+      std::vector<size_t> oldFromNewQueries;
+      Tree queryTree(arma::mat(query.cols(begin, end - 1)), oldFromNewQueries);
+
+      MetricType metric;
+      RuleType rules(referenceTree.Dataset(), queryTree.Dataset(), k, metric);
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+      traverser.Traverse(queryTree, referenceTree);
+
+      arma::Mat<size_t> blockNeighbors;
+      arma::mat blockDistances;
+      rules.GetResults(blockNeighbors, blockDistances);
+
+      // Both trees rearrange their points, so map the query and reference
+      // indices back to the original ones.
+      for (size_t i = 0; i < blockNeighbors.n_cols; ++i)
+      {
+        const size_t queryIndex = begin + oldFromNewQueries[i];
+        distances.col(queryIndex) = blockDistances.col(i);
+        for (size_t j = 0; j < k; ++j)
+        {
+          neighbors(j, queryIndex) =
+              oldFromNewReferences[blockNeighbors(j, i)];
+        }
+      }
+    }
+  }
+
+ private:
+  //! Permutation of the reference points made when building the tree.
+  std::vector<size_t> oldFromNewReferences;
+  //! Reference tree, shared by all threads.
+  Tree referenceTree;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
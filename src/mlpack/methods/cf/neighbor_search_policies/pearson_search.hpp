@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
+#include "parallel_search.hpp"
+
 namespace mlpack {
 namespace cf {
 
@@ -54,17 +56,13 @@ class PearsonSearch
    *
    * @param referenceSet Set of reference points.
    */
-  PearsonSearch(const arma::mat& referenceSet)
-  {
-    // Normalize all vectors in referenceSet.
-    // For each vector x, first subtract mean(x) from each element in x.
-    // Then normalize the vector to unit length.
-    arma::mat normalizedSet(arma::size(referenceSet));
-    normalizedSet = arma::normalise(
-        referenceSet.each_row() - arma::mean(referenceSet));
-
-    neighborSearch.Train(std::move(normalizedSet));
-  }
+  PearsonSearch(const arma::mat& referenceSet) :
+      // Normalize all vectors in referenceSet.
+      // For each vector x, first subtract mean(x) from each element in x.
+      // Then normalize the vector to unit length.
+      neighborSearch(arma::normalise(
+          referenceSet.each_row() - arma::mean(referenceSet)))
+  { }
 
   /**
    * Given a set of query points, find the nearest k neighbors, and return
@@ -96,8 +94,9 @@ class PearsonSearch
   }
 
  private:
-  //! NeighborSearch object.
-  neighbor::KNN neighborSearch;
+  //! Neighbor search object.
+  ParallelSearch<neighbor::NearestNeighborSort, metric::EuclideanDistance>
+      neighborSearch;
 };
 
 } // namespace cf
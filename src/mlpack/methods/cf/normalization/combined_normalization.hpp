@@ -60,6 +60,32 @@ class CombinedNormalization
     SequenceNormalize<0>(data);
   }
 
+  /**
+   * Update the statistics with new ratings that are folded into a trained
+   * model by calling Update() in each normalization object, in the same order
+   * as Normalize().  Each normalization object is given the new ratings as
+   * normalized by the objects before it, and the replaced ratings as it
+   * normalized them.  The stored ratings are shifted by the change of each
+   * object's own statistics, which matches them exactly unless a
+   * ZScoreNormalization follows a per-user or per-item normalization.
+   *
+   * @param cleanedData Normalized ratings of the model.
+   * @param newRatings New ratings in the form of coordinate list; normalized
+   *     on return.
+   * @param oldRatings Stored (normalized) ratings that the new ratings
+   *     replace, in the form of coordinate list.
+   */
+  void Update(arma::sp_mat& cleanedData,
+              arma::mat& newRatings,
+              const arma::mat& oldRatings)
+  {
+    // The replaced ratings as each normalization object output them.
+    std::vector<arma::mat> oldLevels(std::tuple_size<TupleType>::value,
+        oldRatings);
+    SequenceOldRatings<1>(oldLevels);
+    SequenceUpdate<0>(cleanedData, newRatings, oldLevels);
+  }
+
   /**
    * Denormalize rating by calling Denormalize() in each normalization object.
    * Note that the order of objects calling Denormalize() should be the
@@ -130,6 +156,50 @@ class CombinedNormalization
       typename = void>
   void SequenceNormalize(MatType& /* data */) { }
 
+  //! Unpack normalizations tuple to recover the replaced ratings as each
+  //! normalization object output them, from the last object to the first.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceOldRatings(std::vector<arma::mat>& oldLevels) const
+  {
+    SequenceOldRatings<I + 1>(oldLevels);
+
+    const arma::Mat<size_t> combinations =
+        arma::conv_to<arma::Mat<size_t>>::from(oldLevels[I].rows(0, 1));
+    arma::vec ratings = oldLevels[I].row(2).t();
+    std::get<I>(normalizations).Denormalize(combinations, ratings);
+    oldLevels[I - 1].row(2) = ratings.t();
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceOldRatings(std::vector<arma::mat>& /* oldLevels */) const { }
+
+  //! Unpack normalizations tuple to update the statistics.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceUpdate(arma::sp_mat& cleanedData,
+                      arma::mat& newRatings,
+                      const std::vector<arma::mat>& oldLevels)
+  {
+    std::get<I>(normalizations).Update(cleanedData, newRatings, oldLevels[I]);
+    SequenceUpdate<I + 1>(cleanedData, newRatings, oldLevels);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceUpdate(arma::sp_mat& /* cleanedData */,
+                      arma::mat& /* newRatings */,
+                      const std::vector<arma::mat>& /* oldLevels */) { }
+
   //! Unpack normalizations tuple to denormalize.
   template<
       int I, /* Which normalization in tuple to use */
@@ -120,6 +120,84 @@ class ItemMeanNormalization
     }
   }
 
+  /**
+   * Update the item means with new ratings that are folded into a trained
+   * model, and normalize the new ratings.  Only the means of the items that
+   * receive a new rating change; they are updated incrementally, and the
+   * stored ratings of these items are shifted to their new mean.
+   *
+   * @param cleanedData Normalized ratings of the model; it must already have
+   *     a row for each item in newRatings.
+   * @param newRatings New ratings in the form of coordinate list; normalized
+   *     on return.
+   * @param oldRatings Stored (normalized) ratings that the new ratings
+   *     replace, in the form of coordinate list.
+   */
+  void Update(arma::sp_mat& cleanedData,
+              arma::mat& newRatings,
+              const arma::mat& oldRatings)
+  {
+    // New items start with a mean of zero.
+    itemMean.resize(std::max((size_t) cleanedData.n_rows,
+        (size_t) itemMean.n_elem));
+
+    // Sum the changes of the ratings of each item.
+    arma::vec sums(itemMean.n_elem, arma::fill::zeros);
+    arma::vec counts(itemMean.n_elem, arma::fill::zeros);
+    for (size_t i = 0; i < oldRatings.n_cols; ++i)
+    {
+      const size_t item = (size_t) oldRatings(1, i);
+      sums(item) -= oldRatings(2, i) + itemMean(item);
+      counts(item) -= 1;
+    }
+    for (size_t i = 0; i < newRatings.n_cols; ++i)
+    {
+      const size_t item = (size_t) newRatings(1, i);
+      sums(item) += newRatings(2, i);
+      counts(item) += 1;
+    }
+
+    // The stored ratings are kept by user, so the number of stored ratings of
+    // each item takes a pass over them.
+    arma::vec storedCounts(itemMean.n_elem, arma::fill::zeros);
+    for (arma::sp_mat::const_iterator it = cleanedData.begin();
+         it != cleanedData.end(); ++it)
+      storedCounts(it.row()) += 1;
+
+    arma::vec shifts(itemMean.n_elem, arma::fill::zeros);
+    const arma::uvec items = arma::conv_to<arma::uvec>::from(
+        arma::unique(newRatings.row(1)));
+    for (size_t i = 0; i < items.n_elem; ++i)
+    {
+      const size_t item = items[i];
+      const double count = storedCounts(item) + counts(item);
+      const double mean = (count > 0) ?
+          (itemMean(item) * storedCounts(item) + sums(item)) / count : 0.0;
+      shifts(item) = mean - itemMean(item);
+      itemMean(item) = mean;
+    }
+
+    // Shift the stored ratings of the items whose mean changed.
+    for (arma::sp_mat::iterator it = cleanedData.begin();
+         it != cleanedData.end(); ++it)
+    {
+      if (shifts(it.row()) == 0.0)
+        continue;
+
+      double tmp = *it - shifts(it.row());
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+      *it = tmp;
+    }
+
+    for (size_t i = 0; i < newRatings.n_cols; ++i)
+    {
+      newRatings(2, i) -= itemMean((size_t) newRatings(1, i));
+      if (newRatings(2, i) == 0)
+        newRatings(2, i) = std::numeric_limits<float>::min();
+    }
+  }
+
   /**
    * Denormalize computed rating by adding item mean.
    *
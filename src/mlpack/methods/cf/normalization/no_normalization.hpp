@@ -36,6 +36,17 @@ class NoNormalization
   template<typename MatType>
   inline void Normalize(const MatType& /* data */) const { }
 
+  /**
+   * Do nothing.
+   *
+   * @param * (cleanedData) Normalized ratings of the model.
+   * @param * (newRatings) New ratings.
+   * @param * (oldRatings) Stored ratings that the new ratings replace.
+   */
+  inline void Update(const arma::sp_mat& /* cleanedData */,
+                     const arma::mat& /* newRatings */,
+                     const arma::mat& /* oldRatings */) const { }
+
   /**
    * Do nothing.
    *
@@ -93,6 +93,41 @@ class OverallMeanNormalization
     }
   }
 
+  /**
+   * Update the mean with new ratings that are folded into a trained model, and
+   * normalize the new ratings.  The mean is updated incrementally, using the
+   * number of stored ratings.  The stored ratings are not normalized again, so
+   * the predictions for the users and items that the new ratings do not touch
+   * move with the mean.
+   *
+   * @param cleanedData Normalized ratings of the model.
+   * @param newRatings New ratings in the form of coordinate list; normalized
+   *     on return.
+   * @param oldRatings Stored (normalized) ratings that the new ratings
+   *     replace, in the form of coordinate list.
+   */
+  void Update(const arma::sp_mat& cleanedData,
+              arma::mat& newRatings,
+              const arma::mat& oldRatings)
+  {
+    const double count = (double) cleanedData.n_nonzero - oldRatings.n_cols +
+        newRatings.n_cols;
+    if (count > 0)
+    {
+      // The replaced ratings were normalized with the current mean.
+      const double sum = mean * (cleanedData.n_nonzero - oldRatings.n_cols) -
+          arma::accu(oldRatings.row(2)) + arma::accu(newRatings.row(2));
+      mean = sum / count;
+    }
+
+    newRatings.row(2) -= mean;
+    newRatings.row(2).for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<float>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding mean.
    *
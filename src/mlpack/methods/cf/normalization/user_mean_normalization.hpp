@@ -120,6 +120,76 @@ class UserMeanNormalization
     }
   }
 
+  /**
+   * Update the user means with new ratings that are folded into a trained
+   * model, and normalize the new ratings.  Only the means of the users that
+   * receive a new rating change; they are updated incrementally, and the
+   * stored ratings of these users are shifted to their new mean.  The stored
+   * ratings of the other users are not visited.
+   *
+   * @param cleanedData Normalized ratings of the model; it must already have
+   *     a column for each user in newRatings.
+   * @param newRatings New ratings in the form of coordinate list; normalized
+   *     on return.
+   * @param oldRatings Stored (normalized) ratings that the new ratings
+   *     replace, in the form of coordinate list.
+   */
+  void Update(arma::sp_mat& cleanedData,
+              arma::mat& newRatings,
+              const arma::mat& oldRatings)
+  {
+    // New users start with a mean of zero.
+    userMean.resize(std::max((size_t) cleanedData.n_cols,
+        (size_t) userMean.n_elem));
+
+    // Sum the changes of the ratings of each user.
+    arma::vec sums(userMean.n_elem, arma::fill::zeros);
+    arma::vec counts(userMean.n_elem, arma::fill::zeros);
+    for (size_t i = 0; i < oldRatings.n_cols; ++i)
+    {
+      const size_t user = (size_t) oldRatings(0, i);
+      sums(user) -= oldRatings(2, i) + userMean(user);
+      counts(user) -= 1;
+    }
+    for (size_t i = 0; i < newRatings.n_cols; ++i)
+    {
+      const size_t user = (size_t) newRatings(0, i);
+      sums(user) += newRatings(2, i);
+      counts(user) += 1;
+    }
+
+    cleanedData.sync();
+    const arma::uvec users = arma::conv_to<arma::uvec>::from(
+        arma::unique(newRatings.row(0)));
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      const size_t user = users[i];
+      const double storedCount = cleanedData.col_ptrs[user + 1] -
+          cleanedData.col_ptrs[user];
+      const double count = storedCount + counts(user);
+      const double mean = (count > 0) ?
+          (userMean(user) * storedCount + sums(user)) / count : 0.0;
+      const double shift = mean - userMean(user);
+      userMean(user) = mean;
+
+      for (arma::sp_mat::iterator it = cleanedData.begin_col(user);
+           it != cleanedData.end_col(user); ++it)
+      {
+        double tmp = *it - shift;
+        if (tmp == 0)
+          tmp = std::numeric_limits<float>::min();
+        *it = tmp;
+      }
+    }
+
+    for (size_t i = 0; i < newRatings.n_cols; ++i)
+    {
+      newRatings(2, i) -= userMean((size_t) newRatings(0, i));
+      if (newRatings(2, i) == 0)
+        newRatings(2, i) = std::numeric_limits<float>::min();
+    }
+  }
+
   /**
    * Denormalize computed rating by adding user mean.
    *
@@ -105,6 +105,60 @@ class ZScoreNormalization
     }
   }
 
+  /**
+   * Update the mean and standard deviation with new ratings that are folded
+   * into a trained model, and normalize the new ratings.  The statistics are
+   * updated incrementally, using the number of stored ratings.  The stored
+   * ratings are not normalized again, so the predictions for the users and
+   * items that the new ratings do not touch move with the statistics.
+   *
+   * @param cleanedData Normalized ratings of the model.
+   * @param newRatings New ratings in the form of coordinate list; normalized
+   *     on return.
+   * @param oldRatings Stored (normalized) ratings that the new ratings
+   *     replace, in the form of coordinate list.
+   */
+  void Update(const arma::sp_mat& cleanedData,
+              arma::mat& newRatings,
+              const arma::mat& oldRatings)
+  {
+    // Recover the sum and the sum of squares of the stored ratings, and
+    // replace the contributions of the replaced ratings.
+    const double storedCount = cleanedData.n_nonzero;
+    const arma::rowvec oldValues = oldRatings.row(2) * stddev + mean;
+    double sum = mean * storedCount;
+    double squares = storedCount * mean * mean;
+    if (storedCount > 1)
+      squares += stddev * stddev * (storedCount - 1);
+
+    sum += arma::accu(newRatings.row(2)) - arma::accu(oldValues);
+    squares += arma::accu(arma::square(newRatings.row(2))) -
+        arma::accu(arma::square(oldValues));
+
+    const double count = storedCount - oldRatings.n_cols + newRatings.n_cols;
+    if (count > 0)
+      mean = sum / count;
+    if (count > 1)
+    {
+      stddev = std::sqrt(std::max(squares - count * mean * mean, 0.0) /
+          (count - 1));
+    }
+
+    if (std::fabs(stddev) < 1e-14)
+    {
+      Log::Fatal << "Standard deviation of all existing ratings is 0! "
+          << "This may indicate that all existing ratings are the same."
+          << std::endl;
+    }
+
+    newRatings.row(2) = (newRatings.row(2) - mean) / stddev;
+    newRatings.row(2).for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<float>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding mean and multiplying stddev.
    *
@@ -15,7 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
-#include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 
@@ -43,6 +43,30 @@ namespace dbscan {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * The range searches are done for blocks of points at a time, and their
+ * results are unioned into a lock-free union-find structure in parallel and
+ * then discarded, so the neighborhoods of all points are never held in memory
+ * at once.  Since the clusters do not depend on the order in which points are
+ * unioned, the point selection policy only decides the order in which the
+ * points are searched and the order in which clusters are numbered.
+ *
+ * For low-dimensional data, a grid-based mode (see GridMode()) can be used
+ * instead of range searches; it puts the points in a grid of cells with
+ * diagonal epsilon, so that all points in a cell are neighbors, and only
+ * compares points in nearby cells whose components have not been merged yet.
+ * It is described in the following paper:
+ *
+ * @code
+ * @inproceedings{gan2015dbscan,
+ *   title={DBSCAN Revisited: Mis-Claim, Un-Fixability, and Approximation},
+ *   author={Gan, Junhao and Tao, Yufei},
+ *   booktitle={Proceedings of the 2015 ACM SIGMOD International Conference on
+ *       Management of Data},
+ *   pages={519--530},
+ *   year={2015}
+ * }
+ * @endcode
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -56,7 +80,7 @@ class DBSCAN
    * Construct the DBSCAN object with the given parameters.  The batchMode
    * parameter should be set to false in the case where RAM issues will be
    * encountered (i.e. if the dataset is very large or if epsilon is large).
-   * When batchMode is false, each point will be searched iteratively, which
+   * When batchMode is false, points will be searched in small blocks, which
    * could be slower but will use less memory.
    *
    * @param epsilon Size of range query.
@@ -111,6 +135,34 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  arma::mat& centroids);
 
+  //! Get the radius of the range searches.
+  double Epsilon() const { return epsilon; }
+  //! Modify the radius of the range searches.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinPoints() const { return minPoints; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinPoints() { return minPoints; }
+
+  //! Get whether points are searched in large blocks.
+  bool BatchMode() const { return batchMode; }
+  //! Modify whether points are searched in large blocks.
+  bool& BatchMode() { return batchMode; }
+
+  //! Get the number of points searched at once in batch mode.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points searched at once in batch mode.  This bounds
+  //! the memory used for the neighborhoods; 0 means all points at once.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get whether the grid-based algorithm is used instead of range searches.
+  bool GridMode() const { return gridMode; }
+  //! Modify whether the grid-based algorithm is used instead of range searches.
+  //! It uses the Euclidean distance, and is only efficient for data with few
+  //! dimensions (say, up to 4).
+  bool& GridMode() { return gridMode; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   double epsilon;
@@ -119,9 +171,16 @@ class DBSCAN
   //! itself) for the point to be a core-point.
   size_t minPoints;
 
-  //! Whether or not to perform the search in batch mode.  If false, single
+  //! Whether or not to perform the search in batch mode.  If false, points
+  //! are searched in small blocks.
   bool batchMode;
 
+  //! Number of points searched at once in batch mode.
+  size_t blockSize;
+
+  //! Whether or not to use the grid-based algorithm.
+  bool gridMode;
+
   //! Instantiated range search policy.
   RangeSearchType rangeSearch;
 
@@ -129,31 +188,54 @@ class DBSCAN
   PointSelectionPolicy pointSelector;
 
   /**
-   * Performs DBSCAN clustering on the data, returning the number of clusters and
-   * also the list of cluster assignments.  This searches each point iteratively,
-   * and can save on RAM usage.  It may be slower than the batch search with a
-   * dual-tree algorithm.
+   * Performs DBSCAN clustering on the data by searching small blocks of points
+   * iteratively, which saves on RAM usage.  It may be slower than the batch
+   * search with a dual-tree algorithm.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
+   * @param order Order in which to visit the points.
    * @param uf UnionFind structure that will be modified.
    */
   template<typename MatType>
   void PointwiseCluster(const MatType& data,
-                        emst::UnionFind& uf);
+                        const arma::uvec& order,
+                        emst::ConcurrentUnionFind& uf);
 
   /**
-   * Performs DBSCAN clustering on the data, returning number of clusters
-   * and also the list of cluster assignments.  This can perform search in batch,
-   * so it is well suited for dual-tree or naive search.
+   * Performs DBSCAN clustering on the data by searching large blocks of points
+   * at once, so it is well suited for dual-tree or naive search.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
+   * @param order Order in which to visit the points.
    * @param uf UnionFind structure that will be modified.
    */
   template<typename MatType>
   void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+                    const arma::uvec& order,
+                    emst::ConcurrentUnionFind& uf);
+
+  /**
+   * Search for the neighbors of the given points, and union each point with
+   * all of its neighbors in parallel.
+   *
+   * @param data Dataset to cluster.
+   * @param indices Indices of the points to search for.
+   * @param uf UnionFind structure that will be modified.
+   */
+  template<typename MatType>
+  void SearchBlock(const MatType& data,
+                   const arma::uvec& indices,
+                   emst::ConcurrentUnionFind& uf);
+
+  /**
+   * Performs DBSCAN clustering on the data with the grid-based algorithm.
+   *
+   * @param data Dataset to cluster.
+   * @param uf UnionFind structure that will be modified.
+   */
+  template<typename MatType>
+  void GridCluster(const MatType& data,
+                   emst::ConcurrentUnionFind& uf);
 };
 
 } // namespace dbscan
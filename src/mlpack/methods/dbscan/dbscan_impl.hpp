@@ -30,6 +30,8 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     epsilon(epsilon),
     minPoints(minPoints),
     batchMode(batchMode),
+    blockSize(10000),
+    gridMode(false),
     rangeSearch(rangeSearch),
     pointSelector(pointSelector)
 {
@@ -101,13 +103,26 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     arma::Row<size_t>& assignments)
 {
   // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
-  rangeSearch.Train(data);
+  emst::ConcurrentUnionFind uf(data.n_cols);
 
-  if (batchMode)
-    BatchCluster(data, uf);
+  // Get the order in which to visit the points.
+  arma::uvec order(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = pointSelector.Select(i, data);
+
+  if (gridMode)
+  {
+    GridCluster(data, uf);
+  }
   else
-    PointwiseCluster(data, uf);
+  {
+    rangeSearch.Train(data);
+
+    if (batchMode)
+      BatchCluster(data, order, uf);
+    else
+      PointwiseCluster(data, order, uf);
+  }
 
   // Now set assignments.
   assignments.set_size(data.n_cols);
@@ -115,20 +130,25 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     assignments[i] = uf.Find(i);
 
   // Get a count of all clusters.
-  const size_t numClusters = arma::max(assignments) + 1;
-  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
+  arma::Col<size_t> counts(data.n_cols, arma::fill::zeros);
   for (size_t i = 0; i < assignments.n_elem; ++i)
     counts[assignments[i]]++;
 
-  // Now assign clusters to new indices.
+  // Now assign clusters to new indices, in the order in which their first point
+  // is visited.  Components that are not labeled yet are marked with n_cols.
   size_t currentCluster = 0;
-  arma::Col<size_t> newAssignments(numClusters);
-  for (size_t i = 0; i < counts.n_elem; ++i)
+  arma::Col<size_t> newAssignments(data.n_cols);
+  newAssignments.fill(data.n_cols);
+  for (size_t i = 0; i < order.n_elem; ++i)
   {
-    if (counts[i] >= minPoints)
-      newAssignments[i] = currentCluster++;
+    const size_t component = assignments[order[i]];
+    if (newAssignments[component] != data.n_cols)
+      continue;
+
+    if (counts[component] >= minPoints)
+      newAssignments[component] = currentCluster++;
     else
-      newAssignments[i] = SIZE_MAX;
+      newAssignments[component] = SIZE_MAX;
   }
 
   // Now reassign.
@@ -141,61 +161,214 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning the number of clusters and
- * also the list of cluster assignments.  This searches each point iteratively,
- * and can save on RAM usage.  It may be slower than the batch search with a
- * dual-tree algorithm.
+ * Performs DBSCAN clustering on the data by searching small blocks of points
+ * iteratively, which saves on RAM usage.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    const arma::uvec& order,
+    emst::ConcurrentUnionFind& uf)
 {
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
-
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // The blocks are small, to keep few neighborhoods in memory, but not so small
+  // that the range search cannot process their points in parallel.
+  const size_t pointwiseBlockSize = 1000;
+  for (size_t begin = 0; begin < data.n_cols; begin += pointwiseBlockSize)
   {
-    if (i % 10000 == 0 && i > 0)
-      Log::Info << "DBSCAN clustering on point " << i << "..." << std::endl;
-
-    // Do the range search for only this point.
-    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), neighbors,
-        distances);
+    if (begin % 10000 == 0 && begin > 0)
+      Log::Info << "DBSCAN clustering on point " << begin << "..." << std::endl;
 
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[0].size(); ++j)
-      uf.Union(i, neighbors[0][j]);
+    const size_t end = std::min(begin + pointwiseBlockSize,
+        (size_t) data.n_cols);
+    SearchBlock(data, order.subvec(begin, end - 1), uf);
   }
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning number of clusters
- * and also the list of cluster assignments.  This can perform search in batch,
- * naive search).
+ * Performs DBSCAN clustering on the data by searching large blocks of points at
+ * once, so it is well suited for dual-tree or naive search.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
 void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const MatType& data,
-    emst::UnionFind& uf)
+    const arma::uvec& order,
+    emst::ConcurrentUnionFind& uf)
 {
-  // For each point, find the points in epsilon-nighborhood and their distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
+  // Only the neighborhoods of one block of points are held in memory at once.
+  const size_t step = (blockSize == 0) ? data.n_cols : blockSize;
   Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
-  rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
+  for (size_t begin = 0; begin < data.n_cols; begin += step)
+  {
+    const size_t end = std::min(begin + step, (size_t) data.n_cols);
+    SearchBlock(data, order.subvec(begin, end - 1), uf);
+  }
   Log::Info << "Range search complete." << std::endl;
+}
 
-  // Now loop over all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+/**
+ * Search for the neighbors of the given points, and union each point with all
+ * of its neighbors.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+template<typename MatType>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::SearchBlock(
+    const MatType& data,
+    const arma::uvec& indices,
+    emst::ConcurrentUnionFind& uf)
+{
+  MatType block(data.n_rows, indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    block.col(i) = data.col(indices[i]);
+
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  rangeSearch.Search(block, math::Range(0.0, epsilon), neighbors, distances);
+
+  // Union to all neighbors.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < (size_t) indices.n_elem; ++i)
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+      uf.Union(indices[i], neighbors[i][j]);
+}
+
+/**
+ * Performs DBSCAN clustering on the data with the grid-based algorithm.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+template<typename MatType>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::GridCluster(
+    const MatType& data,
+    emst::ConcurrentUnionFind& uf)
+{
+  const size_t d = data.n_rows;
+  if (d > 6)
+  {
+    std::ostringstream oss;
+    oss << "DBSCAN::Cluster(): the grid-based algorithm only supports data with"
+        << " at most 6 dimensions, but the data has " << d << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The cells have a diagonal of epsilon, so all points in a cell are
+  // neighbors.
+  const double side = epsilon / std::sqrt((double) d);
+  arma::imat coords(d, data.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    for (size_t k = 0; k < d; ++k)
+      coords(k, i) = (arma::sword) std::floor(data(k, i) / side);
+
+  // Sort the points by cell, so that each cell is a range of the sorted
+  // points.
+  auto cellLess = [d](const arma::sword* a, const arma::sword* b)
+  {
+    return std::lexicographical_compare(a, a + d, b, b + d);
+  };
+  std::vector<size_t> order(data.n_cols);
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b)
+      { return cellLess(coords.colptr(a), coords.colptr(b)); });
+
+  std::vector<size_t> cellStart;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (i == 0 || cellLess(coords.colptr(order[i - 1]),
+                           coords.colptr(order[i])))
+      cellStart.push_back(i);
+  }
+  const size_t numCells = cellStart.size();
+  cellStart.push_back(order.size());
+
+  // Points in two cells can only be neighbors if the cell coordinates differ
+  // by at most ceil(sqrt(d)) in each dimension.  Only keep the offsets whose
+  // first nonzero coordinate is positive, so each pair of cells is only
+  // checked once, and whose cells are close enough: the gap between the cells
+  // is at least (|offset| - 1) * side in each dimension.
+  const arma::sword radius = (arma::sword) std::ceil(std::sqrt((double) d));
+  const size_t width = 2 * radius + 1;
+  const size_t numOffsets = (size_t) std::pow((double) width, (double) d);
+  std::vector<arma::Col<arma::sword>> offsets;
+  for (size_t o = 0; o < numOffsets; ++o)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    for (size_t j = 0; j < neighbors[index].size(); ++j)
-      uf.Union(index, neighbors[index][j]);
+    arma::Col<arma::sword> offset(d);
+    size_t code = o;
+    for (size_t k = 0; k < d; ++k)
+    {
+      offset[k] = (arma::sword) (code % width) - radius;
+      code /= width;
+    }
+
+    const arma::uvec nonzero = arma::find(offset != 0, 1);
+    if (nonzero.n_elem == 0 || offset[nonzero[0]] < 0)
+      continue;
+
+    arma::sword gap = 0;
+    for (size_t k = 0; k < d; ++k)
+    {
+      const arma::sword g = std::max(std::abs(offset[k]) - 1,
+          (arma::sword) 0);
+      gap += g * g;
+    }
+    if (gap <= (arma::sword) d)
+      offsets.push_back(std::move(offset));
+  }
+
+  // First, union all points in the same cell.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+    for (size_t i = cellStart[c] + 1; i < cellStart[c + 1]; ++i)
+      uf.Union(order[cellStart[c]], order[i]);
+
+  // Then, union neighboring cells that contain at least one pair of points
+  // within epsilon of each other.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    const size_t first = order[cellStart[c]];
+    arma::Col<arma::sword> target(d);
+    for (size_t o = 0; o < offsets.size(); ++o)
+    {
+      target = coords.col(first) + offsets[o];
+
+      // Find the cell with these coordinates, if it is not empty.
+      size_t lo = 0, hi = numCells;
+      while (lo < hi)
+      {
+        const size_t mid = (lo + hi) / 2;
+        if (cellLess(coords.colptr(order[cellStart[mid]]), target.memptr()))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo == numCells || cellLess(target.memptr(),
+          coords.colptr(order[cellStart[lo]])))
+        continue;
+
+      // Nothing to do if the cells are already in the same component.
+      const size_t otherFirst = order[cellStart[lo]];
+      if (uf.Find(first) == uf.Find(otherFirst))
+        continue;
+
+      bool found = false;
+      for (size_t i = cellStart[c]; i < cellStart[c + 1] && !found; ++i)
+      {
+        for (size_t j = cellStart[lo]; j < cellStart[lo + 1]; ++j)
+        {
+          if (metric::EuclideanDistance::Evaluate(data.col(order[i]),
+              data.col(order[j])) <= epsilon)
+          {
+            found = true;
+            break;
+          }
+        }
+      }
+
+      if (found)
+        uf.Union(first, otherFirst);
+    }
   }
 }
 
@@ -61,7 +61,13 @@ BINDING_LONG_DESC(
     " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball'. The " +
     PRINT_PARAM_STRING("single_mode") + " parameter will force single-tree "
     "search (as opposed to the default dual-tree search), and '" +
-    PRINT_PARAM_STRING("naive") + " will force brute-force range search.");
+    PRINT_PARAM_STRING("naive") + " will force brute-force range search.  The "
+    "range searches and the merging of clusters are done in parallel."
+    "\n\n"
+    "For data with few dimensions (at most 6, but it is most efficient for "
+    "2 to 4), the " + PRINT_PARAM_STRING("grid") + " parameter will use a "
+    "grid-based algorithm with the Euclidean distance instead of range "
+    "search.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -96,6 +102,8 @@ PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_FLAG("grid", "If set, a grid-based algorithm will be used instead of "
+    "range search (only for data with at most 6 dimensions).", "g");
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType, typename PointSelectionPolicy>
@@ -114,6 +122,14 @@ void RunDBSCAN(util::Params& params,
 
   DBSCAN<RangeSearchType, PointSelectionPolicy> d(epsilon, minSize,
       !params.Has("single_mode"), rs, pointSelector);
+  d.GridMode() = params.Has("grid");
+
+  if (d.GridMode() && dataset.n_rows > 6)
+  {
+    Log::Fatal << "The grid-based algorithm (" << PRINT_PARAM_STRING("grid")
+        << ") only supports data with at most 6 dimensions, but the data has "
+        << dataset.n_rows << " dimensions!" << std::endl;
+  }
 
   // If possible, avoid the overhead of calculating centroids.
   if (params.Has("centroids"))
@@ -152,6 +168,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
       "no output will be saved");
 
   ReportIgnoredParam(params, {{ "naive", true }}, "single_mode");
+  ReportIgnoredParam(params, {{ "grid", true }}, "single_mode");
+  ReportIgnoredParam(params, {{ "grid", true }}, "naive");
+  ReportIgnoredParam(params, {{ "grid", true }}, "tree_type");
 
   RequireParamInSet<string>(params, "tree_type", { "kd", "cover", "r", "r-star",
       "x", "hilbert-r", "r-plus", "r-plus-plus", "ball" }, true,
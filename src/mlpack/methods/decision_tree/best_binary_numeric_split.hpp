@@ -181,6 +181,30 @@ class BestBinaryNumericSplit
       const ElemType& point,
       const double& splitInfo,
       const AuxiliarySplitInfo& /* aux */);
+
+ private:
+  /**
+   * Return the indices that sort the given values, with a comparison sort.
+   *
+   * @param data Values to sort.
+   */
+  template<typename VecType>
+  static typename std::enable_if<
+      !std::is_integral<typename VecType::elem_type>::value, arma::uvec>::type
+  SortIndex(const VecType& data);
+
+  /**
+   * Return the indices that sort the given integer values.  If they are in a
+   * range that is not much larger than their number (for instance the ranks
+   * that RandomForest trains on), they are sorted by counting in linear time;
+   * otherwise, a comparison sort is used.
+   *
+   * @param data Values to sort.
+   */
+  template<typename VecType>
+  static typename std::enable_if<
+      std::is_integral<typename VecType::elem_type>::value, arma::uvec>::type
+  SortIndex(const VecType& data);
 };
 
 } // namespace tree
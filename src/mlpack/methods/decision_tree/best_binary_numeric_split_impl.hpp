@@ -36,7 +36,7 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<size_t> sortedLabels(labels.n_elem);
   arma::rowvec sortedWeights;
   for (size_t i = 0; i < sortedLabels.n_elem; ++i)
@@ -213,7 +213,7 @@ BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<RType> sortedResponses(responses.n_elem);
   arma::Row<WType> sortedWeights;
   for (size_t i = 0; i < sortedResponses.n_elem; ++i)
@@ -352,7 +352,7 @@ BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<RType> sortedResponses(responses.n_elem);
   arma::Row<WType> sortedWeights;
   for (size_t i = 0; i < sortedResponses.n_elem; ++i)
@@ -482,6 +482,46 @@ size_t BestBinaryNumericSplit<FitnessFunction>::CalculateDirection(
     return 1; // Go right.
 }
 
+template<typename FitnessFunction>
+template<typename VecType>
+typename std::enable_if<
+    !std::is_integral<typename VecType::elem_type>::value, arma::uvec>::type
+BestBinaryNumericSplit<FitnessFunction>::SortIndex(const VecType& data)
+{
+  return arma::sort_index(data);
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+typename std::enable_if<
+    std::is_integral<typename VecType::elem_type>::value, arma::uvec>::type
+BestBinaryNumericSplit<FitnessFunction>::SortIndex(const VecType& data)
+{
+  // Small sets are not worth checking.
+  const size_t n = data.n_elem;
+  if (n < 64)
+    return arma::sort_index(data);
+
+  const size_t minValue = (size_t) arma::min(data);
+  const size_t maxValue = (size_t) arma::max(data);
+  if (maxValue - minValue >= 2 * n)
+    return arma::sort_index(data);
+
+  // Counting sort: find where each value starts, then place every point.
+  const size_t range = maxValue - minValue + 1;
+  arma::uvec offsets(range + 1, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+    ++offsets[(size_t) data[i] - minValue + 1];
+  for (size_t v = 1; v <= range; ++v)
+    offsets[v] += offsets[v - 1];
+
+  arma::uvec sortedIndices(n);
+  for (size_t i = 0; i < n; ++i)
+    sortedIndices[offsets[(size_t) data[i] - minValue]++] = i;
+
+  return sortedIndices;
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,208 @@
+/**
+ * @file methods/decision_tree/compiled_decision_tree.hpp
+ *
+ * A flattened, read-only copy of a trained DecisionTree, laid out for fast
+ * classification of many points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_COMPILED_DECISION_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_COMPILED_DECISION_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A CompiledDecisionTree is built from a trained DecisionTree and gives the
+ * same predictions, but its nodes are stored in contiguous arrays (one array
+ * per node attribute) instead of as linked heap-allocated objects.  The nodes
+ * are numbered in breadth-first order, so that the children of each node are
+ * contiguous and are found from the index of the first child, and the class
+ * probabilities of all leaves are the columns of a single matrix.
+ *
+ * The points are classified in blocks of BlockSize points: all points of a
+ * block go down the tree together, one level at a time, which keeps the top
+ * of the tree in cache and gives the compiler simple loops over the block.
+ * Blocks are classified in parallel with OpenMP.
+ *
+ * The compiled tree is a snapshot: it must be rebuilt if the original tree is
+ * modified or retrained.
+ *
+ * @code
+ * DecisionTree<> tree(data, labels, numClasses);
+ * CompiledDecisionTree<DecisionTree<>> compiledTree(tree);
+ * compiledTree.Classify(testData, predictions, probabilities);
+ * @endcode
+ *
+ * @tparam DecisionTreeType Type of the decision tree to compile.
+ */
+template<typename DecisionTreeType>
+class CompiledDecisionTree
+{
+ public:
+  //! The numeric split type of the tree.
+  typedef typename DecisionTreeType::NumericSplit NumericSplit;
+  //! The categorical split type of the tree.
+  typedef typename DecisionTreeType::CategoricalSplit CategoricalSplit;
+  //! The auxiliary split information of numeric splits.
+  typedef typename NumericSplit::AuxiliarySplitInfo NumericAuxiliarySplitInfo;
+  //! The auxiliary split information of categorical splits.
+  typedef typename CategoricalSplit::AuxiliarySplitInfo
+      CategoricalAuxiliarySplitInfo;
+
+  //! The number of points that go down the tree together.
+  static const size_t BlockSize = 64;
+
+  /**
+   * Create an empty compiled tree.  Compile() must be called before the tree
+   * can classify points.
+   */
+  CompiledDecisionTree() : numClasses(0) { }
+
+  /**
+   * Compile the given trained decision tree.
+   *
+   * @param tree Trained decision tree.
+   */
+  CompiledDecisionTree(const DecisionTreeType& tree) { Compile(tree); }
+
+  /**
+   * Compile the given trained decision tree, replacing anything that was
+   * previously compiled.
+   *
+   * @param tree Trained decision tree.
+   */
+  void Compile(const DecisionTreeType& tree);
+
+  /**
+   * Classify the given point.  The predicted label is returned.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point and also return estimates of the probability for
+   * each class in the given vector.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points.  The predicted labels for each point are stored
+   * in the given vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return estimates of the probabilities
+   * for each class in the given matrix.  The predicted labels for each point
+   * are stored in the given vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for each
+   *      point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  /**
+   * Find the leaf reached by each point of the given range of columns of the
+   * dataset.  At most BlockSize points should be given at once.
+   *
+   * @param data Dataset.
+   * @param begin Index of the first point.
+   * @param count Number of points.
+   * @param leaves Index of the leaf of each point (output); it must have room
+   *      for count elements.
+   */
+  template<typename MatType>
+  void FindLeaves(const MatType& data,
+                  const size_t begin,
+                  const size_t count,
+                  size_t* leaves) const;
+
+  //! Get the number of nodes.
+  size_t NumNodes() const { return numChildren.size(); }
+  //! Get the number of leaves.
+  size_t NumLeaves() const { return leafClasses.size(); }
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the predicted class of each leaf.
+  const std::vector<size_t>& LeafClasses() const { return leafClasses; }
+  //! Get the class probabilities of each leaf (one column per leaf).
+  const arma::mat& LeafProbabilities() const { return leafProbabilities; }
+
+ private:
+  //! The dimension each internal node splits on.
+  std::vector<size_t> splitDimensions;
+  //! The split information of each internal node (the threshold, for binary
+  //! numeric splits).
+  std::vector<double> splitInfo;
+  //! Whether each internal node splits on a categorical dimension.
+  std::vector<char> categorical;
+  //! The number of children of each node (0 for leaves).
+  std::vector<size_t> numChildren;
+  //! For internal nodes, the index of the first child; for leaves, the index
+  //! of the leaf.
+  std::vector<size_t> childOffsets;
+  //! The auxiliary numeric split information of each node.
+  std::vector<NumericAuxiliarySplitInfo> numericAux;
+  //! The auxiliary categorical split information of each node.
+  std::vector<CategoricalAuxiliarySplitInfo> categoricalAux;
+
+  //! The predicted class of each leaf.
+  std::vector<size_t> leafClasses;
+  //! The class probabilities of each leaf.
+  arma::mat leafProbabilities;
+  //! The number of classes.
+  size_t numClasses;
+
+  /**
+   * Return the index of the child of the given internal node that the given
+   * value goes to.
+   */
+  template<typename ElemType>
+  size_t Child(const size_t node, const ElemType& value) const
+  {
+    if (categorical[node])
+    {
+      return childOffsets[node] + CategoricalSplit::CalculateDirection(value,
+          splitInfo[node], categoricalAux[node]);
+    }
+    else
+    {
+      return childOffsets[node] + NumericSplit::CalculateDirection(value,
+          splitInfo[node], numericAux[node]);
+    }
+  }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "compiled_decision_tree_impl.hpp"
+
+#endif
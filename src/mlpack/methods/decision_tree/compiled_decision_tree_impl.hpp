@@ -0,0 +1,187 @@
+/**
+ * @file methods/decision_tree/compiled_decision_tree_impl.hpp
+ *
+ * Implementation of CompiledDecisionTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_COMPILED_DECISION_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_COMPILED_DECISION_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compiled_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename DecisionTreeType>
+void CompiledDecisionTree<DecisionTreeType>::Compile(
+    const DecisionTreeType& tree)
+{
+  splitDimensions.clear();
+  splitInfo.clear();
+  categorical.clear();
+  numChildren.clear();
+  childOffsets.clear();
+  numericAux.clear();
+  categoricalAux.clear();
+  leafClasses.clear();
+  numClasses = tree.NumClasses();
+
+  // Number the nodes in breadth-first order, so that the children of each node
+  // are contiguous.
+  std::vector<const DecisionTreeType*> nodes(1, &tree);
+  std::vector<const DecisionTreeType*> leaves;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const DecisionTreeType& node = *nodes[i];
+    numChildren.push_back(node.NumChildren());
+    numericAux.push_back(node);
+    categoricalAux.push_back(node);
+
+    if (node.NumChildren() == 0)
+    {
+      splitDimensions.push_back(0);
+      splitInfo.push_back(0.0);
+      categorical.push_back(0);
+      childOffsets.push_back(leaves.size());
+      leaves.push_back(&node);
+      continue;
+    }
+
+    splitDimensions.push_back(node.splitDimension);
+    splitInfo.push_back(node.classProbabilities[0]);
+    categorical.push_back((data::Datatype) node.dimensionType ==
+        data::Datatype::categorical);
+    childOffsets.push_back(nodes.size());
+    for (size_t j = 0; j < node.NumChildren(); ++j)
+      nodes.push_back(&node.Child(j));
+  }
+
+  leafClasses.resize(leaves.size());
+  leafProbabilities.set_size(numClasses, leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    leafClasses[i] = leaves[i]->majorityClass;
+    leafProbabilities.col(i) = leaves[i]->classProbabilities;
+  }
+}
+
+template<typename DecisionTreeType>
+template<typename VecType>
+size_t CompiledDecisionTree<DecisionTreeType>::Classify(
+    const VecType& point) const
+{
+  size_t node = 0;
+  while (numChildren[node] != 0)
+    node = Child(node, point[splitDimensions[node]]);
+
+  return leafClasses[childOffsets[node]];
+}
+
+template<typename DecisionTreeType>
+template<typename VecType>
+void CompiledDecisionTree<DecisionTreeType>::Classify(
+    const VecType& point,
+    size_t& prediction,
+    arma::vec& probabilities) const
+{
+  size_t node = 0;
+  while (numChildren[node] != 0)
+    node = Child(node, point[splitDimensions[node]]);
+
+  prediction = leafClasses[childOffsets[node]];
+  probabilities = leafProbabilities.col(childOffsets[node]);
+}
+
+template<typename DecisionTreeType>
+template<typename MatType>
+void CompiledDecisionTree<DecisionTreeType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(data.n_cols);
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t count = std::min((size_t) BlockSize,
+        (size_t) data.n_cols - begin);
+
+    size_t leaves[BlockSize];
+    FindLeaves(data, begin, count, leaves);
+    for (size_t i = 0; i < count; ++i)
+      predictions[begin + i] = leafClasses[leaves[i]];
+  }
+}
+
+template<typename DecisionTreeType>
+template<typename MatType>
+void CompiledDecisionTree<DecisionTreeType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions,
+    arma::mat& probabilities) const
+{
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(numClasses, data.n_cols);
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t count = std::min((size_t) BlockSize,
+        (size_t) data.n_cols - begin);
+
+    size_t leaves[BlockSize];
+    FindLeaves(data, begin, count, leaves);
+    for (size_t i = 0; i < count; ++i)
+    {
+      predictions[begin + i] = leafClasses[leaves[i]];
+      probabilities.col(begin + i) = leafProbabilities.col(leaves[i]);
+    }
+  }
+}
+
+template<typename DecisionTreeType>
+template<typename MatType>
+void CompiledDecisionTree<DecisionTreeType>::FindLeaves(
+    const MatType& data,
+    const size_t begin,
+    const size_t count,
+    size_t* leaves) const
+{
+  // All points start at the root, and go down one level at a time, until all
+  // of them have reached a leaf.
+  size_t nodes[BlockSize];
+  for (size_t i = 0; i < count; ++i)
+    nodes[i] = 0;
+
+  bool moving = (numChildren[0] != 0);
+  while (moving)
+  {
+    moving = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const size_t node = nodes[i];
+      if (numChildren[node] == 0)
+        continue;
+
+      nodes[i] = Child(node, data(splitDimensions[node], begin + i));
+      moving = true;
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i)
+    leaves[i] = childOffsets[nodes[i]];
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
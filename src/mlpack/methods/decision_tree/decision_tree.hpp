@@ -32,6 +32,11 @@
 namespace mlpack {
 namespace tree {
 
+// Forward declarations for the friend declarations below.
+template<typename DecisionTreeType>
+class CompiledDecisionTree;
+class SortedFeatureIndex;
+
 /**
  * This class implements a generic decision tree learner.  Its behavior can be
  * controlled via its template arguments.
@@ -404,6 +409,40 @@ class DecisionTree :
                const std::enable_if_t<arma::is_arma_type<typename
                    std::remove_reference<WeightsType>::type>::value>* = 0);
 
+  /**
+   * Train the decision tree on some of the points of the given dataset, without
+   * copying or modifying the dataset: only the indices of the points are
+   * reordered.  This allows many trees to train at once on the same dataset
+   * (RandomForest does this).  This will overwrite the given model.
+   *
+   * @tparam UseWeights Whether or not to use the weights.
+   * @tparam UseDatasetInfo Whether or not to use the dimension information
+   *      (otherwise all dimensions are numeric).
+   * @param data Dataset to train on.
+   * @param datasetInfo Type information for each dimension (may be ignored).
+   * @param points Indices of the points to train on.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weight of each point of the dataset (may be ignored).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+  double TrainOnPoints(const MatType& data,
+                       const data::DatasetInfo& datasetInfo,
+                       arma::uvec points,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const arma::rowvec& weights,
+                       const size_t minimumLeafSize = 10,
+                       const double minimumGainSplit = 1e-7,
+                       const size_t maximumDepth = 0,
+                       DimensionSelectionType dimensionSelector =
+                           DimensionSelectionType());
+
   /**
    * Classify the given point, using the entire tree.  The predicted label is
    * returned.
@@ -487,6 +526,12 @@ class DecisionTree :
   size_t NumClasses() const;
 
  private:
+  //! Allow the compiled tree to read the nodes.
+  template<typename DecisionTreeType>
+  friend class CompiledDecisionTree;
+  //! Allow the split points of trees trained on ranks to be restored.
+  friend class SortedFeatureIndex;
+
   //! The vector of children.
   std::vector<DecisionTree*> children;
   //! The dimension this node splits on.
@@ -582,6 +627,38 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Corresponding to the public TrainOnPoints() method, this method is called
+   * for training children.  The labels and weights are those of the points in
+   * the points vector, and are reordered with it.
+   *
+   * @param data Dataset to train on.
+   * @param points Indices of the points of the tree.
+   * @param begin Index in points of the first point of this node.
+   * @param count Number of points in this node.
+   * @param datasetInfo Type information for each dimension (may be ignored).
+   * @param labels Labels for each point in points.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point in points (may be ignored).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+  double TrainOnPoints(const MatType& data,
+                       arma::uvec& points,
+                       const size_t begin,
+                       const size_t count,
+                       const data::DatasetInfo& datasetInfo,
+                       arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       arma::rowvec& weights,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       const size_t maximumDepth,
+                       DimensionSelectionType& dimensionSelector);
 };
 
 /**
@@ -615,4 +692,7 @@ typedef DecisionTree<InformationGain,
 // Also include the DecisionTreeRegressor.
 #include "decision_tree_regressor.hpp"
 
+// Also include the compiled decision tree.
+#include "compiled_decision_tree.hpp"
+
 #endif
@@ -837,7 +837,70 @@ double DecisionTree<FitnessFunction,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = data.n_rows; // This means "no split".
 
-  if (maximumDepth != 1)
+  // Decision stumps (such as the weak learners of AdaBoost) have only one node,
+  // which holds all the points, so for them the dimensions are searched in
+  // parallel.  This is only done with BestBinaryNumericSplit, because other
+  // splitters may draw random numbers, and the results would then depend on
+  // the thread schedule.
+  bool parallelSearch = false;
+  #ifdef MLPACK_USE_OPENMP
+    parallelSearch = NoRecursion && (count >= 1024) &&
+        (omp_get_max_threads() > 1) &&
+        std::is_same<NumericSplitType<FitnessFunction>,
+                     BestBinaryNumericSplit<FitnessFunction>>::value;
+  #endif
+
+  if (maximumDepth != 1 && parallelSearch)
+  {
+    std::vector<size_t> dimensions;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // Each dimension is searched against the gain of the node only.
+    const double nodeGain = bestGain;
+    arma::vec dimGains(dimensions.size());
+    std::vector<arma::vec> dimSplitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> dimAux(dimensions.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      dimGains[d] = NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(nodeGain,
+                                    data.cols(begin, begin + count - 1).row(
+                                        dimensions[d]),
+                                    labels.cols(begin, begin + count - 1),
+                                    numClasses,
+                                    UseWeights ?
+                                        weights.cols(begin, begin + count - 1) :
+                                        weights,
+                                    minimumLeafSize,
+                                    minimumGainSplit,
+                                    dimSplitInfo[d],
+                                    dimAux[d]);
+    }
+
+    // Merge the results in order, keeping a dimension only if it improves on
+    // the dimensions before it as a serial search would: by more than
+    // minimumGainSplit, unless it reaches the best possible gain.
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (dimGains[d] == DBL_MAX || (dimGains[d] < 0.0 &&
+          dimGains[d] <= std::min(bestGain + minimumGainSplit, 0.0)))
+        continue;
+
+      bestDim = dimensions[d];
+      bestGain = dimGains[d];
+      classProbabilities = std::move(dimSplitInfo[d]);
+      NumericAuxiliarySplitInfo::operator=(dimAux[d]);
+
+      // If the gain is the best possible, no later dimension can improve.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+  else if (maximumDepth != 1)
   {
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
@@ -952,6 +1015,239 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
+//! Train on the given points of a dataset that is not modified.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainOnPoints(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    arma::uvec points,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(data, labels, "DecisionTree::TrainOnPoints()");
+  if (UseWeights)
+  {
+    util::CheckSameSizes(data, weights, "DecisionTree::TrainOnPoints()",
+        "weights");
+  }
+
+  // Only the labels and weights of the points are copied, so that they can be
+  // reordered with the points.
+  arma::Row<size_t> pointLabels = labels.cols(points);
+  arma::rowvec pointWeights;
+  if (UseWeights)
+    pointWeights = weights.cols(points);
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Pass off work to the TrainOnPoints() method.
+  return TrainOnPoints<UseWeights, UseDatasetInfo>(data, points, 0,
+      points.n_elem, datasetInfo, pointLabels, numClasses, pointWeights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
+//! Train on the given points of a dataset that is not modified.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainOnPoints(
+    const MatType& data,
+    arma::uvec& points,
+    const size_t begin,
+    const size_t count,
+    const data::DatasetInfo& datasetInfo,
+    arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Look through the list of dimensions and obtain the gain of the best split,
+  // as in Train().
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(
+      labels.subvec(begin, begin + count - 1),
+      numClasses,
+      UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  size_t bestDim = data.n_rows; // This means "no split".
+
+  if (maximumDepth != 1)
+  {
+    // The points of the node are not contiguous in the dataset, so their
+    // values in each dimension are gathered first.
+    arma::Row<ElemType> values(count);
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+    {
+      for (size_t j = 0; j < count; ++j)
+        values[j] = data(i, points[begin + j]);
+
+      double dimGain = DBL_MAX;
+      if (UseDatasetInfo &&
+          datasetInfo.Type(i) == data::Datatype::categorical)
+      {
+        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+            values,
+            datasetInfo.NumMappings(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            classProbabilities,
+            *this);
+      }
+      else
+      {
+        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+            values,
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            classProbabilities,
+            *this);
+      }
+
+      // If the splitter reported that it did not split, move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      bestDim = i;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  // Did we split or not?  If so, then split the points and create the
+  // children.
+  if (bestDim != data.n_rows)
+  {
+    const bool categorical = UseDatasetInfo &&
+        datasetInfo.Type(bestDim) == data::Datatype::categorical;
+    dimensionType = (size_t) (categorical ? data::Datatype::categorical :
+        data::Datatype::numeric);
+    splitDimension = bestDim;
+
+    const size_t numChildren = categorical ?
+        CategoricalSplit::NumChildren(classProbabilities[0], *this) :
+        NumericSplit::NumChildren(classProbabilities[0], *this);
+
+    // Calculate all child assignments.
+    arma::Row<size_t> childAssignments(count);
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      const ElemType value = data(bestDim, points[j]);
+      childAssignments[j - begin] = categorical ?
+          CategoricalSplit::CalculateDirection(value, classProbabilities[0],
+              *this) :
+          NumericSplit::CalculateDirection(value, classProbabilities[0],
+              *this);
+    }
+
+    // Figure out counts of children.
+    arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
+    for (size_t j = 0; j < count; ++j)
+      childCounts[childAssignments[j]]++;
+
+    // Initialize bestGain if recursive split is allowed.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+    }
+
+    // Split into children; only the indices of the points (and their labels
+    // and weights) are moved.
+    size_t currentCol = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      size_t currentChildBegin = currentCol;
+      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      {
+        if (childAssignments[j - begin] == i)
+        {
+          childAssignments.swap_cols(currentCol - begin, j - begin);
+          points.swap_rows(currentCol, j);
+          labels.swap_cols(currentCol, j);
+          if (UseWeights)
+            weights.swap_cols(currentCol, j);
+          ++currentCol;
+        }
+      }
+
+      // Now build the child recursively.
+      DecisionTree* child = new DecisionTree();
+      if (NoRecursion)
+      {
+        child->TrainOnPoints<UseWeights, UseDatasetInfo>(data, points,
+            currentChildBegin, currentCol - currentChildBegin, datasetInfo,
+            labels, numClasses, weights, currentCol - currentChildBegin,
+            minimumGainSplit, maximumDepth - 1, dimensionSelector);
+      }
+      else
+      {
+        // During recursion entropy of child node may change.
+        double childGain = child->TrainOnPoints<UseWeights, UseDatasetInfo>(
+            data, points, currentChildBegin, currentCol - currentChildBegin,
+            datasetInfo, labels, numClasses, weights, minimumLeafSize,
+            minimumGainSplit, maximumDepth - 1, dimensionSelector);
+        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+      }
+      children.push_back(child);
+    }
+  }
+  else
+  {
+    // Clear auxiliary info objects.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+    CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(
+        labels.subvec(begin, begin + count - 1),
+        numClasses,
+        UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  }
+
+  return -bestGain;
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -287,7 +287,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
     arma::Row<size_t> predictions;
     arma::mat probabilities;
 
-    model->tree.Classify(testPoints, predictions, probabilities);
+    // Classify with a flattened copy of the tree.
+    CompiledDecisionTree<DecisionTree<>> compiledTree(model->tree);
+    compiledTree.Classify(testPoints, predictions, probabilities);
 
     // Do we need to calculate accuracy?
     if (params.Has("test_labels"))
@@ -0,0 +1,11 @@
+/**
+ * @file elastic_net.hpp
+ *
+ * Convenience include for mlpack/methods/elastic_net/elastic_net.hpp
+ */
+#ifndef MLPACK_ELASTIC_NET_HPP
+#define MLPACK_ELASTIC_NET_HPP
+
+#include "elastic_net/elastic_net.hpp"
+
+#endif
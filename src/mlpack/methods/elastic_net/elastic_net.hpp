@@ -0,0 +1,345 @@
+/**
+ * @file methods/elastic_net/elastic_net.hpp
+ *
+ * Definition of the ElasticNet class, which solves l1 (LASSO) and l1+l2
+ * (Elastic Net) regularized linear regression by coordinate descent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * An implementation of coordinate descent for l1-regularized linear regression
+ * (LASSO) and l1+l2 regularized linear regression (Elastic Net).  It solves the
+ * same problem as LARS,
+ *
+ * \f[ \min_{\beta} 0.5 || X \beta - y ||_2^2 + \lambda_1 || \beta ||_1 +
+ *     0.5 \lambda_2 || \beta ||_2^2 \f]
+ *
+ * but it never forms the Gram matrix \f$ X^T X \f$ and it does not factorize
+ * anything, so each pass over the dimensions costs only one product of the
+ * data with the residual.  It is suited to problems with many dimensions (100k
+ * or more), where LARS is not practical.
+ *
+ * The problem is solved for a decreasing sequence of values of
+ * \f$ \lambda_1 \f$ that ends at Lambda1(), and each solution is the starting
+ * point of the next one (a warm-started regularization path; see
+ * PathLength()).  For each value, the sequential strong rule discards the
+ * dimensions that are very likely to stay zero; coordinate descent runs on the
+ * remaining dimensions only, and the discarded dimensions are then checked
+ * against the optimality conditions and added back if they violate them.  The
+ * products of the data with the residual and the residual updates are computed
+ * in parallel.
+ *
+ * For more details, see the following papers:
+ *
+ * @code
+ * @article{friedman2010regularization,
+ *   title={Regularization paths for generalized linear models via coordinate
+ *       descent},
+ *   author={Friedman, J. and Hastie, T. and Tibshirani, R.},
+ *   journal={Journal of Statistical Software},
+ *   volume={33},
+ *   number={1},
+ *   pages={1--22},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * @code
+ * @article{tibshirani2012strong,
+ *   title={Strong rules for discarding predictors in lasso-type problems},
+ *   author={Tibshirani, R. and Bien, J. and Friedman, J. and Hastie, T. and
+ *       Simon, N. and Taylor, J. and Tibshirani, R. J.},
+ *   journal={Journal of the Royal Statistical Society Series B},
+ *   volume={74},
+ *   number={2},
+ *   pages={245--266},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * If a precomputed Gram matrix is given to the constructor, coordinate descent
+ * updates the correlations \f$ X^T (y - X \beta) \f$ with the columns of the
+ * Gram matrix instead of the residual.  This is faster when the same (small)
+ * set of dimensions is used to solve many problems, as when sparse coding many
+ * points on one dictionary.  The Gram matrix is not owned by the object and
+ * is not serialized.
+ *
+ * @code
+ * // Solve the LASSO with lambda1 = 0.1 on column-major data.
+ * ElasticNet en(0.1);
+ * arma::vec beta;
+ * en.Train(data, responses, beta);
+ * @endcode
+ */
+class ElasticNet
+{
+ public:
+  /**
+   * Set the parameters of the solver.  Both lambda1 and lambda2 default to 0.
+   *
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param maxIterations Maximum number of passes over the dimensions for each
+   *     value of lambda1 on the path (0 means no limit).
+   * @param tolerance Stop when the largest change of the objective caused by
+   *     a coordinate update during a pass is smaller than this, relative to
+   *     ||y||^2.
+   * @param pathLength Number of values of lambda1 on the regularization path
+   *     (1 means solve for lambda1 directly).
+   */
+  ElasticNet(const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const size_t maxIterations = 10000,
+             const double tolerance = 1e-10,
+             const size_t pathLength = 10);
+
+  /**
+   * Set the parameters of the solver, and pass in a precalculated Gram matrix
+   * that will be used by Train() instead of the data.  The Gram matrix must
+   * stay alive as long as the object is used.
+   *
+   * @param gramMatrix Gram matrix (X^T X, with one row and one column for each
+   *     dimension).
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param maxIterations Maximum number of passes over the dimensions for each
+   *     value of lambda1 on the path (0 means no limit).
+   * @param tolerance Stop when the largest change of the objective caused by
+   *     a coordinate update during a pass is smaller than this, relative to
+   *     ||y||^2.
+   * @param pathLength Number of values of lambda1 on the regularization path
+   *     (1 means solve for lambda1 directly).
+   */
+  ElasticNet(const arma::mat& gramMatrix,
+             const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const size_t maxIterations = 10000,
+             const double tolerance = 1e-10,
+             const size_t pathLength = 10);
+
+  /**
+   * Set the parameters of the solver and train it on the given data.
+   *
+   * @param data Input data.
+   * @param responses A vector of targets.
+   * @param transposeData Should be true if the input data is column-major and
+   *     false otherwise.
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param maxIterations Maximum number of passes over the dimensions for each
+   *     value of lambda1 on the path (0 means no limit).
+   * @param tolerance Stop when the largest change of the objective caused by
+   *     a coordinate update during a pass is smaller than this, relative to
+   *     ||y||^2.
+   * @param pathLength Number of values of lambda1 on the regularization path
+   *     (1 means solve for lambda1 directly).
+   */
+  ElasticNet(const arma::mat& data,
+             const arma::rowvec& responses,
+             const bool transposeData = true,
+             const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const size_t maxIterations = 10000,
+             const double tolerance = 1e-10,
+             const size_t pathLength = 10);
+
+  /**
+   * Solve the problem on the given data.  As with LARS, the data should be
+   * column-major (each column is an observation); it is transposed internally
+   * unless transposeData is false, in which case it must be row-major.  If a
+   * Gram matrix was given to the constructor, the data is only used to compute
+   * X^T y, and is never transposed.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData is false).
+   * @param responses A vector of targets.
+   * @param solution Vector to store the solution (the coefficients) in.
+   * @param transposeData Set to false if the data is row-major.
+   * @return The squared error ||y - X beta||^2 of the solution.
+   */
+  double Train(const arma::mat& data,
+               const arma::rowvec& responses,
+               arma::vec& solution,
+               const bool transposeData = true);
+
+  /**
+   * Solve the problem on the given data.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData is false).
+   * @param responses A vector of targets.
+   * @param transposeData Set to false if the data is row-major.
+   * @return The squared error ||y - X beta||^2 of the solution.
+   */
+  double Train(const arma::mat& data,
+               const arma::rowvec& responses,
+               const bool transposeData = true);
+
+  /**
+   * Solve the problem for each of the given values of lambda1, in order, each
+   * solution being the starting point of the next one.  The values should
+   * usually be decreasing.  The last solution is kept as the model.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData is false).
+   * @param responses A vector of targets.
+   * @param lambdas Values of lambda1.
+   * @param betas Matrix to store the solutions in (one column per value of
+   *     lambda1).
+   * @param transposeData Set to false if the data is row-major.
+   */
+  void TrainPath(const arma::mat& data,
+                 const arma::rowvec& responses,
+                 const arma::vec& lambdas,
+                 arma::mat& betas,
+                 const bool transposeData = true);
+
+  /**
+   * Compute the smallest value of lambda1 for which the solution is zero on
+   * the given data.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData is false).
+   * @param responses A vector of targets.
+   * @param transposeData Set to false if the data is row-major.
+   */
+  static double LambdaMax(const arma::mat& data,
+                          const arma::rowvec& responses,
+                          const bool transposeData = true);
+
+  /**
+   * Predict y_i for each data point in the given data matrix using the
+   * currently-trained model.
+   *
+   * @param points The data points to regress on.
+   * @param predictions y, which will contained calculated values on completion.
+   * @param rowMajor Should be true if the data points matrix is row-major and
+   *     false otherwise.
+   */
+  void Predict(const arma::mat& points,
+               arma::rowvec& predictions,
+               const bool rowMajor = false) const;
+
+  /**
+   * Compute the squared error ||y - X beta||^2 of the currently-trained model
+   * on the given data.
+   *
+   * @param data Column-major input data (or row-major input data if rowMajor
+   *     is true).
+   * @param responses A vector of targets.
+   * @param rowMajor Should be true if the data points matrix is row-major and
+   *     false otherwise.
+   */
+  double ComputeError(const arma::mat& data,
+                      const arma::rowvec& responses,
+                      const bool rowMajor = false) const;
+
+  //! Get the L1 regularization coefficient.
+  double Lambda1() const { return lambda1; }
+  //! Modify the L1 regularization coefficient.
+  double& Lambda1() { return lambda1; }
+
+  //! Get the L2 regularization coefficient.
+  double Lambda2() const { return lambda2; }
+  //! Modify the L2 regularization coefficient.
+  double& Lambda2() { return lambda2; }
+
+  //! Get the maximum number of passes for each value of lambda1.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of passes for each value of lambda1 (0 means
+  //! no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of values of lambda1 on the regularization path.
+  size_t PathLength() const { return pathLength; }
+  //! Modify the number of values of lambda1 on the regularization path.  The
+  //! values are spaced geometrically, from the smallest value for which the
+  //! solution is zero down to Lambda1().
+  size_t& PathLength() { return pathLength; }
+
+  //! Get whether the dimensions are visited in a random order.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the dimensions are visited in a random order in each pass
+  //! (randomized coordinate descent) instead of cyclically.
+  bool& Shuffle() { return shuffle; }
+
+  //! Access the solution coefficients.
+  const arma::vec& Beta() const { return beta; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Run coordinate descent for each value of lambda1, starting from zero.
+   *
+   * @param matX Row-major data (unused if there is a Gram matrix).
+   * @param y Responses.
+   * @param vecXTy X^T y.
+   * @param lambdas Values of lambda1.
+   * @param solution Solution for the last value of lambda1 (output).
+   * @param solutions If not NULL, the solution for each value of lambda1.
+   */
+  void SolvePath(const arma::mat& matX,
+                 const arma::vec& y,
+                 const arma::vec& vecXTy,
+                 const arma::vec& lambdas,
+                 arma::vec& solution,
+                 arma::mat* solutions) const;
+
+  //! Compute X^T y, and the data in row-major form if it is needed.
+  void Prepare(const arma::mat& data,
+               const arma::rowvec& responses,
+               const bool transposeData,
+               arma::mat& dataTrans,
+               arma::vec& vecXTy) const;
+
+  //! Subtract delta times the given column from v, in parallel if v is long.
+  static void SubtractScaled(arma::vec& v,
+                             const double delta,
+                             const double* column);
+
+  //! Regularization parameter for l1 penalty.
+  double lambda1;
+  //! Regularization parameter for l2 penalty.
+  double lambda2;
+  //! Maximum number of passes for each value of lambda1.
+  size_t maxIterations;
+  //! Tolerance for the passes.
+  double tolerance;
+  //! Number of values of lambda1 on the regularization path.
+  size_t pathLength;
+  //! Whether to visit the dimensions in a random order.
+  bool shuffle;
+
+  //! Pointer to the Gram matrix, if one was given.
+  const arma::mat* matGram;
+
+  //! The solution.
+  arma::vec beta;
+};
+
+} // namespace regression
+} // namespace mlpack
+
+// Include implementation.
+#include "elastic_net_impl.hpp"
+
+#endif
@@ -0,0 +1,354 @@
+/**
+ * @file methods/elastic_net/elastic_net_impl.hpp
+ *
+ * Implementation of coordinate descent for the LASSO and the Elastic Net.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "elastic_net.hpp"
+
+namespace mlpack {
+namespace regression {
+
+inline ElasticNet::ElasticNet(const double lambda1,
+                              const double lambda2,
+                              const size_t maxIterations,
+                              const double tolerance,
+                              const size_t pathLength) :
+    lambda1(lambda1),
+    lambda2(lambda2),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    pathLength(pathLength),
+    shuffle(false),
+    matGram(NULL)
+{
+  // Nothing to do.
+}
+
+inline ElasticNet::ElasticNet(const arma::mat& gramMatrix,
+                              const double lambda1,
+                              const double lambda2,
+                              const size_t maxIterations,
+                              const double tolerance,
+                              const size_t pathLength) :
+    lambda1(lambda1),
+    lambda2(lambda2),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    pathLength(pathLength),
+    shuffle(false),
+    matGram(&gramMatrix)
+{
+  // Nothing to do.
+}
+
+inline ElasticNet::ElasticNet(const arma::mat& data,
+                              const arma::rowvec& responses,
+                              const bool transposeData,
+                              const double lambda1,
+                              const double lambda2,
+                              const size_t maxIterations,
+                              const double tolerance,
+                              const size_t pathLength) :
+    ElasticNet(lambda1, lambda2, maxIterations, tolerance, pathLength)
+{
+  Train(data, responses, transposeData);
+}
+
+inline double ElasticNet::Train(const arma::mat& data,
+                                const arma::rowvec& responses,
+                                arma::vec& solution,
+                                const bool transposeData)
+{
+  arma::mat dataTrans;
+  arma::vec vecXTy;
+  Prepare(data, responses, transposeData, dataTrans, vecXTy);
+  // matX is row-major.
+  const arma::mat& matX = (dataTrans.n_elem > 0) ? dataTrans : data;
+
+  // The path starts at the smallest value of lambda1 for which the solution is
+  // zero, and its values are spaced geometrically.
+  const double lambdaMax = (vecXTy.n_elem > 0) ?
+      arma::max(arma::abs(vecXTy)) : 0.0;
+  arma::vec lambdas;
+  if (pathLength <= 1 || lambda1 >= lambdaMax)
+  {
+    lambdas.set_size(1);
+    lambdas[0] = lambda1;
+  }
+  else
+  {
+    lambdas = arma::exp(arma::linspace<arma::vec>(std::log(lambdaMax),
+        std::log(std::max(lambda1, 1e-4 * lambdaMax)), pathLength));
+    lambdas[pathLength - 1] = lambda1;
+  }
+
+  SolvePath(matX, responses.t(), vecXTy, lambdas, solution, NULL);
+  beta = solution;
+
+  return ComputeError(data, responses, !transposeData);
+}
+
+inline double ElasticNet::Train(const arma::mat& data,
+                                const arma::rowvec& responses,
+                                const bool transposeData)
+{
+  arma::vec solution;
+  return Train(data, responses, solution, transposeData);
+}
+
+inline void ElasticNet::TrainPath(const arma::mat& data,
+                                  const arma::rowvec& responses,
+                                  const arma::vec& lambdas,
+                                  arma::mat& betas,
+                                  const bool transposeData)
+{
+  arma::mat dataTrans;
+  arma::vec vecXTy;
+  Prepare(data, responses, transposeData, dataTrans, vecXTy);
+  const arma::mat& matX = (dataTrans.n_elem > 0) ? dataTrans : data;
+
+  SolvePath(matX, responses.t(), vecXTy, lambdas, beta, &betas);
+}
+
+inline double ElasticNet::LambdaMax(const arma::mat& data,
+                                    const arma::rowvec& responses,
+                                    const bool transposeData)
+{
+  const arma::vec vecXTy = transposeData ? arma::vec(data * responses.t()) :
+      arma::vec(arma::trans(responses * data));
+  return (vecXTy.n_elem > 0) ? arma::max(arma::abs(vecXTy)) : 0.0;
+}
+
+inline void ElasticNet::Predict(const arma::mat& points,
+                                arma::rowvec& predictions,
+                                const bool rowMajor) const
+{
+  if (rowMajor)
+    predictions = arma::trans(points * beta);
+  else
+    predictions = beta.t() * points;
+}
+
+inline double ElasticNet::ComputeError(const arma::mat& data,
+                                       const arma::rowvec& responses,
+                                       const bool rowMajor) const
+{
+  arma::rowvec predictions;
+  Predict(data, predictions, rowMajor);
+  return arma::accu(arma::square(responses - predictions));
+}
+
+inline void ElasticNet::SolvePath(const arma::mat& matX,
+                                  const arma::vec& y,
+                                  const arma::vec& vecXTy,
+                                  const arma::vec& lambdas,
+                                  arma::vec& solution,
+                                  arma::mat* solutions) const
+{
+  const size_t dimensionality = vecXTy.n_elem;
+  const bool useGram = (matGram != NULL);
+
+  solution.zeros(dimensionality);
+  if (solutions)
+    solutions->zeros(dimensionality, lambdas.n_elem);
+
+  // The squared norm of each dimension.
+  arma::vec sqNorms(dimensionality);
+  if (useGram)
+  {
+    sqNorms = matGram->diag();
+  }
+  else
+  {
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < dimensionality; ++j)
+      sqNorms[j] = arma::dot(matX.col(j), matX.col(j));
+  }
+
+  // Without a Gram matrix, we keep the residual y - X beta, and compute the
+  // correlations X^T (y - X beta) only when all dimensions are checked.  With a
+  // Gram matrix, the correlations are kept up to date instead.
+  arma::vec residual;
+  if (!useGram)
+    residual = y;
+  arma::vec correlations = vecXTy;
+
+  const double threshold = tolerance * arma::dot(y, y);
+  double lastLambda = (dimensionality > 0) ?
+      arma::max(arma::abs(vecXTy)) : 0.0;
+  std::vector<bool> isStrong(dimensionality);
+  std::vector<size_t> strongSet;
+  for (size_t l = 0; l < lambdas.n_elem; ++l)
+  {
+    const double lambda = lambdas[l];
+
+    // Sequential strong rule: only the nonzero dimensions and the dimensions
+    // that are correlated enough with the residual of the previous solution
+    // are optimized.
+    strongSet.clear();
+    for (size_t j = 0; j < dimensionality; ++j)
+    {
+      isStrong[j] = (solution[j] != 0.0 ||
+          std::abs(correlations[j]) >= 2.0 * lambda - lastLambda);
+      if (isStrong[j])
+        strongSet.push_back(j);
+    }
+
+    size_t iterations = 0;
+    while (true)
+    {
+      while (maxIterations == 0 || iterations < maxIterations)
+      {
+        ++iterations;
+
+        arma::uvec order = arma::conv_to<arma::uvec>::from(strongSet);
+        if (shuffle)
+          order = arma::shuffle(order);
+
+        double maxChange = 0.0;
+        for (size_t k = 0; k < order.n_elem; ++k)
+        {
+          const size_t j = order[k];
+          const double denominator = sqNorms[j] + lambda2;
+          if (denominator == 0.0)
+            continue;
+
+          const double correlation = useGram ? correlations[j] :
+              arma::dot(matX.col(j), residual);
+          const double z = correlation + sqNorms[j] * solution[j];
+          double newValue = 0.0;
+          if (z > lambda)
+            newValue = (z - lambda) / denominator;
+          else if (z < -lambda)
+            newValue = (z + lambda) / denominator;
+
+          const double delta = newValue - solution[j];
+          if (delta == 0.0)
+            continue;
+
+          solution[j] = newValue;
+          if (useGram)
+            SubtractScaled(correlations, delta, matGram->colptr(j));
+          else
+            SubtractScaled(residual, delta, matX.colptr(j));
+
+          maxChange = std::max(maxChange, denominator * delta * delta);
+        }
+
+        if (maxChange <= threshold)
+          break;
+      }
+
+      // Check the optimality conditions of the dimensions that were discarded.
+      if (!useGram)
+      {
+        #pragma omp parallel for schedule(static)
+        for (size_t j = 0; j < dimensionality; ++j)
+          correlations[j] = arma::dot(matX.col(j), residual);
+      }
+
+      bool violated = false;
+      for (size_t j = 0; j < dimensionality; ++j)
+      {
+        if (!isStrong[j] && std::abs(correlations[j]) > lambda)
+        {
+          isStrong[j] = true;
+          strongSet.push_back(j);
+          violated = true;
+        }
+      }
+
+      if (!violated || (maxIterations != 0 && iterations >= maxIterations))
+        break;
+    }
+
+    if (maxIterations != 0 && iterations >= maxIterations)
+    {
+      Log::Debug << "ElasticNet: reached the maximum number of iterations ("
+          << maxIterations << ") for lambda1 = " << lambda << "." << std::endl;
+    }
+
+    lastLambda = lambda;
+    if (solutions)
+      solutions->col(l) = solution;
+  }
+}
+
+inline void ElasticNet::Prepare(const arma::mat& data,
+                                const arma::rowvec& responses,
+                                const bool transposeData,
+                                arma::mat& dataTrans,
+                                arma::vec& vecXTy) const
+{
+  const size_t numPoints = transposeData ? data.n_cols : data.n_rows;
+  const size_t dimensionality = transposeData ? data.n_rows : data.n_cols;
+  if (responses.n_elem != numPoints)
+  {
+    std::ostringstream oss;
+    oss << "ElasticNet::Train(): number of responses (" << responses.n_elem
+        << ") does not match number of points (" << numPoints << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (matGram && (matGram->n_rows != dimensionality ||
+      matGram->n_cols != dimensionality))
+  {
+    std::ostringstream oss;
+    oss << "ElasticNet::Train(): Gram matrix has size " << matGram->n_rows
+        << "x" << matGram->n_cols << ", but the data has " << dimensionality
+        << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (transposeData)
+  {
+    vecXTy = data * responses.t();
+    // Coordinate descent reads the data one dimension at a time.
+    if (!matGram)
+      dataTrans = arma::trans(data);
+  }
+  else
+  {
+    vecXTy = arma::trans(responses * data);
+  }
+}
+
+inline void ElasticNet::SubtractScaled(arma::vec& v,
+                                       const double delta,
+                                       const double* column)
+{
+  // Threads only pay off for long vectors.
+  #pragma omp parallel for schedule(static) if (v.n_elem >= 10000)
+  for (size_t i = 0; i < (size_t) v.n_elem; ++i)
+    v[i] -= delta * column[i];
+}
+
+template<typename Archive>
+void ElasticNet::serialize(Archive& ar, const uint32_t /* version */)
+{
+  // The Gram matrix is not owned by the object.
+  if (cereal::is_loading<Archive>())
+    matGram = NULL;
+
+  ar(CEREAL_NVP(lambda1));
+  ar(CEREAL_NVP(lambda2));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(pathLength));
+  ar(CEREAL_NVP(shuffle));
+  ar(CEREAL_NVP(beta));
+}
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
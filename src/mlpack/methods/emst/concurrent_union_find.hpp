@@ -0,0 +1,123 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ *
+ * A lock-free union-find data structure, which can be used to union components
+ * from many threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A union-find data structure that can be modified by several threads at the
+ * same time without locks, in the spirit of the following paper:
+ *
+ * @code
+ * @inproceedings{anderson1991wait,
+ *   title={Wait-free Parallel Algorithms for the Union-Find Problem},
+ *   author={Anderson, Richard J. and Woll, Heather},
+ *   booktitle={Proceedings of the Twenty-Third Annual ACM Symposium on Theory
+ *       of Computing (STOC '91)},
+ *   pages={370--380},
+ *   year={1991}
+ * }
+ * @endcode
+ *
+ * Each parent pointer is an atomic.  Union(x, y) links the root with the larger
+ * index below the root with the smaller index with a compare-and-swap, and
+ * retries if another thread changed that root first; Find(x) shortens the path
+ * it follows by path halving.  Since parents always have smaller indices than
+ * their children, no cycle can appear, and once all unions are done the root
+ * of each component is its smallest index, whatever order the unions were done
+ * in.
+ *
+ * Find() and Union() may be called concurrently from any number of threads.
+ */
+class ConcurrentUnionFind
+{
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  If other threads are
+   * performing unions at the same time, the result may already be out of date
+   * when it is returned.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load(std::memory_order_acquire);
+      if (p == x)
+        return x;
+
+      // Point x to its grandparent; if another thread changed the parent of x
+      // in the meantime, the parent of x is still an ancestor of p, so it does
+      // not matter that this fails.
+      const size_t gp = parent[p].load(std::memory_order_acquire);
+      parent[x].compare_exchange_weak(p, gp, std::memory_order_release,
+          std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.  If several threads union the
+   * same two components at once, exactly one of them returns true.
+   *
+   * @param x one component
+   * @param y the other component
+   * @return Whether the two components were merged by this call (false if they
+   *     were already the same component).
+   */
+  bool Union(size_t x, size_t y)
+  {
+    while (true)
+    {
+      x = Find(x);
+      y = Find(y);
+      if (x == y)
+        return false;
+
+      // Link the larger root below the smaller one.  This only fails if x is
+      // not a root anymore, in which case we start again.
+      if (x < y)
+        std::swap(x, y);
+      size_t expected = x;
+      if (parent[x].compare_exchange_strong(expected, y,
+          std::memory_order_acq_rel, std::memory_order_relaxed))
+        return true;
+    }
+  }
+
+  //! Get the number of elements.
+  size_t Size() const { return parent.size(); }
+
+ private:
+  //! The parent of each element.
+  std::vector<std::atomic<size_t>> parent;
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
@@ -29,6 +29,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "concurrent_union_find.hpp"
 
 namespace mlpack {
 namespace emst /** Euclidean Minimum Spanning Trees. */ {
@@ -65,6 +66,15 @@ namespace emst /** Euclidean Minimum Spanning Trees. */ {
  * More advanced usage of the class can use different types of trees, pass in an
  * already-built tree, or compute the MST using the O(n^2) naive algorithm.
  *
+ * Each Boruvka round is parallelized with OpenMP: the query tree is split into
+ * many subtrees, which are traversed against the whole reference tree by
+ * different threads.  Each thread keeps its own candidate edge for each
+ * component (sharing only the candidate distances, for pruning); the
+ * candidates of the threads are merged at the end of the round, and the
+ * components are then merged with a ConcurrentUnionFind.  Trees whose first
+ * point is the centroid (such as the cover tree) hold points in their internal
+ * nodes, so they are traversed by a single thread.
+ *
  * @tparam MetricType The metric to use.
  * @tparam MatType The type of data matrix to use.
  * @tparam TreeType Type of tree to use.  This should follow the TreeType policy
@@ -100,7 +110,7 @@ class DualTreeBoruvka
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
   //! Connections.
-  UnionFind connections;
+  ConcurrentUnionFind connections;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -109,6 +119,10 @@ class DualTreeBoruvka
   //! List of edge distances.
   arma::vec neighborsDistances;
 
+  //! Core distance of each point, for mutual reachability distances (empty
+  //! for plain distances).
+  arma::vec coreDistances;
+
   //! Total distance of the tree.
   double totalDist;
 
@@ -172,17 +186,35 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
- private:
   /**
-   * Adds a single edge to the edge list
+   * Compute the minimum spanning tree under the mutual reachability distance
+   *
+   *   d_mreach(a, b) = max(core(a), core(b), d(a, b)),
+   *
+   * as used by HDBSCAN.  The distances between the nodes of the tree are still
+   * lower bounds of the mutual reachability distances, so nodes are pruned in
+   * the same way (but the bounds that rely on the triangle inequality are not
+   * used).  The results have the same format as ComputeMST().
+   *
+   * @param results Matrix which results will be stored in.
+   * @param coreDistances Core distance of each point of the dataset given to
+   *     the constructor (in the order of the tree's dataset, if the tree was
+   *     given to the constructor).
    */
-  void AddEdge(const size_t e1, const size_t e2, const double distance);
+  void ComputeMST(arma::mat& results, const arma::vec& coreDistances);
 
+ private:
   /**
    * Adds all the edges found in one iteration to the list of neighbors.
    */
   void AddAllEdges();
 
+  /**
+   * Split the tree into at least the given number of disjoint subtrees (unless
+   * there are not enough nodes), which together hold all of the points.
+   */
+  void QuerySubtrees(const size_t minSubtrees, std::vector<Tree*>& subtrees);
+
   /**
    * Unpermute the edge list and output it to results.
    */
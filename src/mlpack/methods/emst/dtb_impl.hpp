@@ -122,21 +122,71 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   totalDist = 0; // Reset distance.
 
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
-  while (edges.size() < (data.n_cols - 1))
+
+  // Split the query tree so that each thread gets many subtrees to traverse.
+  // Trees with points in internal nodes are traversed as a whole.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  std::vector<Tree*> subtrees;
+  if (!naive)
   {
-    if (naive)
-    {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
-    }
+    if (tree::TreeTraits<Tree>::FirstPointIsCentroid || numThreads == 1)
+      subtrees.push_back(tree);
     else
+      QuerySubtrees(8 * numThreads, subtrees);
+  }
+
+  // Each thread keeps its own candidate edges, which are merged once all
+  // threads are done with a round.  They are allocated (by the thread that uses
+  // them) the first time a thread takes part in a round, and reused after.
+  std::vector<DTBCandidates> candidates(numThreads);
+
+  size_t baseCases = 0;
+  size_t scores = 0;
+  while (edges.size() < (data.n_cols - 1))
+  {
+    #pragma omp parallel reduction(+:baseCases, scores)
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      size_t threadId = 0;
+      #ifdef MLPACK_USE_OPENMP
+        threadId = omp_get_thread_num();
+      #endif
+      if (candidates[threadId].distances.is_empty())
+        candidates[threadId].Init(data.n_cols);
+
+      RuleType rules(data, connections, neighborsDistances, metric,
+          coreDistances, candidates[threadId]);
+
+      if (naive)
+      {
+        // Full O(N^2) traversal.
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            rules.BaseCase(i, j);
+      }
+      else
+      {
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < subtrees.size(); ++i)
+          traverser.Traverse(*subtrees[i], *tree);
+      }
+
+      // The loops above end with a barrier, so all candidates are known.
+      #pragma omp for schedule(static)
+      for (size_t block = 0; block < (size_t) data.n_cols; block += 1024)
+      {
+        RuleType::MergeCandidates(candidates, block,
+            std::min(block + 1024, (size_t) data.n_cols), neighborsDistances,
+            neighborsInComponent, neighborsOutComponent);
+      }
+
+      baseCases += rules.BaseCases();
+      scores += rules.Scores();
     }
 
     AddAllEdges();
@@ -146,8 +196,8 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << baseCases << " cumulative base cases." << std::endl;
+      Log::Info << scores << " cumulative node combinations scored."
           << std::endl;
     }
   }
@@ -158,7 +208,7 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 }
 
 /**
- * Adds a single edge to the edge list
+ * Compute the MST under the mutual reachability distance.
  */
 template<
     typename MetricType,
@@ -166,18 +216,33 @@ template<
     template<typename TreeMetricType,
              typename TreeStatType,
              typename TreeMatType> class TreeType>
-void DualTreeBoruvka<MetricType, MatType, TreeType>::AddEdge(
-    const size_t e1,
-    const size_t e2,
-    const double distance)
+void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
+    arma::mat& results,
+    const arma::vec& coreDistances)
 {
-  Log::Assert((distance >= 0.0),
-      "DualTreeBoruvka::AddEdge(): distance cannot be negative.");
+  if (coreDistances.n_elem != data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "DualTreeBoruvka::ComputeMST(): got " << coreDistances.n_elem
+        << " core distances, but the dataset has " << data.n_cols
+        << " points!";
+    throw std::invalid_argument(oss.str());
+  }
 
-  if (e1 < e2)
-    edges.push_back(EdgePair(e1, e2, distance));
+  // The core distances must follow the order of the points in the tree.
+  if (!naive && ownTree && tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    this->coreDistances.set_size(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      this->coreDistances[i] = coreDistances[oldFromNew[i]];
+  }
   else
-    edges.push_back(EdgePair(e2, e1, distance));
+  {
+    this->coreDistances = coreDistances;
+  }
+
+  ComputeMST(results);
+  this->coreDistances.reset();
 }
 
 /**
@@ -191,19 +256,84 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Only the index of each component (at the start of the merge) has a
+  // candidate edge.  The components are merged concurrently; if two candidate
+  // edges would connect the same components, only the first union succeeds, so
+  // no cycle is ever added.
+  double roundDist = 0.0;
+
+  #pragma omp parallel reduction(+:roundDist)
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    std::vector<EdgePair> localEdges;
+
+    #pragma omp for schedule(static)
+    for (size_t component = 0; component < (size_t) data.n_cols; ++component)
     {
-      // totalDist = totalDist + dist;
-      // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
+      if (neighborsDistances[component] == DBL_MAX)
+        continue;
+
+      const size_t inEdge = neighborsInComponent[component];
+      const size_t outEdge = neighborsOutComponent[component];
+      if (connections.Union(inEdge, outEdge))
+      {
+        roundDist += neighborsDistances[component];
+        if (inEdge < outEdge)
+        {
+          localEdges.push_back(EdgePair(inEdge, outEdge,
+              neighborsDistances[component]));
+        }
+        else
+        {
+          localEdges.push_back(EdgePair(outEdge, inEdge,
+              neighborsDistances[component]));
+        }
+      }
     }
+
+    #pragma omp critical
+    edges.insert(edges.end(), localEdges.begin(), localEdges.end());
+  }
+
+  totalDist += roundDist;
+}
+
+/**
+ * Split the tree into disjoint subtrees, level by level.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::QuerySubtrees(
+    const size_t minSubtrees,
+    std::vector<Tree*>& subtrees)
+{
+  subtrees.clear();
+  subtrees.push_back(tree);
+  while (subtrees.size() < minSubtrees)
+  {
+    std::vector<Tree*> nextSubtrees;
+    bool split = false;
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      if (subtrees[i]->NumChildren() == 0)
+      {
+        nextSubtrees.push_back(subtrees[i]);
+        continue;
+      }
+
+      for (size_t j = 0; j < subtrees[i]->NumChildren(); ++j)
+        nextSubtrees.push_back(&subtrees[i]->Child(j));
+      split = true;
+    }
+
+    // Stop if every subtree is a leaf.
+    if (!split)
+      break;
+
+    subtrees.swap(nextSubtrees);
   }
 }
 
@@ -314,8 +444,7 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::Cleanup()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
-    neighborsDistances[i] = DBL_MAX;
+  neighborsDistances.fill(DBL_MAX);
 
   if (!naive)
     CleanupHelper(tree);
@@ -16,19 +16,59 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "concurrent_union_find.hpp"
+
 namespace mlpack {
 namespace emst {
 
+/**
+ * The candidate edges found by one thread during the Boruvka rounds: for each
+ * component, the shortest edge seen so far to a point in another component.
+ * These are allocated once for the whole computation and reused by every
+ * round; MergeCandidates() resets the entries it reads.
+ */
+struct DTBCandidates
+{
+  //! Allocate the candidates for the given number of points, with no edge.
+  void Init(const size_t numPoints)
+  {
+    distances.set_size(numPoints);
+    distances.fill(DBL_MAX);
+    inComponent.set_size(numPoints);
+    outComponent.set_size(numPoints);
+  }
+
+  //! The distance of the candidate edge of each component.
+  arma::vec distances;
+  //! The endpoint in the component of each candidate edge.
+  arma::Col<size_t> inComponent;
+  //! The endpoint outside of the component of each candidate edge.
+  arma::Col<size_t> outComponent;
+};
+
+/**
+ * The rules for one Boruvka round of the dual-tree Boruvka algorithm: for each
+ * component, find the shortest edge to a point in another component.
+ *
+ * Several DTBRules objects (one per thread) may be used at once, as long as
+ * they traverse disjoint query subtrees.  Each of them keeps its own candidate
+ * edge for each component, so no locks are needed; the candidates of all the
+ * threads are merged with MergeCandidates() after the round.  The candidates
+ * are stored in a DTBCandidates object that outlives the rules, so that they
+ * are not reallocated at every round.  The distance of the best candidate of
+ * each component found by any thread is also shared, so that all threads can
+ * prune with it; it is read and written atomically.
+ */
 template<typename MetricType, typename TreeType>
 class DTBRules
 {
  public:
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
+           ConcurrentUnionFind& connections,
            arma::vec& neighborsDistances,
-           arma::Col<size_t>& neighborsInComponent,
-           arma::Col<size_t>& neighborsOutComponent,
-           MetricType& metric);
+           MetricType& metric,
+           const arma::vec& coreDistances,
+           DTBCandidates& candidates);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -87,6 +127,29 @@ class DTBRules
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
+  /**
+   * Merge the candidate edges found by the given threads for the given range
+   * of components: the shortest candidate of each component is stored in the
+   * given arrays, and the candidates of every thread are reset for the next
+   * round.  Ties are broken in favor of the first threads, so the result does
+   * not depend on the thread schedule.
+   *
+   * @param candidates Candidates of each thread (unallocated entries are
+   *     ignored).
+   * @param begin First component to merge.
+   * @param end One past the last component to merge.
+   * @param neighborsDistances Distance of the candidate edge of each component.
+   * @param neighborsInComponent Endpoint in the component of each candidate.
+   * @param neighborsOutComponent Endpoint outside the component of each
+   *     candidate.
+   */
+  static void MergeCandidates(std::vector<DTBCandidates>& candidates,
+                              const size_t begin,
+                              const size_t end,
+                              arma::vec& neighborsDistances,
+                              arma::Col<size_t>& neighborsInComponent,
+                              arma::Col<size_t>& neighborsOutComponent);
+
   //! Get the number of base cases performed.
   size_t BaseCases() const { return baseCases; }
   //! Modify the number of base cases performed.
@@ -102,22 +165,28 @@ class DTBRules
   const arma::mat& dataSet;
 
   //! Stores the tree structure so far
-  UnionFind& connections;
+  ConcurrentUnionFind& connections;
 
-  //! The distance to the candidate nearest neighbor for each component.
+  //! The distance to the best candidate nearest neighbor for each component
+  //! found by any thread so far.
   arma::vec& neighborsDistances;
 
-  //! The index of the point in the component that is an endpoint of the
-  //! candidate edge.
-  arma::Col<size_t>& neighborsInComponent;
-
-  //! The index of the point outside of the component that is an endpoint
-  //! of the candidate edge.
-  arma::Col<size_t>& neighborsOutComponent;
+  //! The candidate edge of each component found by this object.
+  DTBCandidates& candidates;
 
   //! The instantiated metric.
   MetricType& metric;
 
+  //! The core distance of each point, if the mutual reachability distance is
+  //! used (otherwise this is empty).
+  const arma::vec& coreDistances;
+
+  /**
+   * Get the distance of the best candidate edge of the given component known
+   * to this object.  Other threads may be updating it at the same time.
+   */
+  double NeighborDistance(const size_t component) const;
+
   /**
    * Update the bound for the given query node.
    */
@@ -18,22 +18,22 @@ namespace emst {
 template<typename MetricType, typename TreeType>
 DTBRules<MetricType, TreeType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
+         ConcurrentUnionFind& connections,
          arma::vec& neighborsDistances,
-         arma::Col<size_t>& neighborsInComponent,
-         arma::Col<size_t>& neighborsOutComponent,
-         MetricType& metric)
+         MetricType& metric,
+         const arma::vec& coreDistances,
+         DTBCandidates& candidates)
 :
   dataSet(dataSet),
   connections(connections),
   neighborsDistances(neighborsDistances),
-  neighborsInComponent(neighborsInComponent),
-  neighborsOutComponent(neighborsOutComponent),
+  candidates(candidates),
   metric(metric),
+  coreDistances(coreDistances),
   baseCases(0),
   scores(0)
 {
-  // Nothing else to do.
+  // Nothing to do.
 }
 
 template<typename MetricType, typename TreeType>
@@ -44,7 +44,6 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   // Check if the points are in the same component at this iteration.
   // If not, return the distance between them.  Also, store a better result as
   // the current neighbor, if necessary.
-  double newUpperBound = -1.0;
 
   // Find the index of the component the query is in.
   size_t queryComponentIndex = connections.Find(queryIndex);
@@ -57,19 +56,32 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
     double distance = metric.Evaluate(dataSet.col(queryIndex),
                                       dataSet.col(referenceIndex));
 
-    if (distance < neighborsDistances[queryComponentIndex])
+    // The mutual reachability distance is never smaller than the distance, so
+    // the pruning bounds stay valid.
+    if (!coreDistances.is_empty())
+    {
+      distance = std::max(distance, std::max(coreDistances[queryIndex],
+          coreDistances[referenceIndex]));
+    }
+
+    if (distance < NeighborDistance(queryComponentIndex))
     {
       Log::Assert(queryIndex != referenceIndex);
 
-      neighborsDistances[queryComponentIndex] = distance;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      candidates.distances[queryComponentIndex] = distance;
+      candidates.inComponent[queryComponentIndex] = queryIndex;
+      candidates.outComponent[queryComponentIndex] = referenceIndex;
+
+      // Share the distance with the other threads.  If another thread writes
+      // a larger distance concurrently, the shared distance is only a looser
+      // (but still valid) bound, since it is the distance of a candidate that
+      // some thread keeps.
+      #pragma omp atomic write
+      neighborsDistances.memptr()[queryComponentIndex] = distance;
     }
   }
 
-  if (newUpperBound < neighborsDistances[queryComponentIndex])
-    newUpperBound = neighborsDistances[queryComponentIndex];
-
+  const double newUpperBound = NeighborDistance(queryComponentIndex);
   Log::Assert(newUpperBound >= 0.0);
 
   return newUpperBound;
@@ -93,7 +105,7 @@ double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
-  return neighborsDistances[queryComponentIndex] < distance
+  return NeighborDistance(queryComponentIndex) < distance
       ? DBL_MAX : distance;
 }
 
@@ -104,7 +116,7 @@ double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
+  return (oldScore > NeighborDistance(connections.Find(queryIndex)))
       ? DBL_MAX : oldScore;
 }
 
@@ -137,6 +149,48 @@ double DTBRules<MetricType, TreeType>::Rescore(TreeType& queryNode,
   return (oldScore > bound) ? DBL_MAX : oldScore;
 }
 
+template<typename MetricType, typename TreeType>
+inline double DTBRules<MetricType, TreeType>::NeighborDistance(
+    const size_t component) const
+{
+  double distance;
+  #pragma omp atomic read
+  distance = neighborsDistances.memptr()[component];
+  return std::min(distance, candidates.distances[component]);
+}
+
+template<typename MetricType, typename TreeType>
+void DTBRules<MetricType, TreeType>::MergeCandidates(
+    std::vector<DTBCandidates>& candidates,
+    const size_t begin,
+    const size_t end,
+    arma::vec& neighborsDistances,
+    arma::Col<size_t>& neighborsInComponent,
+    arma::Col<size_t>& neighborsOutComponent)
+{
+  for (size_t component = begin; component < end; ++component)
+  {
+    neighborsDistances[component] = DBL_MAX;
+    for (size_t t = 0; t < candidates.size(); ++t)
+    {
+      if (candidates[t].distances.is_empty())
+        continue;
+
+      double& distance = candidates[t].distances[component];
+      if (distance < neighborsDistances[component])
+      {
+        neighborsDistances[component] = distance;
+        neighborsInComponent[component] = candidates[t].inComponent[component];
+        neighborsOutComponent[component] =
+            candidates[t].outComponent[component];
+      }
+
+      // Reset the candidate for the next round.
+      distance = DBL_MAX;
+    }
+  }
+}
+
 // Calculate the bound for a given query node in its current state and update
 // it.
 template<typename MetricType, typename TreeType>
@@ -153,7 +207,7 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t pointComponent = connections.Find(queryNode.Point(i));
-    const double bound = neighborsDistances[pointComponent];
+    const double bound = NeighborDistance(pointComponent);
 
     if (bound > worstPointBound)
       worstPointBound = bound;
@@ -176,8 +230,12 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   // Now calculate the actual bounds.
   const double worstBound = std::max(worstPointBound, worstChildBound);
   const double bestBound = std::min(bestPointBound, bestChildBound);
-  // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.
-  const double bestAdjustedBound = (bestBound == DBL_MAX) ? DBL_MAX :
+  // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.  The
+  // adjusted bound relies on the triangle inequality, which the mutual
+  // reachability distance does not satisfy, so it is not used with core
+  // distances.
+  const double bestAdjustedBound =
+      (bestBound == DBL_MAX || !coreDistances.is_empty()) ? DBL_MAX :
       bestBound + 2 * queryNode.FurthestDescendantDistance();
 
   // Update the relevant quantities in the node.
@@ -0,0 +1,11 @@
+/**
+ * @file hdbscan.hpp
+ *
+ * Convenience include for mlpack/methods/hdbscan/hdbscan.hpp
+ */
+#ifndef MLPACK_HDBSCAN_HPP
+#define MLPACK_HDBSCAN_HPP
+
+#include "hdbscan/hdbscan.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file methods/hdbscan/hdbscan.hpp
+ *
+ * An implementation of the HDBSCAN clustering method, built on top of
+ * dual-tree Boruvka.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+
+namespace mlpack {
+namespace hdbscan {
+
+/**
+ * HDBSCAN (Hierarchical DBSCAN) is a density-based clustering technique that
+ * does not need the radius parameter of DBSCAN.  It is described in the
+ * following paper:
+ *
+ * @code
+ * @inproceedings{campello2013density,
+ *   title={Density-Based Clustering Based on Hierarchical Density Estimates},
+ *   author={Campello, Ricardo J.G.B. and Moulavi, Davoud and Sander, Joerg},
+ *   booktitle={Advances in Knowledge Discovery and Data Mining (PAKDD '13)},
+ *   pages={160--172},
+ *   year={2013}
+ * }
+ * @endcode
+ *
+ * The core distance of a point is the distance to its minSamples-th nearest
+ * neighbor (counting the point itself), and the mutual reachability distance
+ * between two points is the largest of their distance and their two core
+ * distances.  The clustering is done in four steps:
+ *
+ *  - the core distances are computed with a k-nearest-neighbor search
+ *    (NeighborSearch);
+ *  - the minimum spanning tree of the data under the mutual reachability
+ *    distance is computed with dual-tree Boruvka (emst::DualTreeBoruvka);
+ *  - the single-linkage hierarchy given by the spanning tree is condensed:
+ *    going down from the root, a split only creates two new clusters when both
+ *    sides have at least minClusterSize points, and otherwise the points of the
+ *    small side fall out of the cluster;
+ *  - the clusters with the largest total stability (the sum over the points of
+ *    the range of densities 1 / d for which they are in the cluster) are
+ *    selected, such that no selected cluster contains another one.
+ *
+ * Points that do not belong to any selected cluster are considered noise.
+ *
+ * @tparam MetricType Metric to use for the distances.
+ * @tparam MatType Type of matrix to cluster.
+ * @tparam TreeType Type of tree to use for the nearest neighbor search and the
+ *     spanning tree computation.
+ */
+template<
+    typename MetricType = metric::EuclideanDistance,
+    typename MatType = arma::mat,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType = tree::KDTree>
+class HDBSCAN
+{
+ public:
+  /**
+   * Construct the HDBSCAN object with the given parameters.
+   *
+   * @param minClusterSize Minimum number of points in a cluster.
+   * @param minSamples Number of neighbors (including the point itself) used to
+   *     compute the core distance of each point; 0 means minClusterSize.
+   * @param metric Optional instantiated metric.
+   */
+  HDBSCAN(const size_t minClusterSize = 5,
+          const size_t minSamples = 0,
+          const MetricType metric = MetricType());
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters
+   * and also the list of cluster assignments.  If assignments[i] == SIZE_MAX,
+   * then the point is considered noise.  The clusters are numbered in the
+   * order of the first point of each cluster.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   */
+  size_t Cluster(const MatType& data, arma::Row<size_t>& assignments);
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters,
+   * the centroid of each cluster and also the list of cluster assignments.  If
+   * assignments[i] == SIZE_MAX, then the point is considered noise.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   * @param centroids Matrix in which centroids are stored.
+   */
+  size_t Cluster(const MatType& data,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& centroids);
+
+  /**
+   * Compute the core distance of each point of the dataset, which is the
+   * distance to its minSamples-th nearest neighbor (counting the point
+   * itself).
+   *
+   * @param data Dataset.
+   * @param coreDistances Vector to store the core distances in.
+   */
+  void CoreDistances(const MatType& data, arma::vec& coreDistances);
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinClusterSize() const { return minClusterSize; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinClusterSize() { return minClusterSize; }
+
+  //! Get the number of neighbors used for the core distances (0 means
+  //! MinClusterSize()).
+  size_t MinSamples() const { return minSamples; }
+  //! Modify the number of neighbors used for the core distances (0 means
+  //! MinClusterSize()).
+  size_t& MinSamples() { return minSamples; }
+
+  //! Get the metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the metric.
+  MetricType& Metric() { return metric; }
+
+ private:
+  /**
+   * Build the condensed cluster tree from the minimum spanning tree, and
+   * select the most stable clusters.
+   *
+   * @param mst Minimum spanning tree, as given by DualTreeBoruvka (sorted by
+   *     increasing distance).
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  size_t ExtractClusters(const arma::mat& mst,
+                         arma::Row<size_t>& assignments) const;
+
+  //! Minimum number of points in a cluster.
+  size_t minClusterSize;
+
+  //! Number of neighbors used for the core distances.
+  size_t minSamples;
+
+  //! The instantiated metric.
+  MetricType metric;
+};
+
+} // namespace hdbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "hdbscan_impl.hpp"
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ * @file methods/hdbscan/hdbscan_impl.hpp
+ *
+ * Implementation of HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hdbscan.hpp"
+
+#include <mlpack/methods/emst/union_find.hpp>
+
+namespace mlpack {
+namespace hdbscan {
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+HDBSCAN<MetricType, MatType, TreeType>::HDBSCAN(const size_t minClusterSize,
+                                                const size_t minSamples,
+                                                const MetricType metric) :
+    minClusterSize(minClusterSize),
+    minSamples(minSamples),
+    metric(metric)
+{
+  if (minClusterSize < 2)
+  {
+    std::ostringstream oss;
+    oss << "HDBSCAN::HDBSCAN(): minClusterSize must be at least 2, but "
+        << minClusterSize << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, MatType, TreeType>::Cluster(
+    const MatType& data,
+    arma::Row<size_t>& assignments,
+    arma::mat& centroids)
+{
+  const size_t numClusters = Cluster(data, assignments);
+
+  // Now calculate the centroids.
+  centroids.zeros(data.n_rows, numClusters);
+
+  // Calculate number of points in each cluster.
+  arma::Row<size_t> counts;
+  counts.zeros(numClusters);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (assignments[i] != SIZE_MAX)
+    {
+      centroids.col(assignments[i]) += data.col(i);
+      ++counts[assignments[i]];
+    }
+  }
+
+  // Every selected cluster has at least minClusterSize points.
+  for (size_t i = 0; i < numClusters; ++i)
+    centroids.col(i) /= counts[i];
+
+  return numClusters;
+}
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, MatType, TreeType>::Cluster(
+    const MatType& data,
+    arma::Row<size_t>& assignments)
+{
+  // With too few points, there cannot be any cluster.
+  if (data.n_cols < minClusterSize)
+  {
+    assignments.set_size(data.n_cols);
+    assignments.fill(SIZE_MAX);
+    return 0;
+  }
+
+  arma::vec coreDistances;
+  CoreDistances(data, coreDistances);
+
+  // Compute the minimum spanning tree under the mutual reachability distance.
+  arma::mat mst;
+  {
+    emst::DualTreeBoruvka<MetricType, MatType, TreeType> dtb(data, false,
+        metric);
+    dtb.ComputeMST(mst, coreDistances);
+  }
+
+  return ExtractClusters(mst, assignments);
+}
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void HDBSCAN<MetricType, MatType, TreeType>::CoreDistances(
+    const MatType& data,
+    arma::vec& coreDistances)
+{
+  const size_t k = (minSamples == 0) ? minClusterSize : minSamples;
+  if (k > data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HDBSCAN::CoreDistances(): minSamples (" << k << ") is greater "
+        << "than the number of points (" << data.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each point is its own nearest neighbor.
+  if (k == 1)
+  {
+    coreDistances.zeros(data.n_cols);
+    return;
+  }
+
+  // The monochromatic search does not return the point itself, so we need one
+  // neighbor less.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType, MatType,
+      TreeType> knn(data, neighbor::DUAL_TREE_MODE, 0.0, metric);
+  knn.Search(k - 1, neighbors, distances);
+
+  coreDistances = distances.row(k - 2).t();
+}
+
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+size_t HDBSCAN<MetricType, MatType, TreeType>::ExtractClusters(
+    const arma::mat& mst,
+    arma::Row<size_t>& assignments) const
+{
+  const size_t n = mst.n_cols + 1;
+
+  // Build the single-linkage hierarchy: the leaves 0, ..., n - 1 are the
+  // points, and node n + i merges the two components joined by the i'th
+  // (shortest) edge of the spanning tree.
+  std::vector<size_t> children(2 * (n - 1));
+  std::vector<size_t> sizes(2 * n - 1, 1);
+  std::vector<double> lambdas(n - 1);
+  {
+    emst::UnionFind uf(n);
+    std::vector<size_t> componentNode(n);
+    for (size_t i = 0; i < n; ++i)
+      componentNode[i] = i;
+
+    for (size_t i = 0; i < n - 1; ++i)
+    {
+      const size_t a = uf.Find((size_t) mst(0, i));
+      const size_t b = uf.Find((size_t) mst(1, i));
+      children[2 * i] = componentNode[a];
+      children[2 * i + 1] = componentNode[b];
+      sizes[n + i] = sizes[componentNode[a]] + sizes[componentNode[b]];
+      lambdas[i] = (mst(2, i) > 0.0) ? 1.0 / mst(2, i) :
+          std::numeric_limits<double>::infinity();
+
+      uf.Union(a, b);
+      componentNode[uf.Find(a)] = n + i;
+    }
+  }
+
+  // Duplicate points are merged at an infinite density; use the largest finite
+  // density instead, so that the stabilities stay finite.
+  double maxLambda = 0.0;
+  for (size_t i = 0; i < n - 1; ++i)
+    if (std::isfinite(lambdas[i]))
+      maxLambda = std::max(maxLambda, lambdas[i]);
+  if (maxLambda == 0.0)
+    maxLambda = 1.0;
+  for (size_t i = 0; i < n - 1; ++i)
+    if (!std::isfinite(lambdas[i]))
+      lambdas[i] = maxLambda;
+
+  // Condense the hierarchy, going down from the root.  Children always have
+  // smaller indices than their parents, so visiting the nodes in decreasing
+  // order visits each parent before its children.  Cluster 0 is the root, and
+  // each cluster has a larger index than its parent.
+  std::vector<size_t> nodeClusters(2 * n - 1, SIZE_MAX);
+  std::vector<size_t> pointClusters(n);
+  std::vector<size_t> clusterParents(1, SIZE_MAX);
+  std::vector<double> clusterBirths(1, 0.0);
+  std::vector<double> stabilities(1, 0.0);
+  nodeClusters[2 * n - 2] = 0;
+
+  std::vector<size_t> stack;
+  for (size_t node = 2 * n - 2; node >= n; --node)
+  {
+    // Nodes whose points have already fallen out of their cluster are skipped.
+    const size_t cluster = nodeClusters[node];
+    if (cluster == SIZE_MAX)
+      continue;
+
+    const size_t left = children[2 * (node - n)];
+    const size_t right = children[2 * (node - n) + 1];
+    const double lambda = lambdas[node - n];
+
+    if (sizes[left] >= minClusterSize && sizes[right] >= minClusterSize)
+    {
+      // A true split: both sides become new clusters.
+      for (const size_t child : { left, right })
+      {
+        nodeClusters[child] = clusterParents.size();
+        clusterParents.push_back(cluster);
+        clusterBirths.push_back(lambda);
+        stabilities.push_back(0.0);
+        stabilities[cluster] += sizes[child] *
+            (lambda - clusterBirths[cluster]);
+      }
+      continue;
+    }
+
+    for (const size_t child : { left, right })
+    {
+      // A large enough side is still the same cluster.
+      if (sizes[child] >= minClusterSize)
+      {
+        nodeClusters[child] = cluster;
+        continue;
+      }
+
+      // The points of a small side fall out of the cluster.
+      stack.push_back(child);
+      while (!stack.empty())
+      {
+        const size_t descendant = stack.back();
+        stack.pop_back();
+        if (descendant < n)
+        {
+          pointClusters[descendant] = cluster;
+          stabilities[cluster] += lambda - clusterBirths[cluster];
+        }
+        else
+        {
+          stack.push_back(children[2 * (descendant - n)]);
+          stack.push_back(children[2 * (descendant - n) + 1]);
+        }
+      }
+    }
+  }
+
+  // Select the clusters with the largest total stability, going up from the
+  // leaves of the cluster tree: a cluster is selected if it is more stable
+  // than the best selection of its descendants.  The root is never selected.
+  const size_t numCandidates = clusterParents.size();
+  std::vector<double> childStabilities(numCandidates, 0.0);
+  std::vector<bool> hasChildren(numCandidates, false);
+  std::vector<bool> selected(numCandidates, false);
+  for (size_t c = numCandidates - 1; c > 0; --c)
+  {
+    double best = childStabilities[c];
+    if (!hasChildren[c] || stabilities[c] >= childStabilities[c])
+    {
+      selected[c] = true;
+      best = stabilities[c];
+    }
+
+    childStabilities[clusterParents[c]] += best;
+    hasChildren[clusterParents[c]] = true;
+  }
+
+  // Now find the selected ancestor of each cluster, if any, going down.
+  std::vector<size_t> selectedAncestors(numCandidates, SIZE_MAX);
+  for (size_t c = 1; c < numCandidates; ++c)
+  {
+    const size_t parentAncestor = selectedAncestors[clusterParents[c]];
+    if (parentAncestor != SIZE_MAX)
+      selectedAncestors[c] = parentAncestor;
+    else if (selected[c])
+      selectedAncestors[c] = c;
+  }
+
+  // Number the selected clusters in the order of their first point.
+  std::vector<size_t> labels(numCandidates, SIZE_MAX);
+  size_t numClusters = 0;
+  assignments.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t c = selectedAncestors[pointClusters[i]];
+    if (c == SIZE_MAX)
+    {
+      assignments[i] = SIZE_MAX;
+      continue;
+    }
+
+    if (labels[c] == SIZE_MAX)
+      labels[c] = numClusters++;
+    assignments[i] = labels[c];
+  }
+
+  return numClusters;
+}
+
+} // namespace hdbscan
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file methods/hdbscan/hdbscan_main.cpp
+ *
+ * Implementation of program to run HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME hdbscan
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include "hdbscan.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+using namespace mlpack::metric;
+using namespace mlpack::tree;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_USER_NAME("HDBSCAN clustering");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of HDBSCAN clustering.  Given a dataset, this can "
+    "compute and return a clustering of that dataset, without a radius "
+    "parameter.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program implements the HDBSCAN algorithm for clustering, which "
+    "builds the hierarchy of the DBSCAN clusterings for all radii and "
+    "selects the most stable clusters of that hierarchy.  The core distances "
+    "are computed with tree-based nearest neighbor search, and the minimum "
+    "spanning tree of the mutual reachability distances is computed with the "
+    "dual-tree Boruvka algorithm."
+    "\n\n"
+    "The input dataset is specified with the " + PRINT_PARAM_STRING("input") +
+    " parameter.  The smallest number of points in a cluster is specified "
+    "with the " + PRINT_PARAM_STRING("min_cluster_size") + " parameter, and "
+    "the number of neighbors (including the point itself) used to compute the "
+    "core distance of each point is specified with the " +
+    PRINT_PARAM_STRING("min_samples") + " parameter; if it is 0, it is the "
+    "same as " + PRINT_PARAM_STRING("min_cluster_size") + "."
+    "\n\n"
+    "The " + PRINT_PARAM_STRING("assignments") + " and " +
+    PRINT_PARAM_STRING("centroids") + " output parameters may be "
+    "used to save the output of the clustering. " +
+    PRINT_PARAM_STRING("assignments") + " contains the cluster assignments of "
+    "each point, and " + PRINT_PARAM_STRING("centroids") + " contains the "
+    "centroids of each cluster.  Points that are not in any cluster are "
+    "considered noise, and their assignment is the largest value that an "
+    "unsigned integer can hold."
+    "\n\n"
+    "The type of tree used for the nearest neighbor search and the spanning "
+    "tree can be specified with the " + PRINT_PARAM_STRING("tree_type") +
+    " parameter.");
+
+// Example.
+BINDING_EXAMPLE(
+    "An example usage to run HDBSCAN on the dataset in " +
+    PRINT_DATASET("input") + " with a minimum cluster size of 10, saving the "
+    "assignments to " + PRINT_DATASET("assignments") + ", is given below:"
+    "\n\n" +
+    PRINT_CALL("hdbscan", "input", "input", "min_cluster_size", 10,
+        "assignments", "assignments"));
+
+// See also...
+BINDING_SEE_ALSO("@dbscan", "#dbscan");
+BINDING_SEE_ALSO("@emst", "#emst");
+BINDING_SEE_ALSO("Density-Based Clustering Based on Hierarchical Density "
+        "Estimates", "https://doi.org/10.1007/978-3-642-37456-2_14");
+BINDING_SEE_ALSO("mlpack::hdbscan::HDBSCAN class documentation",
+        "@doxygen/classmlpack_1_1hdbscan_1_1HDBSCAN.html");
+
+PARAM_MATRIX_IN_REQ("input", "Input dataset to cluster.", "i");
+PARAM_UROW_OUT("assignments", "Output matrix for assignments of each "
+    "point.", "a");
+PARAM_MATRIX_OUT("centroids", "Matrix to save output centroids to.", "C");
+
+PARAM_INT_IN("min_cluster_size", "Minimum number of points in a cluster.", "m",
+    5);
+PARAM_INT_IN("min_samples", "Number of neighbors (including the point itself) "
+    "used to compute the core distances; 0 means the same as "
+    "min_cluster_size.", "s", 0);
+
+PARAM_STRING_IN("tree_type", "The type of tree to use ('kd', 'ball', "
+    "'cover').", "t", "kd");
+
+// Actually run the clustering, and process the output.
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RunHDBSCAN(util::Params& params, util::Timers& timers)
+{
+  arma::mat dataset = std::move(params.Get<arma::mat>("input"));
+  arma::Row<size_t> assignments;
+
+  HDBSCAN<EuclideanDistance, arma::mat, TreeType> h(
+      (size_t) params.Get<int>("min_cluster_size"),
+      (size_t) params.Get<int>("min_samples"));
+
+  timers.Start("clustering");
+
+  // If possible, avoid the overhead of calculating centroids.
+  if (params.Has("centroids"))
+  {
+    arma::mat centroids;
+
+    h.Cluster(dataset, assignments, centroids);
+
+    params.Get<arma::mat>("centroids") = std::move(centroids);
+  }
+  else
+  {
+    h.Cluster(dataset, assignments);
+  }
+
+  timers.Stop("clustering");
+
+  if (params.Has("assignments"))
+    params.Get<arma::Row<size_t>>("assignments") = std::move(assignments);
+}
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  RequireAtLeastOnePassed(params, { "assignments", "centroids" }, false,
+      "no output will be saved");
+
+  RequireParamInSet<string>(params, "tree_type", { "kd", "ball", "cover" },
+      true, "unknown tree type");
+
+  // A cluster must have at least two points.
+  RequireParamValue<int>(params, "min_cluster_size",
+      [](int x) { return x >= 2; }, true,
+      "invalid value of min_cluster_size specified");
+
+  RequireParamValue<int>(params, "min_samples", [](int x) { return x >= 0; },
+      true, "invalid value of min_samples specified");
+
+  // If there are fewer points than min_cluster_size, every point is noise and
+  // no core distances are computed.
+  const size_t numPoints = params.Get<arma::mat>("input").n_cols;
+  const int minSamples = (params.Get<int>("min_samples") == 0) ?
+      params.Get<int>("min_cluster_size") : params.Get<int>("min_samples");
+  if ((size_t) params.Get<int>("min_cluster_size") <= numPoints &&
+      (size_t) minSamples > numPoints)
+  {
+    Log::Fatal << "The value of " << PRINT_PARAM_STRING("min_samples")
+        << " (" << minSamples << ") must not be greater than the number of "
+        << "points!" << std::endl;
+  }
+
+  const string treeType = params.Get<string>("tree_type");
+  if (treeType == "kd")
+    RunHDBSCAN<KDTree>(params, timers);
+  else if (treeType == "ball")
+    RunHDBSCAN<BallTree>(params, timers);
+  else if (treeType == "cover")
+    RunHDBSCAN<StandardCoverTree>(params, timers);
+}
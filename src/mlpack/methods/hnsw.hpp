@@ -0,0 +1,11 @@
+/**
+ * @file hnsw.hpp
+ *
+ * Convenience include for mlpack/methods/hnsw/hnsw_search.hpp
+ */
+#ifndef MLPACK_HNSW_HPP
+#define MLPACK_HNSW_HPP
+
+#include "hnsw/hnsw_search.hpp"
+
+#endif
@@ -0,0 +1,330 @@
+/**
+ * @file methods/hnsw/hnsw_search.hpp
+ *
+ * Defines the HNSWSearch class, which performs approximate nearest neighbor
+ * search with a hierarchical navigable small world graph.  The details of the
+ * method can be found in the following paper:
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and Robust Approximate Nearest Neighbor Search Using
+ *       Hierarchical Navigable Small World Graphs},
+ *   author={Malkov, Yu A. and Yashunin, Dmitry A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+#include <mutex>
+#include <queue>
+#include <unordered_set>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The HNSWSearch class builds a hierarchical navigable small world (HNSW)
+ * graph on the reference set, and uses it to find the approximate nearest
+ * neighbors of query points.  Each point is inserted into layers 0 through a
+ * randomly drawn level (with exponentially decaying probability), and is linked
+ * to its closest points in each of these layers.  A search descends greedily
+ * through the sparse upper layers and then runs a best-first search of width
+ * efSearch in the bottom layer.
+ *
+ * The graph is built in parallel with OpenMP: points are inserted concurrently,
+ * and each point's neighbor lists are protected by their own lock during the
+ * build.  New points can be added to a trained model with Insert().  Queries
+ * are answered in parallel too.
+ *
+ * An example of how to use HNSWSearch is shown below:
+ *
+ * @code
+ * extern arma::mat data; // The reference set.
+ * extern arma::mat queries; // The query set.
+ *
+ * // Build the graph with 16 links per point.
+ * HNSWSearch<> hnsw(data, 16);
+ *
+ * // Find the 10 approximate nearest neighbors of each query.
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * hnsw.Search(queries, 10, neighbors, distances);
+ * @endcode
+ *
+ * @tparam DistanceType Distance metric to use for the search.
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename DistanceType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class HNSWSearch
+{
+ public:
+  //! The type of the elements of the data.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the HNSWSearch object and build the graph on the given reference
+   * set.  In order to avoid copying the reference set, consider passing it with
+   * std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links of each point in the upper layers (twice as many
+   *     are kept in the bottom layer).
+   * @param efConstruction Size of the candidate list used when inserting a
+   *     point.
+   * @param efSearch Size of the candidate list used when searching.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(MatType referenceSet,
+             const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Create an empty HNSWSearch object.  Call Train() or Insert() before calling
+   * Search().
+   *
+   * @param m Number of links of each point in the upper layers (twice as many
+   *     are kept in the bottom layer).
+   * @param efConstruction Size of the candidate list used when inserting a
+   *     point.
+   * @param efSearch Size of the candidate list used when searching.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Build the graph on the given reference set, replacing any existing graph.
+   * In order to avoid copying the reference set, consider passing it with
+   * std::move().
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Insert the given points into the graph.  The new points get the indices
+   * following the points already in the reference set.
+   *
+   * @param points Points to insert.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Find the approximate k nearest neighbors of each point in the query set.
+   * The matrices will be set to k rows by n columns, where n is the number of
+   * query points.  If fewer than k points are found for a query, the
+   * remaining neighbors are set to SIZE_MAX and the distances to DBL_MAX.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Find the approximate k nearest neighbors of each point in the reference
+   * set, not counting the point itself.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  //! Get the number of links per point in the upper layers.
+  size_t M() const { return m; }
+
+  //! Get the size of the candidate list used when inserting.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the size of the candidate list used when inserting.
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the size of the candidate list used when searching.
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the size of the candidate list used when searching.
+  size_t& EfSearch() { return efSearch; }
+
+  //! Get the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the highest layer of the graph.
+  size_t MaxLevel() const { return maxLevel; }
+  //! Get the index of the point where searches start.
+  size_t EntryPoint() const { return entryPoint; }
+  //! Get the highest layer of each point.
+  const std::vector<size_t>& Levels() const { return levels; }
+
+  //! Get the neighbors of the given point in the given layer.
+  std::vector<size_t> Neighbors(const size_t point, const size_t layer) const;
+
+  //! Get the distance metric.
+  const DistanceType& Distance() const { return distance; }
+  //! Modify the distance metric.
+  DistanceType& Distance() { return distance; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Candidate represents a point and its distance to a query (distance,
+  //! index).
+  typedef std::pair<double, size_t> Candidate;
+
+  /**
+   * Draw a random layer for a new point.
+   */
+  size_t RandomLevel() const;
+
+  /**
+   * Link the points from the given index to the end of the reference set into
+   * the graph, in parallel.
+   *
+   * @param begin Index of the first point to link.
+   */
+  void InsertPoints(const size_t begin);
+
+  /**
+   * Link the given point into the graph.
+   *
+   * @param point Index of the point.
+   * @param locks Locks of the neighbor lists of every point.
+   * @param entryLock Lock of the entry point and maximum layer.
+   */
+  void InsertPoint(const size_t point,
+                   std::vector<std::mutex>& locks,
+                   std::mutex& entryLock);
+
+  /**
+   * Move greedily towards the query in the given layer, until no neighbor of
+   * the current point is closer to the query.
+   *
+   * @param query Query point.
+   * @param layer Layer to search.
+   * @param current Current point; modified to be the closest point found.
+   * @param currentDistance Distance between the query and the current point.
+   * @param locks Locks of the neighbor lists, or NULL if the graph is not
+   *     being modified.
+   */
+  template<typename VecType>
+  void GreedySearch(const VecType& query,
+                    const size_t layer,
+                    size_t& current,
+                    double& currentDistance,
+                    std::vector<std::mutex>* locks) const;
+
+  /**
+   * Run a best-first search of width ef in the given layer, starting from the
+   * given point, and return the closest points found, sorted by distance.
+   *
+   * @param query Query point.
+   * @param layer Layer to search.
+   * @param start Point to start from.
+   * @param startDistance Distance between the query and the start point.
+   * @param ef Size of the candidate list.
+   * @param results Closest points found, sorted by distance.
+   * @param locks Locks of the neighbor lists, or NULL if the graph is not
+   *     being modified.
+   */
+  template<typename VecType>
+  void SearchLayer(const VecType& query,
+                   const size_t layer,
+                   const size_t start,
+                   const double startDistance,
+                   const size_t ef,
+                   std::vector<Candidate>& results,
+                   std::vector<std::mutex>* locks) const;
+
+  /**
+   * Select at most maxLinks neighbors from the given sorted candidates with
+   * the heuristic of the paper: a candidate is kept only if it is closer to
+   * the point than to every neighbor kept so far, which keeps links in
+   * different directions.
+   *
+   * @param candidates Candidates, sorted by distance to the point.
+   * @param maxLinks Maximum number of neighbors.
+   * @param selected Indices of the selected neighbors.
+   */
+  void SelectNeighbors(const std::vector<Candidate>& candidates,
+                       const size_t maxLinks,
+                       std::vector<size_t>& selected) const;
+
+  //! Copy the neighbors of the given point in the given layer.
+  void GetLinks(const size_t point,
+                const size_t layer,
+                std::vector<size_t>& links) const;
+
+  //! Set the neighbors of the given point in the given layer.
+  void SetLinks(const size_t point,
+                const size_t layer,
+                const std::vector<size_t>& links);
+
+  //! Maximum number of neighbors in the given layer.
+  size_t MaxLinks(const size_t layer) const
+  {
+    return (layer == 0) ? 2 * m : m;
+  }
+
+  //! Reference dataset.
+  MatType referenceSet;
+
+  //! Number of links per point in the upper layers.
+  size_t m;
+  //! Size of the candidate list used when inserting.
+  size_t efConstruction;
+  //! Size of the candidate list used when searching.
+  size_t efSearch;
+
+  //! Highest layer of each point.
+  std::vector<size_t> levels;
+  //! Neighbors of every point in layer 0; one column per point, holding
+  //! baseLinkCounts[i] valid entries.
+  arma::Mat<size_t> baseLinks;
+  //! Number of neighbors of every point in layer 0.
+  arma::Col<size_t> baseLinkCounts;
+  //! Neighbors of every point in layers 1 and above; upperLinks[i][l - 1]
+  //! holds the neighbors of point i in layer l.
+  std::vector<std::vector<std::vector<size_t>>> upperLinks;
+
+  //! Point where searches start (one of the points in the highest layer).
+  size_t entryPoint;
+  //! Highest layer of the graph.
+  size_t maxLevel;
+
+  //! Instantiated distance metric.
+  DistanceType distance;
+}; // class HNSWSearch
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_search_impl.hpp"
+
+#endif
@@ -0,0 +1,519 @@
+/**
+ * @file methods/hnsw/hnsw_search_impl.hpp
+ *
+ * Implementation of the HNSWSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_search.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+// Construct the object and build the graph.
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(MatType referenceSet,
+                                              const size_t m,
+                                              const size_t efConstruction,
+                                              const size_t efSearch,
+                                              DistanceType distance) :
+    HNSWSearch(m, efConstruction, efSearch, std::move(distance))
+{
+  Train(std::move(referenceSet));
+}
+
+// Construct an empty object.
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(const size_t m,
+                                              const size_t efConstruction,
+                                              const size_t efSearch,
+                                              DistanceType distance) :
+    m(m),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    entryPoint(0),
+    maxLevel(0),
+    distance(std::move(distance))
+{
+  if (m < 2)
+    throw std::invalid_argument("HNSWSearch: m must be at least 2!");
+}
+
+// Build the graph on a new reference set.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Train(MatType referenceSetIn)
+{
+  referenceSet = std::move(referenceSetIn);
+
+  levels.clear();
+  baseLinks.reset();
+  baseLinkCounts.reset();
+  upperLinks.clear();
+  entryPoint = 0;
+  maxLevel = 0;
+
+  InsertPoints(0);
+}
+
+// Add new points to the graph.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Insert(const MatType& points)
+{
+  if (referenceSet.n_cols > 0 && points.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Insert(): dimensionality of points (" << points.n_rows
+        << ") does not match dimensionality of reference set ("
+        << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t begin = referenceSet.n_cols;
+  if (begin == 0)
+    referenceSet = points;
+  else
+    referenceSet.insert_cols(begin, points);
+
+  InsertPoints(begin);
+}
+
+// Search for the nearest neighbors of the query points.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("HNSWSearch::Search(): the model has no "
+        "reference points; call Train() or Insert() first!");
+  }
+
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") does not match dimensionality of reference "
+        << "set (" << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(DBL_MAX);
+
+  // The candidate list has to hold at least k points.
+  const size_t ef = std::max(efSearch, k);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Descend greedily through the upper layers.
+    size_t current = entryPoint;
+    double currentDistance = distance.Evaluate(querySet.col(i),
+        referenceSet.col(current));
+    for (size_t layer = maxLevel; layer > 0; --layer)
+      GreedySearch(querySet.col(i), layer, current, currentDistance, NULL);
+
+    std::vector<Candidate> results;
+    SearchLayer(querySet.col(i), 0, current, currentDistance, ef, results,
+        NULL);
+
+    const size_t found = std::min(k, results.size());
+    for (size_t j = 0; j < found; ++j)
+    {
+      neighbors(j, i) = results[j].second;
+      distances(j, i) = results[j].first;
+    }
+  }
+}
+
+// Search for the nearest neighbors of the reference points.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points; k must be less than the number of reference points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Search for one more neighbor, so that the point itself can be dropped.
+  arma::Mat<size_t> allNeighbors;
+  arma::mat allDistances;
+  Search(referenceSet, k + 1, allNeighbors, allDistances);
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    size_t j = 0;
+    for (size_t l = 0; l < k + 1 && j < k; ++l)
+    {
+      if (allNeighbors(l, i) == i)
+        continue;
+
+      neighbors(j, i) = allNeighbors(l, i);
+      distances(j, i) = allDistances(l, i);
+      ++j;
+    }
+  }
+}
+
+// Get the neighbors of a point.
+template<typename DistanceType, typename MatType>
+std::vector<size_t> HNSWSearch<DistanceType, MatType>::Neighbors(
+    const size_t point,
+    const size_t layer) const
+{
+  std::vector<size_t> links;
+  GetLinks(point, layer, links);
+  return links;
+}
+
+// Serialize the model.
+template<typename DistanceType, typename MatType>
+template<typename Archive>
+void HNSWSearch<DistanceType, MatType>::serialize(Archive& ar,
+                                                  const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(m));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(levels));
+  ar(CEREAL_NVP(baseLinks));
+  ar(CEREAL_NVP(baseLinkCounts));
+  ar(CEREAL_NVP(upperLinks));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxLevel));
+  ar(CEREAL_NVP(distance));
+}
+
+// Draw the highest layer of a new point.
+template<typename DistanceType, typename MatType>
+size_t HNSWSearch<DistanceType, MatType>::RandomLevel() const
+{
+  // P(level >= l) = m^(-l).  Use 1 - Random() so that log(0) is never taken.
+  return (size_t) std::floor(-std::log(1.0 - math::Random()) /
+      std::log((double) m));
+}
+
+// Link new points into the graph.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::InsertPoints(const size_t begin)
+{
+  const size_t n = referenceSet.n_cols;
+  if (begin >= n)
+    return;
+
+  // Draw the layers serially, so that they only depend on the random seed.
+  levels.resize(n);
+  upperLinks.resize(n);
+  baseLinks.resize(MaxLinks(0), n);
+  baseLinkCounts.resize(n);
+  for (size_t i = begin; i < n; ++i)
+  {
+    levels[i] = RandomLevel();
+    upperLinks[i].resize(levels[i]);
+    baseLinkCounts[i] = 0;
+  }
+
+  // The first point of an empty graph just becomes the entry point.
+  size_t first = begin;
+  if (begin == 0)
+  {
+    entryPoint = 0;
+    maxLevel = levels[0];
+    first = 1;
+  }
+
+  // The locks are only needed while the graph is being modified.
+  std::vector<std::mutex> locks(n);
+  std::mutex entryLock;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = first; i < n; ++i)
+    InsertPoint(i, locks, entryLock);
+}
+
+// Link one point into the graph.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::InsertPoint(
+    const size_t point,
+    std::vector<std::mutex>& locks,
+    std::mutex& entryLock)
+{
+  size_t current, topLevel;
+  {
+    std::lock_guard<std::mutex> lock(entryLock);
+    current = entryPoint;
+    topLevel = maxLevel;
+  }
+
+  const size_t level = levels[point];
+  double currentDistance = distance.Evaluate(referenceSet.col(point),
+      referenceSet.col(current));
+
+  // Descend greedily through the layers above the point's highest layer.
+  for (size_t layer = topLevel; layer > level; --layer)
+  {
+    GreedySearch(referenceSet.col(point), layer, current, currentDistance,
+        &locks);
+  }
+
+  std::vector<Candidate> candidates;
+  std::vector<Candidate> pruneCandidates;
+  std::vector<size_t> selected;
+  std::vector<size_t> links;
+  for (size_t layer = std::min(level, topLevel) + 1; layer-- > 0; )
+  {
+    SearchLayer(referenceSet.col(point), layer, current, currentDistance,
+        efConstruction, candidates, &locks);
+
+    // A concurrent insertion may have linked to this point already.
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+        [point](const Candidate& c) { return c.second == point; }),
+        candidates.end());
+    if (candidates.empty())
+      continue;
+
+    SelectNeighbors(candidates, m, selected);
+    {
+      std::lock_guard<std::mutex> lock(locks[point]);
+      SetLinks(point, layer, selected);
+    }
+
+    // Add the reverse links, pruning the neighbor lists that grow too long.
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+      const size_t neighbor = selected[i];
+      std::lock_guard<std::mutex> lock(locks[neighbor]);
+      GetLinks(neighbor, layer, links);
+
+      if (links.size() < MaxLinks(layer))
+      {
+        links.push_back(point);
+      }
+      else
+      {
+        pruneCandidates.clear();
+        pruneCandidates.push_back(Candidate(distance.Evaluate(
+            referenceSet.col(neighbor), referenceSet.col(point)), point));
+        for (size_t j = 0; j < links.size(); ++j)
+        {
+          pruneCandidates.push_back(Candidate(distance.Evaluate(
+              referenceSet.col(neighbor), referenceSet.col(links[j])),
+              links[j]));
+        }
+        std::sort(pruneCandidates.begin(), pruneCandidates.end());
+        SelectNeighbors(pruneCandidates, MaxLinks(layer), links);
+      }
+
+      SetLinks(neighbor, layer, links);
+    }
+
+    // Start the search in the next layer from the closest point found.
+    current = candidates[0].second;
+    currentDistance = candidates[0].first;
+  }
+
+  if (level > topLevel)
+  {
+    std::lock_guard<std::mutex> lock(entryLock);
+    if (level > maxLevel)
+    {
+      maxLevel = level;
+      entryPoint = point;
+    }
+  }
+}
+
+// Greedy search in one layer.
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::GreedySearch(
+    const VecType& query,
+    const size_t layer,
+    size_t& current,
+    double& currentDistance,
+    std::vector<std::mutex>* locks) const
+{
+  std::vector<size_t> links;
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    if (locks)
+    {
+      std::lock_guard<std::mutex> lock((*locks)[current]);
+      GetLinks(current, layer, links);
+    }
+    else
+    {
+      GetLinks(current, layer, links);
+    }
+
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+      const double d = distance.Evaluate(query, referenceSet.col(links[i]));
+      if (d < currentDistance)
+      {
+        currentDistance = d;
+        current = links[i];
+        changed = true;
+      }
+    }
+  }
+}
+
+// Best-first search in one layer.
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::SearchLayer(
+    const VecType& query,
+    const size_t layer,
+    const size_t start,
+    const double startDistance,
+    const size_t ef,
+    std::vector<Candidate>& results,
+    std::vector<std::mutex>* locks) const
+{
+  std::unordered_set<size_t> visited;
+  visited.insert(start);
+
+  // Points left to expand, closest first.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> candidates;
+  // The ef closest points found so far, furthest first.
+  std::priority_queue<Candidate> best;
+
+  candidates.push(Candidate(startDistance, start));
+  best.push(Candidate(startDistance, start));
+
+  std::vector<size_t> links;
+  while (!candidates.empty())
+  {
+    const Candidate c = candidates.top();
+    if (c.first > best.top().first)
+      break;
+    candidates.pop();
+
+    if (locks)
+    {
+      std::lock_guard<std::mutex> lock((*locks)[c.second]);
+      GetLinks(c.second, layer, links);
+    }
+    else
+    {
+      GetLinks(c.second, layer, links);
+    }
+
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+      if (!visited.insert(links[i]).second)
+        continue;
+
+      const double d = distance.Evaluate(query, referenceSet.col(links[i]));
+      if (best.size() < ef || d < best.top().first)
+      {
+        candidates.push(Candidate(d, links[i]));
+        best.push(Candidate(d, links[i]));
+        if (best.size() > ef)
+          best.pop();
+      }
+    }
+  }
+
+  results.resize(best.size());
+  for (size_t i = results.size(); i > 0; --i)
+  {
+    results[i - 1] = best.top();
+    best.pop();
+  }
+}
+
+// Neighbor selection heuristic.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::SelectNeighbors(
+    const std::vector<Candidate>& candidates,
+    const size_t maxLinks,
+    std::vector<size_t>& selected) const
+{
+  selected.clear();
+  for (size_t i = 0; i < candidates.size() && selected.size() < maxLinks; ++i)
+  {
+    // Skip candidates that are closer to an already selected neighbor than to
+    // the point; they can be reached through that neighbor.
+    bool keep = true;
+    for (size_t j = 0; j < selected.size(); ++j)
+    {
+      if (distance.Evaluate(referenceSet.col(candidates[i].second),
+          referenceSet.col(selected[j])) < candidates[i].first)
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      selected.push_back(candidates[i].second);
+  }
+}
+
+// Copy the neighbors of a point.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::GetLinks(
+    const size_t point,
+    const size_t layer,
+    std::vector<size_t>& links) const
+{
+  if (layer > levels[point])
+    links.clear();
+  else if (layer == 0)
+    links.assign(baseLinks.colptr(point),
+        baseLinks.colptr(point) + baseLinkCounts[point]);
+  else
+    links = upperLinks[point][layer - 1];
+}
+
+// Set the neighbors of a point.
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::SetLinks(
+    const size_t point,
+    const size_t layer,
+    const std::vector<size_t>& links)
+{
+  if (layer == 0)
+  {
+    std::copy(links.begin(), links.end(), baseLinks.colptr(point));
+    baseLinkCounts[point] = links.size();
+  }
+  else
+  {
+    upperLinks[point][layer - 1] = links;
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
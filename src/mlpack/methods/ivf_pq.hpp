@@ -0,0 +1,11 @@
+/**
+ * @file ivf_pq.hpp
+ *
+ * Convenience include for mlpack/methods/ivf_pq/ivf_pq_search.hpp
+ */
+#ifndef MLPACK_IVF_PQ_HPP
+#define MLPACK_IVF_PQ_HPP
+
+#include "ivf_pq/ivf_pq_search.hpp"
+
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search.hpp
+ *
+ * Defines the IVFPQSearch class, an inverted file index with product-quantized
+ * residuals for approximate nearest neighbor search on very large datasets.
+ * The method is described in the following paper:
+ *
+ * @code
+ * @article{jegou2011product,
+ *   title={Product Quantization for Nearest Neighbor Search},
+ *   author={J{\'e}gou, Herv{\'e} and Douze, Matthijs and Schmid, Cordelia},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={33},
+ *   number={1},
+ *   pages={117--128},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The IVFPQSearch class is a compressed index for approximate Euclidean
+ * nearest neighbor search.  A coarse k-means quantizer splits the space into
+ * numLists cells, each with its own inverted list.  The residual of each point
+ * with respect to its cell's centroid is split into numSubspaces subvectors,
+ * and each subvector is quantized with its own k-means codebook of at most 256
+ * codewords, so that a point is stored as numSubspaces bytes (plus its index)
+ * instead of its full vector.  The reference set itself is not kept.
+ *
+ * A search visits the numProbes cells closest to the query, and computes the
+ * distances to the points in these cells asymmetrically: for each cell, a
+ * lookup table of the squared distances between each subvector of the query
+ * residual and every codeword is built, and the distance to a point is the sum
+ * of numSubspaces table entries.  Optionally, more candidates than requested
+ * can be re-ranked with their exact distances to the original vectors.
+ *
+ * Since the original vectors are only needed for re-ranking, they do not need
+ * to be held in memory; for instance, they can be memory-mapped from a raw
+ * column-major file and wrapped without copying:
+ *
+ * @code
+ * extern arma::mat trainingSet; // A sample of the data.
+ * extern arma::mat queries;
+ * extern double* mappedData; // d x n doubles, e.g. from mmap().
+ *
+ * IVFPQSearch<> index(1024, 16);
+ * index.Train(trainingSet);
+ *
+ * // Add the data in chunks; the points get indices 0, 1, 2, ...
+ * arma::mat data(mappedData, d, n, false, true);
+ * for (size_t i = 0; i < n; i += 1000000)
+ *   index.Add(data.cols(i, std::min(i + 1000000, n) - 1));
+ *
+ * // Find 10 neighbors, re-ranking the best 100 candidates.
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * index.Search(queries, 10, neighbors, distances, data, 100);
+ * @endcode
+ *
+ * Adding points and searching are both parallelized with OpenMP.
+ *
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename MatType = arma::mat>
+class IVFPQSearch
+{
+ public:
+  /**
+   * Create an untrained index with the given parameters.  Call Train() and
+   * then Add() before calling Search().
+   *
+   * @param numLists Number of cells of the coarse quantizer.
+   * @param numSubspaces Number of subvectors each residual is split into;
+   *     this is the number of bytes each point is stored in.
+   * @param numCodewords Number of codewords of each subquantizer (at most
+   *     256).
+   * @param numProbes Number of cells visited by a search.
+   * @param maxIterations Maximum number of k-means iterations when training
+   *     the quantizers.
+   */
+  IVFPQSearch(const size_t numLists = 256,
+              const size_t numSubspaces = 8,
+              const size_t numCodewords = 256,
+              const size_t numProbes = 8,
+              const size_t maxIterations = 25);
+
+  /**
+   * Train the quantizers on the given reference set and add all of its points
+   * to the index.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of cells of the coarse quantizer.
+   * @param numSubspaces Number of subvectors each residual is split into.
+   * @param numCodewords Number of codewords of each subquantizer (at most
+   *     256).
+   * @param numProbes Number of cells visited by a search.
+   * @param maxIterations Maximum number of k-means iterations when training
+   *     the quantizers.
+   */
+  IVFPQSearch(const MatType& referenceSet,
+              const size_t numLists = 256,
+              const size_t numSubspaces = 8,
+              const size_t numCodewords = 256,
+              const size_t numProbes = 8,
+              const size_t maxIterations = 25);
+
+  /**
+   * Train the coarse quantizer and the subquantizers on the given data, and
+   * empty the index.  The data only needs to be a representative sample of the
+   * points that will be added; it is not added to the index.
+   *
+   * @param data Training data.
+   */
+  void Train(const MatType& data);
+
+  /**
+   * Encode the given points and add them to the index.  The points get the
+   * indices following the points already in the index.
+   *
+   * @param points Points to add.
+   */
+  void Add(const MatType& points);
+
+  /**
+   * Find the approximate k nearest neighbors of each query point, using the
+   * asymmetric distances to the encoded points.  If fewer than k points are
+   * found in the visited cells, the remaining neighbors are set to SIZE_MAX and
+   * the distances to DBL_MAX.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing (approximate) distances of neighbors for
+   *     each query point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Find the approximate k nearest neighbors of each query point, by taking
+   * the best numCandidates points by asymmetric distance and re-ranking them
+   * with their exact distances to the given original vectors.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing exact distances of neighbors for each
+   *     query point.
+   * @param originalSet Original vectors of the points in the index, in the
+   *     order they were added.
+   * @param numCandidates Number of candidates to re-rank (at least k are
+   *     used).
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              const MatType& originalSet,
+              const size_t numCandidates) const;
+
+  //! Get the number of cells of the coarse quantizer.
+  size_t NumLists() const { return numLists; }
+  //! Get the number of subvectors each residual is split into.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Get the number of codewords of each subquantizer.
+  size_t NumCodewords() const { return numCodewords; }
+
+  //! Get the number of cells visited by a search.
+  size_t NumProbes() const { return numProbes; }
+  //! Modify the number of cells visited by a search.
+  size_t& NumProbes() { return numProbes; }
+
+  //! Get the maximum number of k-means iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of k-means iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of points in the index.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the dimensionality of the data.
+  size_t Dimensionality() const { return centroids.n_rows; }
+
+  //! Get the centroids of the coarse quantizer (one per column).
+  const arma::mat& Centroids() const { return centroids; }
+  //! Get the codebook of each subquantizer (one codeword per column).
+  const std::vector<arma::mat>& Codebooks() const { return codebooks; }
+
+  //! Get the indices of the points in each cell.
+  const std::vector<std::vector<size_t>>& ListIndices() const
+  { return listIndices; }
+  //! Get the codes of the points in each cell (numSubspaces bytes per point).
+  const std::vector<std::vector<unsigned char>>& ListCodes() const
+  { return listCodes; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Candidate represents a point and its distance to a query (distance,
+  //! index).
+  typedef std::pair<double, size_t> Candidate;
+
+  /**
+   * Find the numCandidates best points for each query by asymmetric distance;
+   * re-rank them against the original set if it is given, and keep the best k.
+   */
+  void SearchInternal(const MatType& querySet,
+                      const size_t k,
+                      const size_t numCandidates,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const MatType* originalSet) const;
+
+  //! Get the squared distances between the given vector and every centroid.
+  arma::vec CentroidDistances(const arma::vec& point) const;
+
+  //! Get the first dimension of the given subspace.
+  size_t SubspaceBegin(const size_t subspace) const
+  {
+    return subspace * centroids.n_rows / numSubspaces;
+  }
+
+  //! Compute the squared norms of the centroids and codewords.
+  void ComputeNorms();
+
+  //! Number of cells of the coarse quantizer.
+  size_t numLists;
+  //! Number of subvectors each residual is split into.
+  size_t numSubspaces;
+  //! Number of codewords of each subquantizer.
+  size_t numCodewords;
+  //! Number of cells visited by a search.
+  size_t numProbes;
+  //! Maximum number of k-means iterations.
+  size_t maxIterations;
+
+  //! Centroids of the coarse quantizer.
+  arma::mat centroids;
+  //! Codebooks of the subquantizers.
+  std::vector<arma::mat> codebooks;
+
+  //! Squared norms of the centroids.
+  arma::vec centroidNorms;
+  //! Squared norms of the codewords of each subquantizer.
+  std::vector<arma::vec> codewordNorms;
+
+  //! Indices of the points in each cell.
+  std::vector<std::vector<size_t>> listIndices;
+  //! Codes of the points in each cell, numSubspaces bytes per point.
+  std::vector<std::vector<unsigned char>> listCodes;
+  //! Number of points in the index.
+  size_t numPoints;
+}; // class IVFPQSearch
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "ivf_pq_search_impl.hpp"
+
+#endif
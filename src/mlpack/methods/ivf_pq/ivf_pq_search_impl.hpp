@@ -0,0 +1,350 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search_impl.hpp
+ *
+ * Implementation of the IVFPQSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ivf_pq_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+// Construct an untrained index.
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCodewords,
+                                  const size_t numProbes,
+                                  const size_t maxIterations) :
+    numLists(numLists),
+    numSubspaces(numSubspaces),
+    numCodewords(numCodewords),
+    numProbes(numProbes),
+    maxIterations(maxIterations),
+    numPoints(0)
+{
+  if (numLists == 0)
+    throw std::invalid_argument("IVFPQSearch: numLists must be positive!");
+  if (numSubspaces == 0)
+    throw std::invalid_argument("IVFPQSearch: numSubspaces must be positive!");
+  if (numCodewords == 0 || numCodewords > 256)
+  {
+    throw std::invalid_argument("IVFPQSearch: numCodewords must be between 1 "
+        "and 256!");
+  }
+}
+
+// Train the index and add the reference set.
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const MatType& referenceSet,
+                                  const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCodewords,
+                                  const size_t numProbes,
+                                  const size_t maxIterations) :
+    IVFPQSearch(numLists, numSubspaces, numCodewords, numProbes,
+        maxIterations)
+{
+  Train(referenceSet);
+  Add(referenceSet);
+}
+
+// Train the quantizers.
+template<typename MatType>
+void IVFPQSearch<MatType>::Train(const MatType& data)
+{
+  if (numSubspaces > data.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Train(): numSubspaces (" << numSubspaces << ") must "
+        << "not be greater than the dimensionality of the data ("
+        << data.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (data.n_cols < std::max(numLists, numCodewords))
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Train(): need at least " << std::max(numLists,
+        numCodewords) << " training points, but only " << data.n_cols
+        << " were given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Train the coarse quantizer.
+  kmeans::KMeans<metric::EuclideanDistance, kmeans::SampleInitialization,
+      kmeans::MaxVarianceNewCluster, kmeans::NaiveKMeans, MatType>
+      coarse(maxIterations);
+  arma::Row<size_t> assignments;
+  coarse.Cluster(data, numLists, assignments, centroids);
+
+  // Train one subquantizer on each subvector of the residuals.
+  const arma::mat residuals = arma::conv_to<arma::mat>::from(data) -
+      centroids.cols(arma::conv_to<arma::uvec>::from(assignments));
+  codebooks.resize(numSubspaces);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    kmeans::KMeans<> subquantizer(maxIterations);
+    const arma::mat subResiduals = residuals.rows(SubspaceBegin(s),
+        SubspaceBegin(s + 1) - 1);
+    subquantizer.Cluster(subResiduals, numCodewords, codebooks[s]);
+  }
+
+  ComputeNorms();
+
+  // Empty the index.
+  listIndices.clear();
+  listIndices.resize(numLists);
+  listCodes.clear();
+  listCodes.resize(numLists);
+  numPoints = 0;
+}
+
+// Encode and add points.
+template<typename MatType>
+void IVFPQSearch<MatType>::Add(const MatType& points)
+{
+  if (centroids.n_cols == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Add(): the index is not "
+        "trained; call Train() first!");
+  }
+
+  if (points.n_rows != centroids.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Add(): dimensionality of points (" << points.n_rows
+        << ") does not match dimensionality of the index (" << centroids.n_rows
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Encode the points in parallel.
+  arma::Row<size_t> lists(points.n_cols);
+  arma::Mat<unsigned char> codes(numSubspaces, points.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const arma::vec point = arma::conv_to<arma::vec>::from(points.col(i));
+    lists[i] = CentroidDistances(point).index_min();
+
+    const arma::vec residual = point - centroids.col(lists[i]);
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const arma::vec sub = residual.subvec(SubspaceBegin(s),
+          SubspaceBegin(s + 1) - 1);
+      // ||c - r||^2 = ||c||^2 - 2 c^T r + ||r||^2; the last term is constant.
+      const arma::vec d = codewordNorms[s] - 2 * codebooks[s].t() * sub;
+      codes(s, i) = (unsigned char) d.index_min();
+    }
+  }
+
+  // Append them to their lists.
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    listIndices[lists[i]].push_back(numPoints + i);
+    listCodes[lists[i]].insert(listCodes[lists[i]].end(), codes.colptr(i),
+        codes.colptr(i) + numSubspaces);
+  }
+
+  numPoints += points.n_cols;
+}
+
+// Search with asymmetric distances only.
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::mat& distances) const
+{
+  SearchInternal(querySet, k, k, neighbors, distances, NULL);
+}
+
+// Search with re-ranking against the original vectors.
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::mat& distances,
+                                  const MatType& originalSet,
+                                  const size_t numCandidates) const
+{
+  if (originalSet.n_rows != centroids.n_rows ||
+      originalSet.n_cols != numPoints)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Search(): the original set must be "
+        << centroids.n_rows << " x " << numPoints << ", but it is "
+        << originalSet.n_rows << " x " << originalSet.n_cols << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  SearchInternal(querySet, k, std::max(k, numCandidates), neighbors,
+      distances, &originalSet);
+}
+
+// Serialize the index.
+template<typename MatType>
+template<typename Archive>
+void IVFPQSearch<MatType>::serialize(Archive& ar,
+                                     const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numLists));
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(numCodewords));
+  ar(CEREAL_NVP(numProbes));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(listIndices));
+  ar(CEREAL_NVP(listCodes));
+  ar(CEREAL_NVP(numPoints));
+
+  // The norms are cheap to recompute.
+  if (cereal::is_loading<Archive>())
+    ComputeNorms();
+}
+
+// Find the best candidates of each query.
+template<typename MatType>
+void IVFPQSearch<MatType>::SearchInternal(const MatType& querySet,
+                                          const size_t k,
+                                          const size_t numCandidates,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances,
+                                          const MatType* originalSet) const
+{
+  if (numPoints == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the index is empty; "
+        "call Train() and Add() first!");
+  }
+
+  if (querySet.n_rows != centroids.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") does not match dimensionality of the index ("
+        << centroids.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(DBL_MAX);
+
+  const size_t probes = std::min(std::max(numProbes, (size_t) 1), numLists);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    const arma::vec query = arma::conv_to<arma::vec>::from(querySet.col(i));
+
+    // Find the closest cells.
+    const arma::uvec cells = arma::sort_index(CentroidDistances(query));
+
+    // The best candidates so far, worst first.
+    std::priority_queue<Candidate> best;
+    arma::mat table(numCodewords, numSubspaces);
+    for (size_t p = 0; p < probes; ++p)
+    {
+      const size_t cell = cells[p];
+      const std::vector<size_t>& indices = listIndices[cell];
+      if (indices.empty())
+        continue;
+
+      // Build the lookup table of the squared distances between each
+      // subvector of the query residual and every codeword.
+      const arma::vec residual = query - centroids.col(cell);
+      for (size_t s = 0; s < numSubspaces; ++s)
+      {
+        const arma::vec sub = residual.subvec(SubspaceBegin(s),
+            SubspaceBegin(s + 1) - 1);
+        table.col(s) = codewordNorms[s] - 2 * codebooks[s].t() * sub +
+            arma::dot(sub, sub);
+      }
+
+      // Scan the codes of the cell.
+      const unsigned char* code = listCodes[cell].data();
+      const double* tablePtr = table.memptr();
+      for (size_t j = 0; j < indices.size(); ++j, code += numSubspaces)
+      {
+        double d = 0.0;
+        for (size_t s = 0; s < numSubspaces; ++s)
+          d += tablePtr[s * numCodewords + code[s]];
+
+        if (best.size() < numCandidates)
+          best.push(Candidate(d, indices[j]));
+        else if (d < best.top().first)
+        {
+          best.pop();
+          best.push(Candidate(d, indices[j]));
+        }
+      }
+    }
+
+    std::vector<Candidate> results(best.size());
+    for (size_t j = results.size(); j > 0; --j)
+    {
+      results[j - 1] = best.top();
+      best.pop();
+    }
+
+    if (originalSet)
+    {
+      // Re-rank with the exact distances.
+      for (size_t j = 0; j < results.size(); ++j)
+      {
+        results[j].first = arma::norm(query - arma::conv_to<arma::vec>::from(
+            originalSet->col(results[j].second)));
+      }
+      std::sort(results.begin(), results.end());
+    }
+    else
+    {
+      // The lookup tables hold squared distances, and quantization error can
+      // make them slightly negative.
+      for (size_t j = 0; j < results.size(); ++j)
+        results[j].first = std::sqrt(std::max(results[j].first, 0.0));
+    }
+
+    const size_t found = std::min(k, results.size());
+    for (size_t j = 0; j < found; ++j)
+    {
+      neighbors(j, i) = results[j].second;
+      distances(j, i) = results[j].first;
+    }
+  }
+}
+
+// Get the squared distances to the centroids.
+template<typename MatType>
+arma::vec IVFPQSearch<MatType>::CentroidDistances(const arma::vec& point) const
+{
+  return centroidNorms - 2 * centroids.t() * point + arma::dot(point, point);
+}
+
+// Compute the squared norms of the centroids and codewords.
+template<typename MatType>
+void IVFPQSearch<MatType>::ComputeNorms()
+{
+  centroidNorms = arma::sum(arma::square(centroids), 0).t();
+  codewordNorms.resize(codebooks.size());
+  for (size_t s = 0; s < codebooks.size(); ++s)
+    codewordNorms[s] = arma::sum(arma::square(codebooks[s]), 0).t();
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
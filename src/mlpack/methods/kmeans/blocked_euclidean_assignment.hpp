@@ -0,0 +1,157 @@
+/**
+ * @file methods/kmeans/blocked_euclidean_assignment.hpp
+ *
+ * Assignment of points to their nearest centroids under the Euclidean distance
+ * with one matrix multiplication per block of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_EUCLIDEAN_ASSIGNMENT_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_EUCLIDEAN_ASSIGNMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * Whether the nearest centroids under the given metric and for the given
+ * matrix type can be found with BlockedEuclideanAssignment.  This is only the
+ * case for the (squared or not) Euclidean distance on dense matrices.
+ */
+template<typename MetricType, typename MatType>
+struct BlockedEuclideanAssignmentTraits
+{
+  static const bool Supported = false;
+};
+
+//! The Euclidean distance on dense matrices is supported.
+template<bool TakeRoot, typename eT>
+struct BlockedEuclideanAssignmentTraits<metric::LMetric<2, TakeRoot>,
+                                        arma::Mat<eT>>
+{
+  static const bool Supported = true;
+};
+
+/**
+ * Find the nearest centroid of every point under the Euclidean distance, with
+ * the expansion
+ *
+ *   || x - c ||^2 = || x ||^2 - 2 c^T x + || c ||^2.
+ *
+ * The first term does not depend on the centroid, so the nearest centroid of
+ * each point of a block X minimizes || c ||^2 - 2 (C^T X)(c, x), and all the
+ * inner products of a block are computed by a single matrix multiplication
+ * (one BLAS GEMM call).  The minimum of each column is found while the tile is
+ * still in cache.
+ *
+ * This is only worthwhile when both the dimensionality and the number of
+ * centroids are large enough for the multiplication to dominate; see
+ * Worthwhile().  The functions return false without doing anything when the
+ * metric and matrix type are not supported or the problem is too small, so
+ * that callers can fall back to evaluating the metric directly.
+ */
+class BlockedEuclideanAssignment
+{
+ public:
+  //! The number of points in each block.
+  static const size_t BlockSize = 256;
+
+  /**
+   * Return whether the blocked computation is worthwhile for the given
+   * dimensionality and number of clusters.
+   */
+  static bool Worthwhile(const size_t dimensionality, const size_t clusters)
+  {
+    return (dimensionality >= 16 && clusters >= 16);
+  }
+
+  /**
+   * Assign every point of the dataset to its nearest centroid, and accumulate
+   * the sum and the number of the points of each centroid.  The points are
+   * processed in parallel, with one set of sums per thread.
+   *
+   * @param data Dataset.
+   * @param centroids Current centroids.
+   * @param sums Sum of the points assigned to each centroid (output).
+   * @param counts Number of points assigned to each centroid (output).
+   * @return Whether the assignment was done.
+   */
+  template<typename MetricType, typename MatType>
+  static bool Accumulate(
+      const MatType& data,
+      const arma::mat& centroids,
+      arma::mat& sums,
+      arma::Col<size_t>& counts,
+      const typename std::enable_if<BlockedEuclideanAssignmentTraits<
+          MetricType, MatType>::Supported>::type* = 0);
+
+  //! The metric or matrix type is not supported.
+  template<typename MetricType, typename MatType>
+  static bool Accumulate(
+      const MatType& /* data */,
+      const arma::mat& /* centroids */,
+      arma::mat& /* sums */,
+      arma::Col<size_t>& /* counts */,
+      const typename std::enable_if<!BlockedEuclideanAssignmentTraits<
+          MetricType, MatType>::Supported>::type* = 0)
+  {
+    return false;
+  }
+
+  /**
+   * Assign every point of the dataset to its nearest centroid, in parallel.
+   *
+   * @param data Dataset.
+   * @param centroids Centroids.
+   * @param assignments Index of the nearest centroid of each point (output).
+   * @return Whether the assignment was done.
+   */
+  template<typename MetricType, typename MatType>
+  static bool Assign(
+      const MatType& data,
+      const arma::mat& centroids,
+      arma::Row<size_t>& assignments,
+      const typename std::enable_if<BlockedEuclideanAssignmentTraits<
+          MetricType, MatType>::Supported>::type* = 0);
+
+  //! The metric or matrix type is not supported.
+  template<typename MetricType, typename MatType>
+  static bool Assign(
+      const MatType& /* data */,
+      const arma::mat& /* centroids */,
+      arma::Row<size_t>& /* assignments */,
+      const typename std::enable_if<!BlockedEuclideanAssignmentTraits<
+          MetricType, MatType>::Supported>::type* = 0)
+  {
+    return false;
+  }
+
+ private:
+  /**
+   * Find the nearest centroid of each point in the given block.
+   *
+   * @param block Points of the block.
+   * @param centroidsT Transposed centroids.
+   * @param centroidNorms Squared norms of the centroids.
+   * @param tile Storage for the inner products.
+   * @param assignments Nearest centroid of each point of the block (output).
+   */
+  static void AssignBlock(const arma::mat& block,
+                          const arma::mat& centroidsT,
+                          const arma::vec& centroidNorms,
+                          arma::mat& tile,
+                          size_t* assignments);
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_euclidean_assignment_impl.hpp"
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file methods/kmeans/blocked_euclidean_assignment_impl.hpp
+ *
+ * Implementation of BlockedEuclideanAssignment.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_EUCLIDEAN_ASSIGNMENT_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_EUCLIDEAN_ASSIGNMENT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_euclidean_assignment.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+bool BlockedEuclideanAssignment::Accumulate(
+    const MatType& data,
+    const arma::mat& centroids,
+    arma::mat& sums,
+    arma::Col<size_t>& counts,
+    const typename std::enable_if<BlockedEuclideanAssignmentTraits<
+        MetricType, MatType>::Supported>::type* /* junk */)
+{
+  if (!Worthwhile(centroids.n_rows, centroids.n_cols))
+    return false;
+
+  const arma::mat centroidsT = centroids.t();
+  const arma::vec centroidNorms = arma::sum(arma::square(centroids), 0).t();
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+
+  sums.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  #pragma omp parallel
+  {
+    // The sums and counts are private for each thread.
+    arma::mat localSums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::mat tile;
+    size_t blockAssignments[BlockSize];
+
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * BlockSize;
+      const size_t end = std::min(begin + BlockSize, (size_t) data.n_cols);
+      const arma::mat block = arma::conv_to<arma::mat>::from(
+          data.cols(begin, end - 1));
+
+      AssignBlock(block, centroidsT, centroidNorms, tile, blockAssignments);
+
+      for (size_t i = 0; i < block.n_cols; ++i)
+      {
+        localSums.unsafe_col(blockAssignments[i]) += block.unsafe_col(i);
+        ++localCounts(blockAssignments[i]);
+      }
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      sums += localSums;
+      counts += localCounts;
+    }
+  }
+
+  return true;
+}
+
+template<typename MetricType, typename MatType>
+bool BlockedEuclideanAssignment::Assign(
+    const MatType& data,
+    const arma::mat& centroids,
+    arma::Row<size_t>& assignments,
+    const typename std::enable_if<BlockedEuclideanAssignmentTraits<
+        MetricType, MatType>::Supported>::type* /* junk */)
+{
+  if (!Worthwhile(centroids.n_rows, centroids.n_cols))
+    return false;
+
+  const arma::mat centroidsT = centroids.t();
+  const arma::vec centroidNorms = arma::sum(arma::square(centroids), 0).t();
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+
+  assignments.set_size(data.n_cols);
+
+  #pragma omp parallel
+  {
+    arma::mat tile;
+
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * BlockSize;
+      const size_t end = std::min(begin + BlockSize, (size_t) data.n_cols);
+      const arma::mat block = arma::conv_to<arma::mat>::from(
+          data.cols(begin, end - 1));
+
+      AssignBlock(block, centroidsT, centroidNorms, tile,
+          assignments.memptr() + begin);
+    }
+  }
+
+  return true;
+}
+
+inline void BlockedEuclideanAssignment::AssignBlock(
+    const arma::mat& block,
+    const arma::mat& centroidsT,
+    const arma::vec& centroidNorms,
+    arma::mat& tile,
+    size_t* assignments)
+{
+  tile = centroidsT * block;
+
+  for (size_t i = 0; i < block.n_cols; ++i)
+  {
+    const double* innerProducts = tile.colptr(i);
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroidsT.n_rows; // Invalid value.
+    for (size_t j = 0; j < centroidsT.n_rows; ++j)
+    {
+      // This is the squared distance, minus the squared norm of the point.
+      const double distance = centroidNorms[j] - 2.0 * innerProducts[j];
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroidsT.n_rows);
+    assignments[i] = closestCluster;
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
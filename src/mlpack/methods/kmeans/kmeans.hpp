@@ -17,6 +17,7 @@
 // Include initialization strategies.
 #include "sample_initialization.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "random_partition.hpp"
 
 // Include empty cluster policies.
@@ -30,6 +31,8 @@
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 
 namespace mlpack {
 namespace kmeans /** K-Means clustering. */ {
@@ -165,6 +168,50 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Perform k-means clustering on the data, returning the centroids of each
+   * cluster, with a Lloyd step that has already been constructed on the data.
+   * This can be used to configure the Lloyd step before clustering (for
+   * instance, to set the batch size of MiniBatchKMeans).  The Lloyd step must
+   * have been constructed with the same dataset and with Metric().
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param lloydStep Lloyd step to use for each iteration.
+   * @param initialGuess If true, then it is assumed that centroids contains the
+   *      initial cluster centroids.
+   */
+  void Cluster(const MatType& data,
+               size_t clusters,
+               arma::mat& centroids,
+               LloydStepType<MetricType, MatType>& lloydStep,
+               const bool initialGuess = false);
+
+  /**
+   * Perform k-means clustering on the data, returning a list of cluster
+   * assignments and also the centroids of each cluster, with a Lloyd step that
+   * has already been constructed on the data.  See the overload above without
+   * a Lloyd step for the meaning of the other parameters.
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param assignments Vector to store cluster assignments in.
+   * @param centroids Matrix in which centroids are stored.
+   * @param lloydStep Lloyd step to use for each iteration.
+   * @param initialAssignmentGuess If true, then it is assumed that assignments
+   *      has a list of initial cluster assignments.
+   * @param initialCentroidGuess If true, then it is assumed that centroids
+   *      contains the initial centroids of each cluster.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::Row<size_t>& assignments,
+               arma::mat& centroids,
+               LloydStepType<MetricType, MatType>& lloydStep,
+               const bool initialAssignmentGuess = false,
+               const bool initialCentroidGuess = false);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
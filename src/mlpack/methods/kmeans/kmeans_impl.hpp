@@ -150,6 +150,31 @@ Cluster(const MatType& data,
         const size_t clusters,
         arma::mat& centroids,
         const bool initialGuess)
+{
+  LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  Cluster(data, clusters, centroids, lloydStep, initialGuess);
+}
+
+/**
+ * Perform k-means clustering on the data with the given Lloyd step, returning
+ * the centroids of each cluster.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::mat& centroids,
+        LloydStepType<MetricType, MatType>& lloydStep,
+        const bool initialGuess)
 {
   // Make sure we have more points than clusters.
   if (clusters > data.n_cols)
@@ -201,7 +226,6 @@ Cluster(const MatType& data,
 
   size_t iteration = 0;
 
-  LloydStepType<MetricType, MatType> lloydStep(data, metric);
   arma::mat centroidsOther;
   double cNorm;
 
@@ -278,6 +302,34 @@ Cluster(const MatType& data,
         arma::mat& centroids,
         const bool initialAssignmentGuess,
         const bool initialCentroidGuess)
+{
+  LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  Cluster(data, clusters, assignments, centroids, lloydStep,
+      initialAssignmentGuess, initialCentroidGuess);
+}
+
+/**
+ * Perform k-means clustering on the data with the given Lloyd step, returning
+ * a list of cluster assignments and the centroids of each cluster.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::Row<size_t>& assignments,
+        arma::mat& centroids,
+        LloydStepType<MetricType, MatType>& lloydStep,
+        const bool initialAssignmentGuess,
+        const bool initialCentroidGuess)
 {
   // Now, the initial assignments.  First determine if they are necessary.
   if (initialAssignmentGuess)
@@ -299,10 +351,15 @@ Cluster(const MatType& data,
         centroids.col(i) /= counts[i];
   }
 
-  Cluster(data, clusters, centroids,
+  Cluster(data, clusters, centroids, lloydStep,
       initialAssignmentGuess || initialCentroidGuess);
 
-  // Calculate final assignments in parallel over the entire dataset.
+  // Calculate final assignments in parallel over the entire dataset.  For the
+  // Euclidean distance, this may be done with blocked matrix multiplications.
+  if (BlockedEuclideanAssignment::Assign<MetricType>(data, centroids,
+      assignments))
+    return;
+
   assignments.set_size(data.n_cols);
 
   #pragma omp parallel for
@@ -21,10 +21,13 @@
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 
 using namespace mlpack;
 using namespace mlpack::math;
@@ -59,16 +62,28 @@ BINDING_LONG_DESC(
     "samplings, the " + PRINT_PARAM_STRING("samplings") + " parameter is used, "
     "and to specify the percentage of the dataset to be used in each sample, "
     "the " + PRINT_PARAM_STRING("percentage") + " parameter is used (it should "
-    "be a value between 0.0 and 1.0)."
+    "be a value between 0.0 and 1.0).  For large numbers of clusters, the "
+    "k-means|| algorithm (\"Scalable K-Means++\", 2012) can be used with the "
+    + PRINT_PARAM_STRING("kmeans_parallel") + " parameter; it samples "
+    "candidate centroids in " + PRINT_PARAM_STRING("rounds") + " passes over "
+    "the data, each sampling about " +
+    PRINT_PARAM_STRING("oversampling_factor") + " times the number of "
+    "clusters, and then reclusters the candidates."
     "\n\n"
     "There are several options available for the algorithm used for each Lloyd "
     "iteration, specified with the " + PRINT_PARAM_STRING("algorithm") + " "
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
-    "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "modification to Elkan's algorithm ('hamerly'), the Yinyang algorithm, "
+    "which keeps bounds for groups of centroids ('yinyang'), the dual-tree "
+    "k-means algorithm ('dualtree'), and the dual-tree k-means algorithm using "
+    "the cover tree ('dualtree-covertree').  All of these give the same result "
+    "as the naive algorithm.  The approximate mini-batch algorithm "
+    "('minibatch') instead updates the centroids with a random batch of " +
+    PRINT_PARAM_STRING("batch_size") + " points at each iteration, which is "
+    "much cheaper per iteration on large datasets; it should be used with a "
+    "limit on the number of iterations."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -111,6 +126,8 @@ BINDING_EXAMPLE(
 BINDING_SEE_ALSO("K-Means tutorial", "@doxygen/kmtutorial.html");
 BINDING_SEE_ALSO("@dbscan", "#dbscan");
 BINDING_SEE_ALSO("k-means++", "https://en.wikipedia.org/wiki/K-means%2B%2B");
+BINDING_SEE_ALSO("Scalable K-Means++ (pdf)",
+        "http://vldb.org/pvldb/vol5/p622_bahmanbahmani_vldb2012.pdf");
 BINDING_SEE_ALSO("Using the triangle inequality to accelerate k-means (pdf)",
         "http://www.aaai.org/Papers/ICML/2003/ICML03-022.pdf");
 BINDING_SEE_ALSO("Making k-means even faster (pdf)",
@@ -119,6 +136,11 @@ BINDING_SEE_ALSO("Making k-means even faster (pdf)",
 BINDING_SEE_ALSO("Accelerating exact k-means algorithms with geometric"
         " reasoning (pdf)", "http://reports-archive.adm.cs.cmu.edu/anon/anon"
         "/usr/ftp/usr0/ftp/2000/CMU-CS-00-105.pdf");
+BINDING_SEE_ALSO("Yinyang K-Means: A Drop-In Replacement of the Classic "
+        "K-Means with Consistent Speedup (pdf)",
+        "http://proceedings.mlr.press/v37/ding15.pdf");
+BINDING_SEE_ALSO("Web-scale k-means clustering (pdf)",
+        "https://www.eecs.tufts.edu/~dsculley/papers/fastkmeans.pdf");
 BINDING_SEE_ALSO("A dual-tree algorithm for fast k-means clustering with large "
         "k (pdf)", "http://www.ratml.org/pub/pdf/2017dual.pdf");
 BINDING_SEE_ALSO("mlpack::kmeans::KMeans class documentation",
@@ -159,9 +181,21 @@ PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
 PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
     "choose initial points.", "K");
 
+// Parameters for k-means|| initialization.
+PARAM_FLAG("kmeans_parallel", "Use the k-means|| (scalable k-means++) "
+    "initialization strategy to choose initial points.", "");
+PARAM_INT_IN("rounds", "Number of sampling rounds for k-means|| (use when "
+    "--kmeans_parallel is specified).", "", 5);
+PARAM_DOUBLE_IN("oversampling_factor", "Expected number of points sampled in "
+    "each k-means|| round, as a multiple of the number of clusters (use when "
+    "--kmeans_parallel is specified).", "", 2.0);
+
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'yinyang', 'dualtree', "
+    "'dualtree-covertree', or 'minibatch').", "a", "naive");
+PARAM_INT_IN("batch_size", "Number of points sampled at each iteration of "
+    "mini-batch k-means; 0 uses the whole dataset (use when --algorithm is "
+    "'minibatch').", "", 1000);
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -193,7 +227,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     RandomSeed((size_t) std::time(NULL));
 
-  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus" }, true,
+  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus",
+      "kmeans_parallel" }, true,
       "Only one initialization strategy can be specified!", true);
 
   // Now, start building the KMeans type that we'll be using.  Start with the
@@ -217,6 +252,18 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     FindEmptyClusterPolicy<KMeansPlusPlusInitialization>(params, timers,
         KMeansPlusPlusInitialization());
   }
+  else if (params.Has("kmeans_parallel"))
+  {
+    RequireParamValue<int>(params, "rounds", [](int x) { return x > 0; },
+        true, "number of rounds must be positive");
+    RequireParamValue<double>(params, "oversampling_factor",
+        [](double x) { return x > 0.0; }, true, "oversampling factor must be "
+        "positive");
+
+    FindEmptyClusterPolicy<KMeansParallelInitialization>(params, timers,
+        KMeansParallelInitialization((size_t) params.Get<int>("rounds"),
+        params.Get<double>("oversampling_factor")));
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(params, timers,
@@ -263,7 +310,8 @@ void FindLloydStepType(util::Params& params,
                        const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>(params, "algorithm", { "elkan", "hamerly",
-      "pelleg-moore", "dualtree", "dualtree-covertree", "naive" }, true,
+      "yinyang", "pelleg-moore", "dualtree", "dualtree-covertree", "minibatch",
+      "naive" }, true,
       "unknown k-means algorithm");
 
   const string algorithm = params.Get<string>("algorithm");
@@ -277,6 +325,11 @@ void FindLloydStepType(util::Params& params,
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, HamerlyKMeans>(
         params, timers, ipp);
   }
+  else if (algorithm == "yinyang")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, YinyangKMeans>(
+        params, timers, ipp);
+  }
   else if (algorithm == "pelleg-moore")
   {
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
@@ -292,6 +345,11 @@ void FindLloydStepType(util::Params& params,
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
         CoverTreeDualTreeKMeans>(params, timers, ipp);
   }
+  else if (algorithm == "minibatch")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, MiniBatchKMeans>(
+        params, timers, ipp);
+  }
   else if (algorithm == "naive")
   {
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(params,
@@ -299,6 +357,24 @@ void FindLloydStepType(util::Params& params,
   }
 }
 
+// Set the parameters of the Lloyd step from the command line.  Most Lloyd
+// steps have no parameters.
+template<typename LloydStepType>
+void SetLloydStepParameters(util::Params& /* params */,
+                            LloydStepType& /* lloydStep */)
+{
+  // Nothing to do.
+}
+
+// Mini-batch k-means needs to know how many points to sample at each
+// iteration.
+void SetLloydStepParameters(
+    util::Params& params,
+    MiniBatchKMeans<metric::EuclideanDistance, arma::mat>& lloydStep)
+{
+  lloydStep.BatchSize() = (size_t) params.Get<int>("batch_size");
+}
+
 // Given the template parameters, sanitize/load input and run k-means.
 template<typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
@@ -329,6 +405,17 @@ void RunKMeans(util::Params& params,
       true, "maximum iterations must be positive or 0 (for no limit)");
   const int maxIterations = params.Get<int>("max_iterations");
 
+  if (params.Get<string>("algorithm") == "minibatch")
+  {
+    RequireParamValue<int>(params, "batch_size", [](int x) { return x >= 0; },
+        true, "batch size must be positive or 0 (for the whole dataset)");
+  }
+  else
+  {
+    ReportIgnoredParam(params, "batch_size", "only the 'minibatch' algorithm "
+        "uses it");
+  }
+
   // Make sure we have an output file if we're not doing the work in-place.
   RequireOnlyOnePassed(params, { "in_place", "output", "centroid" }, false,
       "no results will be saved");
@@ -357,11 +444,17 @@ void RunKMeans(util::Params& params,
          EmptyClusterPolicy,
          LloydStepType> kmeans(maxIterations, metric::EuclideanDistance(), ipp);
 
+  // Build the Lloyd step here, so that its parameters can be set from the
+  // command line.
+  LloydStepType<metric::EuclideanDistance, arma::mat> lloydStep(dataset,
+      kmeans.Metric());
+  SetLloydStepParameters(params, lloydStep);
+
   if (params.Has("output") || params.Has("in_place"))
   {
     // We need to get the assignments.
     arma::Row<size_t> assignments;
-    kmeans.Cluster(dataset, clusters, assignments, centroids,
+    kmeans.Cluster(dataset, clusters, assignments, centroids, lloydStep,
         false, initialCentroidGuess);
     timers.Stop("clustering");
 
@@ -406,7 +499,8 @@ void RunKMeans(util::Params& params,
   else
   {
     // Just save the centroids.
-    kmeans.Cluster(dataset, clusters, centroids, initialCentroidGuess);
+    kmeans.Cluster(dataset, clusters, centroids, lloydStep,
+        initialCentroidGuess);
     timers.Stop("clustering");
   }
 
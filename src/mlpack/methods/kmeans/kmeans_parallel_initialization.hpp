@@ -0,0 +1,115 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file implements the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable K-Means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * k-means++ needs k passes over the data, one for each centroid.  Instead,
+ * k-means|| starts from one random point and, in each of a few rounds, samples
+ * every point independently with probability proportional to its squared
+ * distance to the closest candidate so far, oversampling about l = factor * k
+ * candidates per round.  Each candidate is then weighted by the number of
+ * points closest to it, and the weighted candidates are reclustered into k
+ * centroids with weighted k-means++ followed by a few weighted Lloyd
+ * iterations.  Each round is a parallel pass over the data.
+ *
+ * This class satisfies the InitialPartitionPolicy requirements of KMeans.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object.
+   *
+   * @param rounds Number of sampling rounds.
+   * @param oversamplingFactor Expected number of candidates sampled in each
+   *     round, as a multiple of the number of clusters.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversamplingFactor = 2.0) :
+      rounds(rounds), oversamplingFactor(oversamplingFactor) { }
+
+  /**
+   * Initialize the centroids matrix with the k-means|| algorithm.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor.
+  double OversamplingFactor() const { return oversamplingFactor; }
+  //! Modify the oversampling factor.
+  double& OversamplingFactor() { return oversamplingFactor; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(oversamplingFactor));
+  }
+
+ private:
+  /**
+   * Cluster the weighted candidates into the given number of centroids with
+   * weighted k-means++ seeding and a few weighted Lloyd iterations.
+   */
+  static void Recluster(const arma::mat& candidates,
+                        const arma::vec& weights,
+                        const size_t clusters,
+                        arma::mat& centroids);
+
+  //! The number of sampling rounds.
+  size_t rounds;
+  //! The expected number of candidates of each round, relative to k.
+  double oversamplingFactor;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
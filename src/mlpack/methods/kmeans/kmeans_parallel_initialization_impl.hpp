@@ -0,0 +1,197 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| initialization strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+#include "blocked_euclidean_assignment.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  // Start with one point sampled fully randomly.
+  std::vector<size_t> candidates;
+  candidates.push_back(math::RandInt(0, data.n_cols));
+
+  // The squared distance between each point and its closest candidate.
+  arma::vec minDistances(data.n_cols);
+  minDistances.fill(std::numeric_limits<double>::max());
+
+  const double expectedSamples = oversamplingFactor * clusters;
+  size_t newCandidates = 0;
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    // Update the distances with the candidates of the last round, in parallel.
+    double cost = 0.0;
+
+    #pragma omp parallel for reduction(+:cost)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      for (size_t c = newCandidates; c < candidates.size(); ++c)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), data.col(candidates[c]));
+        minDistances[i] = std::min(distance, minDistances[i]);
+      }
+      cost += minDistances[i];
+    }
+
+    newCandidates = candidates.size();
+    if (cost == 0.0)
+      break;
+
+    // Sample each point independently.  Random numbers are drawn by this
+    // thread only, so the result only depends on the random seed.
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      if (math::Random() < expectedSamples * minDistances[i] / cost)
+        candidates.push_back(i);
+    }
+
+    Log::Info << "KMeansParallelInitialization::Cluster(): " << candidates.size()
+        << " candidates after round " << (r + 1) << "." << std::endl;
+  }
+
+  arma::mat candidateMat(data.n_rows, candidates.size());
+  for (size_t c = 0; c < candidates.size(); ++c)
+    candidateMat.col(c) = data.col(candidates[c]);
+
+  // If there are not more candidates than clusters, there is nothing to
+  // recluster; fill the rest with random points.
+  if (candidates.size() <= clusters)
+  {
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.size() - 1) = candidateMat;
+    for (size_t c = candidates.size(); c < clusters; ++c)
+      centroids.col(c) = data.col(math::RandInt(0, data.n_cols));
+    return;
+  }
+
+  // Weight each candidate by the number of points closest to it.
+  arma::Row<size_t> assignments;
+  if (!BlockedEuclideanAssignment::Assign<metric::EuclideanDistance>(data,
+      candidateMat, assignments))
+  {
+    assignments.set_size(data.n_cols);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      double minDistance = std::numeric_limits<double>::infinity();
+      for (size_t c = 0; c < candidateMat.n_cols; ++c)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), candidateMat.col(c));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          assignments[i] = c;
+        }
+      }
+    }
+  }
+
+  arma::vec weights(candidateMat.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    weights[assignments[i]] += 1.0;
+
+  Recluster(candidateMat, weights, clusters, centroids);
+}
+
+inline void KMeansParallelInitialization::Recluster(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids)
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Weighted k-means++: sample each centroid with probability proportional to
+  // the weight of the candidate times its squared distance to the closest
+  // centroid so far.  The first one only depends on the weights.
+  arma::vec minDistances(candidates.n_cols);
+  minDistances.fill(std::numeric_limits<double>::max());
+  arma::vec distribution = weights;
+  for (size_t k = 0; k < clusters; ++k)
+  {
+    if (k > 0)
+    {
+      #pragma omp parallel for
+      for (size_t c = 0; c < (size_t) candidates.n_cols; ++c)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            candidates.col(c), centroids.col(k - 1));
+        minDistances[c] = std::min(distance, minDistances[c]);
+        distribution[c] = weights[c] * minDistances[c];
+      }
+    }
+
+    const double sampleValue = math::Random() * arma::accu(distribution);
+    double cumulative = 0.0;
+    size_t position = 0;
+    for (; position < candidates.n_cols - 1; ++position)
+    {
+      cumulative += distribution[position];
+      if (cumulative > sampleValue)
+        break;
+    }
+
+    centroids.col(k) = candidates.col(position);
+  }
+
+  // Now refine with weighted Lloyd iterations on the candidates.
+  const size_t lloydIterations = 10;
+  arma::Row<size_t> assignments(candidates.n_cols);
+  for (size_t it = 0; it < lloydIterations; ++it)
+  {
+    #pragma omp parallel for
+    for (size_t c = 0; c < (size_t) candidates.n_cols; ++c)
+    {
+      double minDistance = std::numeric_limits<double>::infinity();
+      for (size_t k = 0; k < clusters; ++k)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            candidates.col(c), centroids.col(k));
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          assignments[c] = k;
+        }
+      }
+    }
+
+    arma::mat sums(candidates.n_rows, clusters, arma::fill::zeros);
+    arma::vec totalWeights(clusters, arma::fill::zeros);
+    for (size_t c = 0; c < candidates.n_cols; ++c)
+    {
+      sums.col(assignments[c]) += weights[c] * candidates.col(c);
+      totalWeights[assignments[c]] += weights[c];
+    }
+
+    // Centroids without any weight stay where they are.
+    for (size_t k = 0; k < clusters; ++k)
+    {
+      if (totalWeights[k] > 0.0)
+        centroids.col(k) = sums.col(k) / totalWeights[k];
+    }
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -28,6 +28,11 @@
  * In accordance with mlpack's InitialPartitionPolicy template type, we only
  * need to implement a constructor and a method to compute the initial
  * centroids.
+ *
+ * The distances of the points to the closest centroid are kept between
+ * iterations, so each new centroid costs one parallel pass over the data.  For
+ * very large k, KMeansParallelInitialization (k-means||) needs far fewer
+ * passes.
  */
 class KMeansPlusPlusInitialization
 {
@@ -54,47 +59,40 @@ class KMeansPlusPlusInitialization
     size_t firstPoint = mlpack::math::RandInt(0, data.n_cols);
     centroids.col(0) = data.col(firstPoint);
 
-    // Utility variable.
+    // The squared distance between each point and its closest already-chosen
+    // centroid.  Each new centroid can only make these smaller, so we only need
+    // to compare each point with the newest centroid, in parallel.
     arma::vec distribution(data.n_cols);
+    distribution.fill(std::numeric_limits<double>::max());
 
     // Now, sample other points...
     for (size_t i = 1; i < clusters; ++i)
     {
-      // We must compute the CDF for sampling... this depends on the computation
-      // of the minimum distance between each point and its closest
-      // already-chosen centroid.
-      //
-      // This computation is ripe for speedup with trees!  I am not sure exactly
-      // how much we would need to approximate, but I think it could be done
-      // without breaking the O(log k)-competitive guarantee (I think).
-      for (size_t p = 0; p < data.n_cols; ++p)
-      {
-        double minDistance = std::numeric_limits<double>::max();
-        for (size_t j = 0; j < i; ++j)
-        {
-          const double distance =
-              mlpack::metric::SquaredEuclideanDistance::Evaluate(data.col(p),
-              centroids.col(j));
-          minDistance = std::min(distance, minDistance);
-        }
+      double total = 0.0;
 
-        distribution[p] = minDistance;
+      #pragma omp parallel for reduction(+:total)
+      for (size_t p = 0; p < (size_t) data.n_cols; ++p)
+      {
+        const double distance =
+            mlpack::metric::SquaredEuclideanDistance::Evaluate(data.col(p),
+            centroids.col(i - 1));
+        distribution[p] = std::min(distance, distribution[p]);
+        total += distribution[p];
       }
 
-      // Next normalize the distribution (actually technically we could avoid
-      // this).
-      distribution /= arma::accu(distribution);
-
-      // Turn it into a CDF for convenience...
-      for (size_t j = 1; j < distribution.n_elem; ++j)
-        distribution[j] += distribution[j - 1];
+      // Sample a point with probability proportional to its squared distance,
+      // by walking the CDF.  If every point is a centroid already, take any
+      // point.
+      const double sampleValue = mlpack::math::Random() * total;
+      double cumulative = 0.0;
+      size_t position = 0;
+      for (; position < data.n_cols - 1; ++position)
+      {
+        cumulative += distribution[position];
+        if (cumulative > sampleValue)
+          break;
+      }
 
-      // Sample a point...
-      const double sampleValue = mlpack::math::Random();
-      const double* elem = std::lower_bound(distribution.begin(),
-          distribution.end(), sampleValue);
-      const size_t position = (size_t)
-          (elem - distribution.begin()) / sizeof(double);
       centroids.col(i) = data.col(position);
     }
   }
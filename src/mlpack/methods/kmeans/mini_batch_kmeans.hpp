@@ -0,0 +1,107 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of mini-batch k-means, which updates the centroids with a
+ * small random sample of the points at each iteration.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * An approximate step of the Lloyd algorithm that only looks at a random batch
+ * of points at each iteration, as described in the following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-Scale K-Means Clustering},
+ *   author={Sculley, D.},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each iteration samples a batch of points (with replacement) and assigns them
+ * to their nearest centroids.  Each centroid is then moved towards each of its
+ * batch points with a learning rate of 1 / v, where v is the total number of
+ * points that have been assigned to it so far; so centroids that have seen many
+ * points move less.  The counts given back to KMeans are these total counts, so
+ * a cluster is only empty if no point was ever assigned to it.
+ *
+ * Since only a batch is visited, the centroids will not converge exactly; this
+ * step is meant for large datasets where each exact Lloyd iteration is too
+ * expensive, and the number of iterations should be limited with the
+ * maxIterations parameter of KMeans.  The assignment of the batch is
+ * parallelized with OpenMP.
+ *
+ * @param MetricType Type of metric used with this implementation.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   * @param batchSize Number of points to sample at each iteration; 0 means
+   *     the whole dataset.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  MetricType& metric,
+                  const size_t batchSize = 1000);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Total number of points assigned to each cluster so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+  //! The number of points sampled at each iteration.
+  size_t batchSize;
+
+  //! The total number of points assigned to each centroid so far.
+  arma::Col<size_t> totalCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of mini-batch k-means.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric,
+                                                      const size_t batchSize) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(batchSize),
+    distanceCalculations(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // Reset the total counts if the number of clusters changed (i.e. if this is
+  // the first iteration).
+  if (totalCounts.n_elem != centroids.n_cols)
+    totalCounts.zeros(centroids.n_cols);
+
+  // Sample the batch.  If it would be as large as the dataset, just use every
+  // point.
+  arma::uvec batch;
+  if (batchSize == 0 || batchSize >= dataset.n_cols)
+  {
+    batch = arma::regspace<arma::uvec>(0, dataset.n_cols - 1);
+  }
+  else
+  {
+    batch = arma::randi<arma::uvec>(batchSize,
+        arma::distr_param(0, (int) dataset.n_cols - 1));
+  }
+
+  // Find the closest centroid to each point in the batch.
+  arma::Col<size_t> assignments(batch.n_elem);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) batch.n_elem; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+
+  distanceCalculations += batch.n_elem * centroids.n_cols;
+
+  // Collect the sum and count of the batch points of each centroid.
+  arma::mat batchSums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+  arma::Col<size_t> batchCounts(centroids.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < batch.n_elem; ++i)
+  {
+    batchSums.col(assignments[i]) += dataset.col(batch[i]);
+    ++batchCounts[assignments[i]];
+  }
+
+  // Taking a gradient step of size 1 / v towards each of the m batch points of
+  // a centroid in turn is the same as moving it by (sum - m * c) / v, where v
+  // is the total count after the batch.
+  newCentroids = centroids;
+  totalCounts += batchCounts;
+  double cNorm = 0.0;
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (batchCounts[c] > 0)
+    {
+      newCentroids.col(c) += (batchSums.col(c) - batchCounts[c] *
+          centroids.col(c)) / totalCounts[c];
+      cNorm += std::pow(metric.Evaluate(centroids.col(c),
+          newCentroids.col(c)), 2.0);
+      ++distanceCalculations;
+    }
+  }
+
+  counts = totalCounts;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,8 @@
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
 
+#include "blocked_euclidean_assignment.hpp"
+
 namespace mlpack {
 namespace kmeans {
 
@@ -25,6 +27,11 @@ namespace kmeans {
  * looking for the mlpack::kmeans::KMeans class instead of this one.  This class
  * is used by KMeans as the actual implementation of the Lloyd iteration.
  *
+ * When the metric is the Euclidean distance and the data is dense, the
+ * distances are computed with BlockedEuclideanAssignment (one matrix
+ * multiplication per block of points) once k and the dimensionality are large
+ * enough.
+ *
  * @param MetricType Type of metric used with this implementation.
  * @param MatType Matrix type (arma::mat or arma::sp_mat).
  */
@@ -36,47 +36,54 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
                                                  arma::mat& newCentroids,
                                                  arma::Col<size_t>& counts)
 {
-  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
-  counts.zeros(centroids.n_cols);
-
-  // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  // For the Euclidean distance with large enough k and dimensionality, find
+  // the closest centroids of blocks of points with a matrix multiplication.
+  if (!BlockedEuclideanAssignment::Accumulate<MetricType>(dataset, centroids,
+      newCentroids, counts))
   {
-    // The current state of the K-means is private for each thread
-    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
-        arma::fill::zeros);
-    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+    counts.zeros(centroids.n_cols);
 
-    #pragma omp for
-    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+    // Find the closest centroid to each point and update the new centroids.
+    // Computed in parallel over the complete dataset
+    #pragma omp parallel
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
+      // The current state of the K-means is private for each thread
+      arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+          arma::fill::zeros);
+      arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
 
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      #pragma omp for
+      for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
+        // Find the closest centroid to this point.
+        double minDistance = std::numeric_limits<double>::infinity();
+        size_t closestCluster = centroids.n_cols; // Invalid value.
+
+        for (size_t j = 0; j < centroids.n_cols; ++j)
         {
-          minDistance = distance;
-          closestCluster = j;
+          const double distance = metric.Evaluate(dataset.col(i),
+              centroids.unsafe_col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closestCluster = j;
+          }
         }
-      }
 
-      Log::Assert(closestCluster != centroids.n_cols);
+        Log::Assert(closestCluster != centroids.n_cols);
 
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
-    }
-    // Combine calculated state from each thread
-    #pragma omp critical
-    {
-      newCentroids += localCentroids;
-      counts += localCounts;
+        // We now have the minimum distance centroid index.  Update that
+        // centroid.
+        localCentroids.unsafe_col(closestCluster) += dataset.col(i);
+        localCounts(closestCluster)++;
+      }
+      // Combine calculated state from each thread
+      #pragma omp critical
+      {
+        newCentroids += localCentroids;
+        counts += localCounts;
+      }
     }
   }
 
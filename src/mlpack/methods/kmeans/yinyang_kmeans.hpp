@@ -0,0 +1,106 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans.hpp
+ *
+ * An implementation of Yinyang k-means, which keeps one lower bound per group
+ * of centroids instead of one per centroid.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * Yinyang k-means is an exact Lloyd iteration that avoids most distance
+ * calculations with the triangle inequality, like Elkan's and Hamerly's
+ * algorithms.  It is described in the following paper:
+ *
+ * @code
+ * @inproceedings{ding2015yinyang,
+ *   title={Yinyang K-Means: A Drop-In Replacement of the Classic K-Means with
+ *       Consistent Speedup},
+ *   author={Ding, Yufei and Zhao, Yue and Shen, Xipeng and Musuvathi, Madanlal
+ *       and Mytkowicz, Todd},
+ *   booktitle={Proceedings of the 32nd International Conference on Machine
+ *       Learning (ICML '15)},
+ *   pages={579--587},
+ *   year={2015}
+ * }
+ * @endcode
+ *
+ * On the first iteration, the centroids are clustered into t = k / 10 groups.
+ * Each point then has an upper bound on the distance to its centroid and one
+ * lower bound on the distance to the other centroids of each group, so the
+ * bounds take O(n t) memory instead of the O(n k) of Elkan's algorithm.  A
+ * point whose upper bound is below all of its group bounds keeps its centroid;
+ * otherwise, only the groups whose bound is below the distance to the current
+ * centroid are searched.
+ *
+ * The iterations are parallelized over the points with OpenMP.
+ */
+template<typename MetricType, typename MatType>
+class YinyangKMeans
+{
+ public:
+  /**
+   * Construct the YinyangKMeans object, which must store several sets of
+   * bounds.
+   */
+  YinyangKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of the Yinyang algorithm, updating the given
+   * centroids into the newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Current counts, to be overwritten with new counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  /**
+   * Cluster the given centroids into groups, with a few iterations of k-means,
+   * and set groups and groupMembers.
+   */
+  void GroupCentroids(const arma::mat& centroids);
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! The group of each centroid.
+  arma::Col<size_t> groups;
+  //! The centroids in each group.
+  std::vector<std::vector<size_t>> groupMembers;
+
+  //! Upper bounds for each point.
+  arma::vec upperBounds;
+  //! Lower bounds for each group (rows) and each point (columns).
+  arma::mat lowerBounds;
+  //! Assignments for each point.
+  arma::Col<size_t> assignments;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "yinyang_kmeans_impl.hpp"
+
+#endif
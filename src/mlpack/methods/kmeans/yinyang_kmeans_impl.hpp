@@ -0,0 +1,288 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans_impl.hpp
+ *
+ * Implementation of Yinyang k-means.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "yinyang_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+YinyangKMeans<MetricType, MatType>::YinyangKMeans(const MatType& dataset,
+                                                  MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+double YinyangKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
+                                                   arma::mat& newCentroids,
+                                                   arma::Col<size_t>& counts)
+{
+  // If this is the first iteration, we need to group the centroids and set all
+  // the bounds.
+  const bool firstIteration = (groups.n_elem != centroids.n_cols);
+  if (firstIteration)
+  {
+    GroupCentroids(centroids);
+    upperBounds.set_size(dataset.n_cols);
+    lowerBounds.set_size(groupMembers.size(), dataset.n_cols);
+    assignments.set_size(dataset.n_cols);
+  }
+
+  const size_t numGroups = groupMembers.size();
+
+  // Reset new centroids.
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  size_t distances = 0;
+  size_t yinyangPruned = 0;
+
+  #pragma omp parallel reduction(+:distances, yinyangPruned)
+  {
+    // The sums and counts are private for each thread.
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    // The closest and second closest distances in each searched group, and the
+    // closest centroid of each searched group.
+    arma::vec groupClosest(numGroups);
+    arma::vec groupSecondClosest(numGroups);
+    arma::Col<size_t> groupClosestIndex(numGroups);
+    std::vector<bool> searched(numGroups);
+
+    #pragma omp for schedule(dynamic, 256)
+    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+    {
+      size_t closest = (firstIteration) ? centroids.n_cols : assignments[i];
+      double closestDistance = DBL_MAX;
+
+      if (!firstIteration)
+      {
+        const double globalLowerBound = arma::min(lowerBounds.col(i));
+
+        // First bound test.
+        if (upperBounds(i) <= globalLowerBound)
+        {
+          ++yinyangPruned;
+          localCentroids.col(closest) += dataset.col(i);
+          ++localCounts(closest);
+          continue;
+        }
+
+        // Tighten upper bound.
+        upperBounds(i) = metric.Evaluate(dataset.col(i),
+            centroids.col(closest));
+        ++distances;
+
+        // Second bound test.
+        if (upperBounds(i) <= globalLowerBound)
+        {
+          localCentroids.col(closest) += dataset.col(i);
+          ++localCounts(closest);
+          continue;
+        }
+
+        closestDistance = upperBounds(i);
+      }
+
+      // Search every group whose bound does not exclude it.  The lower bound
+      // of a group holds for all of its centroids but the assigned one, whose
+      // distance we already know.
+      const size_t oldClosest = closest;
+      const double oldDistance = closestDistance;
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        searched[g] = (firstIteration || lowerBounds(g, i) < closestDistance);
+        if (!searched[g])
+          continue;
+
+        groupClosest(g) = DBL_MAX;
+        groupSecondClosest(g) = DBL_MAX;
+        groupClosestIndex(g) = centroids.n_cols;
+        for (size_t j = 0; j < groupMembers[g].size(); ++j)
+        {
+          const size_t c = groupMembers[g][j];
+          double dist;
+          if (c == oldClosest)
+          {
+            dist = oldDistance;
+          }
+          else
+          {
+            dist = metric.Evaluate(dataset.col(i), centroids.col(c));
+            ++distances;
+          }
+
+          if (dist < groupClosest(g))
+          {
+            groupSecondClosest(g) = groupClosest(g);
+            groupClosest(g) = dist;
+            groupClosestIndex(g) = c;
+          }
+          else if (dist < groupSecondClosest(g))
+          {
+            groupSecondClosest(g) = dist;
+          }
+        }
+
+        if (groupClosest(g) < closestDistance)
+        {
+          closestDistance = groupClosest(g);
+          closest = groupClosestIndex(g);
+        }
+      }
+
+      // Now update the bounds of the searched groups.
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        if (searched[g])
+        {
+          lowerBounds(g, i) = (groupClosestIndex(g) == closest) ?
+              groupSecondClosest(g) : groupClosest(g);
+        }
+      }
+
+      // If the point changed clusters and the group of its old cluster was not
+      // searched, the old cluster is now one of the other centroids of that
+      // group.
+      if (!firstIteration && closest != oldClosest &&
+          !searched[groups[oldClosest]])
+      {
+        lowerBounds(groups[oldClosest], i) = std::min(
+            lowerBounds(groups[oldClosest], i), oldDistance);
+      }
+
+      upperBounds(i) = closestDistance;
+      assignments[i] = closest;
+
+      localCentroids.col(closest) += dataset.col(i);
+      ++localCounts(closest);
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  distanceCalculations += distances;
+
+  // Normalize centroids and calculate cluster movement, and the largest
+  // movement in each group.
+  arma::vec centroidMovements(centroids.n_cols);
+  arma::vec groupMovements(numGroups, arma::fill::zeros);
+  double centroidMovement = 0.0;
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (counts(c) > 0)
+      newCentroids.col(c) /= counts(c);
+
+    const double movement = metric.Evaluate(centroids.col(c),
+                                            newCentroids.col(c));
+    centroidMovements(c) = movement;
+    centroidMovement += std::pow(movement, 2.0);
+    groupMovements(groups[c]) = std::max(groupMovements(groups[c]), movement);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  // Now update bounds.
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+  {
+    upperBounds(i) += centroidMovements(assignments[i]);
+    lowerBounds.col(i) -= groupMovements;
+  }
+
+  Log::Info << "Yinyang prunes: " << yinyangPruned << ".\n";
+
+  return std::sqrt(centroidMovement);
+}
+
+template<typename MetricType, typename MatType>
+void YinyangKMeans<MetricType, MatType>::GroupCentroids(
+    const arma::mat& centroids)
+{
+  // The paper suggests k / 10 groups, found with five iterations of k-means on
+  // the centroids.
+  const size_t k = centroids.n_cols;
+  const size_t numGroups = std::max(k / 10, (size_t) 1);
+  const size_t groupIterations = 5;
+
+  arma::mat groupCentroids(centroids.n_rows, numGroups);
+  for (size_t g = 0; g < numGroups; ++g)
+    groupCentroids.col(g) = centroids.col(g * k / numGroups);
+
+  groups.set_size(k);
+  for (size_t iteration = 0; iteration < groupIterations; ++iteration)
+  {
+    for (size_t c = 0; c < k; ++c)
+    {
+      double minDistance = DBL_MAX;
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        const double dist = metric.Evaluate(centroids.col(c),
+            groupCentroids.col(g));
+        if (dist < minDistance)
+        {
+          minDistance = dist;
+          groups[c] = g;
+        }
+      }
+    }
+    distanceCalculations += k * numGroups;
+
+    arma::Col<size_t> groupCounts(numGroups, arma::fill::zeros);
+    arma::mat newGroupCentroids(centroids.n_rows, numGroups,
+        arma::fill::zeros);
+    for (size_t c = 0; c < k; ++c)
+    {
+      newGroupCentroids.col(groups[c]) += centroids.col(c);
+      ++groupCounts[groups[c]];
+    }
+
+    // Empty groups keep their centroid.
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      if (groupCounts[g] > 0)
+        groupCentroids.col(g) = newGroupCentroids.col(g) / groupCounts[g];
+    }
+  }
+
+  // Collect the members of each group, dropping empty groups.
+  std::vector<size_t> newGroupIndices(numGroups, SIZE_MAX);
+  groupMembers.clear();
+  for (size_t c = 0; c < k; ++c)
+  {
+    if (newGroupIndices[groups[c]] == SIZE_MAX)
+    {
+      newGroupIndices[groups[c]] = groupMembers.size();
+      groupMembers.push_back(std::vector<size_t>());
+    }
+
+    groups[c] = newGroupIndices[groups[c]];
+    groupMembers[groups[c]].push_back(c);
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -22,6 +22,24 @@ namespace regression /** Regression methods. */ {
  * A simple linear regression algorithm using ordinary least squares.
  * Optionally, this class can perform ridge regression, if the lambda parameter
  * is set to a number greater than zero.
+ *
+ * The model is the solution of the normal equations (X X^T + lambda I) b =
+ * X y, and X X^T and X y are sums over the points.  So, the model can also be
+ * trained on a dataset that does not fit in memory, by passing it one chunk at
+ * a time to Update(); the products of each chunk are computed in parallel and
+ * added to those of the previous chunks, and Solve() computes the model from
+ * them.  The normal equations take O(d^2) memory, so Train() only keeps them if
+ * asked to.
+ *
+ * @code
+ * extern arma::mat chunks[10];
+ * extern arma::rowvec chunkResponses[10];
+ *
+ * LinearRegression lr(0.1); // Ridge regression with lambda = 0.1.
+ * for (size_t i = 0; i < 10; ++i)
+ *   lr.Update(chunks[i], chunkResponses[i], false);
+ * lr.Solve();
+ * @endcode
  */
 class LinearRegression
 {
@@ -61,39 +79,114 @@ class LinearRegression
    */
   LinearRegression() : lambda(0.0), intercept(true) { }
 
+  /**
+   * Create an untrained model with the given settings, to be trained with
+   * Update().  Make sure Train() or Update() is called before calling
+   * Predict()!
+   *
+   * @param lambda Regularization constant for ridge regression.
+   * @param intercept Whether or not to include an intercept term.
+   */
+  explicit LinearRegression(const double lambda, const bool intercept = true) :
+      lambda(lambda), intercept(intercept) { }
+
   /**
    * Train the LinearRegression model on the given data. Careful! This will
-   * completely ignore and overwrite the existing model. This particular
-   * implementation does not have an incremental training algorithm.  To set the
-   * regularization parameter lambda, call Lambda() or set a different value in
-   * the constructor.
+   * completely ignore and overwrite the existing model.  To add more data to
+   * the model afterwards, use Update().  To set the regularization parameter
+   * lambda, call Lambda() or set a different value in the constructor.
+   *
+   * The normal equations of the data are released after training, unless
+   * keepNormalEquations is true; they must be kept to call Update() or Solve()
+   * later.
    *
    * @param predictors X, the matrix of data points to train the model on.
    * @param responses y, the responses to the data points.
    * @param intercept Whether or not to fit an intercept term.
+   * @param keepNormalEquations Whether or not to keep the normal equations.
    * @return The least squares error after training.
    */
   double Train(const arma::mat& predictors,
                const arma::rowvec& responses,
-               const bool intercept = true);
+               const bool intercept = true,
+               const bool keepNormalEquations = false);
 
   /**
    * Train the LinearRegression model on the given data and weights. Careful!
-   * This will completely ignore and overwrite the existing model. This
-   * particular implementation does not have an incremental training algorithm.
-   * To set the regularization parameter lambda, call Lambda() or set a
-   * different value in the constructor.
+   * This will completely ignore and overwrite the existing model.  To add more
+   * data to the model afterwards, use Update().  To set the regularization
+   * parameter lambda, call Lambda() or set a different value in the
+   * constructor.
+   *
+   * The normal equations of the data are released after training, unless
+   * keepNormalEquations is true; they must be kept to call Update() or Solve()
+   * later.
    *
    * @param predictors X, the matrix of data points to train the model on.
    * @param responses y, the responses to the data points.
    * @param weights Observation weights (for boosting).
    * @param intercept Whether or not to fit an intercept term.
+   * @param keepNormalEquations Whether or not to keep the normal equations.
    * @return The least squares error after training.
    */
   double Train(const arma::mat& predictors,
                const arma::rowvec& responses,
                const arma::rowvec& weights,
-               const bool intercept = true);
+               const bool intercept = true,
+               const bool keepNormalEquations = false);
+
+  /**
+   * Add the given chunk of data to the model: its contribution to the normal
+   * equations is added to that of the data the model was trained on with
+   * Train() and Update(), so that the model is the same as if it had been
+   * trained on all the data at once.  The intercept setting of the model is
+   * used.  A model that was trained with Train() without keepNormalEquations
+   * (including by a training constructor), loaded from a file, whose
+   * parameters were set by hand, or whose normal equations were released with
+   * ClearNormalEquations() cannot be updated.
+   *
+   * Solving the normal equations takes O(d^3) time; if many small chunks are
+   * given, pass solve = false and call Solve() after the last one.
+   *
+   * @param predictors X, the chunk of data points to add.
+   * @param responses y, the responses to the data points.
+   * @param solve Whether or not to compute the model after adding the chunk.
+   */
+  void Update(const arma::mat& predictors,
+              const arma::rowvec& responses,
+              const bool solve = true);
+
+  /**
+   * Add the given chunk of data to the model, with the given weights.  See the
+   * other overload of Update() for details.
+   *
+   * @param predictors X, the chunk of data points to add.
+   * @param responses y, the responses to the data points.
+   * @param weights Observation weights (for boosting).
+   * @param solve Whether or not to compute the model after adding the chunk.
+   */
+  void Update(const arma::mat& predictors,
+              const arma::rowvec& responses,
+              const arma::rowvec& weights,
+              const bool solve = true);
+
+  /**
+   * Compute the model from the normal equations of the data given to Train()
+   * and Update(), using the current value of Lambda().  The normal equations
+   * must have been kept (see Train()).
+   */
+  void Solve();
+
+  /**
+   * Release the normal equations of the data given to Train() and Update(),
+   * which take O(d^2) memory.  The model can still be used for prediction, but
+   * it cannot be updated or solved again until it is trained with Train().
+   */
+  void ClearNormalEquations()
+  {
+    matXTX.reset();
+    vecXTy.reset();
+  }
 
   /**
    * Calculate y_i for each data point in points.
@@ -142,6 +235,10 @@ class LinearRegression
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
+    // The normal equations are not saved.
+    if (cereal::is_loading<Archive>())
+      ClearNormalEquations();
+
     ar(CEREAL_NVP(parameters));
     ar(CEREAL_NVP(lambda));
     ar(CEREAL_NVP(intercept));
@@ -162,6 +259,22 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! The sum of the outer products of the points (X X^T) seen so far.
+  arma::mat matXTX;
+  //! The sum of the points weighted by their responses (X y) seen so far.
+  arma::vec vecXTy;
+
+  /**
+   * Add the products of the given points to matXTX and vecXTy, in parallel.
+   *
+   * @param predictors X, the points to add.
+   * @param responses y, the responses to the points.
+   * @param weights Observation weights (may be empty).
+   */
+  void Accumulate(const arma::mat& predictors,
+                  const arma::rowvec& responses,
+                  const arma::rowvec& weights);
 };
 
 } // namespace regression
@@ -40,15 +40,18 @@ inline LinearRegression::LinearRegression(
 
 inline double LinearRegression::Train(const arma::mat& predictors,
                                       const arma::rowvec& responses,
-                                      const bool intercept)
+                                      const bool intercept,
+                                      const bool keepNormalEquations)
 {
-  return Train(predictors, responses, arma::rowvec(), intercept);
+  return Train(predictors, responses, arma::rowvec(), intercept,
+      keepNormalEquations);
 }
 
 inline double LinearRegression::Train(const arma::mat& predictors,
                                       const arma::rowvec& responses,
                                       const arma::rowvec& weights,
-                                      const bool intercept)
+                                      const bool intercept,
+                                      const bool keepNormalEquations)
 {
   this->intercept = intercept;
 
@@ -58,42 +61,146 @@ inline double LinearRegression::Train(const arma::mat& predictors,
    * In order to get the intercept value, we will add a row of ones.
    */
 
-  // We store the number of rows and columns of the predictors.
-  // Reminder: Armadillo stores the data transposed from how we think of it,
-  //           that is, columns are actually rows (see: column major order).
-
   // Sanity check on data.
   util::CheckSameSizes(predictors, responses, "LinearRegression::Train()");
+  if (weights.n_elem > 0)
+  {
+    util::CheckSameSizes(predictors, weights, "LinearRegression::Train()",
+        "weights");
+  }
 
-  const size_t nCols = predictors.n_cols;
+  // Convert to this form:
+  // a * (X X^T) = y X^T.
+  // Then we'll use Armadillo to solve it.
+  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
+  // (assuming the SVD is used to solve it)
+  matXTX.reset();
+  vecXTy.reset();
+  Accumulate(predictors, responses, weights);
+  Solve();
+  if (!keepNormalEquations)
+    ClearNormalEquations();
+
+  return ComputeError(predictors, responses);
+}
+
+inline void LinearRegression::Update(const arma::mat& predictors,
+                                     const arma::rowvec& responses,
+                                     const bool solve)
+{
+  Update(predictors, responses, arma::rowvec(), solve);
+}
+
+inline void LinearRegression::Update(const arma::mat& predictors,
+                                     const arma::rowvec& responses,
+                                     const arma::rowvec& weights,
+                                     const bool solve)
+{
+  // Sanity check on data.
+  util::CheckSameSizes(predictors, responses, "LinearRegression::Update()");
+  if (weights.n_elem > 0)
+  {
+    util::CheckSameSizes(predictors, weights, "LinearRegression::Update()",
+        "weights");
+  }
+
+  if (matXTX.n_elem == 0 && parameters.n_elem > 0)
+  {
+    throw std::invalid_argument("LinearRegression::Update(): the model does "
+        "not have its normal equations (train it with Update(), or with Train() "
+        "and keepNormalEquations = true), so it cannot be updated!");
+  }
+
+  const size_t dimensionality = predictors.n_rows + (intercept ? 1 : 0);
+  if (matXTX.n_elem > 0 && matXTX.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegression::Update(): the model has "
+        << (matXTX.n_rows - (intercept ? 1 : 0)) << " dimensions, but the "
+        << "given data has " << predictors.n_rows << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Accumulate(predictors, responses, weights);
+  if (solve)
+    Solve();
+}
+
+inline void LinearRegression::Solve()
+{
+  if (matXTX.n_elem == 0)
+  {
+    throw std::invalid_argument("LinearRegression::Solve(): the model has no "
+        "normal equations (no data was given to Update(), or Train() did not "
+        "keep them)!");
+  }
 
-  arma::mat p = predictors;
-  arma::rowvec r = responses;
+  parameters = arma::solve(matXTX +
+      lambda * arma::eye<arma::mat>(matXTX.n_rows, matXTX.n_rows), vecXTy);
+}
 
+inline void LinearRegression::Accumulate(const arma::mat& predictors,
+                                         const arma::rowvec& responses,
+                                         const arma::rowvec& weights)
+{
   // Here we add the row of ones to the predictors.
   // The intercept is not penalized. Add an "all ones" row to design and set
   // intercept = false to get a penalized intercept.
-  if (intercept)
+  const size_t dimensionality = predictors.n_rows + (intercept ? 1 : 0);
+  if (matXTX.n_elem == 0)
   {
-    p.insert_rows(0, arma::ones<arma::mat>(1, nCols));
+    matXTX.zeros(dimensionality, dimensionality);
+    vecXTy.zeros(dimensionality);
   }
 
-  if (weights.n_elem > 0)
+  // The points are taken in blocks, so that the row of ones is only added to
+  // one block at a time instead of to a copy of the whole dataset.  Each thread
+  // sums the products of its blocks, and the sums are added at the end.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
   {
-    p = p * diagmat(sqrt(weights));
-    r = sqrt(weights) % responses;
-  }
+    arma::mat threadXTX(dimensionality, dimensionality, arma::fill::zeros);
+    arma::vec threadXTy(dimensionality, arma::fill::zeros);
+    arma::mat p;
+    arma::rowvec r;
 
-  // Convert to this form:
-  // a * (X X^T) = y X^T.
-  // Then we'll use Armadillo to solve it.
-  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
-  // (assuming the SVD is used to solve it)
-  arma::mat cov = p * p.t() +
-      lambda * arma::eye<arma::mat>(p.n_rows, p.n_rows);
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) predictors.n_cols) - 1;
 
-  parameters = arma::solve(cov, p * r.t());
-  return ComputeError(predictors, responses);
+      if (intercept)
+      {
+        p = arma::join_cols(arma::ones<arma::rowvec>(end - begin + 1),
+            predictors.cols(begin, end));
+      }
+      else
+      {
+        p = predictors.cols(begin, end);
+      }
+      r = responses.subvec(begin, end);
+
+      if (weights.n_elem > 0)
+      {
+        const arma::rowvec sqrtWeights = arma::sqrt(weights.subvec(begin, end));
+        p.each_row() %= sqrtWeights;
+        r %= sqrtWeights;
+      }
+
+      threadXTX += p * p.t();
+      threadXTy += p * r.t();
+    }
+
+    #pragma omp critical
+    {
+      matXTX += threadXTX;
+      vecXTy += threadXTy;
+    }
+  }
 }
 
 inline void LinearRegression::Predict(
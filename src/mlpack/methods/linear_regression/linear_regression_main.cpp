@@ -175,6 +175,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timer)
 
     timer.Start("regression");
     lr = new LinearRegression(regressors, responses, lambda);
+    lr->ClearNormalEquations();
     timer.Stop("regression");
   }
   else
@@ -110,6 +110,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timer)
 
   timer.Start("regression");
   LinearRegression* lr = new LinearRegression(regressors, responses, lambda);
+  lr->ClearNormalEquations();
   timer.Stop("regression");
 
   // Save the model if needed.
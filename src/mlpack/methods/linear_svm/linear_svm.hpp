@@ -26,6 +26,8 @@ namespace svm {
  * The class supports different observation types via the MatType template
  * parameter; for instance, support vector classification can be performed
  * on sparse datasets by specifying arma::sp_mat as the MatType parameter.
+ * Single precision data (arma::fmat or arma::sp_fmat) is supported too; the
+ * data is never converted, and the parameters are kept in double precision.
  *
  * Linear SVM can be used for general classification tasks which will work
  * on multiclass classification. More technical details about
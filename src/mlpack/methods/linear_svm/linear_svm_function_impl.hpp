@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_IMPL_HPP
 
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/mixed_product.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
 
 // In case it hasn't been included yet.
@@ -110,36 +111,20 @@ void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
 template <typename MatType>
 void LinearSVMFunction<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      dataset.n_cols - 1, dataset.n_cols));
+  // Recover the labels from the ground truth matrix.
+  arma::Row<size_t> labels(groundTruth.n_cols);
+  for (arma::sp_mat::const_iterator it = groundTruth.begin();
+       it != groundTruth.end(); ++it)
+    labels[it.col()] = it.row();
+
+  // Shuffle the points and labels together; this works for sparse data too.
+  MatType newData;
+  arma::Row<size_t> newLabels;
+  math::ShuffleData(dataset, labels, newData, newLabels);
 
-  // Re-sort data.
-  MatType newData = dataset.cols(ordering);
   math::ClearAlias(dataset);
   dataset = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-                             groundTruth.n_cols);
+  GetGroundTruthMatrix(newLabels, groundTruth);
 }
 
 template <typename MatType>
@@ -160,7 +145,7 @@ double LinearSVMFunction<MatType>::Evaluate(
   // Check intercept condition.
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset;
+    scores = math::MixedProduct(parameters.t(), dataset);
   }
   else
   {
@@ -169,7 +154,8 @@ double LinearSVMFunction<MatType>::Evaluate(
     // of Weights `w_i`, and the last row holds `b_i`.
     // On calculating the score, we add `b_i` term to each element of
     // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset)
         + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
         dataset.n_cols);
   }
@@ -209,14 +195,14 @@ double LinearSVMFunction<MatType>::Evaluate(
   // Check intercept condition.
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
+    scores = math::MixedProduct(parameters.t(),
+        dataset.cols(firstId, lastId));
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset.cols(firstId, lastId))
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
@@ -250,11 +236,12 @@ void LinearSVMFunction<MatType>::Gradient(
 
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset;
+    scores = math::MixedProduct(parameters.t(), dataset);
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset)
         + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
         dataset.n_cols);
   }
@@ -281,13 +268,13 @@ void LinearSVMFunction<MatType>::Gradient(
   // Check intercept condition
   if (!fitIntercept)
   {
-    gradient = dataset * difference.t();
+    gradient = math::MixedProductTrans(difference, dataset).t();
   }
   else
   {
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset * difference.t();
+        math::MixedProductTrans(difference, dataset).t();
     gradient.row(parameters.n_rows - 1) =
         arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
   }
@@ -314,12 +301,13 @@ void LinearSVMFunction<MatType>::Gradient(
   // Check intercept condition.
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
+    scores = math::MixedProduct(parameters.t(),
+        dataset.cols(firstId, lastId));
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset.cols(firstId, lastId))
         + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
@@ -338,13 +326,15 @@ void LinearSVMFunction<MatType>::Gradient(
   // Check intercept condition
   if (!fitIntercept)
   {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
+    gradient = math::MixedProductTrans(difference,
+        dataset.cols(firstId, lastId)).t();
   }
   else
   {
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
+        math::MixedProductTrans(difference,
+        dataset.cols(firstId, lastId)).t();
     gradient.row(parameters.n_rows - 1) =
         arma::ones<arma::rowvec>(batchSize) * difference.t();
   }
@@ -368,11 +358,12 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
 
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset;
+    scores = math::MixedProduct(parameters.t(), dataset);
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset)
         + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
         dataset.n_cols);
   }
@@ -392,13 +383,13 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   // Check intercept condition
   if (!fitIntercept)
   {
-    gradient = dataset * difference.t();
+    gradient = math::MixedProductTrans(difference, dataset).t();
   }
   else
   {
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-            dataset * difference.t();
+            math::MixedProductTrans(difference, dataset).t();
     gradient.row(parameters.n_rows - 1) =
             arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
   }
@@ -438,13 +429,14 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   // Check intercept condition.
   if (!fitIntercept)
   {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
+    scores = math::MixedProduct(parameters.t(),
+        dataset.cols(firstId, lastId));
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
+    scores = math::MixedProduct(parameters.rows(0, dataset.n_rows - 1).t(),
+        dataset.cols(firstId, lastId))
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
@@ -462,13 +454,15 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   // Check intercept condition
   if (!fitIntercept)
   {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
+    gradient = math::MixedProductTrans(difference,
+        dataset.cols(firstId, lastId)).t();
   }
   else
   {
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
+        math::MixedProductTrans(difference,
+        dataset.cols(firstId, lastId)).t();
     gradient.row(parameters.n_rows - 1) =
         arma::ones<arma::rowvec>(batchSize) * difference.t();
   }
@@ -480,7 +474,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   gradient += lambda * parameters;
 
   // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX));
+  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
   loss /= batchSize;
 
   // Adding the regularization term.
@@ -173,13 +173,14 @@ void LinearSVM<MatType>::Classify(
 
   if (fitIntercept)
   {
-    scores = parameters.rows(0, parameters.n_rows - 2).t() * data
+    scores = math::MixedProduct(
+        parameters.rows(0, parameters.n_rows - 2).t(), data)
         + arma::repmat(parameters.row(parameters.n_rows - 1).t(), 1,
         data.n_cols);
   }
   else
   {
-    scores = parameters.t() * data;
+    scores = math::MixedProduct(parameters.t(), data);
   }
 }
 
@@ -15,6 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/lars/lars.hpp>
+#include <mlpack/methods/elastic_net/elastic_net.hpp>
 
 // Include three simple dictionary initializers from sparse coding.
 #include <mlpack/methods/sparse_coding/nothing_initializer.hpp>
@@ -47,7 +48,9 @@ namespace lcc {
  * positive definite quadratic program). The sparse coding step involves
  * solving a large number of weighted l1-norm regularized linear regression
  * problems problems; this can be done efficiently using LARS, an algorithm
- * that can solve the LASSO (paper below).
+ * that can solve the LASSO (paper below), or, if UseCoordinateDescent() is
+ * set, by coordinate descent (see regression::ElasticNet), which is faster
+ * when the dictionary has many atoms.
  *
  * The papers are listed below.
  *
@@ -145,7 +148,8 @@ class LocalCoordinateCoding
                    DictionaryInitializer());
 
   /**
-   * Code each point via distance-weighted LARS.
+   * Code each point via distance-weighted LARS (or coordinate descent, if
+   * UseCoordinateDescent() is set).
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
@@ -203,6 +207,12 @@ class LocalCoordinateCoding
   //! Modify the objective tolerance.
   double& Tolerance() { return tolerance; }
 
+  //! Get whether the codes are found by coordinate descent instead of LARS.
+  bool UseCoordinateDescent() const { return useCoordinateDescent; }
+  //! Modify whether the codes are found by coordinate descent instead of LARS.
+  //! This is not saved with the model.
+  bool& UseCoordinateDescent() { return useCoordinateDescent; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -221,6 +231,8 @@ class LocalCoordinateCoding
   size_t maxIterations;
   //! Tolerance for main objective.
   double tolerance;
+  //! Whether to find the codes by coordinate descent instead of LARS.
+  bool useCoordinateDescent;
 };
 
 } // namespace lcc
@@ -29,7 +29,8 @@ LocalCoordinateCoding::LocalCoordinateCoding(
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    useCoordinateDescent(false)
 {
   // Train the model.
   Train(data, initializer);
@@ -43,7 +44,8 @@ inline LocalCoordinateCoding::LocalCoordinateCoding(
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    useCoordinateDescent(false)
 {
   // Nothing to do.
 }
@@ -124,31 +126,39 @@ inline void LocalCoordinateCoding::Encode(const arma::mat& data,
       * data);
 
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
-
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
-
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
+  // The points are independent, so they are encoded in parallel.  Each thread
+  // reuses one solver and one weighted dictionary and Gram matrix for all of
+  // its points; the solvers keep a reference to the Gram matrix, which is
+  // overwritten for each point.
+  #pragma omp parallel
+  {
+    arma::mat dictPrime(dictionary.n_rows, atoms);
+    arma::mat dictGramTD(atoms, atoms);
     bool useCholesky = false;
     regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+    regression::ElasticNet elasticNet(dictGramTD, 0.5 * lambda);
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      arma::vec invW = invSqDists.unsafe_col(i);
+      dictPrime = dictionary * diagmat(invW);
+      dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+
+      // Run LARS (or coordinate descent) for this point, by making an alias of
+      // the point and passing that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      if (useCoordinateDescent)
+        elasticNet.Train(dictPrime, responses, beta, false);
+      else
+        lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
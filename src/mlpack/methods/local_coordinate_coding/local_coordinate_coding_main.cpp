@@ -105,6 +105,9 @@ PARAM_INT_IN("max_iterations", "Maximum number of iterations for LCC (0 "
 PARAM_MATRIX_IN("initial_dictionary", "Optional initial dictionary.", "i");
 PARAM_FLAG("normalize", "If set, the input data matrix will be normalized "
     "before coding.", "N");
+PARAM_FLAG("coordinate_descent", "If set, the codes are found by coordinate "
+    "descent instead of LARS; this is faster for dictionaries with many atoms.",
+    "C");
 PARAM_DOUBLE_IN("tolerance", "Tolerance for objective function.", "o", 0.01);
 
 // Load/save a model.
@@ -179,6 +182,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     lcc->Atoms() = (size_t) params.Get<int>("atoms");
     lcc->MaxIterations() = (size_t) params.Get<int>("max_iterations");
     lcc->Tolerance() = params.Get<double>("tolerance");
+    lcc->UseCoordinateDescent() = params.Has("coordinate_descent");
 
     // Inform the user if we are overwriting their model.
     timers.Start("local_coordinate_coding");
@@ -252,6 +256,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     }
 
     mat codes;
+    lcc->UseCoordinateDescent() = params.Has("coordinate_descent");
     lcc->Encode(matY, codes);
 
     params.Get<mat>("codes") = std::move(codes);
@@ -26,7 +26,9 @@ namespace regression {
  * model, and supports training with multiple optimizers and classification.
  * The class supports different observation types via the MatType template
  * parameter; for instance, logistic regression can be performed on sparse
- * datasets by specifying arma::sp_mat as the MatType parameter.
+ * datasets by specifying arma::sp_mat as the MatType parameter.  Single
+ * precision data (arma::fmat or arma::sp_fmat) is supported too; the data is
+ * never converted, and the parameters are kept in double precision.
  *
  * LogisticRegression can be used for general classification tasks, but the
  * class is restricted to support only two classes.  For multiclass logistic
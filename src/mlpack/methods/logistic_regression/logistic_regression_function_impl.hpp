@@ -85,7 +85,8 @@ double LogisticRegressionFunction<MatType>::Evaluate(
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
   // does not need to be multiplied by any of the predictors.
   const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors))));
 
   // Assemble full objective function.  Often the objective function and the
   // regularization as given are divided by the number of features, but this
@@ -119,8 +120,8 @@ double LogisticRegressionFunction<MatType>::Evaluate(
 
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors.cols(begin, begin + batchSize - 1)))));
 
   // Compute the objective for the given batch size from a given point.
   arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
@@ -143,12 +144,13 @@ void LogisticRegressionFunction<MatType>::Gradient(
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
   const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+      - math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors))));
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = math::MixedProductTrans(
+      sigmoids - responses, predictors) + regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -167,17 +169,17 @@ void LogisticRegressionFunction<MatType>::Gradient(
       / predictors.n_cols * batchSize;
 
   const arma::rowvec exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors.cols(begin, begin + batchSize - 1));
   // Calculating the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = math::MixedProductTrans(
+      sigmoids - responses.subvec(begin, begin + batchSize - 1),
+      predictors.cols(begin, begin + batchSize - 1)) + regularization;
 }
 
 /**
@@ -191,7 +193,8 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
     arma::sp_mat& gradient) const
 {
   const arma::rowvec diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+      - math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors))));
 
   gradient.set_size(arma::size(parameters));
 
@@ -201,8 +204,8 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
   }
   else
   {
-    gradient[j] = arma::dot(-predictors.row(j - 1), diffs) + lambda *
-      parameters(0, j);
+    gradient[j] = -arma::as_scalar(math::MixedProductTrans(diffs,
+        predictors.row(j - 1))) + lambda * parameters(0, j);
   }
 }
 
@@ -222,12 +225,13 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
 
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors))));
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = math::MixedProductTrans(
+      sigmoids - responses, predictors) + regularization;
 
   // Now compute the objective function using the sigmoids.
   double result = arma::accu(arma::log(1.0 -
@@ -258,15 +262,15 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
 
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      predictors.cols(begin, begin + batchSize - 1)))));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient.tail_cols(parameters.n_elem - 1) = math::MixedProductTrans(
+      sigmoids - responses.subvec(begin, begin + batchSize - 1),
+      predictors.cols(begin, begin + batchSize - 1)) + regularization;
 
   // Now compute the objective function using the sigmoids.
   arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
@@ -105,8 +105,9 @@ size_t LogisticRegression<MatType>::Classify(const VecType& point,
                                              const double decisionBoundary)
     const
 {
-  return size_t(1.0 / (1.0 + std::exp(-parameters(0) - arma::dot(point,
-      parameters.tail_cols(parameters.n_elem - 1)))) +
+  return size_t(1.0 / (1.0 + std::exp(-parameters(0) -
+      arma::as_scalar(math::MixedProduct(
+      parameters.tail_cols(parameters.n_elem - 1), point)))) +
       (1.0 - decisionBoundary));
 }
 
@@ -119,7 +120,8 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
   // term correctly sets an offset so that floor() returns 0 or 1 correctly.
   labels = arma::conv_to<arma::Row<size_t>>::from((1.0 /
       (1.0 + arma::exp(-parameters(0) -
-      parameters.tail_cols(parameters.n_elem - 1) * dataset))) +
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      dataset)))) +
       (1.0 - decisionBoundary));
 }
 
@@ -131,7 +133,8 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
   probabilities.set_size(2, dataset.n_cols);
 
   probabilities.row(1) = 1.0 / (1.0 + arma::exp(-parameters(0) -
-      parameters.tail_cols(parameters.n_elem - 1) * dataset));
+      math::MixedProduct(parameters.tail_cols(parameters.n_elem - 1),
+      dataset)));
   probabilities.row(0) = 1.0 - probabilities.row(1);
 }
 
@@ -141,7 +144,7 @@ double LogisticRegression<MatType>::ComputeError(
     const arma::Row<size_t>& responses) const
 {
   // Construct a new error function.
-  LogisticRegressionFunction<> newErrorFunction(predictors, responses,
+  LogisticRegressionFunction<MatType> newErrorFunction(predictors, responses,
       lambda);
 
   return newErrorFunction.Evaluate(parameters);
@@ -193,6 +193,26 @@ class LSHSearch
              const size_t bucketSize = 500,
              const arma::cube& projection = arma::cube());
 
+  /**
+   * Hash the given points into the existing tables and add them to the
+   * reference set, so that the model does not need to be retrained.  The new
+   * points get the indices following the points already in the reference set.
+   * As in Train(), a point is not added to a bucket that already holds
+   * bucketSize points.
+   *
+   * @param points Points to insert.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Remove the point with the given index from the hash tables, so that it is
+   * never returned as a neighbor again.  The point stays in the reference set,
+   * so that the indices of the other points do not change.
+   *
+   * @param index Index of the point to remove.
+   */
+  void Remove(const size_t index);
+
   /**
    * Compute the nearest neighbors of the points in the given query set and
    * store the output in the given matrices.  The matrices will be set to the
@@ -287,9 +307,18 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  //! Get a copy of the second hash table, with one column per non-empty
+  //! bucket.
+  std::vector<arma::Col<size_t>> SecondHashTable() const;
+
+  //! Get the contents of all buckets, stored contiguously.
+  const std::vector<uint32_t>& BucketContents() const { return bucketContents; }
+  //! Get the number of points in each bucket.
+  const std::vector<size_t>& BucketContentSize() const
+      { return bucketContentSize; }
+
+  //! Get whether each point of the reference set has been removed.
+  const std::vector<bool>& RemovedPoints() const { return removedPoints; }
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -317,12 +346,41 @@ class LSHSearch
    *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
    *    single-probe is used.
+   * @param candidateSet Scratch space with one element per reference point,
+   *    used to remove duplicate candidates; it must be all false, and is left
+   *    all false.
    */
   template<typename VecType>
   void ReturnIndicesFromTable(const VecType& queryPoint,
                               arma::uvec& referenceIndices,
                               size_t numTablesToSearch,
-                              const size_t T) const;
+                              const size_t T,
+                              std::vector<bool>& candidateSet) const;
+
+  /**
+   * Compute the second-level hash code of each of the given points in each
+   * table.
+   *
+   * @param points Points to hash.
+   * @param secondHashVectors Resulting codes; row i holds the codes of table i.
+   */
+  void HashPoints(const MatType& points,
+                  arma::Mat<size_t>& secondHashVectors) const;
+
+  /**
+   * Add the given point to the bucket of the given hash code, creating the
+   * bucket if needed.  A full bucket is moved to the end of the contents with
+   * twice its capacity.
+   *
+   * @param hashInd Second-level hash code.
+   * @param index Index of the point.
+   */
+  void AddToBucket(const size_t hashInd, const size_t index);
+
+  /**
+   * Remove the space left behind by moved buckets from the bucket contents.
+   */
+  void CompactBuckets();
 
   /**
    * This is a helper function that computes the distance of the query to the
@@ -447,18 +505,29 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table, in a compressed sparse row layout: the points of
+  //! bucket (row) r are bucketContents[bucketStart[r]] through
+  //! bucketContents[bucketStart[r] + bucketContentSize[r] - 1], with room for
+  //! bucketCapacity[r] points.  There are (< secondHashSize) rows, each with
+  //! (<= bucketSize) points.
+  std::vector<uint32_t> bucketContents;
+
+  //! The position of each bucket in bucketContents.
+  std::vector<size_t> bucketStart;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The number of points each bucket has room for.
+  std::vector<size_t> bucketCapacity;
+
+  //! The number of points present in each bucket.
+  std::vector<size_t> bucketContentSize;
 
   //! For a particular hash value, points to the row in secondHashTable
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
+  //! Whether each point of the reference set has been removed.
+  std::vector<bool> removedPoints;
+
   //! The number of distance evaluations.
   size_t distanceEvaluations;
 
@@ -481,6 +550,11 @@ class LSHSearch
 } // namespace neighbor
 } // namespace mlpack
 
+//! Set the serialization version of the LSHSearch class.  Version 1 stores the
+//! second hash table contiguously.
+CEREAL_TEMPLATE_CLASS_VERSION((template<typename SortPolicy, typename MatType>),
+    (mlpack::neighbor::LSHSearch<SortPolicy, MatType>), (1));
+
 // Include implementation.
 #include "lsh_search_impl.hpp"
 
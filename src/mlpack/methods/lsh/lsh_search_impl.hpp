@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/random.hpp>
 
+#include <numeric>
+
 namespace mlpack {
 namespace neighbor {
 
@@ -83,9 +85,12 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
+    bucketContents(other.bucketContents),
+    bucketStart(other.bucketStart),
+    bucketCapacity(other.bucketCapacity),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
+    removedPoints(other.removedPoints),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Nothing to do.
@@ -103,9 +108,12 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
+    bucketContents(std::move(other.bucketContents)),
+    bucketStart(std::move(other.bucketStart)),
+    bucketCapacity(std::move(other.bucketCapacity)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
+    removedPoints(std::move(other.removedPoints)),
     distanceEvaluations(other.distanceEvaluations)
 {
   // Reset other model to defaults.
@@ -131,9 +139,12 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
+  bucketContents = other.bucketContents;
+  bucketStart = other.bucketStart;
+  bucketCapacity = other.bucketCapacity;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
+  removedPoints = other.removedPoints;
   distanceEvaluations = other.distanceEvaluations;
 
   return *this;
@@ -153,9 +164,12 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
+  bucketContents = std::move(other.bucketContents);
+  bucketStart = std::move(other.bucketStart);
+  bucketCapacity = std::move(other.bucketCapacity);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
+  removedPoints = std::move(other.removedPoints);
   distanceEvaluations = other.distanceEvaluations;
 
   // Reset other model to defaults.
@@ -253,10 +267,151 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
         "tables provided must be equal to numProj");
   }
 
+  if (this->referenceSet.n_cols > (size_t) std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("LSHSearch::Train(): the reference set has too "
+        "many points; at most 2^32 - 1 points can be indexed");
+  }
+
+  // Step IV and V: hash every point in every table.
+  arma::Mat<size_t> secondHashVectors;
+  HashPoints(this->referenceSet, secondHashVectors);
+
+  // Now, using the hash vectors for each table, count the number of rows we
+  // have in the second hash table.
+  arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
+  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
+    secondHashBinCounts[secondHashVectors[i]]++;
+
+  // Enforce the maximum bucket size.
+  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
+  secondHashBinCounts.transform([effectiveBucketSize](size_t val)
+      { return std::min(val, effectiveBucketSize); });
+
+  // Lay the buckets out contiguously, in the order in which they are first
+  // seen.
+  const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
+  bucketStart.clear();
+  bucketStart.reserve(numRowsInTable);
+  bucketCapacity.clear();
+  bucketCapacity.reserve(numRowsInTable);
+  size_t totalSize = 0;
+  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
+  {
+    const size_t hashInd = secondHashVectors[i];
+    if (bucketRowInHashTable[hashInd] == secondHashSize)
+    {
+      bucketRowInHashTable[hashInd] = bucketStart.size();
+      bucketStart.push_back(totalSize);
+      bucketCapacity.push_back(secondHashBinCounts[hashInd]);
+      totalSize += secondHashBinCounts[hashInd];
+    }
+  }
+
+  // Next we must assign each point in each table to the right bucket.
+  bucketContents.resize(totalSize);
+  bucketContentSize.assign(numRowsInTable, 0);
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      // If this bucket is not full, add the point.
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      if (bucketContentSize[row] < bucketCapacity[row])
+        bucketContents[bucketStart[row] + bucketContentSize[row]++] = j;
+    } // Loop over all points in the reference set.
+  } // Loop over tables.
+
+  removedPoints.assign(this->referenceSet.n_cols, false);
+
+  Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
+            << "maximum length of " << arma::max(secondHashBinCounts) << ", "
+            << "totaling " << arma::accu(secondHashBinCounts) << " elements."
+            << std::endl;
+}
+
+// Insert new points into the hash tables.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Insert(const MatType& points)
+{
+  if (numTables == 0)
+  {
+    throw std::invalid_argument("LSHSearch::Insert(): the model is not "
+        "trained; call Train() first");
+  }
+
+  util::CheckSameDimensionality(points, referenceSet, "LSHSearch::Insert()",
+      "points");
+
+  const size_t begin = referenceSet.n_cols;
+  if (begin + points.n_cols > (size_t) std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("LSHSearch::Insert(): too many points; at most "
+        "2^32 - 1 points can be indexed");
+  }
+
+  arma::Mat<size_t> secondHashVectors;
+  HashPoints(points, secondHashVectors);
+
+  referenceSet = arma::join_rows(referenceSet, points);
+  removedPoints.resize(referenceSet.n_cols, false);
+
+  for (size_t i = 0; i < numTables; ++i)
+    for (size_t j = 0; j < points.n_cols; ++j)
+      AddToBucket(secondHashVectors(i, j), begin + j);
+
+  // Reclaim the space of moved buckets once it is more than what is used.
+  const size_t used = std::accumulate(bucketCapacity.begin(),
+      bucketCapacity.end(), (size_t) 0);
+  if (bucketContents.size() > 2 * used)
+    CompactBuckets();
+}
+
+// Remove a point from the hash tables.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::Remove(const size_t index)
+{
+  if (index >= referenceSet.n_cols || removedPoints[index])
+  {
+    std::ostringstream oss;
+    oss << "LSHSearch::Remove(): point " << index << " is not in the model";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Mat<size_t> secondHashVectors;
+  HashPoints(MatType(referenceSet.col(index)), secondHashVectors);
+
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    const size_t row = bucketRowInHashTable[secondHashVectors(i, 0)];
+    if (row == secondHashSize)
+      continue;
+
+    // The order of points in a bucket does not matter, so replace the point
+    // with the last one.
+    uint32_t* bucket = bucketContents.data() + bucketStart[row];
+    for (size_t j = 0; j < bucketContentSize[row]; ++j)
+    {
+      if (bucket[j] == index)
+      {
+        bucket[j] = bucket[--bucketContentSize[row]];
+        break;
+      }
+    }
+  }
+
+  removedPoints[index] = true;
+}
+
+// Hash points into every table.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::HashPoints(
+    const MatType& points,
+    arma::Mat<size_t>& secondHashVectors) const
+{
   // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
+  // vector for table i will be held in row i.
+  secondHashVectors.set_size(numTables, points.n_cols);
 
   for (size_t i = 0; i < numTables; ++i)
   {
@@ -265,19 +420,19 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
 
     // The following code performs the task of hashing each point to a
     // 'numProj'-dimensional integer key.  Hence you get a ('numProj' x
-    // 'referenceSet.n_cols') key matrix.
+    // 'points.n_cols') key matrix.
     //
     // For a single table, let the 'numProj' projections be denoted by 'proj_i'
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
     arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
-    arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
+                                       points.n_cols);
+    arma::mat hashMat = projections.slice(i).t() * points;
     hashMat += offsetMat;
     hashMat /= hashWidth;
 
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
+    // Step V: Putting the points in the second hash table by hashing the key.
     // Now we hash every key, point ID to its corresponding bucket.  We must
     // also normalize the hashes to the range [0, secondHashSize).
     arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
@@ -297,56 +452,84 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
       }
     }
   }
+}
 
-  // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
-  arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
-  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
-    secondHashBinCounts[secondHashVectors[i]]++;
+// Add a point to a bucket.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::AddToBucket(const size_t hashInd,
+                                                 const size_t index)
+{
+  size_t row = bucketRowInHashTable[hashInd];
+  if (row == secondHashSize)
+  {
+    // Start a new, empty bucket at the end of the contents.
+    row = bucketStart.size();
+    bucketRowInHashTable[hashInd] = row;
+    bucketStart.push_back(bucketContents.size());
+    bucketCapacity.push_back(0);
+    bucketContentSize.push_back(0);
+  }
 
   // Enforce the maximum bucket size.
-  const size_t effectiveBucketSize = (bucketSize == 0) ? SIZE_MAX : bucketSize;
-  secondHashBinCounts.transform([effectiveBucketSize](size_t val)
-      { return std::min(val, effectiveBucketSize); });
+  if (bucketSize != 0 && bucketContentSize[row] >= bucketSize)
+    return;
 
-  const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
+  if (bucketContentSize[row] == bucketCapacity[row])
+  {
+    // Move the bucket to the end of the contents, with twice the capacity, so
+    // that insertions take amortized constant time.
+    size_t newCapacity = std::max(2 * bucketCapacity[row], (size_t) 4);
+    if (bucketSize != 0)
+      newCapacity = std::min(newCapacity, bucketSize);
+
+    const size_t newStart = bucketContents.size();
+    bucketContents.resize(newStart + newCapacity);
+    std::copy(bucketContents.begin() + bucketStart[row],
+        bucketContents.begin() + bucketStart[row] + bucketContentSize[row],
+        bucketContents.begin() + newStart);
+
+    bucketStart[row] = newStart;
+    bucketCapacity[row] = newCapacity;
+  }
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
-  size_t currentRow = 0;
-  for (size_t i = 0; i < numTables; ++i)
+  bucketContents[bucketStart[row] + bucketContentSize[row]++] =
+      (uint32_t) index;
+}
+
+// Remove the holes left by moved buckets.
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::CompactBuckets()
+{
+  std::vector<uint32_t> newContents;
+  newContents.reserve(std::accumulate(bucketCapacity.begin(),
+      bucketCapacity.end(), (size_t) 0));
+
+  for (size_t row = 0; row < bucketStart.size(); ++row)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
-    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
-    {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
+    const size_t newStart = newContents.size();
+    newContents.insert(newContents.end(),
+        bucketContents.begin() + bucketStart[row],
+        bucketContents.begin() + bucketStart[row] + bucketCapacity[row]);
+    bucketStart[row] = newStart;
+  }
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
-    } // Loop over all points in the reference set.
-  } // Loop over tables.
+  bucketContents = std::move(newContents);
+}
 
-  Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
-            << "maximum length of " << arma::max(secondHashBinCounts) << ", "
-            << "totaling " << arma::accu(secondHashBinCounts) << " elements."
-            << std::endl;
+// Get a copy of the second hash table.
+template<typename SortPolicy, typename MatType>
+std::vector<arma::Col<size_t>>
+LSHSearch<SortPolicy, MatType>::SecondHashTable() const
+{
+  std::vector<arma::Col<size_t>> table(bucketStart.size());
+  for (size_t row = 0; row < bucketStart.size(); ++row)
+  {
+    table[row].set_size(bucketContentSize[row]);
+    for (size_t j = 0; j < bucketContentSize[row]; ++j)
+      table[row][j] = bucketContents[bucketStart[row] + j];
+  }
+
+  return table;
 }
 
 // Base case where the query set is the reference set.  (So, we can't return
@@ -708,7 +891,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     const VecType& queryPoint,
     arma::uvec& referenceIndices,
     size_t numTablesToSearch,
-    const size_t T) const
+    const size_t T,
+    std::vector<bool>& candidateSet) const
 {
   // Decide on the number of tables to look into.
   if (numTablesToSearch == 0) // If no user input is given, search all.
@@ -781,77 +965,77 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     }
   }
 
-  // There are two ways to proceed here:
-  // Either allocate a maxNumPoints-size vector, place all candidates, and run
-  // unique on the vector to discard duplicates.
-  // Or allocate a referenceSet.n_cols size vector (i.e. number of reference
-  // points) of zeros, and mark found indices as 1.
+  // Each candidate is marked in candidateSet (which has one bit per reference
+  // point, and is all false on entry), so duplicates are skipped without
+  // sorting.  There are two ways to collect the marked candidates:
+  // Either record each candidate when it is first marked, or scan the whole
+  // set once all candidates are marked, which gives them in order.
   // Option 1 runs faster for small maxNumPoints but worse for larger values, so
-  // we choose based on a heuristic.
+  // we choose based on a heuristic.  Either way, candidateSet is all false
+  // again on exit.
   const float cutoff = 0.1;
   const float selectivity = static_cast<float>(maxNumPoints) /
       static_cast<float>(referenceSet.n_cols);
 
+  referenceIndices.set_size(std::min(maxNumPoints,
+      (size_t) referenceSet.n_cols));
+  size_t numCandidates = 0;
   if (selectivity > cutoff)
   {
-    // Heuristic: larger maxNumPoints means we should use find() because it
-    // should be faster.
-    // Reference points hashed in the same bucket as the query are set to >0.
-    arma::Col<size_t> refPointsConsidered;
-    refPointsConsidered.zeros(referenceSet.n_cols);
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // for all tables
+    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
     {
       for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
       {
-        // get the sequence code
-        size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
-
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+        const size_t tableRow = bucketRowInHashTable[hashMat(p, i)];
+        if (tableRow < secondHashSize)
         {
-          // Pick the indices in the bucket corresponding to hashInd.
+          const uint32_t* bucket = bucketContents.data() +
+              bucketStart[tableRow];
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+            candidateSet[bucket[j]] = true;
         }
       }
     }
 
     // Only keep reference points found in at least one bucket.
-    referenceIndices = arma::find(refPointsConsidered > 0);
-    return;
+    for (size_t i = 0; i < referenceSet.n_cols; ++i)
+    {
+      if (candidateSet[i])
+      {
+        referenceIndices[numCandidates++] = i;
+        candidateSet[i] = false;
+      }
+    }
   }
   else
   {
-    // Heuristic: smaller maxNumPoints means we should use unique() because it
-    // should be faster.
-    // Allocate space for the query's potential neighbors.
-    arma::uvec refPointsConsideredSmall;
-    refPointsConsideredSmall.zeros(maxNumPoints);
-
-    // Retrieve candidates.
-    size_t start = 0;
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables
+    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
     {
       for (size_t p = 0; p < T + 1; ++p)
       {
-        const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
-
+        const size_t tableRow = bucketRowInHashTable[hashMat(p, i)];
         if (tableRow < secondHashSize)
         {
-          // Store all secondHashTable points in the candidates set.
+          // Keep only one copy of each candidate.
+          const uint32_t* bucket = bucketContents.data() +
+              bucketStart[tableRow];
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
+          {
+            if (!candidateSet[bucket[j]])
+            {
+              candidateSet[bucket[j]] = true;
+              referenceIndices[numCandidates++] = bucket[j];
+            }
+          }
+        }
       }
     }
 
-    // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
-    return;
+    for (size_t i = 0; i < numCandidates; ++i)
+      candidateSet[referenceIndices[i]] = false;
   }
+
+  referenceIndices.resize(numCandidates);
 }
 
 // Search for nearest neighbors in a given query set.
@@ -904,28 +1088,30 @@ void LSHSearch<SortPolicy, MatType>::Search(
   size_t avgIndicesReturned = 0;
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+  #pragma omp parallel shared(resultingNeighbors, distances) \
       reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    // Each thread has its own set of candidates, to remove duplicates.
+    std::vector<bool> candidateSet(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
+          Teffective, candidateSet);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -966,28 +1152,30 @@ Search(const size_t k,
   size_t avgIndicesReturned = 0;
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+  #pragma omp parallel shared(resultingNeighbors, distances) \
       reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    // Each thread has its own set of candidates, to remove duplicates.
+    std::vector<bool> candidateSet(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(referenceSet.col(i), refIndices,
+          numTablesToSearch, Teffective, candidateSet);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -1026,7 +1214,7 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
-                                               const uint32_t /* version */)
+                                               const uint32_t version)
 {
   ar(CEREAL_NVP(referenceSet));
   ar(CEREAL_NVP(numProj));
@@ -1042,9 +1230,41 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashSize));
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
-  ar(CEREAL_NVP(secondHashTable));
+
+  // Before version 1, the second hash table was stored with one column per
+  // bucket; convert it to the contiguous layout.
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    std::vector<arma::Col<size_t>> secondHashTable;
+    arma::Col<size_t> oldBucketContentSize;
+    ar(CEREAL_NVP(secondHashTable));
+    ar(cereal::make_nvp("bucketContentSize", oldBucketContentSize));
+    ar(CEREAL_NVP(bucketRowInHashTable));
+    ar(CEREAL_NVP(distanceEvaluations));
+
+    bucketStart.resize(secondHashTable.size());
+    bucketCapacity.resize(secondHashTable.size());
+    bucketContentSize.assign(oldBucketContentSize.begin(),
+        oldBucketContentSize.end());
+    bucketContents.clear();
+    for (size_t row = 0; row < secondHashTable.size(); ++row)
+    {
+      bucketStart[row] = bucketContents.size();
+      bucketCapacity[row] = secondHashTable[row].n_elem;
+      bucketContents.insert(bucketContents.end(),
+          secondHashTable[row].begin(), secondHashTable[row].end());
+    }
+
+    removedPoints.assign(referenceSet.n_cols, false);
+    return;
+  }
+
+  ar(CEREAL_NVP(bucketContents));
+  ar(CEREAL_NVP(bucketStart));
+  ar(CEREAL_NVP(bucketCapacity));
   ar(CEREAL_NVP(bucketContentSize));
   ar(CEREAL_NVP(bucketRowInHashTable));
+  ar(CEREAL_NVP(removedPoints));
   ar(CEREAL_NVP(distanceEvaluations));
 }
 
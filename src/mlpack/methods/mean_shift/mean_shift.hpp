@@ -23,6 +23,11 @@ namespace meanshift /** Mean shift clustering. */ {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * All seeds are shifted together: at each iteration, the range searches for
+ * the seeds that have not converged yet are done in batches, in parallel, and
+ * converged seeds are removed from the batches.  Duplicate centroids are then
+ * found with range searches on a tree built on the converged centroids.
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -203,62 +203,115 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   }
 
   // Holds all centroids before removing duplicate ones.
-  arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  arma::mat allCentroids(*pSeeds);
 
   assignments.set_size(data.n_cols);
 
-  range::RangeSearch<> rangeSearcher(data);
+  // The seeds that are still moving are shifted together: at each iteration,
+  // the range searches of a block of seeds are done at once, with one
+  // single-tree traversal per seed in parallel, and the new centroids are then
+  // computed in parallel.  Seeds leave the active set as soon as they converge
+  // (or have no points within the radius), so the later iterations only
+  // search for the few seeds that still move.
+  const size_t blockSize = 4096;
+  range::RangeSearch<> rangeSearcher(data, false, true);
   math::Range validRadius(0, radius);
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+  std::vector<char> converged(pSeeds->n_cols, 0);
+
+  for (size_t completedIterations = 0; !activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    std::vector<size_t> stillActiveSeeds;
+    for (size_t begin = 0; begin < activeSeeds.size(); begin += blockSize)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
-
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      const size_t end = std::min(begin + blockSize, activeSeeds.size());
+      arma::mat queries(pSeeds->n_rows, end - begin);
+      for (size_t i = begin; i < end; ++i)
+        queries.col(i - begin) = allCentroids.col(activeSeeds[i]);
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      rangeSearcher.Search(queries, validRadius, neighbors, distances);
 
-      // If the mean shift vector is small enough, it has converged.
-      if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+      std::vector<char> moving(end - begin, 0);
+      #pragma omp parallel for schedule(dynamic, 16)
+      for (size_t i = 0; i < (size_t) (end - begin); ++i)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        const size_t seed = activeSeeds[begin + i];
+        if (neighbors[i].size() == 0) // There are no points in the cluster.
+          continue;
+
+        // Calculate new centroid.
+        arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+        if (!CalculateCentroid(data, neighbors[i], distances[i], newCentroid))
+          newCentroid = allCentroids.unsafe_col(seed);
+
+        // If the mean shift vector is small enough, it has converged.
+        if (metric::EuclideanDistance::Evaluate(newCentroid,
+            allCentroids.unsafe_col(seed)) < 1e-3 * radius)
         {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
+          converged[seed] = 1;
+          continue;
         }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        // Update the centroid.
+        allCentroids.col(seed) = newCentroid;
+        moving[i] = 1;
       }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      for (size_t i = begin; i < end; ++i)
+        if (moving[i - begin])
+          stillActiveSeeds.push_back(activeSeeds[i]);
+    }
+
+    activeSeeds.swap(stillActiveSeeds);
+  }
+
+  // Now remove the duplicate centroids.  In the order of the seeds, a converged
+  // centroid is kept unless it is within the radius of a centroid that was
+  // already kept; the centroids near each kept centroid are found with a range
+  // search on a tree of all converged centroids, so only one search is needed
+  // per kept centroid.
+  centroids.reset();
+  std::vector<size_t> convergedSeeds;
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    if (converged[i])
+      convergedSeeds.push_back(i);
+
+  if (!convergedSeeds.empty())
+  {
+    arma::mat convergedCentroids(pSeeds->n_rows, convergedSeeds.size());
+    for (size_t i = 0; i < convergedSeeds.size(); ++i)
+      convergedCentroids.col(i) = allCentroids.col(convergedSeeds[i]);
+
+    range::RangeSearch<> centroidSearcher(convergedCentroids, false, true);
+    math::Range duplicateRadius(0, radius);
+    std::vector<char> duplicate(convergedSeeds.size(), 0);
+    std::vector<size_t> keptCentroids;
+    for (size_t i = 0; i < convergedSeeds.size(); ++i)
+    {
+      if (duplicate[i])
+        continue;
+
+      keptCentroids.push_back(i);
+      centroidSearcher.Search(convergedCentroids.col(i), duplicateRadius,
+          neighbors, distances);
+      for (size_t j = 0; j < neighbors[0].size(); ++j)
+      {
+        // The distance to a duplicate must be strictly less than the radius.
+        if (distances[0][j] < radius)
+          duplicate[neighbors[0][j]] = 1;
+      }
     }
+
+    centroids.set_size(pSeeds->n_rows, keptCentroids.size());
+    for (size_t i = 0; i < keptCentroids.size(); ++i)
+      centroids.col(i) = convergedCentroids.col(keptCentroids[i]);
   }
 
   // If no centroid has converged due to too little iterations and without
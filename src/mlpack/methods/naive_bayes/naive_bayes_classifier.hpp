@@ -108,6 +108,14 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * The incremental algorithm can be used to train the model on a stream of
+   * minibatches: the means and variances of each batch are computed in
+   * parallel, and then merged with those of the model, so that the model is the
+   * same as if it had been trained on all the points at once.  If numClasses
+   * differs from the number of classes of the model, the model is reset first,
+   * even if the incremental algorithm is used.  A std::invalid_argument is
+   * thrown if a label is not less than numClasses.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -230,10 +238,31 @@ class NaiveBayesClassifier
   //! Small value to prevent log of zero.
   double epsilon;
 
+  /**
+   * Compute the number of points, the mean and the sum of squared differences
+   * from the mean of each class in the given dataset.
+   *
+   * @param data Set of points.
+   * @param labels Labels of the points.
+   * @param numClasses Number of classes.
+   * @param counts Vector to store the number of points of each class in.
+   * @param batchMeans Matrix to store the mean of each class in.
+   * @param squares Matrix to store the sum of squared differences of each class
+   *     in.
+   */
+  template<typename MatType>
+  void BatchStatistics(const MatType& data,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       arma::vec& counts,
+                       ModelMatType& batchMeans,
+                       ModelMatType& squares) const;
+
   /**
    * Compute the unnormalized posterior log probability of given points (log
    * likelihood). Results are returned as arma::mat, and each column represents
    * a point, each row represents log likelihood of a class.
+   * All classes are evaluated for all points at once with matrix products.
    *
    * @param data Set of points to compute posterior log probability for.
    * @param logLikelihoods Matrix to store log likelihoods in.
@@ -84,13 +84,25 @@ void NaiveBayesClassifier<ModelMatType>::Train(
   static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
+  util::CheckSameSizes(data, labels, "NaiveBayesClassifier::Train()",
+      "labels");
+
+  // Calculate the class probabilities as well as the sample mean and variance
+  // for each of the features with respect to each of the labels, for the given
+  // points only.  This also checks the labels, so it is done before the model
+  // is modified.
+  arma::vec batchCounts;
+  ModelMatType batchMeans, batchSquares;
+  BatchStatistics(data, labels, numClasses, batchCounts, batchMeans,
+      batchSquares);
 
   // Do we need to resize the model?
   if (probabilities.n_elem != numClasses)
   {
     // Perform training, after initializing the model to 0 (that is, if Train()
     // won't do that for us, which it won't if we're using the incremental
-    // algorithm).
+    // algorithm).  The old model cannot be used as a starting point, so none of
+    // its points are counted.
     if (incremental)
     {
       probabilities.zeros(numClasses);
@@ -103,76 +115,132 @@ void NaiveBayesClassifier<ModelMatType>::Train(
       means.set_size(data.n_rows, numClasses);
       variances.set_size(data.n_rows, numClasses);
     }
+
+    trainingPoints = 0;
   }
 
-  // Calculate the class probabilities as well as the sample mean and variance
-  // for each of the features with respect to each of the labels.
   if (incremental)
   {
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
-    probabilities *= trainingPoints;
-
-    for (size_t j = 0; j < data.n_cols; ++j)
+    // Merge the statistics of the points with those of the current model
+    // (Chan et al., "Updating formulae and a pairwise algorithm for computing
+    // sample variances").  The number of points of each class in the current
+    // model is recovered from the class probabilities.
+    probabilities = arma::round(probabilities * trainingPoints);
+    for (size_t i = 0; i < numClasses; ++i)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
+      if (batchCounts[i] == 0)
+        continue;
 
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
-    }
+      const double oldCount = probabilities[i];
+      const double count = oldCount + batchCounts[i];
 
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-    {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
+      // Recover the sum of squared differences of the current model.
+      ModelMatType squares = batchSquares.col(i);
+      if (oldCount > 1)
+        squares += (variances.col(i) - epsilon) * (oldCount - 1);
+
+      const ModelMatType delta = batchMeans.col(i) - means.col(i);
+      means.col(i) += delta * (batchCounts[i] / count);
+      squares += arma::square(delta) * (oldCount * batchCounts[i] / count);
+
+      variances.col(i) = squares;
+      if (count > 1)
+        variances.col(i) /= (count - 1);
+      variances.col(i) += epsilon;
+
+      probabilities[i] = count;
     }
+
+    trainingPoints += data.n_cols;
   }
   else
   {
-    // Set all parameters to zero.
-    probabilities.zeros();
-    means.zeros();
-    variances.zeros();
-
-    // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
-    // possible to calculate the means and variances using a faster one-pass
-    // algorithm but there are some precision and stability issues.  If this is
-    // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
-
-    // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    means = std::move(batchMeans);
+    variances = std::move(batchSquares);
+    for (size_t i = 0; i < numClasses; ++i)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
+      if (batchCounts[i] > 1)
+        variances.col(i) /= (batchCounts[i] - 1);
+      probabilities[i] = batchCounts[i];
     }
 
-    // Normalize means.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] != 0.0)
-        means.col(i) /= probabilities[i];
+    // Add epsilon to prevent log of zero.
+    variances += epsilon;
+
+    trainingPoints = data.n_cols;
+  }
+
+  if (trainingPoints > 0)
+    probabilities /= trainingPoints;
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::BatchStatistics(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::vec& counts,
+    ModelMatType& batchMeans,
+    ModelMatType& squares) const
+{
+  // An invalid label would be an out-of-bounds write inside the parallel
+  // regions below, where an exception could not be caught.
+  if (labels.n_elem > 0 && arma::max(labels) >= numClasses)
+  {
+    std::ostringstream oss;
+    oss << "NaiveBayesClassifier::Train(): label " << arma::max(labels)
+        << " is invalid for " << numClasses << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  counts.zeros(numClasses);
+  batchMeans.zeros(data.n_rows, numClasses);
+  squares.zeros(data.n_rows, numClasses);
 
-    // Calculate variances.
-    for (size_t j = 0; j < data.n_cols; ++j)
+  // This is a two-pass algorithm, which is more stable than accumulating the
+  // sums of squares in one pass.  In each pass, each thread accumulates the
+  // sums of a block of points, and the sums of the threads are added at the
+  // end.
+  #pragma omp parallel
+  {
+    arma::vec threadCounts(numClasses, arma::fill::zeros);
+    ModelMatType threadSums(data.n_rows, numClasses, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t j = 0; j < (size_t) data.n_cols; ++j)
     {
       const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
+      ++threadCounts[label];
+      threadSums.col(label) += data.col(j);
     }
 
-    // Normalize variances.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] > 1)
-        variances.col(i) /= (probabilities[i] - 1);
+    #pragma omp critical
+    {
+      counts += threadCounts;
+      batchMeans += threadSums;
+    }
   }
 
-  // Add epsilon to prevent log of zero.
-  variances += epsilon;
+  for (size_t i = 0; i < numClasses; ++i)
+    if (counts[i] != 0.0)
+      batchMeans.col(i) /= counts[i];
+
+  #pragma omp parallel
+  {
+    ModelMatType threadSquares(data.n_rows, numClasses, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t j = 0; j < (size_t) data.n_cols; ++j)
+    {
+      const size_t label = labels[j];
+      threadSquares.col(label) += arma::square(data.col(j) -
+          batchMeans.col(label));
+    }
 
-  probabilities /= data.n_cols;
-  trainingPoints += data.n_cols;
+    #pragma omp critical
+    squares += threadSquares;
+  }
 }
 
 template<typename ModelMatType>
@@ -188,13 +256,23 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   probabilities *= trainingPoints;
   probabilities[label]++;
 
-  arma::vec delta = point - means.col(label);
-  means.col(label) += delta / probabilities[label];
-  if (probabilities[label] > 2)
-    variances.col(label) *= (probabilities[label] - 2);
-  variances.col(label) += (delta % (point - means.col(label)));
-  if (probabilities[label] > 1)
-    variances.col(label) /= probabilities[label] - 1;
+  // The stored variances include epsilon (as in the batch Train()), so remove
+  // it to recover the sum of squared differences of the previous points.
+  const double count = probabilities[label];
+  ModelMatType squares;
+  if (count > 2)
+    squares = (variances.col(label) - epsilon) * (count - 2);
+  else
+    squares.zeros(point.n_elem, 1);
+
+  const ModelMatType delta = point - means.col(label);
+  means.col(label) += delta / count;
+  squares += delta % (point - means.col(label));
+
+  variances.col(label) = squares;
+  if (count > 1)
+    variances.col(label) /= (count - 1);
+  variances.col(label) += epsilon;
 
   trainingPoints++;
   probabilities /= trainingPoints;
@@ -210,24 +288,35 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
-
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
-  {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
-  }
+  // This is an adaptation of gmm::phi() for the case where the covariance is
+  // a diagonal matrix.  Expanding the square in the exponent,
+  //
+  //   -0.5 (x - mu)^T S^-1 (x - mu) =
+  //       mu^T S^-1 x - 0.5 (x^2)^T diag(S^-1) - 0.5 mu^T S^-1 mu,
+  //
+  // so that the log likelihoods of all classes for all points are given by two
+  // matrix products, plus a term for each class.
+  //
+  // The terms of the expansion are much larger than their sum when the means
+  // are large relative to the standard deviations, so the points and the means
+  // are first centered on the mean of the training points (the mean of the
+  // class means, weighted by the class probabilities).
+  const ModelMatType center = means * probabilities;
+  ModelMatType centered(data);
+  centered.each_col() -= center.col(0);
+  const ModelMatType centeredMeans = means.each_col() - center.col(0);
+
+  const ModelMatType invVar = 1.0 / variances;
+  const ModelMatType scaledMeans = centeredMeans % invVar;
+
+  logLikelihoods = scaledMeans.t() * centered -
+      0.5 * (invVar.t() * arma::square(centered));
+
+  const ModelMatType classTerms = arma::log(probabilities) - 0.5 *
+      (arma::sum(centeredMeans % scaledMeans, 0) +
+       arma::sum(arma::log(variances), 0)).t() -
+      data.n_rows / 2.0 * std::log(2 * M_PI);
+  logLikelihoods.each_col() += classTerms.col(0);
 }
 
 template<typename ModelMatType>
@@ -291,17 +380,11 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(logLikelihoods, 0));
 }
 
 template<typename ModelMatType>
@@ -319,32 +402,22 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
-  for (size_t j = 0; j < data.n_cols; ++j)
-  {
-    // The LogLikelihood() gives us the unnormalized log likelihood which is
-    // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
-    // Besides, to prevent underflow in log of sum of exp of x operation (where
-    // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = arma::max(logLikelihoods.col(j));
-    logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
-        maxValue))) + maxValue;
-    predictionProbs.col(j) = arma::exp(logLikelihoods.col(j) - logProbX);
-  }
-
-  // Now calculate maximum probabilities for each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(logLikelihoods, 0));
+
+  // The LogLikelihood() gives us the unnormalized log likelihood which is
+  // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
+  // Besides, to prevent underflow in log of sum of exp of x operation (where
+  // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
+  const arma::Row<ElemType> maxValues = arma::max(logLikelihoods, 0);
+  logLikelihoods.each_row() -= maxValues;
+  const arma::Row<ElemType> logProbX = arma::log(arma::sum(
+      arma::exp(logLikelihoods), 0));
+  logLikelihoods.each_row() -= logProbX;
+  predictionProbs = arma::exp(logLikelihoods);
 }
 
 template<typename ModelMatType>
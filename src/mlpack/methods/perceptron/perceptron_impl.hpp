@@ -132,17 +132,11 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
-  predictedLabels.set_size(test.n_cols);
-
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
-  {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  // Compute the scores of all classes for all points at once.
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(scores, 0));
 }
 
 /**
@@ -44,6 +44,26 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights = weights.cols(indices);
 }
 
+/**
+ * Draw a bootstrap sample of the given number of points, and return how many
+ * times each point was drawn instead of copying the points.  Training on the
+ * points that were drawn at least once, weighted by their counts, is the same
+ * as training on the bootstrapped dataset.
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param counts Number of times each point was drawn (output).
+ */
+inline void BootstrapCounts(const size_t numPoints, arma::Row<size_t>& counts)
+{
+  counts.zeros(numPoints);
+
+  // Random sampling with replacement.
+  const arma::uvec indices = arma::randi<arma::uvec>(numPoints,
+      arma::distr_param(0, numPoints - 1));
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    ++counts[indices[i]];
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,216 @@
+/**
+ * @file methods/random_forest/compiled_random_forest.hpp
+ *
+ * A flattened, read-only copy of a trained RandomForest, laid out for fast
+ * classification of many points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_COMPILED_RANDOM_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_COMPILED_RANDOM_FOREST_HPP
+
+#include <mlpack/methods/decision_tree/compiled_decision_tree.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A CompiledRandomForest holds a CompiledDecisionTree for each tree of a
+ * trained RandomForest, and gives the same predictions and probabilities as
+ * the forest.  Points are classified in blocks: each block goes down every tree
+ * in turn (see CompiledDecisionTree::FindLeaves()), and the class
+ * probabilities of the leaves are accumulated for the whole block.  Blocks are
+ * classified in parallel with OpenMP.
+ *
+ * The compiled forest is a snapshot: it must be rebuilt if the original forest
+ * is modified or retrained.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses, numTrees);
+ * CompiledRandomForest<RandomForest<>> compiledForest(rf);
+ * compiledForest.Classify(testData, predictions, probabilities);
+ * @endcode
+ *
+ * @tparam RandomForestType Type of the random forest to compile.
+ */
+template<typename RandomForestType>
+class CompiledRandomForest
+{
+ public:
+  //! The type of the compiled trees.
+  typedef CompiledDecisionTree<typename RandomForestType::DecisionTreeType>
+      CompiledTreeType;
+
+  //! The number of points that are classified together.
+  static const size_t BlockSize = CompiledTreeType::BlockSize;
+
+  /**
+   * Create an empty compiled forest.  Compile() must be called before the
+   * forest can classify points.
+   */
+  CompiledRandomForest() { }
+
+  /**
+   * Compile the given trained random forest.
+   *
+   * @param forest Trained random forest.
+   */
+  CompiledRandomForest(const RandomForestType& forest) { Compile(forest); }
+
+  /**
+   * Compile the given trained random forest, replacing anything that was
+   * previously compiled.
+   *
+   * @param forest Trained random forest.
+   */
+  void Compile(const RandomForestType& forest)
+  {
+    trees.resize(forest.NumTrees());
+    for (size_t i = 0; i < forest.NumTrees(); ++i)
+      trees[i].Compile(forest.Tree(i));
+  }
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const
+  {
+    size_t prediction;
+    arma::vec probabilities;
+    Classify(point, prediction, probabilities);
+    return prediction;
+  }
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities for each class.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const
+  {
+    arma::mat probabilities;
+    Classify(data, predictions, probabilities);
+  }
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning
+   * the predicted class probabilities for each point.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return trees.size(); }
+  //! Access a compiled tree.
+  const CompiledTreeType& Tree(const size_t i) const { return trees[i]; }
+
+ private:
+  //! The compiled trees.
+  std::vector<CompiledTreeType> trees;
+};
+
+template<typename RandomForestType>
+template<typename VecType>
+void CompiledRandomForest<RandomForestType>::Classify(
+    const VecType& point,
+    size_t& prediction,
+    arma::vec& probabilities) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("CompiledRandomForest::Classify(): no random "
+        "forest compiled!");
+  }
+
+  // Sum the probabilities in the same order as RandomForest, so that the
+  // results are the same.
+  probabilities.zeros(trees[0].NumClasses());
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    size_t treePrediction; // Ignored.
+    arma::vec treeProbs;
+    trees[i].Classify(point, treePrediction, treeProbs);
+    probabilities += treeProbs;
+  }
+
+  probabilities /= trees.size();
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+template<typename RandomForestType>
+template<typename MatType>
+void CompiledRandomForest<RandomForestType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions,
+    arma::mat& probabilities) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("CompiledRandomForest::Classify(): no random "
+        "forest compiled!");
+  }
+
+  predictions.set_size(data.n_cols);
+  probabilities.zeros(trees[0].NumClasses(), data.n_cols);
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t count = std::min((size_t) BlockSize,
+        (size_t) data.n_cols - begin);
+
+    size_t leaves[BlockSize];
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].FindLeaves(data, begin, count, leaves);
+      const arma::mat& leafProbabilities = trees[t].LeafProbabilities();
+      for (size_t i = 0; i < count; ++i)
+        probabilities.col(begin + i) += leafProbabilities.col(leaves[i]);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      arma::vec probs = probabilities.unsafe_col(begin + i); // Alias.
+      probs /= trees.size();
+      arma::uword maxIndex = 0;
+      probs.max(maxIndex);
+      predictions[begin + i] = (size_t) maxIndex;
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include "bootstrap.hpp"
+#include "sorted_feature_index.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -34,6 +35,16 @@ namespace tree {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * Each tree is trained on a bootstrap sample of the dataset, given to the tree
+ * as the indices of the distinct points of the sample, weighted by the number
+ * of times they were drawn; all the trees train on the same dataset, which is
+ * not copied (see DecisionTree::TrainOnPoints()).  When the trees use
+ * BestBinaryNumericSplit, each dimension of the dataset is sorted once for the
+ * whole forest (see SortedFeatureIndex), and the trees are trained on the
+ * 32-bit ranks of the values, which are sorted in linear time at each node.
+ * The split points are then mapped back to values halfway between two
+ * consecutive distinct values of the dataset.
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
@@ -360,6 +371,43 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Compute the out-of-bag error of the forest: each training point is
+   * classified by the trees whose bootstrap sample did not contain it, and the
+   * error is the fraction of those points that are misclassified.  The given
+   * data and labels must be the ones the forest was trained on.  This will
+   * throw an exception if no tree has out-of-bag points (for instance, if the
+   * forest does not use bootstrap sampling or was loaded from a file, since
+   * out-of-bag points are not saved with the model).
+   *
+   * @param data Dataset the forest was trained on.
+   * @param labels Labels the forest was trained on.
+   * @return Fraction of the out-of-bag points that are misclassified.
+   */
+  template<typename MatType>
+  double OOBError(const MatType& data, const arma::Row<size_t>& labels) const;
+
+  /**
+   * Compute the permutation importance of each dimension on the out-of-bag
+   * points: for each tree and each dimension, the values of the dimension are
+   * shuffled among the out-of-bag points of the tree, and the importance of
+   * the dimension is the decrease of the accuracy of the tree, averaged over
+   * the trees.  The trees and dimensions are processed in parallel.  The
+   * given data and labels must be the ones the forest was trained on.
+   *
+   * @param data Dataset the forest was trained on.
+   * @param labels Labels the forest was trained on.
+   * @param importances Importance of each dimension (output).
+   */
+  template<typename MatType>
+  void FeatureImportance(const MatType& data,
+                         const arma::Row<size_t>& labels,
+                         arma::vec& importances) const;
+
+  //! Get the indices of the training points that were not in the bootstrap
+  //! sample of the given tree.
+  const arma::uvec& OOBIndices(const size_t i) const { return oobIndices[i]; }
+
   /**
    * Serialize the random forest.
    */
@@ -402,9 +450,54 @@ class RandomForest
                DimensionSelectionType& dimensionSelector,
                const bool warmStart = false);
 
+  /**
+   * Train one tree of the forest on a bootstrap sample of the given dataset
+   * (or on the whole dataset if UseBootstrap is false).  The sample is
+   * expressed as the indices of the distinct points that were drawn, weighted
+   * by the number of times they were drawn; the dataset itself is shared by
+   * all the trees and is not copied.
+   *
+   * @param tree Tree to train.
+   * @param treeOOBIndices Indices of the points that were not drawn (output).
+   * @param data Dataset to train on.
+   * @param datasetInfo Dimension information for the dataset (may be ignored).
+   * @param labels Labels for the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point in the dataset (may be ignored).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The gain of the tree.
+   */
+  template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+  double TrainTree(DecisionTreeType& tree,
+                   arma::uvec& treeOOBIndices,
+                   const MatType& data,
+                   const data::DatasetInfo& datasetInfo,
+                   const arma::Row<size_t>& labels,
+                   const size_t numClasses,
+                   const arma::rowvec& weights,
+                   const size_t minimumLeafSize,
+                   const double minimumGainSplit,
+                   const size_t maximumDepth,
+                   DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Check that the forest has out-of-bag points and that they can be indices
+   * of the given training set.
+   */
+  template<typename MatType>
+  void CheckOOB(const MatType& data,
+                const arma::Row<size_t>& labels,
+                const std::string& callerDescription) const;
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 
+  //! The indices of the out-of-bag points of each tree.
+  std::vector<arma::uvec> oobIndices;
+
   //! The average gain of the forest.
   double avgGain;
 };
@@ -447,4 +540,7 @@ using ExtraTrees = RandomForest<FitnessFunction,
 // Include implementation.
 #include "random_forest_impl.hpp"
 
+// Also include the compiled random forest.
+#include "compiled_random_forest.hpp"
+
 #endif
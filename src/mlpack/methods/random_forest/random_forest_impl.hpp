@@ -437,6 +437,193 @@ void RandomForest<
   }
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::OOBError(const MatType& data,
+            const arma::Row<size_t>& labels) const
+{
+  CheckOOB(data, labels, "RandomForest::OOBError()");
+
+  // Find the trees each point is out of bag for, as a compressed list.
+  arma::uvec offsets(data.n_cols + 1, arma::fill::zeros);
+  for (size_t t = 0; t < oobIndices.size(); ++t)
+    for (size_t j = 0; j < oobIndices[t].n_elem; ++j)
+      ++offsets[oobIndices[t][j] + 1];
+  for (size_t i = 1; i <= data.n_cols; ++i)
+    offsets[i] += offsets[i - 1];
+
+  arma::uvec pointTrees(offsets[data.n_cols]);
+  arma::uvec next = offsets.subvec(0, data.n_cols - 1);
+  for (size_t t = 0; t < oobIndices.size(); ++t)
+    for (size_t j = 0; j < oobIndices[t].n_elem; ++j)
+      pointTrees[next[oobIndices[t][j]]++] = t;
+
+  // Classify each point with the trees that did not see it.
+  size_t numPoints = 0;
+  size_t numErrors = 0;
+  const size_t numClasses = trees[0].NumClasses();
+  #pragma omp parallel for reduction(+ : numPoints, numErrors)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+  {
+    if (offsets[i] == offsets[i + 1])
+      continue;
+
+    arma::vec probabilities(numClasses, arma::fill::zeros);
+    for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+    {
+      arma::vec treeProbs;
+      size_t treePrediction; // Ignored.
+      trees[pointTrees[k]].Classify(data.col(i), treePrediction, treeProbs);
+      probabilities += treeProbs;
+    }
+
+    ++numPoints;
+    if ((size_t) probabilities.index_max() != labels[i])
+      ++numErrors;
+  }
+
+  if (numPoints == 0)
+    return 0.0;
+
+  return (double) numErrors / (double) numPoints;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::FeatureImportance(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     arma::vec& importances) const
+{
+  CheckOOB(data, labels, "RandomForest::FeatureImportance()");
+
+  // The accuracy of each tree on its out-of-bag points.
+  arma::vec accuracies(trees.size(), arma::fill::zeros);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    const arma::uvec& oob = oobIndices[t];
+    size_t correct = 0;
+    for (size_t j = 0; j < oob.n_elem; ++j)
+    {
+      if (trees[t].Classify(data.col(oob[j])) == labels[oob[j]])
+        ++correct;
+    }
+
+    if (oob.n_elem > 0)
+      accuracies[t] = (double) correct / (double) oob.n_elem;
+  }
+
+  // Each pair of a tree and a dimension is independent.  Draw the seed of the
+  // permutation of each pair serially, so that the importances only depend on
+  // RandGen() and not on how the pairs are scheduled across threads.
+  arma::mat decreases(data.n_rows, trees.size(), arma::fill::zeros);
+  const size_t numTasks = data.n_rows * trees.size();
+  std::vector<std::mt19937::result_type> seeds(numTasks);
+  for (size_t task = 0; task < numTasks; ++task)
+    seeds[task] = math::RandGen()();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t task = 0; task < numTasks; ++task)
+  {
+    const size_t t = task / data.n_rows;
+    const size_t d = task % data.n_rows;
+    const arma::uvec& oob = oobIndices[t];
+    if (oob.n_elem == 0)
+      continue;
+
+    arma::uvec permutation = arma::regspace<arma::uvec>(0, oob.n_elem - 1);
+    std::mt19937 generator(seeds[task]);
+    std::shuffle(permutation.begin(), permutation.end(), generator);
+
+    arma::Col<typename MatType::elem_type> point;
+    size_t correct = 0;
+    for (size_t j = 0; j < oob.n_elem; ++j)
+    {
+      point = data.col(oob[j]);
+      point[d] = data(d, oob[permutation[j]]);
+      if (trees[t].Classify(point) == labels[oob[j]])
+        ++correct;
+    }
+
+    decreases(d, t) = accuracies[t] - (double) correct / (double) oob.n_elem;
+  }
+
+  size_t numTrees = 0;
+  for (size_t t = 0; t < trees.size(); ++t)
+    if (oobIndices[t].n_elem > 0)
+      ++numTrees;
+
+  importances = arma::sum(decreases, 1) / (double) numTrees;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::CheckOOB(const MatType& data,
+            const arma::Row<size_t>& labels,
+            const std::string& callerDescription) const
+{
+  util::CheckSameSizes(data, labels, callerDescription, "labels");
+
+  bool hasOOB = false;
+  for (size_t t = 0; t < oobIndices.size(); ++t)
+  {
+    if (oobIndices[t].n_elem == 0)
+      continue;
+
+    hasOOB = true;
+    if (oobIndices[t].max() >= data.n_cols)
+    {
+      std::ostringstream oss;
+      oss << callerDescription << ": the forest was trained on more points "
+          << "than the " << data.n_cols << " given!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  if (!hasOOB)
+  {
+    throw std::invalid_argument(callerDescription + ": no out-of-bag points; "
+        "the forest must be trained with bootstrap sampling, and out-of-bag "
+        "points are not saved with the model!");
+  }
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -463,8 +650,14 @@ void RandomForest<
 
   // Allocate space if needed.
   if (cereal::is_loading<Archive>())
+  {
     trees.resize(numTrees);
 
+    // Out-of-bag points are not saved.
+    oobIndices.clear();
+    oobIndices.resize(numTrees);
+  }
+
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
 }
@@ -497,71 +690,46 @@ double RandomForest<
 {
   // Reset the forest if we are not doing a warm-start.
   if (!warmStart)
+  {
     trees.clear();
+    oobIndices.clear();
+  }
   const size_t oldNumTrees = trees.size();
   trees.resize(trees.size() + numTrees);
+  oobIndices.resize(trees.size());
 
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
+  // A tree that uses BestBinaryNumericSplit builds the same splits on the
+  // ranks of the values as on the values themselves, so each dimension is
+  // sorted once here, and the trees are trained on ranks, which are quicker to
+  // sort at each node.
+  const bool useRanks = std::is_same<NumericSplitType<FitnessFunction>,
+      BestBinaryNumericSplit<FitnessFunction>>::value;
+  SortedFeatureIndex index;
+  if (useRanks)
+    index.Build<UseDatasetInfo>(dataset, datasetInfo);
+
   // Train each tree individually.
   #pragma omp parallel for reduction( + : totalGain)
   for (size_t i = 0; i < numTrees; ++i)
   {
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
-    arma::rowvec bootstrapWeights;
-    if (UseBootstrap)
-    {
-      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
-    }
-
-    if (UseWeights)
+    DecisionTreeType& tree = trees[oldNumTrees + i];
+    if (useRanks)
     {
-      if (UseDatasetInfo)
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, weights, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector);
-      }
-      else
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
+      totalGain += TrainTree<UseWeights, UseDatasetInfo>(tree,
+          oobIndices[oldNumTrees + i], index.Ranks(), datasetInfo, labels,
+          numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector);
+      index.RestoreSplits(tree);
     }
     else
     {
-      if (UseDatasetInfo)
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
-      else
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
+      totalGain += TrainTree<UseWeights, UseDatasetInfo>(tree,
+          oobIndices[oldNumTrees + i], dataset, datasetInfo, labels,
+          numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector);
     }
   }
 
@@ -569,6 +737,61 @@ double RandomForest<
   return avgGain;
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::TrainTree(DecisionTreeType& tree,
+             arma::uvec& treeOOBIndices,
+             const MatType& dataset,
+             const data::DatasetInfo& datasetInfo,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses,
+             const arma::rowvec& weights,
+             const size_t minimumLeafSize,
+             const double minimumGainSplit,
+             const size_t maximumDepth,
+             DimensionSelectionType& dimensionSelector)
+{
+  if (!UseBootstrap)
+  {
+    // Every point is used, so none is out of bag.
+    treeOOBIndices.clear();
+
+    return tree.template TrainOnPoints<UseWeights, UseDatasetInfo>(dataset,
+        datasetInfo, arma::regspace<arma::uvec>(0, dataset.n_cols - 1),
+        labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+        maximumDepth, dimensionSelector);
+  }
+
+  // Train on the points that were drawn, weighted by the number of times they
+  // were drawn; this is the same as training on the bootstrapped dataset,
+  // except that minimumLeafSize counts distinct points.  The tree only
+  // reorders the indices of the points, so the dataset is shared by all the
+  // trees.
+  arma::Row<size_t> counts;
+  BootstrapCounts(dataset.n_cols, counts);
+  treeOOBIndices = arma::find(counts == 0);
+
+  arma::rowvec bootstrapWeights = arma::conv_to<arma::rowvec>::from(counts);
+  if (UseWeights)
+    bootstrapWeights %= weights;
+
+  return tree.template TrainOnPoints<true, UseDatasetInfo>(dataset,
+      datasetInfo, arma::find(counts), labels, numClasses, bootstrapWeights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -67,6 +67,21 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("print_training_accuracy") + " is specified, the "
     "calculated accuracy on the training set will be printed."
     "\n\n"
+    "Each tree is trained on a bootstrap sample of the training set, and the "
+    "points that are not in the sample of a tree are its out-of-bag points.  "
+    "If " + PRINT_PARAM_STRING("compute_oob_error") + " is specified, each "
+    "training point is classified by the trees it is out of bag for, and the "
+    "fraction of misclassified points is printed and saved in the " +
+    PRINT_PARAM_STRING("oob_error") + " output parameter; this estimates the "
+    "test error without a separate validation set.  If " +
+    PRINT_PARAM_STRING("compute_feature_importance") + " is specified, the "
+    "permutation importance of each dimension (the decrease of the accuracy "
+    "of the trees on their out-of-bag points when the values of the dimension "
+    "are shuffled) is saved in the " +
+    PRINT_PARAM_STRING("feature_importance") + " output parameter.  With " +
+    PRINT_PARAM_STRING("warm_start") + ", only the new trees are used, since "
+    "out-of-bag points are not saved with the model."
+    "\n\n"
     "Test data may be specified with the " + PRINT_PARAM_STRING("test") + " "
     "parameter, and if performance measures are desired for that test set, "
     "labels for the test points may be specified with the " +
@@ -137,6 +152,15 @@ PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_FLAG("warm_start", "If true and passed along with `training` and "
     "`input_model` then trains more trees on top of existing model.", "w");
 
+PARAM_FLAG("compute_oob_error", "If set, compute the out-of-bag error of the "
+    "forest on the training set.", "o");
+PARAM_FLAG("compute_feature_importance", "If set, compute the permutation "
+    "importance of each dimension on the out-of-bag points.", "i");
+PARAM_DOUBLE_OUT("oob_error", "Out-of-bag error of the forest on the training "
+    "set.");
+PARAM_COL_OUT("feature_importance", "Permutation importance of each dimension "
+    "of the training set.", "I");
+
 /**
  * This is the class that we will serialize.  It is a pretty simple wrapper
  * around DecisionTree<>.  In order to support categoricals, it will need to
@@ -186,11 +210,15 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   ReportIgnoredParam(params, {{ "training", false }},
       "print_training_accuracy");
+  ReportIgnoredParam(params, {{ "training", false }}, "compute_oob_error");
+  ReportIgnoredParam(params, {{ "training", false }},
+      "compute_feature_importance");
   ReportIgnoredParam(params, {{ "test", false }}, "test_labels");
 
   RequireAtLeastOnePassed(params, { "test", "output_model",
-      "print_training_accuracy" }, false, "the trained forest model will not "
-      "be used or saved");
+      "print_training_accuracy", "compute_oob_error",
+      "compute_feature_importance" }, false, "the trained forest model will "
+      "not be used or saved");
 
   if (params.Has("training"))
   {
@@ -267,7 +295,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     {
       timers.Start("rf_prediction");
       arma::Row<size_t> predictions;
-      rfModel->rf.Classify(data, predictions);
+      CompiledRandomForest<RandomForest<>>(rfModel->rf).Classify(data,
+          predictions);
 
       const size_t correct = arma::accu(predictions == labels);
 
@@ -276,6 +305,24 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
           << endl;
       timers.Stop("rf_prediction");
     }
+
+    // Evaluate the forest on the out-of-bag points.
+    if (params.Has("compute_oob_error"))
+    {
+      timers.Start("rf_oob_error");
+      const double oobError = rfModel->rf.OOBError(data, labels);
+      Log::Info << "Out-of-bag error: " << oobError << "." << endl;
+      params.Get<double>("oob_error") = oobError;
+      timers.Stop("rf_oob_error");
+    }
+
+    if (params.Has("compute_feature_importance"))
+    {
+      timers.Start("rf_feature_importance");
+      rfModel->rf.FeatureImportance(data, labels,
+          params.Get<arma::vec>("feature_importance"));
+      timers.Stop("rf_feature_importance");
+    }
   }
 
   if (params.Has("test"))
@@ -283,10 +330,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     arma::mat testData = std::move(params.Get<arma::mat>("test"));
     timers.Start("rf_prediction");
 
-    // Get predictions and probabilities.
+    // Get predictions and probabilities, with a flattened copy of the forest.
     arma::Row<size_t> predictions;
     arma::mat probabilities;
-    rfModel->rf.Classify(testData, predictions, probabilities);
+    CompiledRandomForest<RandomForest<>> compiledForest(rfModel->rf);
+    compiledForest.Classify(testData, predictions, probabilities);
 
     // Did we want to calculate test accuracy?
     if (params.Has("test_labels"))
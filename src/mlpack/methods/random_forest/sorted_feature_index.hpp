@@ -0,0 +1,133 @@
+/**
+ * @file methods/random_forest/sorted_feature_index.hpp
+ *
+ * The ranks of the values of each dimension of a dataset, computed once and
+ * shared by all the trees of a random forest.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_SORTED_FEATURE_INDEX_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_SORTED_FEATURE_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A SortedFeatureIndex sorts each numeric dimension of a dataset once, and
+ * stores the sorted distinct values of the dimension and the rank of the value
+ * of each point among them.  Categorical dimensions are kept as they are.
+ *
+ * A decision tree that uses BestBinaryNumericSplit builds the same splits on
+ * the ranks as on the values, since only the order of the values matters.  The
+ * ranks of the points of a node are integers in a range not much larger than
+ * the number of points near the top of the tree, where nodes are largest, so
+ * BestBinaryNumericSplit sorts them by counting instead of by comparison.
+ * Once a tree is trained on ranks, RestoreSplits() turns its split points back
+ * into values of the original dataset.
+ *
+ * The index is read-only once built, so all the trees of a forest can share it
+ * while they are trained in parallel.
+ */
+class SortedFeatureIndex
+{
+ public:
+  //! Create an empty index.
+  SortedFeatureIndex() { }
+
+  /**
+   * Sort each dimension of the given dataset, in parallel.
+   *
+   * @param dataset Dataset to index.
+   * @param datasetInfo Type of each dimension (only used if UseDatasetInfo is
+   *     true; otherwise all dimensions are numeric).
+   */
+  template<bool UseDatasetInfo, typename MatType>
+  void Build(const MatType& dataset, const data::DatasetInfo& datasetInfo)
+  {
+    ranks.set_size(dataset.n_rows, dataset.n_cols);
+    values.clear();
+    values.resize(dataset.n_rows);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t d = 0; d < (size_t) dataset.n_rows; ++d)
+    {
+      if (UseDatasetInfo &&
+          datasetInfo.Type(d) == data::Datatype::categorical)
+      {
+        for (size_t i = 0; i < dataset.n_cols; ++i)
+          ranks(d, i) = (uint32_t) dataset(d, i);
+        continue;
+      }
+
+      const arma::uvec order = arma::sort_index(dataset.row(d));
+      std::vector<double> dimensionValues;
+      for (size_t k = 0; k < order.n_elem; ++k)
+      {
+        const double value = dataset(d, order[k]);
+        if (dimensionValues.empty() || value != dimensionValues.back())
+          dimensionValues.push_back(value);
+
+        ranks(d, order[k]) = (uint32_t) (dimensionValues.size() - 1);
+      }
+
+      values[d] = arma::vec(dimensionValues);
+    }
+  }
+
+  /**
+   * Turn the split points of the numeric splits of a tree trained on the
+   * ranks back into values of the original dataset.
+   *
+   * A split point is halfway between the ranks of two points of the node
+   * whose values are consecutive in the node; the restored split point is
+   * halfway between the two consecutive values of the whole dataset that
+   * surround it, which sends every point of the node to the same child.
+   *
+   * @param tree Tree trained on Ranks() with BestBinaryNumericSplit.
+   */
+  template<typename TreeType>
+  void RestoreSplits(TreeType& tree) const
+  {
+    if (tree.children.empty())
+      return;
+
+    if (tree.dimensionType == (size_t) data::Datatype::numeric)
+    {
+      const arma::vec& dimensionValues = values[tree.splitDimension];
+      const size_t rank = std::min((size_t) tree.classProbabilities[0],
+          (size_t) dimensionValues.n_elem - 2);
+      tree.classProbabilities[0] = (dimensionValues[rank] +
+          dimensionValues[rank + 1]) / 2.0;
+    }
+
+    for (size_t i = 0; i < tree.children.size(); ++i)
+      RestoreSplits(*tree.children[i]);
+  }
+
+  //! Get the rank of each value (categorical dimensions are unchanged).
+  const arma::Mat<uint32_t>& Ranks() const { return ranks; }
+
+  //! Get the sorted distinct values of the given numeric dimension.
+  const arma::vec& Values(const size_t dimension) const
+  {
+    return values[dimension];
+  }
+
+ private:
+  //! The rank of each value.  Ranks are stored as 32-bit integers, which
+  //! take half the memory of the dataset (for double values), and which
+  //! BestBinaryNumericSplit sorts by counting.
+  arma::Mat<uint32_t> ranks;
+  //! The sorted distinct values of each numeric dimension.
+  std::vector<arma::vec> values;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -361,47 +361,122 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    // The naive brute-force solution.  The query points are independent, so
+    // they are processed in parallel; each thread needs its own rules, because
+    // the rules remember the last base case.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, querySet, range, *neighborPtr,
+          *distancePtr, metric);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
 
     baseCases += (querySet.n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Traverse for each query point in parallel, with one set of rules and one
+    // traverser per thread.  Trees whose first point is the centroid cache
+    // base case results in the statistics of their nodes, so for those the
+    // traversals must be done serially.
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    #pragma omp parallel if (!tree::TreeTraits<Tree>::FirstPointIsCentroid) \
+        reduction(+:totalBaseCases, totalScores)
+    {
+      RuleType rules(*referenceSet, querySet, range, *neighborPtr,
+          *distancePtr, metric);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+
+    baseCases += totalBaseCases;
+    scores += totalScores;
   }
   else // Dual-tree recursion.
   {
-    // Build the query tree.
-    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    // Split the query set into one contiguous chunk per thread, and traverse
+    // each chunk's query tree against the reference tree in parallel, with its
+    // own rules.  The results of the chunks are disjoint, so they are moved in
+    // place, and the mappings of the chunk trees are concatenated into the
+    // mapping of the whole query set.  Trees whose first point is the centroid
+    // cache base case results in the statistics of their nodes, so for those
+    // there is only one chunk.  The query trees are built serially, since some
+    // trees are built with random numbers.
+    size_t numChunks = 1;
+    #ifdef MLPACK_USE_OPENMP
+      if (!tree::TreeTraits<Tree>::FirstPointIsCentroid)
+      {
+        numChunks = std::max(std::min((size_t) omp_get_max_threads(),
+            (size_t) querySet.n_cols), (size_t) 1);
+      }
+    #endif
+    const size_t chunkSize = (querySet.n_cols + numChunks - 1) / numChunks;
 
-    // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    std::vector<Tree*> queryTrees(numChunks, NULL);
+    std::vector<std::vector<size_t>> chunkOldFromNew(numChunks);
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      const size_t begin = c * chunkSize;
+      const size_t end = std::min(begin + chunkSize,
+          (size_t) querySet.n_cols);
+      if (begin < end)
+      {
+        queryTrees[c] = BuildTree<Tree>(MatType(querySet.cols(begin,
+            end - 1)), chunkOldFromNew[c]);
+      }
+    }
+
+    if (tree::TreeTraits<Tree>::RearrangesDataset)
+      oldFromNewQueries.resize(querySet.n_cols);
+
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    #pragma omp parallel for schedule(static, 1) \
+        reduction(+:totalBaseCases, totalScores)
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      if (queryTrees[c] == NULL)
+        continue;
 
-    traverser.Traverse(*queryTree, *referenceTree);
+      const size_t begin = c * chunkSize;
+      const size_t count = queryTrees[c]->Dataset().n_cols;
+      std::vector<std::vector<size_t>> chunkNeighbors(count);
+      std::vector<std::vector<double>> chunkDistances(count);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+      RuleType rules(*referenceSet, queryTrees[c]->Dataset(), range,
+          chunkNeighbors, chunkDistances, metric);
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
-    // Clean up tree memory.
-    delete queryTree;
+      traverser.Traverse(*queryTrees[c], *referenceTree);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        (*neighborPtr)[begin + i] = std::move(chunkNeighbors[i]);
+        (*distancePtr)[begin + i] = std::move(chunkDistances[i]);
+        if (tree::TreeTraits<Tree>::RearrangesDataset)
+          oldFromNewQueries[begin + i] = begin + chunkOldFromNew[c][i];
+      }
+
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+
+      // Clean up tree memory.
+      delete queryTrees[c];
+    }
+
+    baseCases += totalBaseCases;
+    scores += totalScores;
   }
 
   // Map points back to original indices, if necessary.
@@ -571,33 +646,53 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
 
   if (naive)
   {
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // The naive brute-force solution, in parallel over the query points.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+          *distancePtr, metric, true /* don't return the query */);
+
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) referenceSet->n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
 
     baseCases = (referenceSet->n_cols * referenceSet->n_cols);
     scores = 0;
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Traverse for each point in parallel, unless the tree caches base cases
+    // in its statistics (see the other Search() overload).
+    size_t totalBaseCases = 0;
+    size_t totalScores = 0;
+    #pragma omp parallel if (!tree::TreeTraits<Tree>::FirstPointIsCentroid) \
+        reduction(+:totalBaseCases, totalScores)
+    {
+      RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+          *distancePtr, metric, true /* don't return the query */);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < (size_t) referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
 
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+      totalBaseCases += rules.BaseCases();
+      totalScores += rules.Scores();
+    }
+
+    baseCases = totalBaseCases;
+    scores = totalScores;
   }
   else // Dual-tree recursion.
   {
+    RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+        *distancePtr, metric, true /* don't return the query in the results */);
+
     // Create the traverser.
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
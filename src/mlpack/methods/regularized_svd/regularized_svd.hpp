@@ -65,10 +65,13 @@ class RegularizedSVD
    * @param iterations Number of optimization iterations.
    * @param alpha Learning rate for the SGD optimizer.
    * @param lambda Regularization parameter for the optimization.
+   * @param hogwild If true, optimize with lock-free parallel SGD updates
+   *     (Hogwild!) using ens::ParallelSGD instead of StandardSGD.
    */
   RegularizedSVD(const size_t iterations = 10,
                  const double alpha = 0.01,
-                 const double lambda = 0.02);
+                 const double lambda = 0.02,
+                 const bool hogwild = false);
 
   /**
    * Obtains the user and item matrices using the provided data and rank.
@@ -90,6 +93,8 @@ class RegularizedSVD
   double alpha;
   //! Regularization parameter for the optimization.
   double lambda;
+  //! Whether to optimize with parallel Hogwild! SGD.
+  bool hogwild;
 };
 
 } // namespace svd
@@ -150,6 +150,28 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::Update(arma::mat& parameters,
+                                             const size_t i,
+                                             const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+
+  // Prediction error for the example.
+  const double rating = data(2, i);
+  const double ratingError = rating - arma::dot(parameters.col(user),
+                                                parameters.col(item));
+
+  // Gradient is non-zero only for the parameter columns corresponding to the
+  // example.
+  parameters.col(user) -= stepSize * (lambda * parameters.col(user) -
+                                      ratingError * parameters.col(item));
+  parameters.col(item) -= stepSize * (lambda * parameters.col(item) -
+                                      ratingError * parameters.col(user));
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -228,10 +250,23 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double lastObjective;
 
   // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
+  const size_t numFunctions = function.NumFunctions();
+  arma::uvec visitationOrder = arma::linspace<arma::uvec>(0,
+      numFunctions - 1, numFunctions);
+
+  // Each thread visits at most threadShareSize examples per iteration.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numVisited = std::min(numFunctions,
+      numThreads * threadShareSize);
+
+  double stepSize = 0.0;
+  auto update = [&](const size_t i)
+  {
+    function.Update(iterate, i, stepSize);
+  };
 
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
@@ -243,7 +278,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     overallObjective = 0;
 
     #pragma omp parallel for reduction(+:overallObjective)
-    for (size_t j = 0; j < (size_t) function.NumFunctions(); ++j)
+    for (size_t j = 0; j < numFunctions; ++j)
     {
       overallObjective += function.Evaluate(iterate, j);
     }
@@ -268,53 +303,21 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     }
 
     // Get the stepsize for this iteration
-    double stepSize = decayPolicy.StepSize(i);
+    stepSize = decayPolicy.StepSize(i);
 
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::RandGen());
+    if (numVisited < numFunctions)
+    {
+      // Only some of the examples are visited; choose which ones.
+      if (shuffle)
+        std::shuffle(visitationOrder.begin(), visitationOrder.end(),
+            mlpack::math::RandGen());
 
-    #pragma omp parallel
+      arma::uvec partialOrder = visitationOrder.head(numVisited);
+      mlpack::math::HogwildEpoch(partialOrder, shuffle, update);
+    }
+    else
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef MLPACK_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
-      {
-        const size_t numUsers = function.NumUsers();
-
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        double ratingError = rating - arma::dot(iterate.col(user),
-            iterate.col(item));
-
-        double lambda = function.Lambda();
-
-        arma::mat userUpdate = stepSize * (lambda * iterate.col(user) -
-            ratingError * iterate.col(item));
-        arma::mat itemUpdate = stepSize * (lambda * iterate.col(item) -
-            ratingError * iterate.col(user));
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < iterate.n_rows; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemUpdate(i);
-        }
-      }
+      mlpack::math::HogwildEpoch(visitationOrder, shuffle, update);
     }
   }
   mlpack::Log::Info << "\n Parallel SGD terminated with objective : "
@@ -15,11 +15,20 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/mixed_product.hpp>
 
 namespace mlpack {
 namespace regression {
 
-class SoftmaxRegressionFunction
+/**
+ * The objective function of softmax regression.  The data may be dense or
+ * sparse, in single or double precision (for instance arma::sp_fmat); it is
+ * never converted, and the parameters are kept in double precision.
+ *
+ * @tparam MatType Type of data matrix.
+ */
+template<typename MatType = arma::mat>
+class SoftmaxRegressionFunctionType
 {
  public:
   /**
@@ -32,11 +41,11 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
-                            const arma::Row<size_t>& labels,
-                            const size_t numClasses,
-                            const double lambda = 0.0001,
-                            const bool fitIntercept = false);
+  SoftmaxRegressionFunctionType(const MatType& data,
+                               const arma::Row<size_t>& labels,
+                               const size_t numClasses,
+                               const double lambda = 0.0001,
+                               const bool fitIntercept = false);
 
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
@@ -190,7 +199,7 @@ class SoftmaxRegressionFunction
 
  private:
   //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  MatType data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
   //! Initial parameter point.
@@ -203,6 +212,9 @@ class SoftmaxRegressionFunction
   bool fitIntercept;
 };
 
+//! The objective function of softmax regression on dense data.
+typedef SoftmaxRegressionFunctionType<arma::mat> SoftmaxRegressionFunction;
+
 } // namespace regression
 } // namespace mlpack
 
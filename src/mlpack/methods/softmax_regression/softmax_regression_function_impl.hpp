@@ -12,18 +12,21 @@
 #ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
 #define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
 
+#include <mlpack/core/math/shuffle_data.hpp>
+
 #include "softmax_regression_function.hpp"
 
 namespace mlpack {
 namespace regression {
 
-inline SoftmaxRegressionFunction::SoftmaxRegressionFunction(
-    const arma::mat& data,
+template<typename MatType>
+SoftmaxRegressionFunctionType<MatType>::SoftmaxRegressionFunctionType(
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
     const bool fitIntercept) :
-    data(math::MakeAlias(const_cast<arma::mat&>(data), false)),
+    data(math::MakeAlias(const_cast<MatType&>(data), false)),
     numClasses(numClasses),
     lambda(lambda),
     fitIntercept(fitIntercept)
@@ -38,38 +41,23 @@ inline SoftmaxRegressionFunction::SoftmaxRegressionFunction(
 /**
  * Shuffle the data.
  */
-inline void SoftmaxRegressionFunction::Shuffle()
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      data.n_cols - 1, data.n_cols));
+  // Recover the labels from the ground truth matrix.
+  arma::Row<size_t> labels(groundTruth.n_cols);
+  for (arma::sp_mat::const_iterator it = groundTruth.begin();
+       it != groundTruth.end(); ++it)
+    labels[it.col()] = it.row();
+
+  // Shuffle the points and labels together; this works for sparse data too.
+  MatType newData;
+  arma::Row<size_t> newLabels;
+  math::ShuffleData(data, labels, newData, newLabels);
 
-  // Re-sort data.
-  arma::mat newData = data.cols(ordering);
   math::ClearAlias(data);
   data = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-      groundTruth.n_cols);
+  GetGroundTruthMatrix(newLabels, groundTruth);
 }
 
 /**
@@ -77,12 +65,14 @@ inline void SoftmaxRegressionFunction::Shuffle()
  * normal distribution. The weights cannot be initialized to zero, as that will
  * lead to each class output being the same.
  */
-inline const arma::mat SoftmaxRegressionFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights()
 {
   return InitializeWeights(data.n_rows, numClasses, fitIntercept);
 }
 
-inline const arma::mat SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -92,7 +82,8 @@ inline const arma::mat SoftmaxRegressionFunction::InitializeWeights(
     return parameters;
 }
 
-inline void SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     arma::mat &weights,
     const size_t featureSize,
     const size_t numClasses,
@@ -113,7 +104,8 @@ inline void SoftmaxRegressionFunction::InitializeWeights(
  * labels. The output is in the form of a matrix, which leads to simpler
  * calculations in the Evaluate() and Gradient() methods.
  */
-inline void SoftmaxRegressionFunction::GetGroundTruthMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels, arma::sp_mat& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
@@ -149,7 +141,8 @@ inline void SoftmaxRegressionFunction::GetGroundTruthMatrix(
  * Evaluate the probabilities matrix. If fitIntercept flag is true,
  * it should consider the parameters.cols(0) intercept term.
  */
-inline void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities,
     const size_t start,
@@ -167,13 +160,13 @@ inline void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     // split the hypothesis computation to two components.
     hypothesis = arma::exp(
         arma::repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+        math::MixedProduct(parameters.cols(1, parameters.n_cols - 1),
+        data.cols(start, start + batchSize - 1)));
   }
   else
   {
-    hypothesis = arma::exp(parameters *
-        data.cols(start, start + batchSize - 1));
+    hypothesis = arma::exp(math::MixedProduct(parameters,
+        data.cols(start, start + batchSize - 1)));
   }
 
   probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
@@ -183,8 +176,9 @@ inline void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
 /**
  * Evaluates the objective function given the parameters.
  */
-inline double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters)
-    const
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters) const
 {
   // The objective function is the negative log likelihood of the model
   // calculated over all the training examples. Mathematically it is as follows:
@@ -222,9 +216,11 @@ inline double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters)
 /**
  * Evaluate the objective function for the given points given the parameters.
  */
-inline double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
-                                                  const size_t start,
-                                                  const size_t batchSize) const
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t start,
+    const size_t batchSize) const
 {
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
@@ -234,7 +230,7 @@ inline double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
 
   logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
       arma::log(probabilities)) / batchSize;
-  weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
+  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   return -logLikelihood + weightDecay;
 }
@@ -242,8 +238,10 @@ inline double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
 /**
  * Calculates and stores the gradient values given a set of parameters.
  */
-inline void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                                arma::mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
 {
   // Calculate the class probabilities for each training example. The
   // probabilities for each of the classes are given by:
@@ -265,21 +263,22 @@ inline void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
       inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
       lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-      inner * data.t() / data.n_cols +
+      math::MixedProductTrans(inner, data) / data.n_cols +
       lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
-               lambda * parameters;
+    gradient = math::MixedProductTrans(probabilities - groundTruth, data) /
+        data.n_cols + lambda * parameters;
   }
 }
 
-inline void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                                const size_t start,
-                                                arma::mat& gradient,
-                                                const size_t batchSize)
-    const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t start,
+    arma::mat& gradient,
+    const size_t batchSize) const
 {
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
@@ -294,21 +293,24 @@ inline void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
         inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        math::MixedProductTrans(inner,
+        data.cols(start, start + batchSize - 1)) / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
+    gradient = math::MixedProductTrans(probabilities -
+        groundTruth.cols(start, start + batchSize - 1),
+        data.cols(start, start + batchSize - 1)) / batchSize
         + lambda * parameters;
   }
 }
 
-inline void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
-                                                       const size_t j,
-                                                       arma::sp_mat& gradient) 
-    const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::PartialGradient(
+    const arma::mat& parameters,
+    const size_t j,
+    arma::sp_mat& gradient) const
 {
   gradient.zeros(arma::size(parameters));
 
@@ -327,14 +329,15 @@ inline void SoftmaxRegressionFunction::PartialGradient(const arma::mat& paramete
     }
     else
     {
-      gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
-          parameters.col(j);
+      // Column j of the parameters is for dimension j - 1 of the data.
+      gradient.col(j) = math::MixedProductTrans(inner, data.row(j - 1)) /
+          data.n_cols + lambda * parameters.col(j);
     }
   }
   else
   {
-    gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
-        parameters.col(j);
+    gradient.col(j) = math::MixedProductTrans(inner, data.row(j)) /
+        data.n_cols + lambda * parameters.col(j);
   }
 }
 
@@ -18,9 +18,9 @@
 namespace mlpack {
 namespace regression {
 
-template<typename OptimizerType>
+template<typename OptimizerType, typename MatType>
 SoftmaxRegression::SoftmaxRegression(
-    const arma::mat& data,
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -33,9 +33,9 @@ SoftmaxRegression::SoftmaxRegression(
   Train(data, labels, numClasses, optimizer);
 }
 
-template<typename OptimizerType, typename... CallbackTypes>
+template<typename OptimizerType, typename MatType, typename... CallbackTypes>
 SoftmaxRegression::SoftmaxRegression(
-    const arma::mat& data,
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -61,9 +61,9 @@ inline SoftmaxRegression::SoftmaxRegression(
       parameters, inputSize, numClasses, fitIntercept);
 }
 
-inline void SoftmaxRegression::Classify(const arma::mat& dataset,
-                                        arma::Row<size_t>& labels)
-    const
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::Row<size_t>& labels) const
 {
   arma::mat probabilities;
   Classify(dataset, probabilities);
@@ -91,10 +91,10 @@ inline void SoftmaxRegression::Classify(const arma::mat& dataset,
   }
 }
 
-inline void SoftmaxRegression::Classify(const arma::mat& dataset,
-                                        arma::Row<size_t>& labels,
-                                        arma::mat& probabilities)
-    const
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::Row<size_t>& labels,
+                                 arma::mat& probabilities) const
 {
   Classify(dataset, probabilities);
 
@@ -121,9 +121,9 @@ inline void SoftmaxRegression::Classify(const arma::mat& dataset,
   }
 }
 
-inline void SoftmaxRegression::Classify(const arma::mat& dataset,
-                                        arma::mat& probabilities)
-    const
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::mat& probabilities) const
 {
   util::CheckSameDimensionality(dataset, FeatureSize(),
       "SoftmaxRegression::Classify()");
@@ -140,11 +140,11 @@ inline void SoftmaxRegression::Classify(const arma::mat& dataset,
     // split the hypothesis computation to two components.
     hypothesis = arma::exp(
       arma::repmat(parameters.col(0), 1, dataset.n_cols) +
-      parameters.cols(1, parameters.n_cols - 1) * dataset);
+      math::MixedProduct(parameters.cols(1, parameters.n_cols - 1), dataset));
   }
   else
   {
-    hypothesis = arma::exp(parameters * dataset);
+    hypothesis = arma::exp(math::MixedProduct(parameters, dataset));
   }
 
   probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
@@ -159,8 +159,9 @@ size_t SoftmaxRegression::Classify(const VecType& point) const
   return size_t(label(0));
 }
 
-inline double SoftmaxRegression::ComputeAccuracy(
-    const arma::mat& testData,
+template<typename MatType>
+double SoftmaxRegression::ComputeAccuracy(
+    const MatType& testData,
     const arma::Row<size_t>& labels) const
 {
   arma::Row<size_t> predictions;
@@ -178,14 +179,14 @@ inline double SoftmaxRegression::ComputeAccuracy(
   return (count * 100.0) / predictions.n_elem;
 }
 
-template<typename OptimizerType>
-double SoftmaxRegression::Train(const arma::mat& data,
+template<typename OptimizerType, typename MatType>
+double SoftmaxRegression::Train(const MatType& data,
                                 const arma::Row<size_t>& labels,
                                 const size_t numClasses,
                                 OptimizerType optimizer)
 {
-  SoftmaxRegressionFunction regressor(data, labels, numClasses, lambda,
-                                      fitIntercept);
+  SoftmaxRegressionFunctionType<MatType> regressor(data, labels, numClasses,
+      lambda, fitIntercept);
   if (parameters.n_elem != regressor.GetInitialPoint().n_elem)
     parameters = regressor.GetInitialPoint();
 
@@ -198,15 +199,15 @@ double SoftmaxRegression::Train(const arma::mat& data,
   return out;
 }
 
-template<typename OptimizerType, typename... CallbackTypes>
-double SoftmaxRegression::Train(const arma::mat& data,
+template<typename OptimizerType, typename MatType, typename... CallbackTypes>
+double SoftmaxRegression::Train(const MatType& data,
                                 const arma::Row<size_t>& labels,
                                 const size_t numClasses,
                                 OptimizerType optimizer,
                                 CallbackTypes&&... callbacks)
 {
-  SoftmaxRegressionFunction regressor(data, labels, numClasses, lambda,
-                                      fitIntercept);
+  SoftmaxRegressionFunctionType<MatType> regressor(data, labels, numClasses,
+      lambda, fitIntercept);
   if (parameters.n_elem != regressor.GetInitialPoint().n_elem)
     parameters = regressor.GetInitialPoint();
 
@@ -15,6 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/lars/lars.hpp>
+#include <mlpack/methods/elastic_net/elastic_net.hpp>
 
 // Include our three simple dictionary initializers.
 #include "nothing_initializer.hpp"
@@ -95,7 +96,9 @@ namespace sparse_coding {
  *
  * Note that the implementation here does not use the feature-sign search
  * algorithm from Honglak Lee's paper, but instead the LARS algorithm suggested
- * in that paper.
+ * in that paper.  If UseCoordinateDescent() is set, the codes are instead
+ * found by coordinate descent (see regression::ElasticNet), which is faster
+ * when the dictionary has many atoms.
  *
  * When Train() is called, the dictionary is initialized using the
  * DictionaryInitializationPolicy class.  Possible choices include the
@@ -186,8 +189,9 @@ class SparseCoding
                    DictionaryInitializer());
 
   /**
-   * Sparse code each point in the given dataset via LARS, using the current
-   * dictionary and store the encoded data in the codes matrix.
+   * Sparse code each point in the given dataset via LARS (or coordinate
+   * descent, if UseCoordinateDescent() is set), using the current dictionary
+   * and store the encoded data in the codes matrix.
    *
    * @param data Input data matrix to be encoded.
    * @param codes Output codes matrix.
@@ -254,6 +258,12 @@ class SparseCoding
   //! Modify the tolerance for Newton's method (dictionary optimization step).
   double& NewtonTolerance() { return newtonTolerance; }
 
+  //! Get whether the codes are found by coordinate descent instead of LARS.
+  bool UseCoordinateDescent() const { return useCoordinateDescent; }
+  //! Modify whether the codes are found by coordinate descent instead of LARS.
+  //! This is not saved with the model.
+  bool& UseCoordinateDescent() { return useCoordinateDescent; }
+
   //! Serialize the sparse coding model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -276,6 +286,8 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+  //! Whether to find the codes by coordinate descent instead of LARS.
+  bool useCoordinateDescent;
 };
 
 } // namespace sparse_coding
@@ -34,7 +34,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    useCoordinateDescent(false)
 {
   Train(data, initializer);
 }
@@ -51,7 +52,8 @@ inline SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    useCoordinateDescent(false)
 {
   // Nothing to do.
 }
@@ -64,21 +66,29 @@ inline void SparseCoding::Encode(const arma::mat& data,
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
+  // The points are independent, so they are encoded in parallel.  Each thread
+  // reuses one solver (and its workspace) for all of its points.
+  #pragma omp parallel
+  {
     bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
+    regression::ElasticNet elasticNet(matGram, lambda1, lambda2);
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      if (useCoordinateDescent)
+        elasticNet.Train(dictionary, responses, code, false);
+      else
+        lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
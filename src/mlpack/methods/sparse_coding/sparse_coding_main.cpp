@@ -109,6 +109,9 @@ PARAM_MATRIX_IN("initial_dictionary", "Optional initial dictionary matrix.",
     "i");
 PARAM_FLAG("normalize", "If set, the input data matrix will be normalized "
     "before coding.", "N");
+PARAM_FLAG("coordinate_descent", "If set, the codes are found by coordinate "
+    "descent instead of LARS; this is faster for dictionaries with many atoms.",
+    "C");
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_DOUBLE_IN("objective_tolerance", "Tolerance for convergence of the "
     "objective function.", "o", 0.01);
@@ -186,6 +189,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     sc = new SparseCoding(0, 0.0);
 
+  sc->UseCoordinateDescent() = params.Has("coordinate_descent");
+
   if (params.Has("training"))
   {
     mat matX = std::move(params.Get<arma::mat>("training"));
@@ -80,10 +80,13 @@ class SVDPlusPlus
    * @param iterations Number of optimization iterations.
    * @param alpha Learning rate for the SGD optimizer.
    * @param lambda Regularization parameter for the optimization.
+   * @param hogwild If true, optimize with lock-free parallel SGD updates
+   *     (Hogwild!) using ens::ParallelSGD instead of StandardSGD.
    */
   SVDPlusPlus(const size_t iterations = 10,
               const double alpha = 0.001,
-              const double lambda = 0.1);
+              const double lambda = 0.1,
+              const bool hogwild = false);
 
   /**
    * Trains the model and obtains user/item matrices, user/item bias, and
@@ -143,6 +146,8 @@ class SVDPlusPlus
   double alpha;
   //! Regularization parameter for the optimization.
   double lambda;
+  //! Whether to optimize with parallel Hogwild! SGD.
+  bool hogwild;
 };
 
 } // namespace svd
@@ -285,6 +285,66 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::Update(arma::mat& parameters,
+                                          const size_t i,
+                                          const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+  const size_t implicitStart = numUsers + numItems;
+
+  // Calculate the squared error in the prediction.
+  const double rating = data(2, i);
+  const double userBias = parameters(rank, user);
+  const double itemBias = parameters(rank, item);
+
+  // Iterate through each item which the user interacted with to calculate
+  // user vector.
+  arma::vec userVec(rank, arma::fill::zeros);
+  arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+  arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+  size_t implicitCount = 0;
+  for (; it != it_end; ++it)
+  {
+    userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+    implicitCount += 1;
+  }
+  if (implicitCount != 0)
+    userVec /= std::sqrt(implicitCount);
+  userVec += parameters.col(user).subvec(0, rank - 1);
+
+  const double ratingError = rating - userBias - itemBias -
+      arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+
+  // Gradient is non-zero only for the parameter columns corresponding to the
+  // example.
+  parameters.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(user).subvec(0, rank - 1) -
+      ratingError * parameters.col(item).subvec(0, rank - 1));
+  parameters.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * parameters.col(item).subvec(0, rank - 1) -
+      ratingError * userVec);
+  parameters(rank, user) -= stepSize * 2 * (
+      lambda * parameters(rank, user) - ratingError);
+  parameters(rank, item) -= stepSize * 2 * (
+      lambda * parameters(rank, item) - ratingError);
+
+  // Update item implicit vectors.
+  it = implicitData.begin_col(user);
+  it_end = implicitData.end_col(user);
+  for (; it != it_end; ++it)
+  {
+    // Note that implicitCount != 0 if this loop is acutally executed.
+    parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -=
+        stepSize * 2.0 * (lambda / implicitCount *
+        parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -
+        ratingError / std::sqrt(implicitCount) *
+        parameters.col(item).subvec(0, rank - 1));
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -403,17 +463,23 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double lastObjective;
 
   // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
-  const size_t numUsers = function.NumUsers();
-  const size_t numItems = function.NumItems();
-  const double lambda = function.Lambda();
-
-  // Rank of decomposition.
-  const size_t rank = function.Rank();
+  const size_t numFunctions = function.NumFunctions();
+  arma::uvec visitationOrder = arma::linspace<arma::uvec>(0,
+      numFunctions - 1, numFunctions);
+
+  // Each thread visits at most threadShareSize examples per iteration.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numVisited = std::min(numFunctions,
+      numThreads * threadShareSize);
+
+  double stepSize = 0.0;
+  auto update = [&](const size_t i)
+  {
+    function.Update(iterate, i, stepSize);
+  };
 
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
@@ -425,7 +491,7 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     overallObjective = 0;
 
     #pragma omp parallel for reduction(+:overallObjective)
-    for (size_t j = 0; j < (size_t) function.NumFunctions(); ++j)
+    for (size_t j = 0; j < numFunctions; ++j)
     {
       overallObjective += function.Evaluate(iterate, j);
     }
@@ -450,102 +516,21 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     }
 
     // Get the stepsize for this iteration
-    double stepSize = decayPolicy.StepSize(i);
+    stepSize = decayPolicy.StepSize(i);
 
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::RandGen());
+    if (numVisited < numFunctions)
+    {
+      // Only some of the examples are visited; choose which ones.
+      if (shuffle)
+        std::shuffle(visitationOrder.begin(), visitationOrder.end(),
+            mlpack::math::RandGen());
 
-    #pragma omp parallel
+      arma::uvec partialOrder = visitationOrder.head(numVisited);
+      mlpack::math::HogwildEpoch(partialOrder, shuffle, update);
+    }
+    else
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef MLPACK_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
-      {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
-        {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
-        userVec += iterate.col(user).subvec(0, rank - 1);
-
-        double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
-        {
-          for (size_t i = 0; i < rank; ++i)
-          {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
-          }
-        }
-      }
+      mlpack::math::HogwildEpoch(visitationOrder, shuffle, update);
     }
   }
   mlpack::Log::Info << "\n Parallel SGD terminated with objective : "
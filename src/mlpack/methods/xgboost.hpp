@@ -0,0 +1,11 @@
+/**
+ * @file xgboost.hpp
+ *
+ * Convenience include for mlpack/methods/xgboost/xgboost.hpp
+ */
+#ifndef MLPACK_XGBOOST_HPP
+#define MLPACK_XGBOOST_HPP
+
+#include "xgboost/xgboost.hpp"
+
+#endif
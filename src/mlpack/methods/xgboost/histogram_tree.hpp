@@ -0,0 +1,255 @@
+/**
+ * @file methods/xgboost/histogram_tree.hpp
+ *
+ * A regression tree for gradient boosting, grown on histograms of the
+ * gradients and Hessians of the loss.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_HPP
+#define MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "quantile_binning.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * A HistogramTree is one tree of a gradient boosting ensemble, grown with the
+ * second order approximation of the loss described in the following paper:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD '16)},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * With G and H the sums of the gradients and Hessians of the points of a node,
+ * the score of the node is T(G)^2 / (H + lambda), where T() shrinks G towards
+ * zero by alpha (L1 regularization), the value of a leaf is
+ * -T(G) / (H + lambda), and the gain of a split is
+ *
+ *   1/2 (score(left) + score(right) - score(node)) - gamma.
+ *
+ * Splits are only searched at the cuts of a QuantileBinning, so that the sums
+ * of each bin of a node (its histogram) are enough to evaluate every split of
+ * a dimension.  The histograms of the dimensions of a node are built and
+ * scanned in parallel with OpenMP, and only the histogram of the smaller child
+ * of each split is built from its points: the other one is the difference
+ * between the histogram of the parent and that child.
+ *
+ * The nodes are stored in flat arrays, and the two children of a node are
+ * next to each other.  A trained tree predicts points of the original
+ * dataset; the binned points can also be predicted directly.
+ */
+class HistogramTree
+{
+ public:
+  //! Create an empty tree, which predicts 0.
+  HistogramTree() :
+      bins(NULL),
+      binning(NULL),
+      gradients(NULL),
+      hessians(NULL),
+      rows(NULL),
+      dimensions(NULL),
+      maxDepth(0),
+      minChildWeight(0.0),
+      lambda(0.0),
+      alpha(0.0),
+      gamma(0.0),
+      learningRate(1.0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Grow the tree on the given points of a binned dataset.
+   *
+   * @param bins Binned dataset (one row per point), from
+   *     QuantileBinning::Transform().
+   * @param binning The binning used for the dataset.
+   * @param gradients Gradient of the loss of each point.
+   * @param hessians Hessian of the loss of each point.
+   * @param rows Indices of the points to grow the tree on.  This is reordered
+   *     during training.
+   * @param dimensions Dimensions that splits may be on.
+   * @param maxDepth Maximum depth of the tree (0 means no limit).
+   * @param minChildWeight Minimum sum of the Hessians of each child of a
+   *     split.
+   * @param lambda L2 regularization of the leaf values.
+   * @param alpha L1 regularization of the leaf values.
+   * @param gamma Minimum gain of a split.
+   * @param learningRate Shrinkage applied to the leaf values.
+   */
+  void Train(const arma::Mat<unsigned char>& bins,
+             const QuantileBinning& binning,
+             const arma::vec& gradients,
+             const arma::vec& hessians,
+             std::vector<size_t>& rows,
+             const std::vector<size_t>& dimensions,
+             const size_t maxDepth,
+             const double minChildWeight,
+             const double lambda,
+             const double alpha,
+             const double gamma,
+             const double learningRate);
+
+  /**
+   * Predict the value of the given point.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const
+  {
+    if (values.empty())
+      return 0.0;
+
+    size_t node = 0;
+    while (children[node] != 0)
+    {
+      node = children[node] +
+          ((point[splitDimensions[node]] > splitValues[node]) ? 1 : 0);
+    }
+
+    return values[node];
+  }
+
+  /**
+   * Predict the value of a point of a binned dataset.
+   *
+   * @param bins Binned dataset (one row per point).
+   * @param row Index of the point.
+   */
+  double Predict(const arma::Mat<unsigned char>& bins, const size_t row) const
+  {
+    if (values.empty())
+      return 0.0;
+
+    size_t node = 0;
+    while (children[node] != 0)
+    {
+      node = children[node] +
+          ((bins(row, splitDimensions[node]) > splitBins[node]) ? 1 : 0);
+    }
+
+    return values[node];
+  }
+
+  //! Get the number of nodes of the tree.
+  size_t NumNodes() const { return values.size(); }
+
+  //! Get the number of leaves of the tree.
+  size_t NumLeaves() const
+  {
+    return values.empty() ? 0 : (values.size() + 1) / 2;
+  }
+
+  //! Serialize the tree.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * The sums of the gradients, Hessians and number of points in each bin of
+   * each dimension of a node.  Bin b of the j'th searched dimension is in rows
+   * 3b to 3b + 2 of column j.
+   */
+  typedef arma::mat Histogram;
+
+  /**
+   * Grow the subtree of the given node, whose points are rows[begin, end) and
+   * whose histogram is given.  The histogram is destroyed.
+   */
+  void Grow(const size_t node,
+            const size_t begin,
+            const size_t end,
+            const size_t depth,
+            Histogram& histogram);
+
+  /**
+   * Build the histogram of the points rows[begin, end).
+   */
+  void BuildHistogram(const size_t begin,
+                      const size_t end,
+                      Histogram& histogram) const;
+
+  //! Shrink the sum of gradients towards zero by alpha.
+  double ThresholdL1(const double sumGradients) const
+  {
+    if (sumGradients > alpha)
+      return sumGradients - alpha;
+    else if (sumGradients < -alpha)
+      return sumGradients + alpha;
+
+    return 0.0;
+  }
+
+  //! Compute the score of a node.
+  double Score(const double sumGradients, const double sumHessians) const
+  {
+    if (sumHessians + lambda <= 0.0)
+      return 0.0;
+
+    const double g = ThresholdL1(sumGradients);
+    return g * g / (sumHessians + lambda);
+  }
+
+  //! The dimension of the split of each node.
+  std::vector<size_t> splitDimensions;
+  //! The split value of each node; points go left if their value is not
+  //! greater.
+  std::vector<double> splitValues;
+  //! The bin of the split of each node.
+  std::vector<size_t> splitBins;
+  //! The index of the left child of each node (the right child is next to
+  //! it), or 0 for leaves.
+  std::vector<size_t> children;
+  //! The value of each leaf (0 for internal nodes).
+  std::vector<double> values;
+
+  // These are only used during training.
+
+  //! The binned dataset.
+  const arma::Mat<unsigned char>* bins;
+  //! The binning of the dataset.
+  const QuantileBinning* binning;
+  //! The gradients of the points.
+  const arma::vec* gradients;
+  //! The Hessians of the points.
+  const arma::vec* hessians;
+  //! The points of the tree, grouped by node.
+  std::vector<size_t>* rows;
+  //! The dimensions that may be split on.
+  const std::vector<size_t>* dimensions;
+  //! The maximum depth.
+  size_t maxDepth;
+  //! The minimum sum of Hessians of a child.
+  double minChildWeight;
+  //! The L2 regularization.
+  double lambda;
+  //! The L1 regularization.
+  double alpha;
+  //! The minimum gain of a split.
+  double gamma;
+  //! The shrinkage of the leaf values.
+  double learningRate;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_tree_impl.hpp"
+
+#endif
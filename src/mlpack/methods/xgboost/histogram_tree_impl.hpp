@@ -0,0 +1,234 @@
+/**
+ * @file methods/xgboost/histogram_tree_impl.hpp
+ *
+ * Implementation of HistogramTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_HISTOGRAM_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "histogram_tree.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+inline void HistogramTree::Train(const arma::Mat<unsigned char>& bins,
+                                 const QuantileBinning& binning,
+                                 const arma::vec& gradients,
+                                 const arma::vec& hessians,
+                                 std::vector<size_t>& rows,
+                                 const std::vector<size_t>& dimensions,
+                                 const size_t maxDepth,
+                                 const double minChildWeight,
+                                 const double lambda,
+                                 const double alpha,
+                                 const double gamma,
+                                 const double learningRate)
+{
+  splitDimensions.clear();
+  splitValues.clear();
+  splitBins.clear();
+  children.clear();
+  values.clear();
+
+  this->bins = &bins;
+  this->binning = &binning;
+  this->gradients = &gradients;
+  this->hessians = &hessians;
+  this->rows = &rows;
+  this->dimensions = &dimensions;
+  this->maxDepth = maxDepth;
+  this->minChildWeight = minChildWeight;
+  this->lambda = lambda;
+  this->alpha = alpha;
+  this->gamma = gamma;
+  this->learningRate = learningRate;
+
+  // Create the root.
+  splitDimensions.push_back(0);
+  splitValues.push_back(0.0);
+  splitBins.push_back(0);
+  children.push_back(0);
+  values.push_back(0.0);
+
+  Histogram histogram;
+  BuildHistogram(0, rows.size(), histogram);
+  Grow(0, 0, rows.size(), 0, histogram);
+
+  this->bins = NULL;
+  this->binning = NULL;
+  this->gradients = NULL;
+  this->hessians = NULL;
+  this->rows = NULL;
+  this->dimensions = NULL;
+}
+
+inline void HistogramTree::Grow(const size_t node,
+                                const size_t begin,
+                                const size_t end,
+                                const size_t depth,
+                                Histogram& histogram)
+{
+  double sumGradients = 0.0, sumHessians = 0.0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    sumGradients += (*gradients)[(*rows)[i]];
+    sumHessians += (*hessians)[(*rows)[i]];
+  }
+
+  if (sumHessians + lambda > 0.0)
+  {
+    values[node] = -learningRate * ThresholdL1(sumGradients) /
+        (sumHessians + lambda);
+  }
+
+  const size_t numDimensions = dimensions->size();
+  if ((maxDepth != 0 && depth >= maxDepth) || end - begin < 2 ||
+      numDimensions == 0)
+    return;
+
+  // Find the best split of each dimension in parallel.
+  std::vector<double> bestScores(numDimensions, -DBL_MAX);
+  std::vector<size_t> bestBins(numDimensions, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t j = 0; j < numDimensions; ++j)
+  {
+    const size_t numBins = binning->NumBins((*dimensions)[j]);
+    const double* binSums = histogram.colptr(j);
+    double leftGradients = 0.0, leftHessians = 0.0, leftCount = 0.0;
+    for (size_t b = 0; b + 1 < numBins; ++b)
+    {
+      leftGradients += binSums[3 * b];
+      leftHessians += binSums[3 * b + 1];
+      leftCount += binSums[3 * b + 2];
+
+      const double rightHessians = sumHessians - leftHessians;
+      const double rightCount = (end - begin) - leftCount;
+      if (leftCount == 0.0 || leftHessians < minChildWeight)
+        continue;
+      if (rightCount == 0.0 || rightHessians < minChildWeight)
+        break;
+
+      const double score = Score(leftGradients, leftHessians) +
+          Score(sumGradients - leftGradients, rightHessians);
+      if (score > bestScores[j])
+      {
+        bestScores[j] = score;
+        bestBins[j] = b;
+      }
+    }
+  }
+
+  // Take the best dimension; ties go to the first one, so that the result
+  // does not depend on the number of threads.
+  size_t bestDimension = numDimensions;
+  double bestScore = -DBL_MAX;
+  for (size_t j = 0; j < numDimensions; ++j)
+  {
+    if (bestScores[j] > bestScore)
+    {
+      bestScore = bestScores[j];
+      bestDimension = j;
+    }
+  }
+
+  if (bestDimension == numDimensions)
+    return;
+
+  const double gain = 0.5 * (bestScore - Score(sumGradients, sumHessians)) -
+      gamma;
+  if (gain <= 0.0)
+    return;
+
+  // Split the node and sort its points into the two children.
+  const size_t dimension = (*dimensions)[bestDimension];
+  const size_t bin = bestBins[bestDimension];
+  const unsigned char* dimensionBins = bins->colptr(dimension);
+  const size_t middle = std::stable_partition(rows->begin() + begin,
+      rows->begin() + end, [&](const size_t row)
+      {
+        return dimensionBins[row] <= bin;
+      }) - rows->begin();
+
+  const size_t left = values.size();
+  splitDimensions[node] = dimension;
+  splitValues[node] = binning->Cut(dimension, bin);
+  splitBins[node] = bin;
+  children[node] = left;
+  values[node] = 0.0;
+
+  splitDimensions.resize(left + 2, 0);
+  splitValues.resize(left + 2, 0.0);
+  splitBins.resize(left + 2, 0);
+  children.resize(left + 2, 0);
+  values.resize(left + 2, 0.0);
+
+  // Build the histogram of the smaller child, and get the other one by
+  // subtraction from the histogram of this node.
+  Histogram childHistogram;
+  if (middle - begin <= end - middle)
+  {
+    BuildHistogram(begin, middle, childHistogram);
+    histogram -= childHistogram;
+    Grow(left, begin, middle, depth + 1, childHistogram);
+    Grow(left + 1, middle, end, depth + 1, histogram);
+  }
+  else
+  {
+    BuildHistogram(middle, end, childHistogram);
+    histogram -= childHistogram;
+    Grow(left, begin, middle, depth + 1, histogram);
+    Grow(left + 1, middle, end, depth + 1, childHistogram);
+  }
+}
+
+inline void HistogramTree::BuildHistogram(const size_t begin,
+                                          const size_t end,
+                                          Histogram& histogram) const
+{
+  const size_t numDimensions = dimensions->size();
+  histogram.zeros(3 * binning->MaxBins(), numDimensions);
+
+  const size_t* nodeRows = rows->data();
+  const double* g = gradients->memptr();
+  const double* h = hessians->memptr();
+
+  // Each thread fills the histograms of its own dimensions; small nodes are
+  // not worth starting threads for.
+  #pragma omp parallel for schedule(static) \
+      if ((end - begin) * numDimensions >= 16384)
+  for (size_t j = 0; j < numDimensions; ++j)
+  {
+    const unsigned char* dimensionBins = bins->colptr((*dimensions)[j]);
+    double* binSums = histogram.colptr(j);
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t row = nodeRows[i];
+      double* sums = binSums + 3 * dimensionBins[row];
+      sums[0] += g[row];
+      sums[1] += h[row];
+      sums[2] += 1.0;
+    }
+  }
+}
+
+template<typename Archive>
+void HistogramTree::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(splitDimensions));
+  ar(CEREAL_NVP(splitValues));
+  ar(CEREAL_NVP(splitBins));
+  ar(CEREAL_NVP(children));
+  ar(CEREAL_NVP(values));
+}
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
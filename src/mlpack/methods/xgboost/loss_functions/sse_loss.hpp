@@ -93,6 +93,44 @@ class SSELoss
     return std::pow(ApplyL1(arma::accu(gradients)), 2) /
         (arma::accu(hessians) + lambda);
   }
+
+  /**
+   * Compute the first and second order gradients of the loss of each point
+   * with respect to its current prediction.  For the squared error these are
+   * the residuals and ones.
+   *
+   * @param observed The observed responses.
+   * @param predictions The predictions at the current step of boosting.
+   * @param gradients First order gradients of each point (output).
+   * @param hessians Second order gradients of each point (output).
+   */
+  template<typename VecType>
+  void Gradients(const VecType& observed,
+                 const VecType& predictions,
+                 arma::vec& gradients,
+                 arma::vec& hessians) const
+  {
+    gradients = arma::conv_to<arma::vec>::from(predictions - observed);
+    hessians.ones(observed.n_elem);
+  }
+
+  /**
+   * Compute the mean loss of the given predictions, 1 / 2 times the mean
+   * squared error.
+   *
+   * @param observed The observed responses.
+   * @param predictions The predicted responses.
+   */
+  template<typename VecType>
+  double Loss(const VecType& observed, const VecType& predictions) const
+  {
+    if (observed.n_elem == 0)
+      return 0.0;
+
+    return 0.5 * arma::accu(arma::square(predictions - observed)) /
+        (double) observed.n_elem;
+  }
+
  private:
   //! The L1 regularization parameter.
   const double alpha;
@@ -0,0 +1,161 @@
+/**
+ * @file methods/xgboost/quantile_binning.hpp
+ *
+ * Discretization of each dimension of a dataset into a small number of bins
+ * at its quantiles, for histogram-based split finding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_QUANTILE_BINNING_HPP
+#define MLPACK_METHODS_XGBOOST_QUANTILE_BINNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * QuantileBinning finds, for each dimension of a dataset, at most MaxBins() - 1
+ * cut points at the quantiles of the values of that dimension, and maps each
+ * value to the index of its bin.  Bin b holds the values x with
+ *
+ *   cut(b - 1) < x <= cut(b),
+ *
+ * so that a split "x <= cut(b)" on the original values is the same as the split
+ * "bin <= b" on the bins.  Each cut is halfway between two consecutive distinct
+ * values of the dimension; if a dimension has at most MaxBins() distinct
+ * values, each of them gets its own bin.
+ *
+ * Bins are stored as unsigned chars, so there can be at most 256 of them.  The
+ * binned dataset is transposed (one row per point) so that the bins of one
+ * dimension are contiguous.
+ */
+class QuantileBinning
+{
+ public:
+  /**
+   * Create the object with the given maximum number of bins per dimension.
+   *
+   * @param maxBins Maximum number of bins of each dimension (2 to 256).
+   */
+  QuantileBinning(const size_t maxBins = 256) : maxBins(maxBins)
+  {
+    if (maxBins < 2 || maxBins > 256)
+    {
+      std::ostringstream oss;
+      oss << "QuantileBinning::QuantileBinning(): maxBins must be between 2 "
+          << "and 256 (" << maxBins << " given)!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  /**
+   * Compute the cut points of each dimension of the given dataset.  The
+   * dimensions are processed in parallel.
+   *
+   * @param data Dataset (one column per point).
+   */
+  template<typename MatType>
+  void Fit(const MatType& data)
+  {
+    cuts.clear();
+    cuts.resize(data.n_rows);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t d = 0; d < (size_t) data.n_rows; ++d)
+    {
+      const arma::vec values = arma::sort(
+          arma::conv_to<arma::vec>::from(data.row(d).t()));
+      const arma::vec uniqueValues = arma::unique(values);
+
+      std::vector<double> dimensionCuts;
+      if (uniqueValues.n_elem <= maxBins)
+      {
+        for (size_t i = 1; i < uniqueValues.n_elem; ++i)
+        {
+          dimensionCuts.push_back((uniqueValues[i - 1] + uniqueValues[i]) /
+              2.0);
+        }
+      }
+      else
+      {
+        // Cut just above each quantile, halfway to the next distinct value.
+        for (size_t j = 1; j < maxBins; ++j)
+        {
+          const double value = values[j * values.n_elem / maxBins - 1];
+          const double* next = std::upper_bound(values.begin(), values.end(),
+              value);
+          if (next == values.end())
+            break;
+
+          const double cut = (value + *next) / 2.0;
+          if (dimensionCuts.empty() || cut > dimensionCuts.back())
+            dimensionCuts.push_back(cut);
+        }
+      }
+
+      cuts[d] = arma::vec(dimensionCuts);
+    }
+  }
+
+  /**
+   * Map each value of the given dataset to its bin.  Fit() must have been
+   * called on data of the same dimensionality.
+   *
+   * @param data Dataset (one column per point).
+   * @param bins Bins of each point (one row per point) (output).
+   */
+  template<typename MatType>
+  void Transform(const MatType& data, arma::Mat<unsigned char>& bins) const
+  {
+    util::CheckSameDimensionality(data, cuts.size(),
+        "QuantileBinning::Transform()");
+
+    bins.set_size(data.n_cols, data.n_rows);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t d = 0; d < (size_t) data.n_rows; ++d)
+    {
+      const arma::vec& dimensionCuts = cuts[d];
+      unsigned char* dimensionBins = bins.colptr(d);
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        dimensionBins[i] = (unsigned char) (std::lower_bound(
+            dimensionCuts.begin(), dimensionCuts.end(), (double) data(d, i)) -
+            dimensionCuts.begin());
+      }
+    }
+  }
+
+  //! Get the number of bins of the given dimension.
+  size_t NumBins(const size_t dimension) const
+  {
+    return cuts[dimension].n_elem + 1;
+  }
+
+  //! Get the upper bound of the given bin of the given dimension.
+  double Cut(const size_t dimension, const size_t bin) const
+  {
+    return cuts[dimension][bin];
+  }
+
+  //! Get the dimensionality of the data the cuts were computed on.
+  size_t Dimensionality() const { return cuts.size(); }
+
+  //! Get the maximum number of bins of each dimension.
+  size_t MaxBins() const { return maxBins; }
+
+ private:
+  //! The maximum number of bins of each dimension.
+  size_t maxBins;
+  //! The cut points of each dimension, in increasing order.
+  std::vector<arma::vec> cuts;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ *
+ * Gradient boosted regression trees, in the style of XGBoost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "loss_functions/sse_loss.hpp"
+#include "quantile_binning.hpp"
+#include "histogram_tree.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+/**
+ * XGBoost is a gradient boosting ensemble of regression trees.  Each boosting
+ * round computes the gradients and Hessians of the loss at the current
+ * predictions and grows a HistogramTree that minimizes the second order
+ * approximation of the loss, as described in the following paper:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD '16)},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The training set is binned once at its quantiles (see QuantileBinning), and
+ * the splits of all trees are found on histograms of the bins, in parallel
+ * over the dimensions.  The leaf values are shrunk by the learning rate, and
+ * each tree may be grown on a random subset of the points (Subsample()) and of
+ * the dimensions (ColumnSubsample()).
+ *
+ * If a validation set is given to Train(), its loss is computed after each
+ * round, and if EarlyStoppingRounds() is not 0, training stops when the
+ * validation loss has not improved for that many rounds; the trees added
+ * after the best round are then removed.
+ *
+ * @code
+ * // At most 100 rounds, with a learning rate of 0.1.
+ * XGBoost<> model(100, 0.1);
+ * model.Train(data, responses, validationData, validationResponses);
+ * arma::rowvec predictions;
+ * model.Predict(testData, predictions);
+ * @endcode
+ *
+ * @tparam LossFunctionType Loss to minimize; it must provide
+ *     InitialPrediction(), Gradients() and Loss(), like SSELoss.
+ */
+template<typename LossFunctionType = SSELoss>
+class XGBoost
+{
+ public:
+  /**
+   * Create the model with the given parameters, without training it.
+   *
+   * @param numRounds Maximum number of boosting rounds (trees).
+   * @param learningRate Shrinkage of the value of each tree.
+   * @param maxDepth Maximum depth of each tree (0 means no limit).
+   * @param lossFunction Instantiated loss function.
+   */
+  XGBoost(const size_t numRounds = 100,
+          const double learningRate = 0.3,
+          const size_t maxDepth = 6,
+          const LossFunctionType& lossFunction = LossFunctionType());
+
+  /**
+   * Create the model with the given parameters, and train it on the given
+   * data and responses.  The other parameters have their default values.
+   *
+   * @param data Training dataset.
+   * @param responses Responses of the training points.
+   * @param numRounds Maximum number of boosting rounds (trees).
+   * @param learningRate Shrinkage of the value of each tree.
+   * @param maxDepth Maximum depth of each tree (0 means no limit).
+   * @param lossFunction Instantiated loss function.
+   */
+  template<typename MatType>
+  XGBoost(const MatType& data,
+          const arma::rowvec& responses,
+          const size_t numRounds = 100,
+          const double learningRate = 0.3,
+          const size_t maxDepth = 6,
+          const LossFunctionType& lossFunction = LossFunctionType());
+
+  /**
+   * Train the model on the given data and responses, replacing any trees it
+   * already has.
+   *
+   * @param data Training dataset.
+   * @param responses Responses of the training points.
+   * @return The loss of the trained model on the training set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data, const arma::rowvec& responses);
+
+  /**
+   * Train the model on the given data and responses, replacing any trees it
+   * already has, and compute the loss on the given validation set after each
+   * round for early stopping.
+   *
+   * @param data Training dataset.
+   * @param responses Responses of the training points.
+   * @param validationData Validation dataset.
+   * @param validationResponses Responses of the validation points.
+   * @return The loss of the trained model on the validation set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::rowvec& responses,
+               const MatType& validationData,
+               const arma::rowvec& validationResponses);
+
+  /**
+   * Predict the response of the given point.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of the given points, in parallel.
+   *
+   * @param data Points to predict.
+   * @param predictions Predicted responses (output).
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Get the maximum number of boosting rounds.
+  size_t NumRounds() const { return numRounds; }
+  //! Modify the maximum number of boosting rounds.
+  size_t& NumRounds() { return numRounds; }
+
+  //! Get the learning rate.
+  double LearningRate() const { return learningRate; }
+  //! Modify the learning rate.
+  double& LearningRate() { return learningRate; }
+
+  //! Get the maximum depth of the trees.
+  size_t MaxDepth() const { return maxDepth; }
+  //! Modify the maximum depth of the trees (0 means no limit).
+  size_t& MaxDepth() { return maxDepth; }
+
+  //! Get the minimum sum of Hessians of the children of a split.
+  double MinChildWeight() const { return minChildWeight; }
+  //! Modify the minimum sum of Hessians of the children of a split.
+  double& MinChildWeight() { return minChildWeight; }
+
+  //! Get the L2 regularization of the leaf values.
+  double Lambda() const { return lambda; }
+  //! Modify the L2 regularization of the leaf values.
+  double& Lambda() { return lambda; }
+
+  //! Get the L1 regularization of the leaf values.
+  double Alpha() const { return alpha; }
+  //! Modify the L1 regularization of the leaf values.
+  double& Alpha() { return alpha; }
+
+  //! Get the minimum gain of a split.
+  double Gamma() const { return gamma; }
+  //! Modify the minimum gain of a split.
+  double& Gamma() { return gamma; }
+
+  //! Get the fraction of the points each tree is grown on.
+  double Subsample() const { return subsample; }
+  //! Modify the fraction of the points each tree is grown on.
+  double& Subsample() { return subsample; }
+
+  //! Get the fraction of the dimensions each tree may split on.
+  double ColumnSubsample() const { return columnSubsample; }
+  //! Modify the fraction of the dimensions each tree may split on.
+  double& ColumnSubsample() { return columnSubsample; }
+
+  //! Get the maximum number of histogram bins of each dimension.
+  size_t MaxBins() const { return maxBins; }
+  //! Modify the maximum number of histogram bins of each dimension (2 to
+  //! 256).
+  size_t& MaxBins() { return maxBins; }
+
+  //! Get the number of rounds without improvement before stopping.
+  size_t EarlyStoppingRounds() const { return earlyStoppingRounds; }
+  //! Modify the number of rounds without improvement of the validation loss
+  //! before stopping (0 means no early stopping).
+  size_t& EarlyStoppingRounds() { return earlyStoppingRounds; }
+
+  //! Get the number of trees of the trained model.
+  size_t NumTrees() const { return trees.size(); }
+  //! Get the given tree.
+  const HistogramTree& Tree(const size_t i) const { return trees[i]; }
+
+  //! Get the prediction before any tree is added.
+  double InitialPrediction() const { return initialPrediction; }
+
+  //! Get the dimensionality of the model.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Train the model, with or without a validation set.
+   */
+  template<bool UseValidation, typename MatType>
+  double TrainInternal(const MatType& data,
+                       const arma::rowvec& responses,
+                       const MatType* validationData,
+                       const arma::rowvec* validationResponses);
+
+  //! The maximum number of boosting rounds.
+  size_t numRounds;
+  //! The shrinkage of each tree.
+  double learningRate;
+  //! The maximum depth of each tree.
+  size_t maxDepth;
+  //! The minimum sum of Hessians of each child of a split.
+  double minChildWeight;
+  //! The L2 regularization of the leaf values.
+  double lambda;
+  //! The L1 regularization of the leaf values.
+  double alpha;
+  //! The minimum gain of a split.
+  double gamma;
+  //! The fraction of points each tree is grown on.
+  double subsample;
+  //! The fraction of dimensions each tree may split on.
+  double columnSubsample;
+  //! The maximum number of bins of each dimension.
+  size_t maxBins;
+  //! The number of rounds without improvement before stopping.
+  size_t earlyStoppingRounds;
+
+  //! The dimensionality of the model.
+  size_t dimensionality;
+  //! The prediction before any tree is added.
+  double initialPrediction;
+  //! The trees of the ensemble.
+  std::vector<HistogramTree> trees;
+
+  //! The loss function.
+  LossFunctionType lossFunction;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_impl.hpp"
+
+#endif
@@ -0,0 +1,277 @@
+/**
+ * @file methods/xgboost/xgboost_impl.hpp
+ *
+ * Implementation of XGBoost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+template<typename LossFunctionType>
+XGBoost<LossFunctionType>::XGBoost(const size_t numRounds,
+                                   const double learningRate,
+                                   const size_t maxDepth,
+                                   const LossFunctionType& lossFunction) :
+    numRounds(numRounds),
+    learningRate(learningRate),
+    maxDepth(maxDepth),
+    minChildWeight(1.0),
+    lambda(1.0),
+    alpha(0.0),
+    gamma(0.0),
+    subsample(1.0),
+    columnSubsample(1.0),
+    maxBins(256),
+    earlyStoppingRounds(0),
+    dimensionality(0),
+    initialPrediction(0.0),
+    lossFunction(lossFunction)
+{
+  // Nothing to do.
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+XGBoost<LossFunctionType>::XGBoost(const MatType& data,
+                                   const arma::rowvec& responses,
+                                   const size_t numRounds,
+                                   const double learningRate,
+                                   const size_t maxDepth,
+                                   const LossFunctionType& lossFunction) :
+    XGBoost(numRounds, learningRate, maxDepth, lossFunction)
+{
+  Train(data, responses);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+double XGBoost<LossFunctionType>::Train(const MatType& data,
+                                        const arma::rowvec& responses)
+{
+  return TrainInternal<false>(data, responses, (const MatType*) NULL,
+      (const arma::rowvec*) NULL);
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+double XGBoost<LossFunctionType>::Train(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const MatType& validationData,
+    const arma::rowvec& validationResponses)
+{
+  return TrainInternal<true>(data, responses, &validationData,
+      &validationResponses);
+}
+
+template<typename LossFunctionType>
+template<bool UseValidation, typename MatType>
+double XGBoost<LossFunctionType>::TrainInternal(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const MatType* validationData,
+    const arma::rowvec* validationResponses)
+{
+  util::CheckSameSizes(data, responses, "XGBoost::Train()", "responses");
+  if (UseValidation)
+  {
+    util::CheckSameSizes(*validationData, *validationResponses,
+        "XGBoost::Train()", "validation responses");
+    util::CheckSameDimensionality(*validationData, (size_t) data.n_rows,
+        "XGBoost::Train()", "validation dataset");
+  }
+
+  if (data.n_cols == 0)
+    throw std::invalid_argument("XGBoost::Train(): dataset is empty!");
+
+  if (learningRate <= 0.0)
+  {
+    std::ostringstream oss;
+    oss << "XGBoost::Train(): learning rate must be positive (" << learningRate
+        << " given)!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (subsample <= 0.0 || subsample > 1.0 || columnSubsample <= 0.0 ||
+      columnSubsample > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "XGBoost::Train(): subsample and column subsample must be in "
+        << "(0, 1] (" << subsample << " and " << columnSubsample
+        << " given)!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Bin the training set once for all the trees.
+  QuantileBinning binning(maxBins);
+  binning.Fit(data);
+  arma::Mat<unsigned char> bins;
+  binning.Transform(data, bins);
+
+  dimensionality = data.n_rows;
+  initialPrediction = lossFunction.InitialPrediction(responses);
+  trees.clear();
+
+  arma::rowvec predictions(data.n_cols);
+  predictions.fill(initialPrediction);
+  arma::rowvec validationPredictions;
+  double validationLoss = 0.0;
+  if (UseValidation)
+  {
+    validationPredictions.set_size(validationData->n_cols);
+    validationPredictions.fill(initialPrediction);
+    validationLoss = lossFunction.Loss(*validationResponses,
+        validationPredictions);
+  }
+
+  const size_t numPoints = data.n_cols;
+  const size_t numRows = std::max((size_t) 1,
+      (size_t) std::round(subsample * numPoints));
+  const size_t numDimensions = std::max((size_t) 1,
+      (size_t) std::round(columnSubsample * dimensionality));
+
+  arma::vec gradients, hessians;
+  std::vector<size_t> rows(numRows);
+  std::vector<size_t> dimensions(numDimensions);
+
+  double bestValidationLoss = validationLoss;
+  size_t bestNumTrees = 0;
+  for (size_t round = 0; round < numRounds; ++round)
+  {
+    lossFunction.Gradients(responses, predictions, gradients, hessians);
+
+    // Choose the points and the dimensions of this tree.
+    if (numRows < numPoints)
+    {
+      const arma::uvec sample = arma::sort(arma::randperm(numPoints, numRows));
+      std::copy(sample.begin(), sample.end(), rows.begin());
+    }
+    else
+    {
+      for (size_t i = 0; i < numRows; ++i)
+        rows[i] = i;
+    }
+
+    if (numDimensions < dimensionality)
+    {
+      const arma::uvec sample = arma::sort(arma::randperm(dimensionality,
+          numDimensions));
+      std::copy(sample.begin(), sample.end(), dimensions.begin());
+    }
+    else
+    {
+      for (size_t d = 0; d < numDimensions; ++d)
+        dimensions[d] = d;
+    }
+
+    trees.push_back(HistogramTree());
+    HistogramTree& tree = trees.back();
+    tree.Train(bins, binning, gradients, hessians, rows, dimensions, maxDepth,
+        minChildWeight, lambda, alpha, gamma, learningRate);
+
+    // Every training point is updated, not only those the tree was grown on.
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < numPoints; ++i)
+      predictions[i] += tree.Predict(bins, i);
+
+    if (UseValidation)
+    {
+      #pragma omp parallel for schedule(static)
+      for (size_t i = 0; i < (size_t) validationData->n_cols; ++i)
+        validationPredictions[i] += tree.Predict(validationData->col(i));
+
+      validationLoss = lossFunction.Loss(*validationResponses,
+          validationPredictions);
+      Log::Debug << "XGBoost::Train(): round " << round + 1 << ", validation "
+          << "loss " << validationLoss << "." << std::endl;
+
+      if (validationLoss < bestValidationLoss)
+      {
+        bestValidationLoss = validationLoss;
+        bestNumTrees = trees.size();
+      }
+      else if (earlyStoppingRounds > 0 &&
+          trees.size() - bestNumTrees >= earlyStoppingRounds)
+      {
+        Log::Info << "XGBoost::Train(): validation loss has not improved for "
+            << earlyStoppingRounds << " rounds; stopping after round "
+            << bestNumTrees << "." << std::endl;
+        break;
+      }
+    }
+  }
+
+  if (UseValidation)
+  {
+    if (earlyStoppingRounds > 0 && bestNumTrees < trees.size())
+    {
+      trees.resize(bestNumTrees);
+      validationLoss = bestValidationLoss;
+    }
+
+    return validationLoss;
+  }
+
+  return lossFunction.Loss(responses, predictions);
+}
+
+template<typename LossFunctionType>
+template<typename VecType>
+double XGBoost<LossFunctionType>::Predict(const VecType& point) const
+{
+  double prediction = initialPrediction;
+  for (size_t t = 0; t < trees.size(); ++t)
+    prediction += trees[t].Predict(point);
+
+  return prediction;
+}
+
+template<typename LossFunctionType>
+template<typename MatType>
+void XGBoost<LossFunctionType>::Predict(const MatType& data,
+                                        arma::rowvec& predictions) const
+{
+  util::CheckSameDimensionality(data, dimensionality, "XGBoost::Predict()");
+
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+    predictions[i] = Predict(data.col(i));
+}
+
+template<typename LossFunctionType>
+template<typename Archive>
+void XGBoost<LossFunctionType>::serialize(Archive& ar,
+                                          const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numRounds));
+  ar(CEREAL_NVP(learningRate));
+  ar(CEREAL_NVP(maxDepth));
+  ar(CEREAL_NVP(minChildWeight));
+  ar(CEREAL_NVP(lambda));
+  ar(CEREAL_NVP(alpha));
+  ar(CEREAL_NVP(gamma));
+  ar(CEREAL_NVP(subsample));
+  ar(CEREAL_NVP(columnSubsample));
+  ar(CEREAL_NVP(maxBins));
+  ar(CEREAL_NVP(earlyStoppingRounds));
+  ar(CEREAL_NVP(dimensionality));
+  ar(CEREAL_NVP(initialPrediction));
+  ar(CEREAL_NVP(trees));
+}
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * @file methods/xgboost/xgboost_main.cpp
+ *
+ * A program to train gradient boosted regression trees and predict with them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME xgboost
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
+
+using namespace mlpack;
+using namespace mlpack::ensemble;
+using namespace mlpack::math;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_USER_NAME("Gradient Boosted Trees (XGBoost)");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of gradient boosted regression trees in the style of "
+    "XGBoost, with second order split gains, histogram-based split finding, "
+    "shrinkage, subsampling and early stopping.  Given a dataset and "
+    "responses, a model can be trained and saved for later use, or a "
+    "pre-trained model can be used to predict the responses of a test set.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program trains an ensemble of regression trees by gradient boosting"
+    ": each round grows a tree that minimizes a second order approximation of "
+    "the squared error of the current ensemble, with L2 and L1 regularization "
+    "of the leaf values (" + PRINT_PARAM_STRING("lambda") + " and " +
+    PRINT_PARAM_STRING("alpha") + ") and a minimum split gain (" +
+    PRINT_PARAM_STRING("gamma") + ").  The value of each tree is shrunk by " +
+    PRINT_PARAM_STRING("learning_rate") + ", and each tree can be grown on a "
+    "random fraction of the points (" + PRINT_PARAM_STRING("subsample") + ") "
+    "and of the dimensions (" + PRINT_PARAM_STRING("column_subsample") + ")."
+    "\n\n"
+    "Each dimension of the training set is discretized into at most " +
+    PRINT_PARAM_STRING("max_bins") + " bins at its quantiles, and splits are "
+    "found on histograms of the bins, in parallel over the dimensions."
+    "\n\n"
+    "If a validation set is given with " + PRINT_PARAM_STRING("validation") +
+    " and " + PRINT_PARAM_STRING("validation_responses") + ", its loss is "
+    "printed after training, and if " +
+    PRINT_PARAM_STRING("early_stopping_rounds") + " is not 0, training stops "
+    "when the validation loss has not improved for that many rounds; the model "
+    "then keeps the trees up to the best round."
+    "\n\n"
+    "A trained model can be saved with " + PRINT_PARAM_STRING("output_model") +
+    " and loaded with " + PRINT_PARAM_STRING("input_model") + ".  Predictions "
+    "for the points given with " + PRINT_PARAM_STRING("test") + " are saved "
+    "with " + PRINT_PARAM_STRING("predictions") + ".");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to train at most 500 trees with a learning rate of 0.1 on "
+    "the dataset " + PRINT_DATASET("X") + " with responses " +
+    PRINT_DATASET("y") + ", stopping when the loss on the validation set " +
+    PRINT_DATASET("X_val") + " (with responses " + PRINT_DATASET("y_val") +
+    ") has not improved for 20 rounds, and saving the model to " +
+    PRINT_MODEL("xgb_model") + ", the following command could be used:"
+    "\n\n" +
+    PRINT_CALL("xgboost", "training", "X", "training_responses", "y",
+        "validation", "X_val", "validation_responses", "y_val", "num_rounds",
+        500, "learning_rate", 0.1, "early_stopping_rounds", 20, "output_model",
+        "xgb_model") +
+    "\n\n"
+    "Then, to predict the responses of the test set " +
+    PRINT_DATASET("X_test") + " with that model, saving them to " +
+    PRINT_DATASET("y_test") + ", the following command could be used:"
+    "\n\n" +
+    PRINT_CALL("xgboost", "input_model", "xgb_model", "test", "X_test",
+        "predictions", "y_test"));
+
+// See also...
+BINDING_SEE_ALSO("@decision_tree", "#decision_tree");
+BINDING_SEE_ALSO("@random_forest", "#random_forest");
+BINDING_SEE_ALSO("Gradient boosting on Wikipedia",
+        "https://en.wikipedia.org/wiki/Gradient_boosting");
+BINDING_SEE_ALSO("XGBoost: A Scalable Tree Boosting System (pdf)",
+        "https://arxiv.org/pdf/1603.02754.pdf");
+BINDING_SEE_ALSO("mlpack::ensemble::XGBoost C++ class documentation",
+        "@doxygen/classmlpack_1_1ensemble_1_1XGBoost.html");
+
+PARAM_MATRIX_IN("training", "Training dataset.", "t");
+PARAM_ROW_IN("training_responses", "Responses of the training dataset.", "r");
+PARAM_MATRIX_IN("validation", "Validation dataset, for early stopping.", "");
+PARAM_ROW_IN("validation_responses", "Responses of the validation dataset.",
+    "");
+PARAM_MATRIX_IN("test", "Test dataset to produce predictions for.", "T");
+
+PARAM_MODEL_IN(XGBoost<>, "input_model", "Pre-trained model to use for "
+    "prediction.", "m");
+PARAM_MODEL_OUT(XGBoost<>, "output_model", "Model to save the trained model "
+    "to.", "M");
+PARAM_ROW_OUT("predictions", "Predicted responses of the test dataset.", "p");
+
+PARAM_INT_IN("num_rounds", "Maximum number of boosting rounds (trees).", "n",
+    100);
+PARAM_DOUBLE_IN("learning_rate", "Shrinkage of the value of each tree.", "l",
+    0.3);
+PARAM_INT_IN("max_depth", "Maximum depth of each tree (0 means no limit).",
+    "D", 6);
+PARAM_DOUBLE_IN("min_child_weight", "Minimum sum of the Hessians of each child "
+    "of a split.", "w", 1.0);
+PARAM_DOUBLE_IN("lambda", "L2 regularization of the leaf values.", "L", 1.0);
+PARAM_DOUBLE_IN("alpha", "L1 regularization of the leaf values.", "A", 0.0);
+PARAM_DOUBLE_IN("gamma", "Minimum gain of a split.", "g", 0.0);
+PARAM_DOUBLE_IN("subsample", "Fraction of the points each tree is grown on.",
+    "s", 1.0);
+PARAM_DOUBLE_IN("column_subsample", "Fraction of the dimensions each tree may "
+    "split on.", "c", 1.0);
+PARAM_INT_IN("max_bins", "Maximum number of histogram bins of each dimension "
+    "(2 to 256).", "b", 256);
+PARAM_INT_IN("early_stopping_rounds", "Number of rounds without improvement of "
+    "the validation loss before training stops (0 means no early stopping).",
+    "e", 0);
+
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "S", 0);
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  // Initialize random seed if needed.
+  if (params.Get<int>("seed") != 0)
+    RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    RandomSeed((size_t) std::time(NULL));
+
+  // Check for incompatible input parameters.
+  RequireOnlyOnePassed(params, { "training", "input_model" }, true);
+  RequireAtLeastOnePassed(params, { "test", "output_model" }, false,
+      "the trained model will not be used or saved");
+
+  if (params.Has("training"))
+  {
+    RequireAtLeastOnePassed(params, { "training_responses" }, true, "must pass "
+        "responses when training set given");
+  }
+  RequireNoneOrAllPassed(params, { "validation", "validation_responses" },
+      true);
+
+  ReportIgnoredParam(params, {{ "training", false }}, "validation");
+  ReportIgnoredParam(params, {{ "training", false }}, "early_stopping_rounds");
+  ReportIgnoredParam(params, {{ "validation", false }},
+      "early_stopping_rounds");
+  ReportIgnoredParam(params, {{ "test", false }}, "predictions");
+
+  RequireParamValue<int>(params, "num_rounds", [](int x) { return x > 0; },
+      true, "number of rounds must be positive");
+  RequireParamValue<double>(params, "learning_rate",
+      [](double x) { return x > 0.0; }, true, "learning rate must be positive");
+  RequireParamValue<int>(params, "max_depth", [](int x) { return x >= 0; },
+      true, "maximum depth must not be negative");
+  RequireParamValue<double>(params, "min_child_weight",
+      [](double x) { return x >= 0.0; }, true, "minimum child weight must not "
+      "be negative");
+  RequireParamValue<double>(params, "lambda", [](double x) { return x >= 0.0; },
+      true, "lambda must not be negative");
+  RequireParamValue<double>(params, "alpha", [](double x) { return x >= 0.0; },
+      true, "alpha must not be negative");
+  RequireParamValue<double>(params, "gamma", [](double x) { return x >= 0.0; },
+      true, "gamma must not be negative");
+  RequireParamValue<double>(params, "subsample",
+      [](double x) { return x > 0.0 && x <= 1.0; }, true, "subsample must be "
+      "in (0, 1]");
+  RequireParamValue<double>(params, "column_subsample",
+      [](double x) { return x > 0.0 && x <= 1.0; }, true, "column subsample "
+      "must be in (0, 1]");
+  RequireParamValue<int>(params, "max_bins",
+      [](int x) { return x >= 2 && x <= 256; }, true, "maximum number of bins "
+      "must be between 2 and 256");
+  RequireParamValue<int>(params, "early_stopping_rounds",
+      [](int x) { return x >= 0; }, true, "early stopping rounds must not be "
+      "negative");
+
+  XGBoost<>* model;
+  if (params.Has("training"))
+  {
+    arma::mat data = std::move(params.Get<arma::mat>("training"));
+    arma::rowvec responses =
+        std::move(params.Get<arma::rowvec>("training_responses"));
+    if (responses.n_elem != data.n_cols)
+    {
+      Log::Fatal << "The responses must have the same number of elements as "
+          << "there are points in the training set (" << responses.n_elem
+          << " vs. " << data.n_cols << ")!" << endl;
+    }
+
+    model = new XGBoost<>((size_t) params.Get<int>("num_rounds"),
+        params.Get<double>("learning_rate"),
+        (size_t) params.Get<int>("max_depth"));
+    model->MinChildWeight() = params.Get<double>("min_child_weight");
+    model->Lambda() = params.Get<double>("lambda");
+    model->Alpha() = params.Get<double>("alpha");
+    model->Gamma() = params.Get<double>("gamma");
+    model->Subsample() = params.Get<double>("subsample");
+    model->ColumnSubsample() = params.Get<double>("column_subsample");
+    model->MaxBins() = (size_t) params.Get<int>("max_bins");
+    model->EarlyStoppingRounds() =
+        (size_t) params.Get<int>("early_stopping_rounds");
+
+    timers.Start("xgboost_training");
+    if (params.Has("validation"))
+    {
+      arma::mat validationData =
+          std::move(params.Get<arma::mat>("validation"));
+      arma::rowvec validationResponses =
+          std::move(params.Get<arma::rowvec>("validation_responses"));
+      if (validationData.n_rows != data.n_rows ||
+          validationResponses.n_elem != validationData.n_cols)
+      {
+        delete model;
+        Log::Fatal << "The validation set must have the same dimensionality as"
+            << " the training set and one response per point!" << endl;
+      }
+
+      const double loss = model->Train(data, responses, validationData,
+          validationResponses);
+      Log::Info << "Validation loss: " << loss << "." << endl;
+    }
+    else
+    {
+      const double loss = model->Train(data, responses);
+      Log::Info << "Training loss: " << loss << "." << endl;
+    }
+    timers.Stop("xgboost_training");
+
+    Log::Info << "Trained " << model->NumTrees() << " trees." << endl;
+  }
+  else
+  {
+    model = params.Get<XGBoost<>*>("input_model");
+  }
+
+  if (params.Has("test"))
+  {
+    arma::mat testData = std::move(params.Get<arma::mat>("test"));
+    if (testData.n_rows != model->Dimensionality())
+    {
+      // If we built the model, nothing will free it so we have to...
+      const size_t dimensionality = model->Dimensionality();
+      if (params.Has("training"))
+        delete model;
+      Log::Fatal << "The model was trained on " << dimensionality
+          << "-dimensional data, but the test points are " << testData.n_rows
+          << "-dimensional!" << endl;
+    }
+
+    timers.Start("xgboost_prediction");
+    arma::rowvec predictions;
+    model->Predict(testData, predictions);
+    timers.Stop("xgboost_prediction");
+
+    params.Get<arma::rowvec>("predictions") = std::move(predictions);
+  }
+
+  params.Get<XGBoost<>*>("output_model") = model;
+}
@@ -789,6 +789,55 @@ TEST_CASE("TrainTest", "[AdaBoostTest]")
   REQUIRE(lError <= 0.30);
 }
 
+/**
+ * Make sure that classifying a set of points at once gives the weighted vote
+ * of the weak learners for each point.
+ */
+TEST_CASE("BatchClassifyMatchesVoteTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  const arma::Row<size_t> labelsvec = labels.row(0);
+
+  ID3DecisionStump ds(inputData, labelsvec, numClasses, 6);
+  AdaBoost<ID3DecisionStump> a(inputData, labelsvec, numClasses, ds, 50,
+      1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  arma::mat probabilities;
+  a.Classify(inputData, predictedLabels, probabilities);
+
+  for (size_t j = 0; j < inputData.n_cols; ++j)
+  {
+    arma::vec votes(numClasses, arma::fill::zeros);
+    for (size_t i = 0; i < a.WeakLearners(); ++i)
+      votes[a.WeakLearner(i).Classify(inputData.col(j))] += a.Alpha(i);
+    votes /= arma::accu(votes);
+
+    REQUIRE(predictedLabels[j] == votes.index_max());
+    for (size_t k = 0; k < numClasses; ++k)
+      REQUIRE(probabilities(k, j) == Approx(votes[k]).margin(1e-10));
+  }
+
+  // The perceptron classifies all points at once too.
+  Perceptron<> p(inputData, labelsvec, numClasses, 400);
+  arma::Row<size_t> perceptronLabels;
+  p.Classify(inputData, perceptronLabels);
+  for (size_t j = 0; j < inputData.n_cols; ++j)
+  {
+    const arma::vec scores = p.Weights().t() * inputData.col(j) + p.Biases();
+    REQUIRE(perceptronLabels[j] == scores.index_max());
+  }
+}
+
 TEST_CASE("PerceptronSerializationTest", "[AdaBoostTest]")
 {
   // Build an AdaBoost object.
@@ -139,9 +139,10 @@ void GetRecommendationsQueriedUser()
  */
 template<typename DecompositionPolicy,
          typename NormalizationType = NoNormalization>
-void RecommendationAccuracy(const size_t allowedFailures = 17)
+void RecommendationAccuracy(
+    const size_t allowedFailures = 17,
+    const DecompositionPolicy& decomposition = DecompositionPolicy())
 {
-  DecompositionPolicy decomposition;
 
   // Small GroupLens dataset.
   arma::mat dataset;
@@ -249,7 +250,8 @@ void CFPredict(const double rmseBound = 1.5)
 // Do the same thing as the previous test, but ensure that the ratings we
 // predict with the batch Predict() are the same as the individual Predict()
 // calls.
-template<typename DecompositionPolicy>
+template<typename DecompositionPolicy,
+         typename InterpolationPolicy = AverageInterpolation>
 void BatchPredict()
 {
   DecompositionPolicy decomposition;
@@ -273,11 +275,13 @@ void BatchPredict()
   }
 
   arma::vec predictions;
-  c.Predict(combinations, predictions);
+  c.template Predict<EuclideanSearch, InterpolationPolicy>(combinations,
+      predictions);
 
   for (size_t i = 0; i < combinations.n_cols; ++i)
   {
-    const double prediction = c.Predict(combinations(0, i), combinations(1, i));
+    const double prediction = c.template Predict<EuclideanSearch,
+        InterpolationPolicy>(combinations(0, i), combinations(1, i));
     REQUIRE(prediction == Approx(predictions[i]).epsilon(1e-10));
   }
 }
@@ -568,6 +572,15 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for weighted ALS method.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersALSTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -705,6 +718,25 @@ TEST_CASE("RecommendationAccuracyBiasSVDTest", "[CFTest]")
   RecommendationAccuracy<BiasSVDPolicy>(22);
 }
 
+/**
+ * Make sure recommendations are still reasonably accurate when regularized SVD
+ * is trained with parallel Hogwild! SGD.
+ */
+TEST_CASE("RecommendationAccuracyRegSVDHogwildTest", "[CFTest]")
+{
+  RecommendationAccuracy<RegSVDPolicy>(17, RegSVDPolicy(10, true));
+}
+
+/**
+ * Make sure recommendations are still reasonably accurate when bias SVD is
+ * trained with parallel Hogwild! SGD.
+ */
+TEST_CASE("RecommendationAccuracyBiasSVDHogwildTest", "[CFTest]")
+{
+  RecommendationAccuracy<BiasSVDPolicy>(22,
+      BiasSVDPolicy(10, 0.02, 0.05, true));
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate
  * for SVDPlusPlus method.
@@ -776,6 +808,15 @@ TEST_CASE("CFPredictSVDPPTest", "[CFTest]")
   CFPredict<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that Predict() is returning reasonable results for weighted ALS
+ * method.
+ */
+TEST_CASE("CFPredictALSTest", "[CFTest]")
+{
+  CFPredict<ALSPolicy>();
+}
+
 // Compare batch Predict() and individual Predict() for randomized SVD.
 TEST_CASE("CFBatchPredictRandSVDTest", "[CFTest]")
 {
@@ -828,6 +869,15 @@ TEST_CASE("CFBatchPredictSVDPPTest", "[CFTest]")
   BatchPredict<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure the batch Predict() (which computes interpolation weights in
+ * parallel) matches individual predictions with regression interpolation.
+ */
+TEST_CASE("CFBatchPredictRegressionInterpolationTest", "[CFTest]")
+{
+  BatchPredict<RegSVDPolicy, RegressionInterpolation>();
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay for
  * randomized SVD.
@@ -1216,3 +1266,397 @@ TEST_CASE("CFPredictRegressionInterpolation", "[CFTest]")
             EuclideanSearch,
             RegressionInterpolation>(2.2);
 }
+
+/**
+ * Make sure that the recommendations found with max-inner-product search are
+ * the same as the recommendations found by computing all ratings.
+ */
+template<typename DecompositionPolicy>
+void FastMKSRecommendations()
+{
+  DecompositionPolicy decomposition;
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy,
+      OverallMeanNormalization> c(dataset, decomposition, 5, 5, 30);
+
+  const size_t numRecs = 10;
+  arma::Mat<size_t> recommendations, fastmksRecommendations;
+  c.GetRecommendations(numRecs, recommendations);
+  c.GetFastMKSRecommendations(numRecs, fastmksRecommendations);
+
+  REQUIRE(fastmksRecommendations.n_rows == recommendations.n_rows);
+  REQUIRE(fastmksRecommendations.n_cols == recommendations.n_cols);
+
+  for (size_t i = 0; i < recommendations.n_cols; ++i)
+  {
+    for (size_t j = 0; j < numRecs; ++j)
+    {
+      // Only compare the predicted ratings, in case of ties.
+      const double rating = c.Predict(i, recommendations(j, i));
+      const double fastmksRating = c.Predict(i, fastmksRecommendations(j, i));
+      REQUIRE(fastmksRating == Approx(rating).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test max-inner-product recommendations for NMF.
+ */
+TEST_CASE("CFFastMKSRecommendationsNMFTest", "[CFTest]")
+{
+  FastMKSRecommendations<NMFPolicy>();
+}
+
+/**
+ * Test max-inner-product recommendations for regularized SVD.
+ */
+TEST_CASE("CFFastMKSRecommendationsRegSVDTest", "[CFTest]")
+{
+  FastMKSRecommendations<RegSVDPolicy>();
+}
+
+/**
+ * Test max-inner-product recommendations for Bias SVD, where the item bias is
+ * folded into the item factors.
+ */
+TEST_CASE("CFFastMKSRecommendationsBiasSVDTest", "[CFTest]")
+{
+  FastMKSRecommendations<BiasSVDPolicy>();
+}
+
+/**
+ * Test max-inner-product recommendations for SVD++.
+ */
+TEST_CASE("CFFastMKSRecommendationsSVDPPTest", "[CFTest]")
+{
+  FastMKSRecommendations<SVDPlusPlusPolicy>();
+}
+
+/**
+ * A decomposition policy that does not provide GetItemFactors() and
+ * GetUserFactors(), so that CFType has to fall back to GetRatingOfUser().
+ */
+class RatingsOnlyPolicy
+{
+ public:
+  template<typename MatType>
+  void Apply(const MatType& data,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    nmf.Apply(data, cleanedData, rank, maxIterations, minResidue, mit);
+  }
+
+  double GetRating(const size_t user, const size_t item) const
+  {
+    return nmf.GetRating(user, item);
+  }
+
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    nmf.GetRatingOfUser(user, rating);
+  }
+
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    nmf.template GetNeighborhood<NeighborSearchPolicy>(users,
+        numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(nmf));
+  }
+
+ private:
+  NMFPolicy nmf;
+};
+
+/**
+ * Make sure that recommendations for a decomposition policy without factors
+ * are computed from GetRatingOfUser(), and match the recommendations of the
+ * same model computed from the factors.
+ */
+TEST_CASE("CFRecommendationsWithoutFactorsTest", "[CFTest]")
+{
+  static_assert(HasFactors<NMFPolicy>::value,
+      "NMFPolicy should provide its factors");
+  static_assert(!HasFactors<RatingsOnlyPolicy>::value,
+      "RatingsOnlyPolicy should not provide its factors");
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  // Both models are trained from the same random initialization.
+  math::RandomSeed(42);
+  CFType<NMFPolicy, OverallMeanNormalization> c(dataset, NMFPolicy(), 5, 5,
+      30);
+  math::RandomSeed(42);
+  CFType<RatingsOnlyPolicy, OverallMeanNormalization> fallback(dataset,
+      RatingsOnlyPolicy(), 5, 5, 30);
+
+  const size_t numRecs = 10;
+  arma::Mat<size_t> recommendations, fallbackRecommendations,
+      fastmksRecommendations;
+  c.GetRecommendations(numRecs, recommendations);
+  fallback.GetRecommendations(numRecs, fallbackRecommendations);
+  fallback.GetFastMKSRecommendations(numRecs, fastmksRecommendations);
+
+  REQUIRE(fallbackRecommendations.n_rows == recommendations.n_rows);
+  REQUIRE(fallbackRecommendations.n_cols == recommendations.n_cols);
+  CheckMatrices(fastmksRecommendations, fallbackRecommendations);
+
+  for (size_t i = 0; i < recommendations.n_cols; ++i)
+  {
+    for (size_t j = 0; j < numRecs; ++j)
+    {
+      // Only compare the predicted ratings, in case of ties.
+      const double rating = c.Predict(i, recommendations(j, i));
+      const double fallbackRating = c.Predict(i,
+          fallbackRecommendations(j, i));
+      REQUIRE(fallbackRating == Approx(rating).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that folding ratings into a trained model adds new users and fits
+ * the new ratings reasonably well.
+ */
+template<typename DecompositionPolicy>
+void FoldIn()
+{
+  DecompositionPolicy decomposition;
+
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  // Hold out every rating of the last user, so that it is new to the model,
+  // and every tenth rating of the other users.
+  const size_t newUser = (size_t) arma::max(dataset.row(0));
+  std::vector<arma::uword> trainCols, foldInCols;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (dataset(0, i) == newUser || i % 10 == 0)
+      foldInCols.push_back(i);
+    else
+      trainCols.push_back(i);
+  }
+  const arma::mat trainData = dataset.cols(arma::uvec(trainCols));
+  const arma::mat foldInData = dataset.cols(arma::uvec(foldInCols));
+
+  CFType<DecompositionPolicy,
+      OverallMeanNormalization> c(trainData, decomposition, 5, 5, 30);
+  REQUIRE(c.CleanedData().n_cols <= newUser);
+
+  c.FoldIn(foldInData, 10, 0.01);
+  REQUIRE(c.CleanedData().n_cols == newUser + 1);
+  REQUIRE(c.CleanedData().n_nonzero == trainData.n_cols + foldInData.n_cols);
+
+  // The statistics of the normalization must cover all ratings.
+  REQUIRE(c.Normalization().Mean() ==
+      Approx(arma::mean(dataset.row(2))).epsilon(1e-7));
+
+  double totalError = 0.0;
+  for (size_t i = 0; i < foldInData.n_cols; ++i)
+  {
+    const double prediction = c.Predict(foldInData(0, i), foldInData(1, i));
+    totalError += std::pow(prediction - foldInData(2, i), 2.0);
+  }
+
+  const double rmse = std::sqrt(totalError / foldInData.n_cols);
+  REQUIRE(rmse < 1.5);
+
+  // Recommendations must be available for the new user.
+  arma::Mat<size_t> recommendations;
+  arma::Col<size_t> users = { newUser };
+  c.GetRecommendations(5, recommendations, users);
+  REQUIRE(recommendations.n_rows == 5);
+  REQUIRE(recommendations.n_cols == 1);
+}
+
+/**
+ * Make sure that the incremental update of the normalization statistics during
+ * fold-in keeps every stored rating consistent with the raw rating it came
+ * from, including a rating that is given again with a new value.  If
+ * checkUntouchedUsers is true, also make sure that the stored ratings of the
+ * users that the fold-in does not touch are left as they are.
+ */
+template<typename NormalizationType>
+void FoldInNormalization(const bool checkUntouchedUsers)
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  const size_t newUser = (size_t) arma::max(dataset.row(0));
+  std::vector<arma::uword> trainCols, foldInCols;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (dataset(0, i) == newUser || i % 10 == 0)
+      foldInCols.push_back(i);
+    else
+      trainCols.push_back(i);
+  }
+  const arma::mat trainData = dataset.cols(arma::uvec(trainCols));
+  arma::mat foldInData = dataset.cols(arma::uvec(foldInCols));
+
+  // Give a new value to a rating that is already in the model.
+  foldInData.insert_cols(foldInData.n_cols, trainData.col(0));
+  foldInData(2, foldInData.n_cols - 1) += 1.0;
+
+  CFType<RegSVDPolicy, NormalizationType> c(trainData, RegSVDPolicy(), 5, 5,
+      30);
+  const arma::sp_mat before = c.CleanedData();
+
+  c.FoldIn(foldInData, 2, 0.01);
+  const arma::sp_mat& after = c.CleanedData();
+
+  // The raw ratings after the fold-in.
+  arma::sp_mat raw(after.n_rows, after.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    raw((size_t) trainData(1, i), (size_t) trainData(0, i)) = trainData(2, i);
+  for (size_t i = 0; i < foldInData.n_cols; ++i)
+    raw((size_t) foldInData(1, i), (size_t) foldInData(0, i)) =
+        foldInData(2, i);
+
+  REQUIRE(after.n_nonzero == raw.n_nonzero);
+  for (arma::sp_mat::const_iterator it = after.begin(); it != after.end();
+       ++it)
+  {
+    REQUIRE(c.Normalization().Denormalize(it.col(), it.row(), *it) ==
+        Approx(raw(it.row(), it.col())).epsilon(1e-7));
+  }
+
+  if (checkUntouchedUsers)
+  {
+    for (size_t u = 0; u < before.n_cols; ++u)
+    {
+      if (arma::any(foldInData.row(0) == (double) u))
+        continue;
+
+      REQUIRE(arma::accu(arma::abs(after.col(u) - before.col(u))) == 0.0);
+    }
+  }
+}
+
+/**
+ * Test the incremental update of UserMeanNormalization.
+ */
+TEST_CASE("CFFoldInUserMeanNormalizationTest", "[CFTest]")
+{
+  FoldInNormalization<UserMeanNormalization>(true);
+}
+
+/**
+ * Test the incremental update of ItemMeanNormalization.
+ */
+TEST_CASE("CFFoldInItemMeanNormalizationTest", "[CFTest]")
+{
+  FoldInNormalization<ItemMeanNormalization>(false);
+}
+
+/**
+ * Test the incremental update of a CombinedNormalization.
+ */
+TEST_CASE("CFFoldInCombinedNormalizationTest", "[CFTest]")
+{
+  FoldInNormalization<CombinedNormalization<UserMeanNormalization,
+      ItemMeanNormalization>>(false);
+}
+
+/**
+ * Test fold-in for NMF.
+ */
+TEST_CASE("CFFoldInNMFTest", "[CFTest]")
+{
+  FoldIn<NMFPolicy>();
+}
+
+/**
+ * Test fold-in for regularized SVD.
+ */
+TEST_CASE("CFFoldInRegSVDTest", "[CFTest]")
+{
+  FoldIn<RegSVDPolicy>();
+}
+
+/**
+ * Test fold-in for Bias SVD.
+ */
+TEST_CASE("CFFoldInBiasSVDTest", "[CFTest]")
+{
+  FoldIn<BiasSVDPolicy>();
+}
+
+/**
+ * Test fold-in for SVD++.
+ */
+TEST_CASE("CFFoldInSVDPPTest", "[CFTest]")
+{
+  FoldIn<SVDPlusPlusPolicy>();
+}
+
+/**
+ * Make sure that folding a new user into an implicit feedback ALS model solves
+ * the same problems as an ALS sweep over the full data: the user is solved
+ * against the current item factors, and then the items it rated against the
+ * resulting user factors.  The fold-in uses the regularization of the policy
+ * by default.
+ */
+TEST_CASE("CFFoldInImplicitALSTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  // Hold out the last user, keeping only its ratings of items that are in the
+  // training set, so that the item factors do not grow.
+  const size_t newUser = (size_t) arma::max(dataset.row(0));
+  const arma::mat trainData = dataset.cols(arma::find(dataset.row(0) !=
+      (double) newUser));
+  const size_t numItems = (size_t) arma::max(trainData.row(1)) + 1;
+  const arma::mat foldInData = dataset.cols(arma::find(
+      dataset.row(0) == (double) newUser &&
+      dataset.row(1) < (double) numItems));
+  REQUIRE(foldInData.n_cols > 0);
+
+  const double lambda = 0.1;
+  const double alpha = 2.0;
+  ALSPolicy decomposition(lambda, alpha);
+  CFType<ALSPolicy, NoNormalization> c(trainData, decomposition, 5, 5, 10);
+  const arma::mat w = c.Decomposition().W();
+  REQUIRE(w.n_rows == numItems);
+
+  c.FoldIn(foldInData, 1);
+  const arma::sp_mat& cleanedData = c.CleanedData();
+  REQUIRE(cleanedData.n_cols == newUser + 1);
+
+  // Solve for every user with the item factors the model was trained with.
+  amf::WeightedALSUpdate update(lambda, alpha);
+  arma::mat hExpected;
+  update.HUpdate(cleanedData, w, hExpected);
+  CheckMatrices(c.Decomposition().H().col(newUser), hExpected.col(newUser));
+
+  // Solve for every item with the user factors after the fold-in.
+  update.Initialize(cleanedData, 5);
+  arma::mat wExpected(w);
+  update.WUpdate(cleanedData, wExpected, c.Decomposition().H());
+  const arma::uvec items = arma::conv_to<arma::uvec>::from(
+      arma::unique(foldInData.row(1)));
+  CheckMatrices(c.Decomposition().W().rows(items), wExpected.rows(items));
+}
@@ -305,3 +305,97 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * Check that searching the points in blocks of any size gives the same
+ * clustering.
+ */
+TEST_CASE("DBSCANBlockSizeTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 1000, arma::fill::randu);
+
+  DBSCAN<> d(0.08, 3);
+  d.BlockSize() = 0;
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  d.BlockSize() = 77;
+  arma::Row<size_t> blockAssignments;
+  REQUIRE(d.Cluster(points, blockAssignments) == clusters);
+  CheckMatrices(assignments, blockAssignments);
+
+  DBSCAN<> d3(0.08, 3, false, RangeSearch<>(false, true));
+  arma::Row<size_t> pointwiseAssignments;
+  REQUIRE(d3.Cluster(points, pointwiseAssignments) == clusters);
+  CheckMatrices(assignments, pointwiseAssignments);
+}
+
+/**
+ * Check that the default configuration (batch mode with dual-tree range search)
+ * gives the same clustering with several threads as with one thread.
+ */
+TEST_CASE("DBSCANParallelBatchTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 2000, arma::fill::randu);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  DBSCAN<> d(0.08, 3);
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(4);
+  #endif
+
+  arma::Row<size_t> parallelAssignments;
+  const size_t parallelClusters = d.Cluster(points, parallelAssignments);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(prevNumThreads);
+  #endif
+
+  REQUIRE(parallelClusters == clusters);
+  CheckMatrices(assignments, parallelAssignments);
+}
+
+/**
+ * Check that the grid-based algorithm gives the same clustering as range
+ * search, in a few dimensions.
+ */
+TEST_CASE("DBSCANGridModeTest", "[DBSCANTest]")
+{
+  for (size_t d = 1; d <= 4; ++d)
+  {
+    arma::mat points(d, 1500, arma::fill::randu);
+    // Make sure some coordinates are negative.
+    points -= 0.3;
+    const double epsilon = 0.02 * std::pow(2.0, (double) d);
+
+    DBSCAN<> rangeDBSCAN(epsilon, 4);
+    arma::Row<size_t> assignments;
+    const size_t clusters = rangeDBSCAN.Cluster(points, assignments);
+
+    DBSCAN<> gridDBSCAN(epsilon, 4);
+    gridDBSCAN.GridMode() = true;
+    arma::Row<size_t> gridAssignments;
+    REQUIRE(gridDBSCAN.Cluster(points, gridAssignments) == clusters);
+    CheckMatrices(assignments, gridAssignments);
+  }
+}
+
+/**
+ * Make sure that the grid-based algorithm refuses high-dimensional data.
+ */
+TEST_CASE("DBSCANGridModeDimensionalityTest", "[DBSCANTest]")
+{
+  arma::mat points(7, 100, arma::fill::randu);
+
+  DBSCAN<> d(0.5, 3);
+  d.GridMode() = true;
+  arma::Row<size_t> assignments;
+  REQUIRE_THROWS_AS(d.Cluster(points, assignments), std::invalid_argument);
+}
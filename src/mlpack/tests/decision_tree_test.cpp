@@ -1040,6 +1040,48 @@ TEST_CASE("CategoricalWeightedBuildTest", "[DecisionTreeTest]")
   REQUIRE(correctPct > 0.70);
 }
 
+/**
+ * Make sure that a weighted decision stump finds the same split when its
+ * dimensions are searched in parallel as when they are searched serially.
+ */
+TEST_CASE("DecisionStumpParallelSearchTest", "[DecisionTreeTest]")
+{
+  // Many dimensions are informative, so that the best one is not obvious.
+  arma::mat data(12, 3000, arma::fill::randu);
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    labels[i] = math::RandInt(3);
+    data.col(i) += 0.05 * labels[i] * arma::linspace<arma::vec>(0.5, 1.0, 12);
+  }
+  arma::rowvec weights(3000, arma::fill::randu);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  ID3DecisionStump stump(data, labels, 3, weights);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(4);
+  #endif
+
+  ID3DecisionStump parallelStump(data, labels, 3, weights);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(prevNumThreads);
+  #endif
+
+  REQUIRE(stump.NumChildren() == parallelStump.NumChildren());
+  REQUIRE(stump.SplitDimension() == parallelStump.SplitDimension());
+
+  arma::Row<size_t> predictions, parallelPredictions;
+  stump.Classify(data, predictions);
+  parallelStump.Classify(data, parallelPredictions);
+  REQUIRE(arma::all(predictions == parallelPredictions));
+}
+
 /**
  * Test that we can build a decision tree using weighted data (where the
  * low-weighted data is random noise) with information gain, and that the tree
@@ -1395,3 +1437,106 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Make sure that training on some of the points of a dataset gives the same
+ * tree as training on a copy of those points, and leaves the dataset as it was.
+ */
+TEST_CASE("DecisionTreeTrainOnPointsTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  const arma::mat originalDataset(dataset);
+  arma::rowvec weights(dataset.n_cols, arma::fill::randu);
+  arma::uvec points = arma::regspace<arma::uvec>(0, 2, dataset.n_cols - 1);
+
+  arma::mat subset = dataset.cols(points);
+  arma::Row<size_t> subsetLabels = labels.cols(points);
+  arma::rowvec subsetWeights = weights.cols(points);
+  DecisionTree<> d(subset, subsetLabels, 3, subsetWeights, 5);
+
+  DecisionTree<> pointsTree;
+  pointsTree.TrainOnPoints<true, false>(dataset,
+      data::DatasetInfo(dataset.n_rows), points, labels, 3, weights, 5);
+
+  CheckMatrices(dataset, originalDataset);
+  REQUIRE(pointsTree.NumChildren() == d.NumChildren());
+
+  arma::Row<size_t> predictions, pointsPredictions;
+  d.Classify(dataset, predictions);
+  pointsTree.Classify(dataset, pointsPredictions);
+  CheckMatrices(predictions, pointsPredictions);
+}
+
+/**
+ * Make sure that a compiled decision tree gives exactly the same predictions
+ * and probabilities as the tree it was compiled from, on a dataset with both
+ * numeric and categorical dimensions.
+ */
+TEST_CASE("CompiledDecisionTreeTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  DecisionTree<> tree(trainingData, di, trainingLabels, 5, 10);
+  CompiledDecisionTree<DecisionTree<>> compiledTree(tree);
+
+  REQUIRE(compiledTree.NumClasses() == tree.NumClasses());
+  REQUIRE(compiledTree.NumLeaves() <= compiledTree.NumNodes());
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  tree.Classify(testData, predictions, probabilities);
+  compiledTree.Classify(testData, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  arma::Row<size_t> compiledPredictionsOnly;
+  compiledTree.Classify(testData, compiledPredictionsOnly);
+  CheckMatrices(predictions, compiledPredictionsOnly);
+
+  // Check single points too.
+  for (size_t i = 0; i < 100; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    compiledTree.Classify(testData.col(i), prediction, pointProbabilities);
+    REQUIRE(prediction == predictions[i]);
+    REQUIRE(compiledTree.Classify(testData.col(i)) == predictions[i]);
+    CheckMatrices(pointProbabilities, probabilities.col(i));
+  }
+}
+
+/**
+ * A compiled tree with a single leaf should predict the majority class.
+ */
+TEST_CASE("CompiledDecisionTreeLeafTest", "[DecisionTreeTest]")
+{
+  arma::mat data(3, 100, arma::fill::randu);
+  arma::Row<size_t> labels(100, arma::fill::zeros);
+  labels.subvec(80, 99).fill(1);
+
+  // A minimum leaf size larger than the dataset gives a single leaf.
+  DecisionTree<> tree(data, labels, 2, 200);
+  REQUIRE(tree.NumChildren() == 0);
+
+  CompiledDecisionTree<DecisionTree<>> compiledTree(tree);
+  REQUIRE(compiledTree.NumNodes() == 1);
+
+  arma::Row<size_t> predictions;
+  compiledTree.Classify(data, predictions);
+  REQUIRE(predictions.n_elem == 100);
+  REQUIRE(arma::all(predictions == 0));
+}
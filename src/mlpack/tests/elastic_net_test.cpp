@@ -0,0 +1,220 @@
+/**
+ * @file tests/elastic_net_test.cpp
+ *
+ * Tests for the coordinate descent LASSO and Elastic Net solver.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/elastic_net.hpp>
+#include <mlpack/methods/lars.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::regression;
+
+/**
+ * Generate a random regression problem, where only the first nNonzero
+ * dimensions of the true coefficients are nonzero.
+ */
+void ElasticNetGenerateProblem(arma::mat& X,
+                               arma::rowvec& y,
+                               const size_t nPoints,
+                               const size_t nDims,
+                               const size_t nNonzero)
+{
+  X = arma::randn(nDims, nPoints);
+  arma::vec beta = arma::zeros(nDims);
+  beta.head(nNonzero) = arma::randn(nNonzero);
+  y = beta.t() * X + 0.1 * arma::randn<arma::rowvec>(nPoints);
+}
+
+/**
+ * Check the optimality conditions of the Elastic Net problem.
+ */
+void ElasticNetVerifyCorrectness(const arma::mat& X,
+                                 const arma::rowvec& y,
+                                 const arma::vec& beta,
+                                 const double lambda1,
+                                 const double lambda2)
+{
+  const arma::vec errCorr = X * (X.t() * beta - y.t()) + lambda2 * beta;
+  const double tol = 1e-5;
+  for (size_t j = 0; j < beta.n_elem; ++j)
+  {
+    if (beta(j) == 0)
+      REQUIRE(std::abs(errCorr(j)) <= lambda1 + tol);
+    else if (beta(j) < 0)
+      REQUIRE(errCorr(j) - lambda1 == Approx(0.0).margin(tol));
+    else
+      REQUIRE(errCorr(j) + lambda1 == Approx(0.0).margin(tol));
+  }
+}
+
+/**
+ * Make sure the LASSO and Elastic Net solutions satisfy the optimality
+ * conditions and match LARS, with and without a Gram matrix, and with cyclic
+ * and random orders.
+ */
+TEST_CASE("ElasticNetMatchesLARSTest", "[ElasticNetTest]")
+{
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    arma::mat X;
+    arma::rowvec y;
+    ElasticNetGenerateProblem(X, y, 100, 20, 5);
+
+    const double lambda1 = 0.1 * ElasticNet::LambdaMax(X, y);
+    const double lambda2 = (trial % 2 == 0) ? 0.0 : lambda1 / 2;
+
+    LARS lars(true, lambda1, lambda2);
+    arma::vec larsBeta;
+    lars.Train(X, y, larsBeta);
+
+    const arma::mat gram = X * X.t();
+    ElasticNet en(lambda1, lambda2);
+    ElasticNet enGram(gram, lambda1, lambda2);
+    en.Tolerance() = 1e-16;
+    enGram.Tolerance() = 1e-16;
+    en.Shuffle() = (trial >= 2);
+
+    arma::vec beta, gramBeta;
+    en.Train(X, y, beta);
+    enGram.Train(X, y, gramBeta);
+
+    ElasticNetVerifyCorrectness(X, y, beta, lambda1, lambda2);
+    ElasticNetVerifyCorrectness(X, y, gramBeta, lambda1, lambda2);
+    for (size_t j = 0; j < beta.n_elem; ++j)
+    {
+      REQUIRE(beta[j] == Approx(larsBeta[j]).margin(1e-5));
+      REQUIRE(gramBeta[j] == Approx(larsBeta[j]).margin(1e-5));
+    }
+  }
+}
+
+/**
+ * Make sure that row-major data gives the same solution, and that Predict()
+ * and ComputeError() agree with the solution.
+ */
+TEST_CASE("ElasticNetRowMajorTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  ElasticNetGenerateProblem(X, y, 100, 10, 3);
+  const arma::mat XT = X.t();
+
+  ElasticNet en(1.0, 0.5, 10000, 1e-16);
+  const double error = en.Train(X, y);
+  const arma::vec beta = en.Beta();
+
+  ElasticNet enRowMajor(1.0, 0.5, 10000, 1e-16);
+  const double rowMajorError = enRowMajor.Train(XT, y, false);
+
+  for (size_t j = 0; j < beta.n_elem; ++j)
+    REQUIRE(beta[j] == Approx(enRowMajor.Beta()[j]).margin(1e-6));
+  REQUIRE(rowMajorError == Approx(error).epsilon(1e-6));
+
+  arma::rowvec predictions, rowMajorPredictions;
+  en.Predict(X, predictions);
+  en.Predict(XT, rowMajorPredictions, true);
+  CheckMatrices(predictions, rowMajorPredictions);
+  REQUIRE(error == Approx(arma::accu(arma::square(y - predictions))));
+}
+
+/**
+ * Make sure that each solution of a regularization path is the solution for
+ * its value of lambda1, and that the solution at LambdaMax() is zero.
+ */
+TEST_CASE("ElasticNetPathTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  ElasticNetGenerateProblem(X, y, 200, 30, 10);
+
+  const double lambdaMax = ElasticNet::LambdaMax(X, y);
+  const arma::vec lambdas = lambdaMax * arma::logspace<arma::vec>(0, -3, 20);
+
+  ElasticNet en(0.0, 0.1);
+  en.Tolerance() = 1e-16;
+  arma::mat betas;
+  en.TrainPath(X, y, lambdas, betas);
+
+  REQUIRE(betas.n_rows == 30);
+  REQUIRE(betas.n_cols == 20);
+  REQUIRE(arma::accu(arma::abs(betas.col(0))) == 0.0);
+  CheckMatrices(betas.col(19), en.Beta());
+
+  for (size_t l = 0; l < lambdas.n_elem; ++l)
+    ElasticNetVerifyCorrectness(X, y, betas.col(l), lambdas[l], 0.1);
+
+  // More dimensions are nonzero as lambda1 decreases.
+  REQUIRE(arma::accu(betas.col(19) != 0) > arma::accu(betas.col(5) != 0));
+}
+
+/**
+ * Make sure that the solver handles many more dimensions than points, where
+ * the strong rule discards most dimensions.
+ */
+TEST_CASE("ElasticNetManyDimensionsTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  ElasticNetGenerateProblem(X, y, 100, 5000, 5);
+
+  const double lambda1 = 0.2 * ElasticNet::LambdaMax(X, y);
+  ElasticNet en(lambda1);
+  en.Tolerance() = 1e-16;
+  arma::vec beta;
+  en.Train(X, y, beta);
+
+  ElasticNetVerifyCorrectness(X, y, beta, lambda1, 0.0);
+  REQUIRE(arma::accu(beta != 0) < 100);
+
+  // Solving directly gives the same solution.
+  ElasticNet enDirect(lambda1, 0.0, 10000, 1e-16, 1);
+  arma::vec directBeta;
+  enDirect.Train(X, y, directBeta);
+  for (size_t j = 0; j < beta.n_elem; ++j)
+    REQUIRE(beta[j] == Approx(directBeta[j]).margin(1e-5));
+}
+
+/**
+ * Make sure that invalid sizes are rejected.
+ */
+TEST_CASE("ElasticNetInvalidSizesTest", "[ElasticNetTest]")
+{
+  arma::mat X(5, 20, arma::fill::randu);
+  arma::rowvec y(19, arma::fill::randu);
+
+  ElasticNet en(0.1);
+  REQUIRE_THROWS_AS(en.Train(X, y), std::invalid_argument);
+
+  y.randu(20);
+  const arma::mat gram(4, 4, arma::fill::eye);
+  ElasticNet enGram(gram, 0.1);
+  REQUIRE_THROWS_AS(enGram.Train(X, y), std::invalid_argument);
+}
+
+/**
+ * Make sure that a trained model can be serialized.
+ */
+TEST_CASE("ElasticNetSerializationTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  ElasticNetGenerateProblem(X, y, 100, 10, 3);
+
+  ElasticNet en(X, y, true, 1.0, 0.5);
+  ElasticNet xmlEn, jsonEn, binaryEn;
+  SerializeObjectAll(en, xmlEn, jsonEn, binaryEn);
+
+  REQUIRE(xmlEn.Lambda1() == Approx(1.0));
+  REQUIRE(jsonEn.Lambda2() == Approx(0.5));
+  CheckMatrices(en.Beta(), xmlEn.Beta(), jsonEn.Beta(), binaryEn.Beta());
+}
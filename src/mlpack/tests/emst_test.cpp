@@ -273,3 +273,40 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that the parallel Boruvka rounds give a spanning tree with the same
+ * length as the naive computation on a larger random dataset, with several
+ * types of trees.
+ */
+TEST_CASE("EMSTParallelRandomTest", "[EMSTTest]")
+{
+  arma::mat inputData = arma::randu<arma::mat>(4, 3000);
+
+  DualTreeBoruvka<> naive(inputData, true);
+  DualTreeBoruvka<> kd(inputData);
+  DualTreeBoruvka<EuclideanDistance, arma::mat, BallTree> ball(inputData);
+
+  arma::mat naiveResults, kdResults, ballResults;
+  naive.ComputeMST(naiveResults);
+  kd.ComputeMST(kdResults);
+  ball.ComputeMST(ballResults);
+
+  REQUIRE(kdResults.n_cols == inputData.n_cols - 1);
+  REQUIRE(ballResults.n_cols == inputData.n_cols - 1);
+
+  REQUIRE(arma::accu(kdResults.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+  REQUIRE(arma::accu(ballResults.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+
+  // The edges must connect every point.
+  UnionFind uf(inputData.n_cols);
+  for (size_t i = 0; i < kdResults.n_cols; ++i)
+  {
+    const size_t a = (size_t) kdResults(0, i);
+    const size_t b = (size_t) kdResults(1, i);
+    REQUIRE(uf.Find(a) != uf.Find(b));
+    uf.Union(a, b);
+  }
+}
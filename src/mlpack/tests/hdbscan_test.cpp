@@ -0,0 +1,186 @@
+/**
+ * @file tests/hdbscan_test.cpp
+ *
+ * Test the HDBSCAN implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+using namespace mlpack::emst;
+using namespace mlpack::neighbor;
+
+/**
+ * Make sure that the core distances are the distances to the minSamples-th
+ * nearest neighbor, counting the point itself.
+ */
+TEST_CASE("HDBSCANCoreDistancesTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 200, arma::fill::randu);
+
+  HDBSCAN<> h(5, 4);
+  arma::vec coreDistances;
+  h.CoreDistances(points, coreDistances);
+
+  REQUIRE(coreDistances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    arma::vec distances(points.n_cols);
+    for (size_t j = 0; j < points.n_cols; ++j)
+      distances[j] = metric::EuclideanDistance::Evaluate(points.col(i),
+          points.col(j));
+    distances = arma::sort(distances);
+
+    // distances[0] is the point itself.
+    REQUIRE(coreDistances[i] == Approx(distances[3]).epsilon(1e-7));
+  }
+
+  // With one sample, every core distance is 0.
+  h.MinSamples() = 1;
+  h.CoreDistances(points, coreDistances);
+  REQUIRE(arma::all(coreDistances == 0.0));
+}
+
+/**
+ * Check the mutual reachability spanning tree computed by dual-tree Boruvka
+ * against the naive computation.
+ */
+TEST_CASE("HDBSCANMutualReachabilityMSTTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 300, arma::fill::randu);
+
+  HDBSCAN<> h(5);
+  arma::vec coreDistances;
+  h.CoreDistances(points, coreDistances);
+
+  arma::mat naiveResults, kdResults, ballResults;
+  DualTreeBoruvka<> naive(points, true);
+  naive.ComputeMST(naiveResults, coreDistances);
+  DualTreeBoruvka<> dtb(points);
+  dtb.ComputeMST(kdResults, coreDistances);
+  DualTreeBoruvka<metric::EuclideanDistance, arma::mat, tree::BallTree>
+      ballDtb(points);
+  ballDtb.ComputeMST(ballResults, coreDistances);
+
+  REQUIRE(kdResults.n_cols == points.n_cols - 1);
+  REQUIRE(ballResults.n_cols == points.n_cols - 1);
+  REQUIRE(arma::accu(kdResults.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+  REQUIRE(arma::accu(ballResults.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+
+  // Every edge must be at least as long as the core distances of its points.
+  for (size_t i = 0; i < kdResults.n_cols; ++i)
+  {
+    REQUIRE(kdResults(2, i) >= coreDistances[(size_t) kdResults(0, i)]);
+    REQUIRE(kdResults(2, i) >= coreDistances[(size_t) kdResults(1, i)]);
+  }
+
+  // The spanning tree under the mutual reachability distance is at least as
+  // long as the plain one.
+  arma::mat plainResults;
+  DualTreeBoruvka<> plain(points);
+  plain.ComputeMST(plainResults);
+  REQUIRE(arma::accu(kdResults.row(2)) >= arma::accu(plainResults.row(2)));
+}
+
+/**
+ * Three well-separated blobs with a few outliers should give three clusters
+ * and noise.
+ */
+TEST_CASE("HDBSCANThreeClustersTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 303);
+  points.cols(0, 99) = arma::randn(2, 100) * 0.1;
+  points.cols(100, 199) = arma::randn(2, 100) * 0.1;
+  points.cols(200, 299) = arma::randn(2, 100) * 0.1;
+  points.cols(100, 199).each_col() += arma::vec("10.0 0.0");
+  points.cols(200, 299).each_col() += arma::vec("0.0 10.0");
+
+  // Add 3 outliers.
+  points.col(300) = arma::vec("-8.0 -8.0");
+  points.col(301) = arma::vec("20.0 20.0");
+  points.col(302) = arma::vec("25.0 -15.0");
+
+  HDBSCAN<> h(10);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  const size_t clusters = h.Cluster(points, assignments, centroids);
+
+  REQUIRE(clusters == 3);
+  REQUIRE(assignments.n_elem == points.n_cols);
+  REQUIRE(centroids.n_cols == 3);
+
+  // The clusters are numbered in the order of their first point.
+  for (size_t c = 0; c < 3; ++c)
+  {
+    for (size_t i = 100 * c; i < 100 * (c + 1); ++i)
+      REQUIRE(assignments[i] == c);
+  }
+
+  REQUIRE(assignments[300] == SIZE_MAX);
+  REQUIRE(assignments[301] == SIZE_MAX);
+  REQUIRE(assignments[302] == SIZE_MAX);
+
+  REQUIRE(arma::norm(centroids.col(1) - arma::vec("10.0 0.0")) < 0.1);
+  REQUIRE(arma::norm(centroids.col(2) - arma::vec("0.0 10.0")) < 0.1);
+}
+
+/**
+ * The clustering should not depend on the tree type.  (With ties in the mutual
+ * reachability distances, the spanning trees may differ, so only the clusters
+ * are compared.)
+ */
+TEST_CASE("HDBSCANTreeTypeTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 400);
+  points.cols(0, 199) = arma::randn(3, 200) * 0.5;
+  points.cols(200, 399) = arma::randn(3, 200) * 0.5;
+  points.cols(200, 399).each_col() += arma::vec("20.0 0.0 0.0");
+
+  HDBSCAN<> kd(15, 5);
+  HDBSCAN<metric::EuclideanDistance, arma::mat, tree::BallTree> ball(15, 5);
+  HDBSCAN<metric::EuclideanDistance, arma::mat, tree::StandardCoverTree>
+      cover(15, 5);
+
+  arma::Row<size_t> kdAssignments, ballAssignments, coverAssignments;
+  REQUIRE(kd.Cluster(points, kdAssignments) == 2);
+  REQUIRE(ball.Cluster(points, ballAssignments) == 2);
+  REQUIRE(cover.Cluster(points, coverAssignments) == 2);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const size_t cluster = (i < 200) ? 0 : 1;
+    REQUIRE(kdAssignments[i] == cluster);
+    REQUIRE(ballAssignments[i] == cluster);
+    REQUIRE(coverAssignments[i] == cluster);
+  }
+}
+
+/**
+ * With fewer points than the minimum cluster size, every point is noise.
+ */
+TEST_CASE("HDBSCANTooFewPointsTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 4, arma::fill::randu);
+
+  HDBSCAN<> h(5);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 0);
+  REQUIRE(assignments.n_elem == points.n_cols);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+
+  REQUIRE_THROWS_AS(HDBSCAN<>(1), std::invalid_argument);
+}
@@ -0,0 +1,244 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Unit tests for the 'HNSWSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/hnsw.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+/**
+ * Make sure that the recall of the bichromatic search against exact search is
+ * high.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(5, 2000);
+  arma::mat qdata = arma::randu<arma::mat>(5, 200);
+  const size_t k = 10;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(qdata, k, groundTruth, groundDistances);
+
+  HNSWSearch<> hnsw(rdata, 12, 100, 50);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(qdata, k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == qdata.n_cols);
+  REQUIRE(KNN::Recall(neighbors, groundTruth) > 0.95);
+
+  // The distances should be sorted and correct.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(arma::norm(qdata.col(i) -
+          rdata.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+}
+
+/**
+ * Make sure that a larger efSearch does not lower the recall.
+ */
+TEST_CASE("HNSWEfSearchTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(10, 2000);
+  arma::mat qdata = arma::randu<arma::mat>(10, 100);
+  const size_t k = 10;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(qdata, k, groundTruth, groundDistances);
+
+  HNSWSearch<> hnsw(rdata, 4, 20, 10);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(qdata, k, neighbors, distances);
+  const double lowRecall = KNN::Recall(neighbors, groundTruth);
+
+  hnsw.EfSearch() = 200;
+  hnsw.Search(qdata, k, neighbors, distances);
+  const double highRecall = KNN::Recall(neighbors, groundTruth);
+
+  REQUIRE(highRecall >= lowRecall);
+  REQUIRE(highRecall > 0.9);
+}
+
+/**
+ * Make sure that the monochromatic search does not return the point itself.
+ */
+TEST_CASE("HNSWMonochromaticTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(3, 1000);
+  const size_t k = 5;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(k, groundTruth, groundDistances);
+
+  HNSWSearch<> hnsw(rdata);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == rdata.n_cols);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < k; ++j)
+      REQUIRE(neighbors(j, i) != i);
+
+  REQUIRE(KNN::Recall(neighbors, groundTruth) > 0.95);
+}
+
+/**
+ * Make sure that points inserted into a trained model can be found, and that
+ * the recall is still high.
+ */
+TEST_CASE("HNSWInsertTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(4, 2000);
+  arma::mat qdata = arma::randu<arma::mat>(4, 100);
+  const size_t k = 5;
+
+  HNSWSearch<> hnsw(rdata.cols(0, 999));
+  hnsw.Insert(rdata.cols(1000, 1499));
+  hnsw.Insert(rdata.cols(1500, 1999));
+
+  REQUIRE(hnsw.ReferenceSet().n_cols == 2000);
+  CheckMatrices(hnsw.ReferenceSet(), rdata);
+
+  // Each inserted point should be its own nearest neighbor.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(rdata.cols(1500, 1999), 1, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    REQUIRE(neighbors(0, i) == 1500 + i);
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(qdata, k, groundTruth, groundDistances);
+
+  hnsw.Search(qdata, k, neighbors, distances);
+  REQUIRE(KNN::Recall(neighbors, groundTruth) > 0.95);
+}
+
+/**
+ * Make sure that an empty model can be filled with Insert().
+ */
+TEST_CASE("HNSWEmptyInsertTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(3, 500);
+
+  HNSWSearch<> hnsw;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(hnsw.Search(rdata, 1, neighbors, distances),
+      std::invalid_argument);
+
+  hnsw.Insert(rdata);
+  hnsw.Search(rdata, 1, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    REQUIRE(neighbors(0, i) == i);
+}
+
+/**
+ * Make sure that the graph respects the limits on the number of links, and
+ * that every link points to a point in the same layer.
+ */
+TEST_CASE("HNSWGraphStructureTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(5, 3000);
+  const size_t m = 6;
+
+  HNSWSearch<> hnsw(rdata, m, 50);
+
+  const std::vector<size_t>& levels = hnsw.Levels();
+  REQUIRE(levels.size() == rdata.n_cols);
+  REQUIRE(levels[hnsw.EntryPoint()] == hnsw.MaxLevel());
+
+  for (size_t i = 0; i < rdata.n_cols; ++i)
+  {
+    REQUIRE(levels[i] <= hnsw.MaxLevel());
+    for (size_t layer = 0; layer <= levels[i]; ++layer)
+    {
+      const std::vector<size_t> links = hnsw.Neighbors(i, layer);
+      REQUIRE(links.size() <= ((layer == 0) ? 2 * m : m));
+      for (size_t j = 0; j < links.size(); ++j)
+      {
+        REQUIRE(links[j] != i);
+        REQUIRE(links[j] < rdata.n_cols);
+        REQUIRE(levels[links[j]] >= layer);
+      }
+    }
+
+    // Every point but a lone first point should be linked in layer 0.
+    REQUIRE(hnsw.Neighbors(i, 0).size() > 0);
+  }
+}
+
+/**
+ * Make sure that invalid parameters and inputs throw.
+ */
+TEST_CASE("HNSWInvalidParametersTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(3, 100);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  REQUIRE_THROWS_AS(HNSWSearch<>(rdata, 1), std::invalid_argument);
+
+  HNSWSearch<> hnsw(rdata);
+  REQUIRE_THROWS_AS(hnsw.Search(arma::randu<arma::mat>(4, 10), 1, neighbors,
+      distances), std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(100, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Insert(arma::randu<arma::mat>(4, 10)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized model gives the same results.
+ */
+TEST_CASE("HNSWSerializationTest", "[HNSWTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(5, 1000);
+  arma::mat qdata = arma::randu<arma::mat>(5, 100);
+
+  HNSWSearch<> hnsw(rdata, 8, 50, 30);
+  HNSWSearch<> xmlHnsw, jsonHnsw, binaryHnsw;
+  SerializeObjectAll(hnsw, xmlHnsw, jsonHnsw, binaryHnsw);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  hnsw.Search(qdata, 5, neighbors, distances);
+  xmlHnsw.Search(qdata, 5, xmlNeighbors, xmlDistances);
+  jsonHnsw.Search(qdata, 5, jsonNeighbors, jsonDistances);
+  binaryHnsw.Search(qdata, 5, binaryNeighbors, binaryDistances);
+
+  REQUIRE(xmlHnsw.EfSearch() == 30);
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
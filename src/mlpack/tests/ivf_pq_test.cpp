@@ -0,0 +1,184 @@
+/**
+ * @file tests/ivf_pq_test.cpp
+ *
+ * Unit tests for the 'IVFPQSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/ivf_pq.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+/**
+ * Make sure that re-ranking the best candidates against the original vectors
+ * gives a high recall and exact distances.
+ */
+TEST_CASE("IVFPQRerankRecallTest", "[IVFPQTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(8, 4000);
+  arma::mat qdata = arma::randu<arma::mat>(8, 100);
+  const size_t k = 10;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(qdata, k, groundTruth, groundDistances);
+
+  // Visit every cell, so that only the quantization of the residuals matters.
+  IVFPQSearch<> index(rdata, 16, 4, 64, 16);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(qdata, k, neighbors, distances, rdata, 200);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == qdata.n_cols);
+  REQUIRE(KNN::Recall(neighbors, groundTruth) > 0.95);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(arma::norm(qdata.col(i) -
+          rdata.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+}
+
+/**
+ * Make sure that the asymmetric distances alone give a reasonable recall, and
+ * that re-ranking improves it.
+ */
+TEST_CASE("IVFPQAsymmetricRecallTest", "[IVFPQTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(8, 4000);
+  arma::mat qdata = arma::randu<arma::mat>(8, 100);
+  const size_t k = 10;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> groundTruth;
+  arma::mat groundDistances;
+  knn.Search(qdata, k, groundTruth, groundDistances);
+
+  IVFPQSearch<> index(rdata, 16, 8, 64, 16);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(qdata, k, neighbors, distances);
+  const double adcRecall = KNN::Recall(neighbors, groundTruth);
+
+  // Every neighbor should be valid and the distances sorted.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(neighbors(j, i) < rdata.n_cols);
+      if (j > 0)
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+
+  index.Search(qdata, k, neighbors, distances, rdata, 100);
+  const double rerankRecall = KNN::Recall(neighbors, groundTruth);
+
+  REQUIRE(adcRecall > 0.4);
+  REQUIRE(rerankRecall >= adcRecall);
+}
+
+/**
+ * Make sure that points added in chunks get consecutive indices, and that each
+ * point is stored in numSubspaces bytes.
+ */
+TEST_CASE("IVFPQAddTest", "[IVFPQTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(6, 3000);
+  const size_t numSubspaces = 3;
+
+  IVFPQSearch<> index(8, numSubspaces, 32);
+  index.Train(rdata.cols(0, 999));
+  REQUIRE(index.NumPoints() == 0);
+
+  index.Add(rdata.cols(0, 1999));
+  index.Add(rdata.cols(2000, 2999));
+  REQUIRE(index.NumPoints() == 3000);
+
+  std::vector<bool> seen(rdata.n_cols, false);
+  for (size_t l = 0; l < index.NumLists(); ++l)
+  {
+    const std::vector<size_t>& indices = index.ListIndices()[l];
+    REQUIRE(index.ListCodes()[l].size() == numSubspaces * indices.size());
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+      REQUIRE(indices[j] < rdata.n_cols);
+      REQUIRE(!seen[indices[j]]);
+      seen[indices[j]] = true;
+    }
+  }
+
+  for (size_t i = 0; i < seen.size(); ++i)
+    REQUIRE(seen[i]);
+}
+
+/**
+ * Make sure that invalid parameters and inputs throw.
+ */
+TEST_CASE("IVFPQInvalidParametersTest", "[IVFPQTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(4, 500);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  REQUIRE_THROWS_AS(IVFPQSearch<>(8, 4, 300), std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(rdata, 8, 5, 16), std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(rdata, 1000, 2, 16), std::invalid_argument);
+
+  IVFPQSearch<> index(8, 2, 16);
+  REQUIRE_THROWS_AS(index.Add(rdata), std::invalid_argument);
+
+  index.Train(rdata);
+  REQUIRE_THROWS_AS(index.Search(rdata, 1, neighbors, distances),
+      std::invalid_argument);
+
+  index.Add(rdata);
+  REQUIRE_THROWS_AS(index.Search(arma::randu<arma::mat>(3, 10), 1, neighbors,
+      distances), std::invalid_argument);
+  REQUIRE_THROWS_AS(index.Search(rdata, 1, neighbors, distances,
+      rdata.cols(0, 99), 10), std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized index gives the same results.
+ */
+TEST_CASE("IVFPQSerializationTest", "[IVFPQTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(6, 1000);
+  arma::mat qdata = arma::randu<arma::mat>(6, 50);
+
+  IVFPQSearch<> index(rdata, 8, 3, 32, 4);
+  IVFPQSearch<> xmlIndex, jsonIndex, binaryIndex;
+  SerializeObjectAll(index, xmlIndex, jsonIndex, binaryIndex);
+
+  REQUIRE(xmlIndex.NumPoints() == index.NumPoints());
+  REQUIRE(jsonIndex.NumProbes() == 4);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  index.Search(qdata, 5, neighbors, distances);
+  xmlIndex.Search(qdata, 5, xmlNeighbors, xmlDistances);
+  jsonIndex.Search(qdata, 5, jsonNeighbors, jsonDistances);
+  binaryIndex.Search(qdata, 5, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
@@ -12,6 +12,7 @@
 #include <mlpack/methods/neighbor_search.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::kmeans;
@@ -540,6 +541,64 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Test that the k-means|| initialization strategy returns decent initial
+ * cluster estimates on the same dataset as the k-means++ test, and that it can
+ * be used as the initial partition policy of KMeans.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k(5, 2.0);
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  REQUIRE(resultingCentroids.n_rows == 3);
+  REQUIRE(resultingCentroids.n_cols == 5);
+
+  // Calculate the sum of distances to the closest centroids.
+  double distortion = 0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      bestDist = std::min(bestDist, metric::EuclideanDistance::Evaluate(
+          data.col(i), resultingCentroids.col(j)));
+    }
+    distortion += bestDist;
+  }
+
+  // The reclustering step runs Lloyd iterations on the weighted candidates, so
+  // this should be at least as good as k-means++.
+  REQUIRE(distortion < 14500.0);
+
+  // Now use it inside KMeans.
+  KMeans<metric::EuclideanDistance, KMeansParallelInitialization> km;
+  arma::Row<size_t> assignments;
+  arma::mat kmCentroids;
+  km.Cluster(data, 5, assignments, kmCentroids);
+
+  REQUIRE(kmCentroids.n_cols == 5);
+  REQUIRE(assignments.n_elem == data.n_cols);
+  REQUIRE(arma::max(assignments) < 5);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -656,6 +715,153 @@ TEST_CASE("HamerlyTest", "[KMeansTest]")
   }
 }
 
+TEST_CASE("YinyangTest", "[KMeansTest]")
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    // Use enough clusters that there are several groups.
+    const size_t k = 12 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the Yinyang algorithm and the naive method return the same
+    // clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        YinyangKMeans> yinyang;
+    arma::Row<size_t> yinyangAssignments;
+    arma::mat yinyangCentroids(centroids);
+    yinyang.Cluster(dataset, k, yinyangAssignments, yinyangCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == yinyangAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(yinyangCentroids[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that mini-batch k-means finds the centers of well-separated
+ * Gaussians, even though it only sees a small batch at each iteration.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  arma::mat means("0.0 10.0 -10.0 0.0;"
+                  "0.0 10.0 10.0 -10.0");
+  arma::mat dataset(2, 8000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col(i) = means.col(i % 4) + arma::randn<arma::vec>(2);
+
+  // Start from one perturbed centroid near each mean.
+  arma::mat centroids = means + 2.0 * arma::randu<arma::mat>(2, 4) - 1.0;
+
+  KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, MiniBatchKMeans> km(100);
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, 4, assignments, centroids, false, true);
+
+  for (size_t c = 0; c < 4; ++c)
+    REQUIRE(arma::norm(centroids.col(c) - means.col(c)) < 0.3);
+
+  // Every point is far closer to its own mean than to any other.
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (assignments[i] == i % 4)
+      ++correct;
+  REQUIRE(correct > 0.99 * dataset.n_cols);
+}
+
+/**
+ * Make sure that the blocked Euclidean assignment finds the same nearest
+ * centroids and the same sums as evaluating every distance.
+ */
+TEST_CASE("BlockedEuclideanAssignmentTest", "[KMeansTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(32, 1500);
+  arma::mat centroids = arma::randu<arma::mat>(32, 40);
+
+  arma::Row<size_t> assignments;
+  REQUIRE(BlockedEuclideanAssignment::Assign<metric::EuclideanDistance>(
+      dataset, centroids, assignments));
+
+  arma::mat sums;
+  arma::Col<size_t> counts;
+  REQUIRE(BlockedEuclideanAssignment::Accumulate<
+      metric::SquaredEuclideanDistance>(dataset, centroids, sums, counts));
+
+  arma::mat bruteSums(32, 40, arma::fill::zeros);
+  arma::Col<size_t> bruteCounts(40, arma::fill::zeros);
+  REQUIRE(assignments.n_elem == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    arma::vec distances(centroids.n_cols);
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+      distances[j] = arma::norm(dataset.col(i) - centroids.col(j));
+
+    REQUIRE(assignments[i] == distances.index_min());
+    bruteSums.col(assignments[i]) += dataset.col(i);
+    ++bruteCounts[assignments[i]];
+  }
+
+  CheckMatrices(counts, bruteCounts);
+  CheckMatrices(sums, bruteSums);
+
+  // Float data can be used too.
+  arma::fmat floatDataset = arma::conv_to<arma::fmat>::from(dataset);
+  arma::Row<size_t> floatAssignments;
+  REQUIRE(BlockedEuclideanAssignment::Assign<metric::EuclideanDistance>(
+      floatDataset, centroids, floatAssignments));
+  REQUIRE(floatAssignments.n_elem == dataset.n_cols);
+
+  // Other metrics, sparse data and small problems are not handled.
+  REQUIRE(!BlockedEuclideanAssignment::Assign<metric::ManhattanDistance>(
+      dataset, centroids, assignments));
+  arma::sp_mat sparseDataset = arma::sprandu<arma::sp_mat>(32, 100, 0.1);
+  REQUIRE(!BlockedEuclideanAssignment::Assign<metric::EuclideanDistance>(
+      sparseDataset, centroids, assignments));
+  REQUIRE(!BlockedEuclideanAssignment::Assign<metric::EuclideanDistance>(
+      dataset, centroids.cols(0, 4), assignments));
+}
+
+/**
+ * Make sure that k-means with the blocked assignment gives the same clusters
+ * as Hamerly's algorithm, which evaluates the distances directly.
+ */
+TEST_CASE("BlockedNaiveKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(40, 2000);
+  arma::mat centroids = arma::randu<arma::mat>(40, 30);
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km(30);
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, 30, assignments, naiveCentroids, false, true);
+
+  KMeans<metric::EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      HamerlyKMeans> hamerly(30);
+  arma::Row<size_t> hamerlyAssignments;
+  arma::mat hamerlyCentroids(centroids);
+  hamerly.Cluster(dataset, 30, hamerlyAssignments, hamerlyCentroids, false,
+      true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(assignments[i] == hamerlyAssignments[i]);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(naiveCentroids[i] == Approx(hamerlyCentroids[i]).epsilon(1e-7));
+}
+
 TEST_CASE("PellegMooreTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -266,3 +266,146 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * Make sure that training on a dataset one chunk at a time with Update() gives
+ * the same model as training on the whole dataset, with and without an
+ * intercept and weights.
+ */
+TEST_CASE("LinearRegressionUpdateTest", "[LinearRegressionTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 5000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(5000);
+  arma::rowvec weights = arma::randu<arma::rowvec>(5000);
+
+  // Chunks of different sizes, including chunks with fewer points than
+  // dimensions.
+  const size_t bounds[] = { 0, 2, 1500, 1503, 4000, 5000 };
+
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    const bool intercept = (trial % 2 == 0);
+    const arma::rowvec trialWeights = (trial >= 2) ? weights : arma::rowvec();
+
+    LinearRegression lr(dataset, responses, trialWeights, 0.3, intercept);
+
+    LinearRegression lrUpdate(0.3, intercept);
+    for (size_t c = 0; c < 5; ++c)
+    {
+      const arma::mat chunk = dataset.cols(bounds[c], bounds[c + 1] - 1);
+      const arma::rowvec chunkResponses =
+          responses.subvec(bounds[c], bounds[c + 1] - 1);
+      if (trial >= 2)
+      {
+        lrUpdate.Update(chunk, chunkResponses,
+            weights.subvec(bounds[c], bounds[c + 1] - 1), false);
+      }
+      else
+      {
+        lrUpdate.Update(chunk, chunkResponses, false);
+      }
+    }
+    lrUpdate.Solve();
+
+    REQUIRE(lr.Parameters().n_elem == lrUpdate.Parameters().n_elem);
+    for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    {
+      REQUIRE(lrUpdate.Parameters()[i] ==
+          Approx(lr.Parameters()[i]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that a model trained with Train() can be updated with new data, and
+ * that changing lambda only requires Solve().
+ */
+TEST_CASE("LinearRegressionTrainUpdateTest", "[LinearRegressionTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 2000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(2000);
+
+  LinearRegression lr(dataset, responses, 0.5);
+
+  LinearRegression lrUpdate(0.5);
+  lrUpdate.Train(dataset.cols(0, 999), responses.subvec(0, 999), true, true);
+  lrUpdate.Update(dataset.cols(1000, 1999), responses.subvec(1000, 1999));
+
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+  {
+    REQUIRE(lrUpdate.Parameters()[i] ==
+        Approx(lr.Parameters()[i]).epsilon(1e-7));
+  }
+
+  LinearRegression lrLambda(dataset, responses, 2.0);
+  lrUpdate.Lambda() = 2.0;
+  lrUpdate.Solve();
+  for (size_t i = 0; i < lrLambda.Parameters().n_elem; ++i)
+  {
+    REQUIRE(lrUpdate.Parameters()[i] ==
+        Approx(lrLambda.Parameters()[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that Update() and Solve() reject models and data they cannot use.
+ */
+TEST_CASE("LinearRegressionInvalidUpdateTest", "[LinearRegressionTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 100);
+  arma::rowvec responses = arma::randu<arma::rowvec>(100);
+
+  // Nothing to solve.
+  LinearRegression lr;
+  REQUIRE_THROWS_AS(lr.Solve(), std::invalid_argument);
+
+  // Data with a different dimensionality.
+  lr.Update(dataset, responses);
+  arma::mat otherDataset = arma::randu<arma::mat>(3, 100);
+  REQUIRE_THROWS_AS(lr.Update(otherDataset, responses),
+      std::invalid_argument);
+
+  // Weights of the wrong size.
+  arma::rowvec weights = arma::randu<arma::rowvec>(99);
+  REQUIRE_THROWS_AS(lr.Update(dataset, responses, weights),
+      std::invalid_argument);
+  LinearRegression lrWeights;
+  REQUIRE_THROWS_AS(lrWeights.Train(dataset, responses, weights),
+      std::invalid_argument);
+
+  // A loaded model does not keep the normal equations.
+  LinearRegression xmlLr, jsonLr, binaryLr;
+  SerializeObjectAll(lr, xmlLr, jsonLr, binaryLr);
+  REQUIRE_THROWS_AS(xmlLr.Update(dataset, responses), std::invalid_argument);
+
+  // Neither does a model trained with Train(), unless it is asked to.
+  LinearRegression lrTrain(dataset, responses);
+  REQUIRE_THROWS_AS(lrTrain.Update(dataset, responses), std::invalid_argument);
+  REQUIRE_THROWS_AS(lrTrain.Solve(), std::invalid_argument);
+}
+
+/**
+ * Make sure that releasing the normal equations keeps the model usable for
+ * prediction, and that the model can be trained again afterwards.
+ */
+TEST_CASE("LinearRegressionClearNormalEquationsTest", "[LinearRegressionTest]")
+{
+  static_assert(!std::is_convertible<double, LinearRegression>::value,
+      "LinearRegression should not be implicitly constructible from lambda");
+
+  arma::mat dataset = arma::randu<arma::mat>(4, 200);
+  arma::rowvec responses = arma::randu<arma::rowvec>(200);
+
+  LinearRegression lr(0.1);
+  lr.Train(dataset, responses, true, true);
+  const arma::vec parameters = lr.Parameters();
+
+  lr.ClearNormalEquations();
+  REQUIRE(arma::approx_equal(lr.Parameters(), parameters, "absdiff", 1e-12));
+  REQUIRE_THROWS_AS(lr.Update(dataset, responses), std::invalid_argument);
+  REQUIRE_THROWS_AS(lr.Solve(), std::invalid_argument);
+
+  lr.Train(dataset, responses, true, true);
+  lr.Update(dataset, responses);
+  REQUIRE(lr.Parameters().n_elem == parameters.n_elem);
+}
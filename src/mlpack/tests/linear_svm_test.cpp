@@ -1195,3 +1195,43 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * Make sure that a linear SVM trained on single precision sparse data finds
+ * the same model as on dense double precision data, and that shuffling sparse
+ * data for SGD works.
+ */
+TEST_CASE("LinearSVMSparseFloatTest", "[LinearSVMTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 800, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = (arma::accu(denseDataset.col(i)) > 1.5) ? 1 : 0;
+
+  arma::sp_fmat sparseFloatDataset(
+      arma::conv_to<arma::fmat>::from(denseDataset));
+
+  LinearSVM<arma::mat> svm(denseDataset, labels, 2, 0.3, 1, false,
+      ens::L_BFGS());
+  LinearSVM<arma::sp_fmat> svmSparseFloat(sparseFloatDataset, labels, 2, 0.3,
+      1, false, ens::L_BFGS());
+
+  REQUIRE(svm.Parameters().n_elem == svmSparseFloat.Parameters().n_elem);
+  for (size_t i = 0; i < svm.Parameters().n_elem; ++i)
+  {
+    REQUIRE(svm.Parameters()[i] ==
+        Approx(svmSparseFloat.Parameters()[i]).epsilon(1e-2));
+  }
+
+  arma::Row<size_t> predictions, sparseFloatPredictions;
+  svm.Classify(denseDataset, predictions);
+  svmSparseFloat.Classify(sparseFloatDataset, sparseFloatPredictions);
+  REQUIRE(arma::accu(predictions == sparseFloatPredictions) >= 790);
+
+  // Train with shuffled minibatches, with an intercept.
+  LinearSVM<arma::sp_mat> svmSGD(dataset, labels, 2, 0.0001, 1, true,
+      ens::StandardSGD(0.01, 32, 100 * dataset.n_cols, 1e-9, true));
+  REQUIRE(svmSGD.ComputeAccuracy(dataset, labels) >= 0.85);
+}
@@ -83,6 +83,47 @@ TEST_CASE("LocalCoordinateCodingTestCodingStep",
   }
 }
 
+/**
+ * Make sure that coding by coordinate descent gives optimal codes too.
+ */
+TEST_CASE("LocalCoordinateCodingTestCodingStepCoordinateDescent",
+          "[LocalCoordinateCodingTest]")
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 10;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // normalize each point since these are images
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    X.col(i) /= norm(X.col(i), 2);
+  }
+
+  mat Z;
+  LocalCoordinateCoding lcc(X, nAtoms, lambda1, 10);
+  lcc.UseCoordinateDescent() = true;
+  lcc.Encode(X, Z);
+
+  mat D = lcc.Dictionary();
+
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    vec sqDists = vec(nAtoms);
+    for (uword j = 0; j < nAtoms; ++j)
+    {
+      sqDists[j] = arma::norm(D.col(j) - X.col(i));
+    }
+    mat Dprime = D * diagmat(1.0 / sqDists);
+    mat zPrime = Z.unsafe_col(i) % sqDists;
+
+    vec errCorr = trans(Dprime) * (Dprime * zPrime - X.unsafe_col(i));
+    VerifyCorrectness(zPrime, errCorr, 0.5 * lambda1);
+  }
+}
+
 TEST_CASE("LocalCoordinateCodingTestDictionaryStep",
           "[LocalCoordinateCodingTest]")
 {
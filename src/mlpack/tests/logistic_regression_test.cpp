@@ -1080,3 +1080,48 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Make sure that logistic regression trained on single precision data, dense
+ * or sparse, finds the same model as on double precision data.
+ */
+TEST_CASE("LogisticRegressionFloatTest", "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 800, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = (arma::accu(denseDataset.col(i)) > 1.5) ? 1 : 0;
+
+  arma::fmat floatDataset = arma::conv_to<arma::fmat>::from(denseDataset);
+  arma::sp_fmat sparseFloatDataset(floatDataset);
+
+  LogisticRegression<> lr(denseDataset, labels, 0.3);
+  LogisticRegression<arma::fmat> lrFloat(floatDataset, labels, 0.3);
+  LogisticRegression<arma::sp_fmat> lrSparseFloat(sparseFloatDataset, labels,
+      0.3);
+
+  REQUIRE(lr.Parameters().n_elem == lrFloat.Parameters().n_elem);
+  REQUIRE(lr.Parameters().n_elem == lrSparseFloat.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+  {
+    REQUIRE(lr.Parameters()[i] ==
+        Approx(lrFloat.Parameters()[i]).epsilon(1e-2));
+    REQUIRE(lr.Parameters()[i] ==
+        Approx(lrSparseFloat.Parameters()[i]).epsilon(1e-2));
+  }
+
+  // The predictions should mostly agree.
+  arma::Row<size_t> predictions, floatPredictions, sparseFloatPredictions;
+  lr.Classify(denseDataset, predictions);
+  lrFloat.Classify(floatDataset, floatPredictions);
+  lrSparseFloat.Classify(sparseFloatDataset, sparseFloatPredictions);
+  REQUIRE(arma::accu(predictions == floatPredictions) >= 790);
+  REQUIRE(arma::accu(predictions == sparseFloatPredictions) >= 790);
+  REQUIRE(lrSparseFloat.Classify(sparseFloatDataset.col(0)) ==
+      sparseFloatPredictions[0]);
+
+  REQUIRE(lrSparseFloat.ComputeError(sparseFloatDataset, labels) ==
+      Approx(lr.ComputeError(denseDataset, labels)).epsilon(1e-2));
+}
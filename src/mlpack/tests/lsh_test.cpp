@@ -990,3 +990,84 @@ TEST_CASE("SparseLSHTest", "[LSHTest]")
     REQUIRE(!std::isnan(sparseDistances[i]));
   }
 }
+
+/**
+ * Make sure that inserting points into a trained model gives the same results
+ * as training on all of the points at once.
+ */
+TEST_CASE("LSHInsertTest", "[LSHTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(5, 2000);
+  arma::mat qdata = arma::randu<arma::mat>(5, 100);
+  const arma::cube projections = arma::randn<arma::cube>(5, 10, 8);
+
+  // Use the same seed so that both models draw the same offsets and second
+  // hash weights, and no bucket size limit so that no point is dropped.
+  math::RandomSeed(42);
+  LSHSearch<> lsh(rdata, projections, 1.0, 99901, 0);
+
+  math::RandomSeed(42);
+  LSHSearch<> incrementalLsh(rdata.cols(0, 499), projections, 1.0, 99901, 0);
+  incrementalLsh.Insert(rdata.cols(500, 1199));
+  incrementalLsh.Insert(rdata.cols(1200, 1999));
+
+  REQUIRE(incrementalLsh.ReferenceSet().n_cols == 2000);
+  REQUIRE(incrementalLsh.RemovedPoints().size() == 2000);
+
+  arma::Mat<size_t> neighbors, incrementalNeighbors;
+  arma::mat distances, incrementalDistances;
+  lsh.Search(qdata, 5, neighbors, distances);
+  incrementalLsh.Search(qdata, 5, incrementalNeighbors, incrementalDistances);
+
+  CheckMatrices(neighbors, incrementalNeighbors);
+  CheckMatrices(distances, incrementalDistances);
+
+  // Each bucket should hold the same points.
+  std::vector<arma::Col<size_t>> table = lsh.SecondHashTable();
+  std::vector<arma::Col<size_t>> incrementalTable =
+      incrementalLsh.SecondHashTable();
+  REQUIRE(table.size() == incrementalTable.size());
+  size_t totalSize = 0;
+  for (size_t i = 0; i < table.size(); ++i)
+    totalSize += table[i].n_elem;
+  size_t incrementalTotalSize = 0;
+  for (size_t i = 0; i < incrementalTable.size(); ++i)
+    incrementalTotalSize += incrementalTable[i].n_elem;
+  REQUIRE(totalSize == incrementalTotalSize);
+  REQUIRE(totalSize == 8 * rdata.n_cols);
+}
+
+/**
+ * Make sure that removed points are never returned, and that invalid removals
+ * throw.
+ */
+TEST_CASE("LSHRemoveTest", "[LSHTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(3, 1000);
+  arma::mat qdata = arma::randu<arma::mat>(3, 100);
+
+  LSHSearch<> lsh(rdata, 5, 10, 0.5, 99901, 0);
+  for (size_t i = 0; i < rdata.n_cols; i += 2)
+    lsh.Remove(i);
+
+  REQUIRE_THROWS_AS(lsh.Remove(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(lsh.Remove(1000), std::invalid_argument);
+
+  // The reference set keeps its size.
+  REQUIRE(lsh.ReferenceSet().n_cols == 1000);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(qdata, 3, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE((neighbors[i] == rdata.n_cols || neighbors[i] % 2 == 1));
+
+  lsh.Search(3, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+    REQUIRE((neighbors[i] == rdata.n_cols || neighbors[i] % 2 == 1));
+
+  std::vector<arma::Col<size_t>> table = lsh.SecondHashTable();
+  for (size_t i = 0; i < table.size(); ++i)
+    for (size_t j = 0; j < table[i].n_elem; ++j)
+      REQUIRE(table[i][j] % 2 == 1);
+}
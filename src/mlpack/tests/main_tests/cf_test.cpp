@@ -141,7 +141,7 @@ TEST_CASE_METHOD(CFTestFixture, "CFNeighborhoodBoundTest",
 /**
  * Ensure algorithm is one of { "NMF", "BatchSVD",
  * "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
- * "BiasSVD", "SVDPP" }.
+ * "BiasSVD", "SVDPP", "ALS" }.
  */
 TEST_CASE_METHOD(CFTestFixture, "CFAlgorithmBoundTest",
                 "[CFMainTest][BindingTests]")
@@ -158,6 +158,84 @@ TEST_CASE_METHOD(CFTestFixture, "CFAlgorithmBoundTest",
   Log::Fatal.ignoreInput = false;
 }
 
+/**
+ * Ensure lambda and alpha are non-negative for ALS.
+ */
+TEST_CASE_METHOD(CFTestFixture, "CFALSParametersBoundTest",
+                "[CFMainTest][BindingTests]")
+{
+  mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  SetInputParam("algorithm", std::string("ALS"));
+  SetInputParam("lambda", double(-1));
+  SetInputParam("training", dataset);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  ResetSettings();
+
+  SetInputParam("algorithm", std::string("ALS"));
+  SetInputParam("alpha", double(-1));
+  SetInputParam("training", std::move(dataset));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Ensure lambda and alpha are passed to the ALS decomposition.
+ */
+TEST_CASE_METHOD(CFTestFixture, "CFALSParametersTest",
+                "[CFMainTest][BindingTests]")
+{
+  mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  SetInputParam("training", std::move(dataset));
+  SetInputParam("algorithm", std::string("ALS"));
+  SetInputParam("max_iterations", int(10));
+  SetInputParam("lambda", double(0.2));
+  SetInputParam("alpha", double(3.0));
+
+  RUN_BINDING();
+
+  const CFModel* outputModel = params.Get<CFModel*>("output_model");
+  CFType<ALSPolicy, NoNormalization>& cf =
+      dynamic_cast<CFWrapper<ALSPolicy,
+                   NoNormalization>&>(*(outputModel->CF())).CF();
+
+  REQUIRE(cf.Decomposition().Lambda() == Approx(0.2));
+  REQUIRE(cf.Decomposition().Alpha() == Approx(3.0));
+}
+
+/**
+ * Ensure the hogwild flag is passed to the SGD-based decompositions.
+ */
+TEST_CASE_METHOD(CFTestFixture, "CFHogwildTest",
+                "[CFMainTest][BindingTests]")
+{
+  mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  SetInputParam("training", std::move(dataset));
+  SetInputParam("algorithm", std::string("RegSVD"));
+  SetInputParam("max_iterations", int(10));
+  SetInputParam("hogwild", true);
+
+  RUN_BINDING();
+
+  const CFModel* outputModel = params.Get<CFModel*>("output_model");
+  CFType<RegSVDPolicy, NoNormalization>& cf =
+      dynamic_cast<CFWrapper<RegSVDPolicy,
+                   NoNormalization>&>(*(outputModel->CF())).CF();
+
+  REQUIRE(cf.Decomposition().Hogwild() == true);
+}
+
 /**
  * Ensure saved models can be reused again.
  */
@@ -166,7 +244,7 @@ TEST_CASE_METHOD(CFTestFixture, "CFModelReuseTest",
 {
   std::string algorithms[] = { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "BiasSVD", "SVDPP" };
+      "BiasSVD", "SVDPP", "ALS" };
 
   mat dataset;
   data::Load("GroupLensSmall.csv", dataset);
@@ -715,3 +793,66 @@ TEST_CASE_METHOD(CFTestFixture, "CFNormalizationTest",
   REQUIRE(arma::any(arma::vectorise(output1 != output2)));
   REQUIRE(arma::any(arma::vectorise(output1 != output3)));
 }
+
+/**
+ * Ensure ratings of a new user can be folded into a trained model, and that
+ * the new user can then be queried.
+ */
+TEST_CASE_METHOD(CFTestFixture, "CFFoldInTest",
+                "[CFMainTest][BindingTests]")
+{
+  mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  // Hold out the ratings of the last user.
+  const size_t newUser = (size_t) max(dataset.row(0));
+  const mat foldIn = dataset.cols(find(dataset.row(0) == newUser));
+  dataset = dataset.cols(find(dataset.row(0) != newUser));
+
+  SetInputParam("training", std::move(dataset));
+  SetInputParam("max_iterations", int(10));
+  SetInputParam("algorithm", std::string("RegSVD"));
+
+  RUN_BINDING();
+
+  CFModel* m = params.Get<CFModel*>("output_model");
+  ResetSettings();
+
+  arma::Mat<size_t> query = { newUser };
+  SetInputParam("input_model", m);
+  SetInputParam("fold_in", foldIn);
+  SetInputParam("query", query);
+  SetInputParam("recommendations", 5);
+
+  RUN_BINDING();
+
+  const arma::Mat<size_t> output = params.Get<arma::Mat<size_t>>("output");
+
+  REQUIRE(output.n_rows == 5);
+  REQUIRE(output.n_cols == 1);
+
+  // The folded-in model must know about the new user.
+  arma::vec predictions;
+  arma::Mat<size_t> combinations = { { newUser }, { 0 } };
+  params.Get<CFModel*>("output_model")->Predict(EUCLIDEAN_SEARCH,
+      AVERAGE_INTERPOLATION, combinations, predictions);
+  REQUIRE(predictions.n_elem == 1);
+}
+
+/**
+ * Ensure fold_in_iterations is positive.
+ */
+TEST_CASE_METHOD(CFTestFixture, "CFFoldInIterationsBoundTest",
+                "[CFMainTest][BindingTests]")
+{
+  mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  SetInputParam("fold_in", dataset);
+  SetInputParam("fold_in_iterations", int(0));
+  SetInputParam("training", std::move(dataset));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file tests/main_tests/hdbscan_test.cpp
+ *
+ * Test RUN_BINDING() of hdbscan_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan/hdbscan_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(HDBSCANTestFixture);
+
+/**
+ * Check that the number of output labels and the number of input points are
+ * equal.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANOutputDimensionTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::Row<size_t>>("assignments").n_cols ==
+      inputData.n_cols);
+  REQUIRE(params.Get<arma::Row<size_t>>("assignments").n_rows == 1);
+  REQUIRE(params.Get<arma::mat>("centroids").n_rows == 4);
+  REQUIRE(params.Get<arma::mat>("centroids").n_cols >= 1);
+}
+
+/**
+ * Check that the minimum cluster size must be at least 2.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANMinClusterSizeTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("min_cluster_size", (int) 1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that min_samples may not be negative or larger than the dataset.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANMinSamplesTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("min_samples", (int) -1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", inputData);
+  SetInputParam("min_samples", (int) inputData.n_cols + 1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that an unknown tree type is rejected.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANTreeTypeTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("tree_type", std::string("binary"));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that all tree types give the same clustering on well-separated data.
+ */
+TEST_CASE_METHOD(HDBSCANTestFixture, "HDBSCANAllTreeTypesTest",
+                 "[HDBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData(2, 200);
+  inputData.cols(0, 99) = arma::randn(2, 100) * 0.1;
+  inputData.cols(100, 199) = arma::randn(2, 100) * 0.1;
+  inputData.cols(100, 199).each_col() += arma::vec("5.0 5.0");
+
+  const std::vector<std::string> treeTypes = { "kd", "ball", "cover" };
+  for (size_t t = 0; t < treeTypes.size(); ++t)
+  {
+    CleanMemory();
+    ResetSettings();
+
+    SetInputParam("input", inputData);
+    SetInputParam("tree_type", treeTypes[t]);
+    SetInputParam("min_cluster_size", (int) 20);
+
+    RUN_BINDING();
+
+    const arma::Row<size_t>& assignments =
+        params.Get<arma::Row<size_t>>("assignments");
+    REQUIRE(assignments.n_elem == inputData.n_cols);
+    for (size_t i = 0; i < inputData.n_cols; ++i)
+      REQUIRE(assignments[i] == ((i < 100) ? 0 : 1));
+  }
+}
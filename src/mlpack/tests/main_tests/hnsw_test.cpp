@@ -0,0 +1,208 @@
+/**
+ * @file tests/main_tests/hnsw_test.cpp
+ *
+ * Test RUN_BINDING() of hnsw_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hnsw/hnsw_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(HNSWTestFixture);
+
+/**
+ * Check that output neighbors and distances have valid dimensions.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWOutputDimensionTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) 6);
+
+  RUN_BINDING();
+
+  // Check the neighbors matrix has 6 points for each of the 100 input points.
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_rows == 6);
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_cols == 100);
+
+  // Check the distances matrix has 6 points for each of the 100 input points.
+  REQUIRE(params.Get<arma::mat>("distances").n_rows == 6);
+  REQUIRE(params.Get<arma::mat>("distances").n_cols == 100);
+}
+
+/**
+ * Ensure that k, links, ef_construction and ef_search are validated.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWParamValidityTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) -1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("links", (int) 1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("ef_construction", (int) 0);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) 6);
+  SetInputParam("ef_search", (int) -1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Make sure only one of reference data or pre-trained model is passed.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWModelValidityTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) 6);
+
+  RUN_BINDING();
+
+  SetInputParam("input_model",
+      params.Get<neighbor::HNSWSearch<>*>("output_model"));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that a saved model can be reused, with the same results.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWModelReuseTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 200);
+  arma::mat query = arma::randu<arma::mat>(5, 40);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("query", query);
+  SetInputParam("k", (int) 6);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> neighbors = params.Get<arma::Mat<size_t>>("neighbors");
+  arma::mat distances = params.Get<arma::mat>("distances");
+
+  neighbor::HNSWSearch<>* m =
+      params.Get<neighbor::HNSWSearch<>*>("output_model");
+  params.Get<neighbor::HNSWSearch<>*>("output_model") = NULL;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", m);
+  SetInputParam("query", std::move(query));
+  SetInputParam("k", (int) 6);
+
+  RUN_BINDING();
+
+  CheckMatrices(neighbors, params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, params.Get<arma::mat>("distances"));
+}
+
+/**
+ * Check that points can be inserted into a saved model.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWInsertTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 200);
+  arma::mat newPoints = arma::randu<arma::mat>(5, 50);
+
+  SetInputParam("reference", std::move(reference));
+
+  RUN_BINDING();
+
+  neighbor::HNSWSearch<>* m =
+      params.Get<neighbor::HNSWSearch<>*>("output_model");
+  params.Get<neighbor::HNSWSearch<>*>("output_model") = NULL;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", m);
+  SetInputParam("insert", newPoints);
+  SetInputParam("query", std::move(newPoints));
+  SetInputParam("k", (int) 1);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<neighbor::HNSWSearch<>*>("output_model")->
+      ReferenceSet().n_cols == 250);
+
+  // Each inserted point should be its own nearest neighbor.
+  const arma::Mat<size_t>& neighbors =
+      params.Get<arma::Mat<size_t>>("neighbors");
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    REQUIRE(neighbors(0, i) == 200 + i);
+}
+
+/**
+ * Make sure true_neighbors have valid dimensions.
+ */
+TEST_CASE_METHOD(HNSWTestFixture, "HNSWModelTrueNeighborsDimTest",
+                 "[HNSWMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(5, 100);
+
+  // Initalize trueNeighbors with invalid dimensions.
+  arma::Mat<size_t> trueNeighbors = arma::randu<arma::Mat<size_t>>(7, 100);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("true_neighbors", std::move(trueNeighbors));
+  SetInputParam("k", (int) 6);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
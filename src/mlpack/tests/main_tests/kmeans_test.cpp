@@ -340,6 +340,24 @@ TEST_CASE_METHOD(KmTestFixture, "AlgorithmsSimilarTest",
   CleanMemory();
   ResetSettings();
 
+  algo = "yinyang";
+
+  SetInputParam("input", inputData);
+  SetInputParam("clusters", c);
+  SetInputParam("algorithm", std::move(algo));
+  SetInputParam("labels_only", true);
+  SetInputParam("initial_centroids", initCentroid);
+
+  RUN_BINDING();
+
+  arma::mat yinyangOutput;
+  arma::mat yinyangCentroid;
+  yinyangOutput = std::move(params.Get<arma::mat>("output"));
+  yinyangCentroid = std::move(params.Get<arma::mat>("centroid"));
+
+  CleanMemory();
+  ResetSettings();
+
   algo = "dualtree";
 
   SetInputParam("input", inputData);
@@ -376,12 +394,110 @@ TEST_CASE_METHOD(KmTestFixture, "AlgorithmsSimilarTest",
   // Checking all the algorithms return same assignments
   CheckMatrices(naiveOutput, hamerlyOutput);
   CheckMatrices(naiveOutput, elkanOutput);
+  CheckMatrices(naiveOutput, yinyangOutput);
   CheckMatrices(naiveOutput, dualTreeOutput);
   CheckMatrices(naiveOutput, dualCoverTreeOutput);
 
   // Checking all the algorithms return almost same centroid
   CheckMatrices(naiveCentroid, hamerlyCentroid);
   CheckMatrices(naiveCentroid, elkanCentroid);
+  CheckMatrices(naiveCentroid, yinyangCentroid);
   CheckMatrices(naiveCentroid, dualTreeCentroid);
   CheckMatrices(naiveCentroid, dualCoverTreeCentroid);
 }
+
+/**
+ * Make sure that k-means|| initialization can be used and gives the right
+ * number of centroids.
+ */
+TEST_CASE_METHOD(KmTestFixture, "KmeansParallelInitializationTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  int c = 5;
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Unable to load train dataset vc2.csv!");
+
+  size_t row = inputData.n_rows;
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("clusters", c);
+  SetInputParam("kmeans_parallel", true);
+  SetInputParam("rounds", 3);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::mat>("centroid").n_rows == row);
+  REQUIRE(params.Get<arma::mat>("centroid").n_cols == (arma::uword) c);
+}
+
+/**
+ * Make sure that only one initialization strategy can be given, and that the
+ * number of k-means|| rounds must be positive.
+ */
+TEST_CASE_METHOD(KmTestFixture, "KmeansParallelInvalidParametersTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Unable to load train dataset vc2.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("clusters", 3);
+  SetInputParam("kmeans_parallel", true);
+  SetInputParam("kmeans_plus_plus", true);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("clusters", 3);
+  SetInputParam("kmeans_parallel", true);
+  SetInputParam("rounds", 0);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Make sure that the batch size of mini-batch k-means can be set, and that it
+ * must not be negative.
+ */
+TEST_CASE_METHOD(KmTestFixture, "KmeansMiniBatchSizeTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  int c = 5;
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Unable to load train dataset vc2.csv!");
+
+  size_t row = inputData.n_rows;
+
+  SetInputParam("input", inputData);
+  SetInputParam("clusters", c);
+  SetInputParam("algorithm", std::string("minibatch"));
+  SetInputParam("batch_size", 50);
+  SetInputParam("max_iterations", 20);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::mat>("centroid").n_rows == row);
+  REQUIRE(params.Get<arma::mat>("centroid").n_cols == (arma::uword) c);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("clusters", c);
+  SetInputParam("algorithm", std::string("minibatch"));
+  SetInputParam("batch_size", -1);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -515,3 +515,36 @@ TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestWarmStart",
 
   REQUIRE(oldNumTrees + 10 == newNumTrees);
 }
+
+/**
+ * Make sure that the out-of-bag error and the feature importance are computed
+ * when requested.
+ */
+TEST_CASE_METHOD(RandomForestTestFixture, "RandomForestOOBErrorTest",
+                 "[RandomForestMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  const size_t dimensionality = inputData.n_rows;
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("compute_oob_error", true);
+  SetInputParam("compute_feature_importance", true);
+
+  RUN_BINDING();
+
+  const double oobError = params.Get<double>("oob_error");
+  REQUIRE(oobError >= 0.0);
+  REQUIRE(oobError <= 0.35);
+
+  const arma::vec& importances = params.Get<arma::vec>("feature_importance");
+  REQUIRE(importances.n_elem == dimensionality);
+  REQUIRE(importances.max() > 0.0);
+}
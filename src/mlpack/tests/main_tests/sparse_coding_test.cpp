@@ -695,3 +695,46 @@ TEST_CASE_METHOD(SparseCodingTestFixture, "SparseCodingDiffL1L2Test",
   REQUIRE(arma::accu(codes ==
       params.Get<arma::mat>("codes")) < codes.n_elem);
 }
+
+/**
+ * Check that a model encodes the same codes by coordinate descent as by LARS.
+ */
+TEST_CASE_METHOD(SparseCodingTestFixture, "SparseCodingCoordinateDescentTest",
+                 "[SparseCodingMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  arma::mat testData;
+  LoadData(inputData, testData);
+
+  // Input data.
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("atoms", (int) 2);
+  SetInputParam("lambda1", 0.1);
+  SetInputParam("max_iterations", (int) 100);
+  SetInputParam("normalize", (bool) true);
+  SetInputParam("test", testData);
+
+  RUN_BINDING();
+
+  arma::mat codes = std::move(params.Get<arma::mat>("codes"));
+
+  // Reset passed parameters.
+  SparseCoding* m = params.Get<SparseCoding*>("output_model");
+  params.Get<SparseCoding*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  // Encode the test points again, by coordinate descent.
+  SetInputParam("input_model", m);
+  SetInputParam("normalize", (bool) true);
+  SetInputParam("coordinate_descent", (bool) true);
+  SetInputParam("test", std::move(testData));
+
+  RUN_BINDING();
+
+  const arma::mat& cdCodes = params.Get<arma::mat>("codes");
+  REQUIRE(cdCodes.n_rows == codes.n_rows);
+  REQUIRE(cdCodes.n_cols == codes.n_cols);
+  for (size_t i = 0; i < codes.n_elem; ++i)
+    REQUIRE(cdCodes[i] == Approx(codes[i]).margin(1e-4));
+}
@@ -0,0 +1,180 @@
+/**
+ * @file tests/main_tests/xgboost_test.cpp
+ *
+ * Test RUN_BINDING() of xgboost_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/xgboost/xgboost_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(XGBoostTestFixture);
+
+/**
+ * Make a simple regression dataset.
+ */
+void XGBoostBindingDataset(const size_t numPoints,
+                           arma::mat& data,
+                           arma::rowvec& responses)
+{
+  data.randu(2, numPoints);
+  responses = 3.0 * data.row(0) + arma::sin(4.0 * data.row(1));
+}
+
+/**
+ * Check that there is one prediction per test point, and that they are
+ * accurate.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostOutputDimensionTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat data, testData;
+  arma::rowvec responses, testResponses;
+  XGBoostBindingDataset(1000, data, responses);
+  XGBoostBindingDataset(200, testData, testResponses);
+
+  SetInputParam("training", std::move(data));
+  SetInputParam("training_responses", std::move(responses));
+  SetInputParam("test", testData);
+  SetInputParam("learning_rate", 0.1);
+
+  RUN_BINDING();
+
+  const arma::rowvec& predictions = params.Get<arma::rowvec>("predictions");
+  REQUIRE(predictions.n_elem == 200);
+  REQUIRE(arma::mean(arma::square(predictions - testResponses)) <
+      0.05 * arma::var(testResponses));
+}
+
+/**
+ * Ensure that a saved model gives the same predictions.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostModelReuseTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat data, testData;
+  arma::rowvec responses, testResponses;
+  XGBoostBindingDataset(500, data, responses);
+  XGBoostBindingDataset(100, testData, testResponses);
+
+  SetInputParam("training", std::move(data));
+  SetInputParam("training_responses", std::move(responses));
+  SetInputParam("test", testData);
+  SetInputParam("num_rounds", 20);
+
+  RUN_BINDING();
+
+  const arma::rowvec predictions = params.Get<arma::rowvec>("predictions");
+  ensemble::XGBoost<>* model =
+      params.Get<ensemble::XGBoost<>*>("output_model");
+  REQUIRE(model->NumTrees() == 20);
+
+  // Reset passed parameters.
+  params.Get<ensemble::XGBoost<>*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", model);
+  SetInputParam("test", std::move(testData));
+
+  RUN_BINDING();
+
+  CheckMatrices(predictions, params.Get<arma::rowvec>("predictions"));
+}
+
+/**
+ * Check that early stopping keeps fewer trees than the number of rounds.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostEarlyStoppingTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat data, validationData;
+  arma::rowvec responses, validationResponses;
+  XGBoostBindingDataset(200, data, responses);
+  XGBoostBindingDataset(200, validationData, validationResponses);
+  responses += arma::randn<arma::rowvec>(200);
+  validationResponses += arma::randn<arma::rowvec>(200);
+
+  SetInputParam("training", std::move(data));
+  SetInputParam("training_responses", std::move(responses));
+  SetInputParam("validation", std::move(validationData));
+  SetInputParam("validation_responses", std::move(validationResponses));
+  SetInputParam("num_rounds", 1000);
+  SetInputParam("max_depth", 0);
+  SetInputParam("lambda", 0.0);
+  SetInputParam("min_child_weight", 0.0);
+  SetInputParam("early_stopping_rounds", 5);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<ensemble::XGBoost<>*>("output_model")->NumTrees() <
+      1000);
+}
+
+/**
+ * Check that invalid parameters are rejected.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostInvalidParametersTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  XGBoostBindingDataset(100, data, responses);
+
+  Log::Fatal.ignoreInput = true;
+
+  // No responses.
+  SetInputParam("training", data);
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Invalid learning rate.
+  SetInputParam("training", data);
+  SetInputParam("training_responses", responses);
+  SetInputParam("learning_rate", 0.0);
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Invalid subsample.
+  SetInputParam("training", data);
+  SetInputParam("training_responses", responses);
+  SetInputParam("subsample", 1.5);
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Invalid number of bins.
+  SetInputParam("training", data);
+  SetInputParam("training_responses", responses);
+  SetInputParam("max_bins", 1);
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Validation set without responses.
+  SetInputParam("training", data);
+  SetInputParam("training_responses", responses);
+  SetInputParam("validation", data);
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  Log::Fatal.ignoreInput = false;
+}
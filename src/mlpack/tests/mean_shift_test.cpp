@@ -162,3 +162,53 @@ TEST_CASE("GaussianClustering", "[MeanShiftTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Make sure that without seeds, every point is shifted and the remaining
+ * centroids are at least one radius apart, with or without the kernel.
+ */
+TEST_CASE("MeanShiftNoSeedsTest", "[MeanShiftTest]")
+{
+  arma::mat dataset(2, 600);
+  dataset.cols(0, 199) = arma::randn(2, 200) * 0.3;
+  dataset.cols(200, 399) = arma::randn(2, 200) * 0.3;
+  dataset.cols(400, 599) = arma::randn(2, 200) * 0.3;
+  dataset.cols(200, 399).each_col() += arma::vec("6.0 0.0");
+  dataset.cols(400, 599).each_col() += arma::vec("0.0 6.0");
+
+  MeanShift<> meanShift(1.5);
+  MeanShift<true> kernelMeanShift(1.5);
+
+  arma::Row<size_t> assignments, kernelAssignments;
+  arma::mat centroids, kernelCentroids;
+  meanShift.Cluster(dataset, assignments, centroids, true, false);
+  kernelMeanShift.Cluster(dataset, kernelAssignments, kernelCentroids, true,
+      false);
+
+  REQUIRE(centroids.n_cols == 3);
+  REQUIRE(kernelCentroids.n_cols == 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = i + 1; j < 3; ++j)
+    {
+      REQUIRE(metric::EuclideanDistance::Evaluate(centroids.col(i),
+          centroids.col(j)) >= 1.5);
+      REQUIRE(metric::EuclideanDistance::Evaluate(kernelCentroids.col(i),
+          kernelCentroids.col(j)) >= 1.5);
+    }
+  }
+
+  // Each blob is one cluster.
+  for (size_t c = 0; c < 3; ++c)
+  {
+    for (size_t i = 200 * c; i < 200 * (c + 1); ++i)
+    {
+      REQUIRE(assignments[i] == assignments[200 * c]);
+      REQUIRE(kernelAssignments[i] == kernelAssignments[200 * c]);
+    }
+  }
+
+  REQUIRE(assignments[0] != assignments[200]);
+  REQUIRE(assignments[0] != assignments[400]);
+  REQUIRE(assignments[200] != assignments[400]);
+}
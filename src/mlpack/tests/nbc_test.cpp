@@ -398,3 +398,194 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Make sure that training incrementally on a stream of minibatches gives the
+ * same model as training on all the points at once.
+ */
+TEST_CASE("NaiveBayesClassifierMinibatchTest", "[NBCTest]")
+{
+  const size_t classes = 4;
+  arma::mat trainData(6, 1000, arma::fill::randn);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(1000, arma::distr_param(0, classes - 1));
+  // Give each class a different mean and scale.
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    trainData.col(i) = (labels[i] + 1) * trainData.col(i) + 3.0 * labels[i];
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+
+  // Use batches of different sizes, including a batch with only one point.
+  NaiveBayesClassifier<> nbcBatches(trainData.n_rows, classes);
+  const size_t bounds[] = { 0, 1, 50, 300, 301, 700, 1000 };
+  for (size_t b = 0; b < 6; ++b)
+  {
+    const arma::mat batch = trainData.cols(bounds[b], bounds[b + 1] - 1);
+    const arma::Row<size_t> batchLabels =
+        labels.subvec(bounds[b], bounds[b + 1] - 1);
+    nbcBatches.Train(batch, batchLabels, classes, true);
+  }
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    REQUIRE(nbcBatches.Means()[i] == Approx(nbc.Means()[i]).epsilon(1e-7));
+    REQUIRE(nbcBatches.Variances()[i] ==
+        Approx(nbc.Variances()[i]).epsilon(1e-7));
+  }
+
+  for (size_t i = 0; i < classes; ++i)
+  {
+    REQUIRE(nbcBatches.Probabilities()[i] ==
+        Approx(nbc.Probabilities()[i]).epsilon(1e-7));
+  }
+
+  // Training again without the incremental algorithm forgets the batches.
+  nbcBatches.Train(trainData, labels, classes, false);
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    REQUIRE(nbcBatches.Variances()[i] ==
+        Approx(nbc.Variances()[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that incremental training with a different number of classes
+ * starts from an empty model, and that an invalid label throws without
+ * modifying the model.
+ */
+TEST_CASE("NaiveBayesClassifierChangeClassesTest", "[NBCTest]")
+{
+  arma::mat trainData(4, 200, arma::fill::randn);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(200, arma::distr_param(0, 2));
+
+  NaiveBayesClassifier<> nbc(trainData, labels, 3);
+
+  // Training the two-class model again with the incremental algorithm must not
+  // count the points of the three-class model.
+  arma::Row<size_t> newLabels =
+      arma::randi<arma::Row<size_t>>(200, arma::distr_param(0, 1));
+  newLabels[0] = 0;
+  newLabels[1] = 1;
+  nbc.Train(trainData, newLabels, 2, true);
+
+  NaiveBayesClassifier<> nbc2(trainData, newLabels, 2);
+  REQUIRE(nbc.Probabilities().n_elem == 2);
+  REQUIRE(arma::accu(nbc.Probabilities()) == Approx(1.0));
+  for (size_t i = 0; i < 2; ++i)
+  {
+    REQUIRE(nbc.Probabilities()[i] ==
+        Approx(nbc2.Probabilities()[i]).epsilon(1e-7));
+  }
+
+  // A label that is too large is an error, and the model is unchanged.
+  const arma::vec probabilities = nbc.Probabilities();
+  newLabels[5] = 2;
+  REQUIRE_THROWS_AS(nbc.Train(trainData, newLabels, 2, true),
+      std::invalid_argument);
+  REQUIRE(arma::approx_equal(nbc.Probabilities(), probabilities, "absdiff",
+      1e-10));
+}
+
+/**
+ * Make sure that classifying a set of points at once gives the same
+ * predictions and probabilities as classifying each point on its own.
+ */
+TEST_CASE("NaiveBayesClassifierBatchClassifyTest", "[NBCTest]")
+{
+  const size_t classes = 3;
+  arma::mat trainData(10, 600, arma::fill::randn);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(600, arma::distr_param(0, classes - 1));
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    trainData.col(i) += labels[i];
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+
+  arma::mat testData(10, 200, arma::fill::randn);
+  testData *= 2.0;
+  arma::Row<size_t> predictions, probabilityPredictions;
+  arma::mat probabilities;
+  nbc.Classify(testData, predictions);
+  nbc.Classify(testData, probabilityPredictions, probabilities);
+
+  REQUIRE(probabilities.n_rows == classes);
+  REQUIRE(probabilities.n_cols == testData.n_cols);
+  for (size_t i = 0; i < testData.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    nbc.Classify(testData.col(i), prediction, pointProbabilities);
+
+    REQUIRE(predictions[i] == prediction);
+    REQUIRE(probabilityPredictions[i] == prediction);
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0));
+    for (size_t c = 0; c < classes; ++c)
+    {
+      REQUIRE(probabilities(c, i) ==
+          Approx(pointProbabilities[c]).margin(1e-10));
+    }
+  }
+}
+
+/**
+ * Train on features whose means are large relative to their standard
+ * deviations, and compare the class probabilities with those computed directly
+ * from the model in double precision.
+ */
+template<typename MatType>
+void CheckLargeMeanProbabilities(const double offset,
+                                 const double stddev,
+                                 const double tolerance)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t classes = 2;
+  arma::mat noise(3, 400, arma::fill::randn);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(400, arma::distr_param(0, classes - 1));
+  for (size_t i = 0; i < noise.n_cols; ++i)
+    noise.col(i) = offset + stddev * (noise.col(i) + labels[i]);
+  const MatType trainData = arma::conv_to<MatType>::from(noise);
+
+  NaiveBayesClassifier<MatType> nbc(trainData, labels, classes);
+
+  arma::Row<size_t> predictions;
+  MatType probabilities;
+  nbc.Classify(trainData, predictions, probabilities);
+
+  const arma::mat means = arma::conv_to<arma::mat>::from(nbc.Means());
+  const arma::mat variances = arma::conv_to<arma::mat>::from(nbc.Variances());
+  const arma::vec classProbabilities =
+      arma::conv_to<arma::vec>::from(nbc.Probabilities());
+  const arma::mat data = arma::conv_to<arma::mat>::from(trainData);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::vec logLikelihoods(classes);
+    for (size_t c = 0; c < classes; ++c)
+    {
+      logLikelihoods[c] = std::log(classProbabilities[c]) - 0.5 *
+          arma::accu(arma::log(2 * M_PI * variances.col(c)) +
+          arma::square(data.col(i) - means.col(c)) / variances.col(c));
+    }
+
+    const arma::vec expected = arma::exp(logLikelihoods -
+        arma::max(logLikelihoods)) / arma::accu(arma::exp(logLikelihoods -
+        arma::max(logLikelihoods)));
+    for (size_t c = 0; c < classes; ++c)
+    {
+      REQUIRE(probabilities(c, i) ==
+          Approx((ElemType) expected[c]).margin(tolerance));
+    }
+  }
+}
+
+TEST_CASE("NaiveBayesClassifierLargeMeanTest", "[NBCTest]")
+{
+  CheckLargeMeanProbabilities<arma::mat>(1e6, 1e-3, 1e-6);
+}
+
+TEST_CASE("NaiveBayesClassifierLargeMeanFloatTest", "[NBCTest]")
+{
+  CheckLargeMeanProbabilities<arma::fmat>(1e4, 1e-2, 1e-4);
+}
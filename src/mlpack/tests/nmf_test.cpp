@@ -299,3 +299,100 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * Make sure that weighted ALS recovers a low-rank matrix from a sparse sample
+ * of its elements, using only the observed elements.
+ */
+TEST_CASE("SparseWeightedALSTest", "[NMFTest]")
+{
+  mat w = randu<mat>(50, 3);
+  mat h = randu<mat>(3, 40);
+  mat dv = w * h;
+
+  // Observe about half of the elements.
+  sp_mat v(dv % conv_to<mat>::from(randu<mat>(50, 40) < 0.5));
+  const size_t r = 3;
+
+  SimpleToleranceTermination<sp_mat> stt(1e-8, 200);
+  AMF<SimpleToleranceTermination<sp_mat>,
+      RandomInitialization,
+      WeightedALSUpdate> als(stt, RandomInitialization(),
+      WeightedALSUpdate(1e-6));
+  mat ow, oh;
+  als.Apply(v, r, ow, oh);
+
+  // The missing elements should be recovered too.
+  const double relError = arma::norm(dv - ow * oh, "fro") /
+      arma::norm(dv, "fro");
+  REQUIRE(relError < 0.05);
+}
+
+/**
+ * Check the implicit feedback path of weighted ALS on a small case that can be
+ * solved by hand.  With alpha > 0, each column of H minimizes
+ *
+ *   sum_i (1 + alpha * V(i, j)) (P(i, j) - W.row(i) * h)^2 + lambda ||h||^2,
+ *
+ * where P(i, j) is 1 if V(i, j) is observed and 0 otherwise.
+ */
+TEST_CASE("ImplicitWeightedALSTest", "[NMFTest]")
+{
+  // Two items and two users; only V(0, 0) = 3 is observed.
+  sp_mat v(2, 2);
+  v(0, 0) = 3.0;
+
+  const double lambda = 1.0;
+  const double alpha = 1.0;
+  WeightedALSUpdate update(lambda, alpha);
+  update.Initialize(v, 1);
+
+  // The objective of one column of H (or one row of W), given the fixed
+  // factors of the other side and the (dense) column of V.
+  auto objective = [&](const vec& fixed, const vec& values, const double x)
+  {
+    double result = lambda * x * x;
+    for (size_t i = 0; i < values.n_elem; ++i)
+    {
+      const double preference = (values[i] != 0.0) ? 1.0 : 0.0;
+      const double confidence = 1.0 + alpha * values[i];
+      result += confidence * std::pow(preference - fixed[i] * x, 2.0);
+    }
+    return result;
+  };
+
+  // User 0: 4 (1 - h)^2 + (0 - 2h)^2 + h^2 is minimized at h = 4 / 9.
+  // User 1: (0 - h)^2 + (0 - 2h)^2 + h^2 is minimized at h = 0.
+  mat w = { { 1.0 }, { 2.0 } };
+  mat h(1, 2);
+  update.HUpdate(v, w, h);
+
+  REQUIRE(h(0, 0) == Approx(4.0 / 9.0).epsilon(1e-10));
+  REQUIRE(h(0, 1) == Approx(0.0).margin(1e-10));
+
+  const mat dv(v);
+  const vec wCol = w.col(0);
+  for (size_t j = 0; j < 2; ++j)
+  {
+    const double best = objective(wCol, dv.col(j), h(0, j));
+    REQUIRE(best < objective(wCol, dv.col(j), h(0, j) + 1e-3));
+    REQUIRE(best < objective(wCol, dv.col(j), h(0, j) - 1e-3));
+  }
+
+  // Item 0: 4 (1 - 0.5 w)^2 + (0 - w)^2 + w^2 is minimized at w = 2 / 3.
+  // Item 1: (0 - 0.5 w)^2 + (0 - w)^2 + w^2 is minimized at w = 0.
+  h = { { 0.5, 1.0 } };
+  update.WUpdate(v, w, h);
+
+  REQUIRE(w(0, 0) == Approx(2.0 / 3.0).epsilon(1e-10));
+  REQUIRE(w(1, 0) == Approx(0.0).margin(1e-10));
+
+  const vec hRow = h.row(0).t();
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const vec values = dv.row(i).t();
+    const double best = objective(hRow, values, w(i, 0));
+    REQUIRE(best < objective(hRow, values, w(i, 0) + 1e-3));
+    REQUIRE(best < objective(hRow, values, w(i, 0) - 1e-3));
+  }
+}
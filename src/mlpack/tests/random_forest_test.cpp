@@ -608,3 +608,236 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.91);
 }
+
+/**
+ * Make sure that a compiled random forest gives exactly the same predictions
+ * and probabilities as the forest it was compiled from.
+ */
+TEST_CASE("CompiledRandomForestTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  RandomForest<> rf(trainingData, di, trainingLabels, 5, 10 /* 10 trees */);
+  CompiledRandomForest<RandomForest<>> compiledForest(rf);
+  REQUIRE(compiledForest.NumTrees() == rf.NumTrees());
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  rf.Classify(testData, predictions, probabilities);
+  compiledForest.Classify(testData, compiledPredictions,
+      compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(compiledForest.Classify(testData.col(i)) == predictions[i]);
+
+  // An empty forest cannot classify.
+  CompiledRandomForest<RandomForest<>> emptyForest;
+  REQUIRE_THROWS_AS(emptyForest.Classify(testData, compiledPredictions),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that bootstrap counts add up to the number of points.
+ */
+TEST_CASE("BootstrapCountsTest", "[RandomForestTest]")
+{
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::Row<size_t> counts;
+    BootstrapCounts(1000, counts);
+
+    REQUIRE(counts.n_elem == 1000);
+    REQUIRE(arma::accu(counts) == 1000);
+
+    // About 63% of the points should be drawn at least once.
+    const size_t inBag = arma::accu(counts > 0);
+    REQUIRE(inBag > 550);
+    REQUIRE(inBag < 720);
+  }
+}
+
+/**
+ * Check the ranks and values of a sorted feature index, and that categorical
+ * dimensions are not changed.
+ */
+TEST_CASE("SortedFeatureIndexTest", "[RandomForestTest]")
+{
+  arma::mat dataset("3.0 -1.0 3.0 0.5 -1.0;"
+                    "2.0  0.0 1.0 1.0  2.0");
+  data::DatasetInfo info(2);
+  info.MapString<double>("a", 1);
+  info.MapString<double>("b", 1);
+  info.MapString<double>("c", 1);
+
+  SortedFeatureIndex index;
+  index.Build<true>(dataset, info);
+
+  const arma::Mat<uint32_t>& ranks = index.Ranks();
+  REQUIRE(ranks.n_rows == 2);
+  REQUIRE(ranks.n_cols == 5);
+  REQUIRE(ranks(0, 0) == 2);
+  REQUIRE(ranks(0, 1) == 0);
+  REQUIRE(ranks(0, 2) == 2);
+  REQUIRE(ranks(0, 3) == 1);
+  REQUIRE(ranks(0, 4) == 0);
+  for (size_t i = 0; i < 5; ++i)
+    REQUIRE(ranks(1, i) == (uint32_t) dataset(1, i));
+
+  REQUIRE(index.Values(0).n_elem == 3);
+  REQUIRE(index.Values(0)[0] == -1.0);
+  REQUIRE(index.Values(0)[1] == 0.5);
+  REQUIRE(index.Values(0)[2] == 3.0);
+
+  // Without dataset information, every dimension is ranked.
+  index.Build<false>(dataset, info);
+  REQUIRE(index.Ranks()(1, 0) == 2);
+  REQUIRE(index.Ranks()(1, 1) == 0);
+  REQUIRE(index.Ranks()(1, 2) == 1);
+  REQUIRE(index.Values(1).n_elem == 3);
+}
+
+/**
+ * Make sure that a decision tree trained on ranks, once its splits are
+ * restored, classifies points like a decision tree trained on the values.
+ */
+TEST_CASE("SortedFeatureIndexRestoreSplitsTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  SortedFeatureIndex index;
+  index.Build<false>(dataset, data::DatasetInfo(dataset.n_rows));
+
+  DecisionTree<> dt(dataset, labels, 3, 5);
+  DecisionTree<> rankTree(index.Ranks(), labels, 3, 5);
+  index.RestoreSplits(rankTree);
+
+  REQUIRE(rankTree.NumChildren() == dt.NumChildren());
+
+  arma::Row<size_t> predictions, rankPredictions;
+  dt.Classify(dataset, predictions);
+  rankTree.Classify(dataset, rankPredictions);
+  CheckMatrices(predictions, rankPredictions);
+
+  // On points that were not seen, the split points may differ, but only
+  // between two consecutive training values.
+  dt.Classify(testDataset, predictions);
+  rankTree.Classify(testDataset, rankPredictions);
+  REQUIRE(arma::accu(predictions == rankPredictions) >=
+      0.9 * testDataset.n_cols);
+}
+
+/**
+ * Make sure that the out-of-bag error is close to the error on a test set, and
+ * that each tree has about a third of the points out of bag.
+ */
+TEST_CASE("RandomForestOOBErrorTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  for (size_t i = 0; i < rf.NumTrees(); ++i)
+  {
+    REQUIRE(rf.OOBIndices(i).n_elem > 0.25 * dataset.n_cols);
+    REQUIRE(rf.OOBIndices(i).n_elem < 0.5 * dataset.n_cols);
+  }
+
+  arma::Row<size_t> predictions;
+  rf.Classify(testDataset, predictions);
+  const double testError = 1.0 - (double) arma::accu(predictions ==
+      testLabels) / testLabels.n_elem;
+
+  const double oobError = rf.OOBError(dataset, labels);
+  REQUIRE(oobError >= 0.0);
+  REQUIRE(oobError <= 0.35);
+  REQUIRE(std::abs(oobError - testError) < 0.15);
+
+  // A loaded forest has no out-of-bag points.
+  RandomForest<> xmlRf, jsonRf, binaryRf;
+  SerializeObjectAll(rf, xmlRf, jsonRf, binaryRf);
+  REQUIRE_THROWS_AS(xmlRf.OOBError(dataset, labels), std::invalid_argument);
+
+  // Neither do extra trees, which do not use bootstrap sampling.
+  ExtraTrees<> et(dataset, labels, 3, 5);
+  REQUIRE_THROWS_AS(et.OOBError(dataset, labels), std::invalid_argument);
+
+  // The dataset must be the training set.
+  REQUIRE_THROWS_AS(rf.OOBError(dataset.cols(0, 9), labels.subvec(0, 9)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the permutation importance finds the only informative
+ * dimension.
+ */
+TEST_CASE("RandomForestFeatureImportanceTest", "[RandomForestTest]")
+{
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    labels[i] = (dataset(2, i) > 0.5) ? 1 : 0;
+
+  RandomForest<> rf(dataset, labels, 2, 20 /* 20 trees */, 1, 1e-7, 0,
+      MultipleRandomDimensionSelect(2));
+
+  arma::vec importances;
+  rf.FeatureImportance(dataset, labels, importances);
+
+  REQUIRE(importances.n_elem == 4);
+  REQUIRE(importances[2] > 0.3);
+  REQUIRE(std::abs(importances[0]) < 0.05);
+  REQUIRE(std::abs(importances[1]) < 0.05);
+  REQUIRE(std::abs(importances[3]) < 0.05);
+}
+
+/**
+ * Make sure that the permutation importance only depends on the random seed,
+ * and not on how the work is split across threads.
+ */
+TEST_CASE("RandomForestFeatureImportanceSeedTest", "[RandomForestTest]")
+{
+  arma::mat dataset(4, 500, arma::fill::randu);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 500; ++i)
+    labels[i] = (dataset(1, i) + dataset(3, i) > 1.0) ? 1 : 0;
+
+  RandomForest<> rf(dataset, labels, 2, 10 /* 10 trees */, 1, 1e-7, 0,
+      MultipleRandomDimensionSelect(2));
+
+  arma::vec importances1, importances2;
+  math::RandomSeed(7);
+  rf.FeatureImportance(dataset, labels, importances1);
+  math::RandomSeed(7);
+  rf.FeatureImportance(dataset, labels, importances2);
+
+  REQUIRE(importances1.n_elem == 4);
+  REQUIRE(arma::approx_equal(importances1, importances2, "absdiff", 1e-12));
+}
@@ -674,3 +674,47 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+/**
+ * Make sure that softmax regression trained on sparse data, in single or double
+ * precision, finds the same model as on dense data.
+ */
+TEST_CASE("SoftmaxRegressionSparseTest", "[SoftmaxRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 800, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = (size_t) std::min(2.0, std::floor(arma::accu(
+        denseDataset.col(i))));
+
+  arma::sp_fmat sparseFloatDataset(
+      arma::conv_to<arma::fmat>::from(denseDataset));
+
+  SoftmaxRegression sr(denseDataset, labels, 3, 0.01, true);
+  SoftmaxRegression srSparse(dataset, labels, 3, 0.01, true);
+  SoftmaxRegression srSparseFloat(sparseFloatDataset, labels, 3, 0.01, true);
+
+  REQUIRE(sr.Parameters().n_elem == srSparse.Parameters().n_elem);
+  REQUIRE(sr.Parameters().n_elem == srSparseFloat.Parameters().n_elem);
+  for (size_t i = 0; i < sr.Parameters().n_elem; ++i)
+  {
+    REQUIRE(sr.Parameters()[i] ==
+        Approx(srSparse.Parameters()[i]).epsilon(1e-2).margin(1e-2));
+    REQUIRE(sr.Parameters()[i] ==
+        Approx(srSparseFloat.Parameters()[i]).epsilon(1e-2).margin(1e-2));
+  }
+
+  arma::Row<size_t> predictions, sparsePredictions, sparseFloatPredictions;
+  sr.Classify(denseDataset, predictions);
+  srSparse.Classify(dataset, sparsePredictions);
+  srSparseFloat.Classify(sparseFloatDataset, sparseFloatPredictions);
+  REQUIRE(arma::accu(predictions == sparsePredictions) >= 795);
+  REQUIRE(arma::accu(predictions == sparseFloatPredictions) >= 790);
+
+  // Shuffled minibatches of sparse data should give a good model too.
+  SoftmaxRegression srSGD(dataset, labels, 3, 0.0001, true,
+      ens::StandardSGD(0.1, 32, 50 * dataset.n_cols, 1e-9, true));
+  REQUIRE(srSGD.ComputeAccuracy(dataset, labels) >= 80.0);
+}
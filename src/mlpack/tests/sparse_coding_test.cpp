@@ -109,6 +109,73 @@ TEST_CASE("SparseCodingTestCodingStepElasticNet", "[SparseCodingTest]")
   }
 }
 
+/**
+ * Make sure that coding by coordinate descent gives the same codes as LARS.
+ */
+TEST_CASE("SparseCodingTestCodingStepCoordinateDescent", "[SparseCodingTest]")
+{
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  // Try the LASSO and the Elastic Net.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    SparseCoding sc(nAtoms, 0.1, (trial == 0) ? 0.0 : 0.2);
+    DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+
+    mat larsZ, cdZ;
+    sc.Encode(X, larsZ);
+    sc.UseCoordinateDescent() = true;
+    sc.Encode(X, cdZ);
+
+    REQUIRE(cdZ.n_rows == nAtoms);
+    REQUIRE(cdZ.n_cols == nPoints);
+    for (uword i = 0; i < larsZ.n_elem; ++i)
+      REQUIRE(cdZ[i] == Approx(larsZ[i]).margin(1e-3));
+  }
+}
+
+/**
+ * Make sure that encoding a batch of points, in parallel with one solver per
+ * thread, gives the same codes as solving for each point separately.
+ */
+TEST_CASE("SparseCodingTestBatchEncoding", "[SparseCodingTest]")
+{
+  double lambda1 = 0.1;
+  double lambda2 = 0.05;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, lambda2);
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+  mat Z;
+  sc.Encode(X, Z);
+
+  const mat& D = sc.Dictionary();
+  const mat gram = trans(D) * D;
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    LARS lars(true, gram, lambda1, lambda2);
+    vec beta;
+    lars.Train(D, X.col(i).t(), beta, false);
+    CheckMatrices(Z.col(i), beta);
+  }
+}
+
 TEST_CASE("SparseCodingTestDictionaryStep", "[SparseCodingTest]")
 {
   const double tol = 1e-6;
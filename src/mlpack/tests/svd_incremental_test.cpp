@@ -2,8 +2,8 @@
  * @file tests/svd_incremental_test.cpp
  * @author Sumedh Ghaisas
  *
- * Tests for SVDIncompleteIncrementalLearning and
- * SVDCompleteIncrementalLearning.
+ * Tests for SVDIncompleteIncrementalLearning,
+ * SVDCompleteIncrementalLearning and SVDHogwildLearning.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -136,3 +136,60 @@ TEST_CASE("SVDIncompleteIncrementalRegularizationTest", "[SVDIncrementalTest]")
 
   REQUIRE(regularizedRMSE < regularRMSE + 0.105);
 }
+
+/**
+ * Test for convergence of lock-free parallel (Hogwild!) learning.
+ */
+TEST_CASE("SVDHogwildConvergenceTest", "[SVDIncrementalTest]")
+{
+  sp_mat data;
+  data.sprandn(100, 100, 0.2);
+
+  SVDHogwildLearning svd(0.01);
+  SimpleToleranceTermination<sp_mat> stt;
+
+  AMF<SimpleToleranceTermination<sp_mat>,
+      RandomInitialization,
+      SVDHogwildLearning> amf(stt, RandomInitialization(), svd);
+
+  mat m1, m2;
+  amf.Apply(data, 2, m1, m2);
+
+  REQUIRE(amf.TerminationPolicy().Iteration() !=
+          amf.TerminationPolicy().MaxIterations());
+}
+
+/**
+ * Make sure that lock-free parallel learning recovers a low-rank matrix from
+ * its observed elements.
+ */
+TEST_CASE("SVDHogwildReconstructionTest", "[SVDIncrementalTest]")
+{
+  const mat w = randu<mat>(200, 3);
+  const mat h = randu<mat>(3, 150);
+  const mat full = w * h;
+
+  // Observe about 30% of the elements.
+  sp_mat data(sprandu<sp_mat>(200, 150, 0.3));
+  for (sp_mat::iterator it = data.begin(); it != data.end(); ++it)
+    (*it) = full(it.row(), it.col());
+
+  SVDHogwildLearning svd(0.02);
+  MaxIterationTermination mit(300);
+  AMF<MaxIterationTermination,
+      RandomInitialization,
+      SVDHogwildLearning> amf(mit, RandomInitialization(), svd);
+
+  mat m1, m2;
+  amf.Apply(data, 3, m1, m2);
+
+  double error = 0.0;
+  for (sp_mat::const_iterator it = data.begin(); it != data.end(); ++it)
+  {
+    const double prediction = arma::dot(m1.row(it.row()), m2.col(it.col()));
+    error += std::pow(prediction - (*it), 2.0);
+  }
+  const double rmse = std::sqrt(error / data.n_nonzero);
+
+  REQUIRE(rmse < 0.1);
+}
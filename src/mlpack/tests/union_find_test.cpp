@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "catch.hpp"
 
 using namespace mlpack;
@@ -46,3 +47,60 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+TEST_CASE("TestConcurrentUnion", "[UnionFindTest]")
+{
+  static const size_t testSize = 10;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == i);
+
+  REQUIRE(testUnionFind.Union(0, 1));
+  REQUIRE(testUnionFind.Union(2, 3));
+  REQUIRE(testUnionFind.Union(0, 2));
+  REQUIRE(testUnionFind.Union(5, 0));
+  REQUIRE(testUnionFind.Union(0, 6));
+
+  // These are already in the same component.
+  REQUIRE(!testUnionFind.Union(3, 1));
+  REQUIRE(!testUnionFind.Union(6, 6));
+
+  REQUIRE(testUnionFind.Find(0) == testUnionFind.Find(1));
+  REQUIRE(testUnionFind.Find(2) == testUnionFind.Find(3));
+  REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
+  REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
+  REQUIRE(testUnionFind.Find(4) == 4);
+
+  // The root of each component is its smallest element.
+  REQUIRE(testUnionFind.Find(6) == 0);
+}
+
+/**
+ * Union many random pairs in parallel, and make sure the components are the
+ * same as with the sequential union-find.
+ */
+TEST_CASE("TestConcurrentUnionParallel", "[UnionFindTest]")
+{
+  static const size_t testSize = 5000;
+  const arma::Mat<size_t> pairs = arma::randi<arma::Mat<size_t>>(2, 4000,
+      arma::distr_param(0, testSize - 1));
+
+  UnionFind sequential(testSize);
+  for (size_t i = 0; i < pairs.n_cols; ++i)
+    sequential.Union(pairs(0, i), pairs(1, i));
+
+  ConcurrentUnionFind concurrent(testSize);
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) pairs.n_cols; ++i)
+    concurrent.Union(pairs(0, i), pairs(1, i));
+
+  for (size_t i = 0; i < testSize; ++i)
+  {
+    for (size_t j = i + 1; j < std::min(i + 50, testSize); ++j)
+    {
+      REQUIRE((sequential.Find(i) == sequential.Find(j)) ==
+          (concurrent.Find(i) == concurrent.Find(j)));
+    }
+  }
+}
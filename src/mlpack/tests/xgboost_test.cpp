@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -64,3 +65,330 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Test that the gradients, Hessians and loss of SSE loss are correct.
+ */
+TEST_CASE("SSEGradientsTest", "[XGBTest]")
+{
+  arma::rowvec observed = { 1.0, 3.0, 2.0, 2.0 };
+  arma::rowvec predictions = { 0.5, 1.0, 2.5, 1.5 };
+
+  SSELoss loss;
+  arma::vec gradients, hessians;
+  loss.Gradients(observed, predictions, gradients, hessians);
+
+  REQUIRE(gradients.n_elem == 4);
+  REQUIRE(hessians.n_elem == 4);
+  REQUIRE(gradients[0] == Approx(-0.5));
+  REQUIRE(gradients[1] == Approx(-2.0));
+  REQUIRE(gradients[2] == Approx(0.5));
+  REQUIRE(gradients[3] == Approx(-0.5));
+  REQUIRE(arma::all(hessians == 1.0));
+
+  // (0.25 + 4 + 0.25 + 0.25) / 8.
+  REQUIRE(loss.Loss(observed, predictions) == Approx(0.59375));
+}
+
+/**
+ * Test that a dimension with few distinct values gets one bin per value, with
+ * cuts halfway between them, and that binning matches the cuts.
+ */
+TEST_CASE("QuantileBinningFewValuesTest", "[XGBTest]")
+{
+  arma::mat data = { { 3.0, 1.0, 2.0, 1.0, 3.0, 5.0 },
+                     { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+
+  QuantileBinning binning(256);
+  binning.Fit(data);
+
+  REQUIRE(binning.NumBins(0) == 4);
+  REQUIRE(binning.Cut(0, 0) == Approx(1.5));
+  REQUIRE(binning.Cut(0, 1) == Approx(2.5));
+  REQUIRE(binning.Cut(0, 2) == Approx(4.0));
+  REQUIRE(binning.NumBins(1) == 1);
+
+  arma::Mat<unsigned char> bins;
+  binning.Transform(data, bins);
+
+  REQUIRE(bins.n_rows == 6);
+  REQUIRE(bins.n_cols == 2);
+  const size_t expected[] = { 2, 0, 1, 0, 2, 3 };
+  for (size_t i = 0; i < 6; ++i)
+  {
+    REQUIRE((size_t) bins(i, 0) == expected[i]);
+    REQUIRE((size_t) bins(i, 1) == 0);
+  }
+}
+
+/**
+ * Test that a dimension with many distinct values is split into at most the
+ * maximum number of bins, of roughly equal sizes.
+ */
+TEST_CASE("QuantileBinningManyValuesTest", "[XGBTest]")
+{
+  arma::mat data(1, 10000, arma::fill::randu);
+
+  QuantileBinning binning(16);
+  binning.Fit(data);
+  REQUIRE(binning.NumBins(0) <= 16);
+  REQUIRE(binning.NumBins(0) >= 15);
+
+  arma::Mat<unsigned char> bins;
+  binning.Transform(data, bins);
+
+  arma::Col<size_t> counts(binning.NumBins(0), arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE((size_t) bins(i, 0) < binning.NumBins(0));
+    ++counts[bins(i, 0)];
+
+    // The bin must match the cuts.
+    if (bins(i, 0) > 0)
+      REQUIRE(data(0, i) > binning.Cut(0, bins(i, 0) - 1));
+    if ((size_t) bins(i, 0) + 1 < binning.NumBins(0))
+      REQUIRE(data(0, i) <= binning.Cut(0, bins(i, 0)));
+  }
+
+  for (size_t b = 0; b < counts.n_elem; ++b)
+  {
+    REQUIRE(counts[b] > 500);
+    REQUIRE(counts[b] < 800);
+  }
+}
+
+/**
+ * Test that a single unregularized tree fits a step function exactly, and
+ * that predictions on the original and binned points agree.
+ */
+TEST_CASE("HistogramTreeStepTest", "[XGBTest]")
+{
+  arma::mat data(2, 200, arma::fill::randu);
+  arma::rowvec responses(200);
+  for (size_t i = 0; i < 200; ++i)
+    responses[i] = (data(1, i) > 0.5) ? 3.0 : -1.0;
+
+  QuantileBinning binning;
+  binning.Fit(data);
+  arma::Mat<unsigned char> bins;
+  binning.Transform(data, bins);
+
+  // With a zero prediction, the gradients are the negated responses.
+  arma::vec gradients = -responses.t();
+  arma::vec hessians(200, arma::fill::ones);
+  std::vector<size_t> rows(200);
+  for (size_t i = 0; i < 200; ++i)
+    rows[i] = i;
+  std::vector<size_t> dimensions = { 0, 1 };
+
+  HistogramTree tree;
+  tree.Train(bins, binning, gradients, hessians, rows, dimensions, 1, 0.0,
+      0.0, 0.0, 0.0, 1.0);
+
+  REQUIRE(tree.NumNodes() == 3);
+  REQUIRE(tree.NumLeaves() == 2);
+  for (size_t i = 0; i < 200; ++i)
+  {
+    REQUIRE(tree.Predict(data.col(i)) == Approx(responses[i]));
+    REQUIRE(tree.Predict(bins, i) == Approx(responses[i]));
+  }
+}
+
+/**
+ * Test that the minimum split gain stops a tree from splitting.
+ */
+TEST_CASE("HistogramTreeGammaTest", "[XGBTest]")
+{
+  arma::mat data(1, 100, arma::fill::randu);
+  arma::rowvec responses(100);
+  for (size_t i = 0; i < 100; ++i)
+    responses[i] = (data(0, i) > 0.5) ? 0.1 : -0.1;
+
+  QuantileBinning binning;
+  binning.Fit(data);
+  arma::Mat<unsigned char> bins;
+  binning.Transform(data, bins);
+
+  arma::vec gradients = -responses.t();
+  arma::vec hessians(100, arma::fill::ones);
+  std::vector<size_t> rows(100);
+  for (size_t i = 0; i < 100; ++i)
+    rows[i] = i;
+  std::vector<size_t> dimensions = { 0 };
+
+  // The best split has a gain of 1/2 * 100 * 0.1^2 = 0.5.
+  HistogramTree tree;
+  tree.Train(bins, binning, gradients, hessians, rows, dimensions, 0, 0.0,
+      0.0, 0.0, 1.0, 1.0);
+  REQUIRE(tree.NumLeaves() == 1);
+
+  tree.Train(bins, binning, gradients, hessians, rows, dimensions, 0, 0.0,
+      0.0, 0.0, 0.1, 1.0);
+  REQUIRE(tree.NumLeaves() == 2);
+}
+
+/**
+ * Make a noisy nonlinear regression dataset.
+ */
+void XGBoostDataset(const size_t numPoints,
+                    arma::mat& data,
+                    arma::rowvec& responses,
+                    const double noise)
+{
+  data.randu(3, numPoints);
+  responses.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    responses[i] = std::sin(6.0 * data(0, i)) + 2.0 * data(1, i) * data(1, i) +
+        ((data(2, i) > 0.5) ? 1.0 : 0.0);
+  }
+  responses += noise * arma::randn<arma::rowvec>(numPoints);
+}
+
+/**
+ * Test that boosting fits a nonlinear function much better than its mean.
+ */
+TEST_CASE("XGBoostRegressionTest", "[XGBTest]")
+{
+  arma::mat data, testData;
+  arma::rowvec responses, testResponses;
+  XGBoostDataset(2000, data, responses, 0.0);
+  XGBoostDataset(500, testData, testResponses, 0.0);
+
+  XGBoost<> model(200, 0.1, 4);
+  const double trainingLoss = model.Train(data, responses);
+
+  REQUIRE(model.NumTrees() == 200);
+  REQUIRE(model.Dimensionality() == 3);
+  REQUIRE(model.InitialPrediction() == Approx(arma::mean(responses)));
+
+  arma::rowvec predictions;
+  model.Predict(testData, predictions);
+  REQUIRE(predictions.n_elem == 500);
+
+  const double baseline = arma::var(testResponses);
+  const double mse = arma::mean(arma::square(predictions - testResponses));
+  REQUIRE(mse < 0.05 * baseline);
+  REQUIRE(trainingLoss < 0.05 * baseline);
+
+  // The single-point overload gives the same result.
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(model.Predict(testData.col(i)) == Approx(predictions[i]));
+}
+
+/**
+ * Test that training on random subsets of the points and dimensions still
+ * learns the function.
+ */
+TEST_CASE("XGBoostSubsampleTest", "[XGBTest]")
+{
+  arma::mat data, testData;
+  arma::rowvec responses, testResponses;
+  XGBoostDataset(2000, data, responses, 0.0);
+  XGBoostDataset(500, testData, testResponses, 0.0);
+
+  XGBoost<> model(300, 0.1, 4);
+  model.Subsample() = 0.5;
+  model.ColumnSubsample() = 0.67;
+  model.MaxBins() = 32;
+  model.Train(data, responses);
+
+  arma::rowvec predictions;
+  model.Predict(testData, predictions);
+
+  const double mse = arma::mean(arma::square(predictions - testResponses));
+  REQUIRE(mse < 0.1 * arma::var(testResponses));
+}
+
+/**
+ * Test that early stopping removes the trees after the best validation round,
+ * and that the returned loss is the validation loss of the final model.
+ */
+TEST_CASE("XGBoostEarlyStoppingTest", "[XGBTest]")
+{
+  arma::mat data, validationData;
+  arma::rowvec responses, validationResponses;
+  XGBoostDataset(300, data, responses, 0.5);
+  XGBoostDataset(300, validationData, validationResponses, 0.5);
+
+  // Deep trees with no regularization overfit quickly.
+  XGBoost<> model(500, 0.5, 0);
+  model.Lambda() = 0.0;
+  model.MinChildWeight() = 0.0;
+  model.EarlyStoppingRounds() = 10;
+  const double validationLoss = model.Train(data, responses, validationData,
+      validationResponses);
+
+  REQUIRE(model.NumTrees() < 500);
+
+  arma::rowvec predictions;
+  model.Predict(validationData, predictions);
+  SSELoss loss;
+  REQUIRE(loss.Loss(validationResponses, predictions) ==
+      Approx(validationLoss).epsilon(1e-7));
+
+  // Adding the next tree does not improve the validation loss.
+  XGBoost<> longerModel(model.NumTrees() + 1, 0.5, 0);
+  longerModel.Lambda() = 0.0;
+  longerModel.MinChildWeight() = 0.0;
+  const double longerLoss = longerModel.Train(data, responses, validationData,
+      validationResponses);
+  REQUIRE(longerModel.NumTrees() == model.NumTrees() + 1);
+  REQUIRE(longerLoss >= validationLoss);
+}
+
+/**
+ * Test that invalid parameters are rejected.
+ */
+TEST_CASE("XGBoostInvalidParametersTest", "[XGBTest]")
+{
+  arma::mat data(3, 100, arma::fill::randu);
+  arma::rowvec responses(100, arma::fill::randu);
+  arma::rowvec wrongResponses(99, arma::fill::randu);
+
+  XGBoost<> model(10);
+  REQUIRE_THROWS_AS(model.Train(data, wrongResponses), std::invalid_argument);
+
+  model.Subsample() = 0.0;
+  REQUIRE_THROWS_AS(model.Train(data, responses), std::invalid_argument);
+
+  model.Subsample() = 1.0;
+  model.MaxBins() = 1000;
+  REQUIRE_THROWS_AS(model.Train(data, responses), std::invalid_argument);
+
+  model.MaxBins() = 256;
+  model.Train(data, responses);
+  arma::mat wrongData(4, 10, arma::fill::randu);
+  arma::rowvec predictions;
+  REQUIRE_THROWS_AS(model.Predict(wrongData, predictions),
+      std::invalid_argument);
+}
+
+/**
+ * Test that a serialized model gives the same predictions.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  XGBoostDataset(500, data, responses, 0.1);
+
+  XGBoost<> model(20, 0.3, 3);
+  model.Train(data, responses);
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+
+  XGBoost<> xmlModel, jsonModel, binaryModel(5);
+  binaryModel.Train(data, responses);
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::rowvec xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+
+  REQUIRE(binaryModel.NumTrees() == 20);
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}